@@ -198,6 +198,7 @@ extern "C"{
  int gpu_get_device_count(int * dev_count);
  int gpu_is_mine(int gpu_num);
  int gpu_busy_least();
+ int gpu_tasks_in_flight(int gpu_num = -1);
  int gpu_in_focus(int gpu_num = -1);
  int gpu_activate(int gpu_num);
  size_t gpu_device_memory_size(int gpu_num);
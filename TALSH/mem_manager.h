@@ -13,21 +13,40 @@ LICENSE: BSD 3-Clause
 #define MEM_MANAGER_H_
 
 #include <cstddef>
+#include <atomic>
 
 //Types:
-// Generic slab:
+// Generic slab (thread-safe: lock-free free list with optional per-thread magazines):
 typedef struct{
  size_t max_entries;    //max number of entries in the slab
  size_t entry_size;     //entry size in bytes (can be larger than the slab data type because of alignment)
  size_t alignment;      //optional alignment of entries with respect to the slab base
- size_t first_free;     //first free entry number (stack pointer)
+ std::atomic<unsigned long long> free_head; //tagged head of the free list: [ABA tag (32 bits) | free entry number (32 bits)]
  void * slab_base;      //slab base pointer
- void ** free_entries;  //stack of free entries
+ std::atomic<unsigned int> * free_links; //free list links: next free entry number for each free entry
+ std::atomic<unsigned char> * entry_used; //per-entry in-use flags (detection of double release)
+ void * magazines;      //per-thread magazines caching free entries (NULL: disabled)
+ unsigned int num_mags; //number of magazines
+ unsigned int mag_size; //capacity of each magazine (number of entries)
 #ifndef NO_GPU
  int mem_mapped;        //non-zero if the underlying Host memory was allocated via cudaHostAlloc() as portable mapped
 #endif
 } slab_t;
 
+// Object pool (slab with per-thread magazines backed by the heap once the slab is exhausted):
+typedef struct{
+ slab_t slab;                               //slab of pooled objects
+ size_t obj_size;                           //object size in bytes
+ std::atomic<unsigned long long> pool_gets; //number of objects served from the slab
+ std::atomic<unsigned long long> heap_gets; //number of objects served from the heap (slab exhausted or absent)
+ std::atomic<long long> num_used;           //number of objects currently in use
+} obj_pool_t;
+
+// Argument buffer entry relocator (online defragmentation of an argument buffer):
+//  action = 0: query whether the argument buffer entry can be relocated (returns YEP/NOPE);
+//  action = 1: relocate the contents of the argument buffer entry elsewhere and release it (returns 0 on success).
+typedef int (*buf_entry_relocator_t)(int dev_id, int entry_num, int action);
+
 //Exported functions:
 extern "C"{
 //Buffer memory management (all devices):
@@ -46,6 +65,8 @@ extern "C"{
  void print_blck_buf_sizes_host(); //Host only
  int get_buf_entry_host(size_t bsize, char **entry_ptr, int *entry_num); //Host only
  int free_buf_entry_host(int entry_num); //Host only
+ int arg_buf_set_relocator_host(buf_entry_relocator_t relocator); //Host only
+ int arg_buf_defrag_host(size_t bsize); //Host only
  int get_buf_entry_gpu(int gpu_num, size_t bsize, char **entry_ptr, int *entry_num); //NVidia GPU only
  int free_buf_entry_gpu(int gpu_num, int entry_num); //NVidia GPU only
  int const_args_entry_get(int gpu_num, int *entry_num); //NVidia GPU only
@@ -63,6 +84,7 @@ extern "C"{
 #else
  int slab_construct(slab_t * slab, size_t slab_entry_size, size_t slab_max_entries, size_t align = 0);
 #endif
+ int slab_set_magazines(slab_t * slab, unsigned int num_mags, unsigned int mag_size = 32);
  int slab_entry_get(slab_t * slab, void ** slab_entry);
  int slab_entry_release(slab_t * slab, void * slab_entry);
  int slab_get_base_ptr(slab_t * slab, void ** base_ptr);
@@ -72,12 +94,20 @@ extern "C"{
  int slab_destruct(slab_t * slab);
  int slab_destroy(slab_t * slab);
 
+ int obj_pool_construct(obj_pool_t * pool, size_t obj_size, size_t max_pooled, unsigned int num_mags = 64);
+ int obj_pool_get(obj_pool_t * pool, void ** obj);
+ int obj_pool_release(obj_pool_t * pool, void * obj);
+ int obj_pool_get_stats(obj_pool_t * pool, unsigned long long * pool_gets, unsigned long long * heap_gets, long long * num_used);
+ int obj_pool_destruct(obj_pool_t * pool);
+
  int host_mem_alloc(void **host_ptr, size_t tsize, size_t align = 1);
  int host_mem_free(void *host_ptr);
  int host_mem_alloc_pin(void **host_ptr, size_t tsize); //generic
  int host_mem_free_pin(void *host_ptr); //generic
  int host_mem_register(void *host_ptr, size_t tsize); //generic
  int host_mem_unregister(void *host_ptr); //generic
+ int host_mem_map_file(void **host_ptr, size_t tsize, const char *file_name, int map_mode, int map_advice); //Host only
+ int host_mem_unmap_file(void *host_ptr, size_t tsize); //Host only
  int mem_allocate(int dev_id, size_t bytes, int in_buffer, void ** mem_ptr); //generic
  int mem_free(int dev_id, void ** mem_ptr); // generic
 
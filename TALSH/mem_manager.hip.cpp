@@ -27,6 +27,13 @@ FOR DEVELOPERS ONLY:
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
+#include <new>
+#include <atomic>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
 
 #ifndef NO_OMP
 #include <omp.h>
@@ -42,6 +49,10 @@ FOR DEVELOPERS ONLY:
 #define BLCK_BUF_DEPTH_GPU 12        //number of distinct tensor block buffer levels on GPU
 #define BLCK_BUF_TOP_GPU 6           //number of argument buffer entries of the largest size (level 0) on GPU: multiple of 3
 #define BLCK_BUF_BRANCH_GPU 2        //branching factor for each subsequent buffer level on GPU
+//Generic slab:
+#define SLAB_NULL_ENTRY 0xFFFFFFFFU  //free list terminator (no free entry)
+#define SLAB_ENTRY_MASK 0xFFFFFFFFULL //mask extracting the entry number from the tagged free list head
+#define SLAB_MAG_MAX_SIZE 64         //max capacity of a per-thread slab magazine
 
 static int VERBOSE=1; //verbosity (for errors)
 static int DEBUG=0;   //debugging
@@ -55,6 +66,14 @@ typedef struct{
  int buf_branch; //branching factor for each subsequent level
 } ab_conf_t;
 
+// Per-thread slab magazine (cache of free slab entries):
+typedef struct{
+ std::atomic_flag busy;                     //magazine try-lock (a busy magazine is bypassed, never waited upon)
+ unsigned int count;                        //number of cached free entries
+ unsigned int entries[SLAB_MAG_MAX_SIZE];   //cached free entry numbers
+ char padding[GPU_CACHE_LINE_LEN];          //prevents false sharing between neighboring magazines
+} slab_mag_t;
+
 //MODULE DATA:
 // Buffer memory management:
 #ifndef NO_OMP
@@ -84,6 +103,12 @@ size_t occ_size_host=0; //total size (bytes) of all occupied entries in the Host
 size_t occ_size_gpu[MAX_GPUS_PER_NODE]={0}; //total size (bytes) of all occupied entries in each GPU buffer
 size_t args_size_host=0; //total size (bytes) of all arguments in the Host argument buffer !`Not used now
 size_t args_size_gpu[MAX_GPUS_PER_NODE]={0}; //total size (bytes) of all arguments in each GPU buffer !`Not used now
+// Host argument buffer defragmentation:
+buf_entry_relocator_t abh_relocator=NULL; //relocator of the Host argument buffer entries (NULL: defragmentation disabled)
+int abh_defrag_active=0; //non-zero while a defragmentation pass is in progress
+size_t abh_defrag_passes=0; //number of successful defragmentation passes over the Host argument buffer
+size_t abh_defrag_moves=0; //number of relocated Host argument buffer entries
+size_t abh_defrag_bytes=0; //total size (bytes) of relocated Host argument buffer entries
 // Slab for multi-index storage (pinned Host memory):
 int miBank[MAX_GPU_ARGS*MAX_MLNDS_PER_TENS][MAX_TENSOR_RANK]; //All active .dims[], .divs[], .grps[], .prmn[] will be stored here
 int miFreeHandle[MAX_GPU_ARGS*MAX_MLNDS_PER_TENS]; //free entries for storing multi-indices
@@ -99,6 +124,8 @@ static size_t ab_get_offset(ab_conf_t ab_conf, int level, int offset, const size
 static int get_buf_entry(ab_conf_t ab_conf, size_t bsize, void *arg_buf_ptr, size_t *ab_occ, size_t ab_occ_size,
                          const size_t *blck_sizes, char **entry_ptr, int *entry_num);
 static int free_buf_entry(ab_conf_t ab_conf, size_t *ab_occ, size_t ab_occ_size, const size_t *blck_sizes, int entry_num);
+static int ab_entry_is_whole(ab_conf_t ab_conf, const size_t *ab_occ, int level, int offset);
+static void ab_collect_entries(ab_conf_t ab_conf, const size_t *ab_occ, int level, int offset, int *entries, int *num_entries);
 static void ab_conf_print(ab_conf_t ab_conf);
 static int mi_entry_init();
 static int mi_entry_stop();
@@ -156,6 +183,35 @@ static int ab_get_1st_child(ab_conf_t ab_conf, int level, int offset)
  }
 }
 
+static int ab_entry_is_whole(ab_conf_t ab_conf, const size_t *ab_occ, int level, int offset)
+/** Returns YEP if the buffer entry {level, offset} is occupied as a whole (allocated directly),
+NOPE if it is either free or only partially occupied via its children. No arguments bounds check here! **/
+{
+ int i,l;
+ size_t occ;
+ if(ab_occ[ab_get_1d_pos(ab_conf,level,offset)] == 0) return NOPE;
+ if(level == ab_conf.buf_depth-1) return YEP;
+ l=ab_get_1st_child(ab_conf,level,offset); occ=0;
+ for(i=0;i<ab_conf.buf_branch;i++) occ+=ab_occ[ab_get_1d_pos(ab_conf,level+1,l+i)];
+ if(occ == 0) return YEP;
+ return NOPE;
+}
+
+static void ab_collect_entries(ab_conf_t ab_conf, const size_t *ab_occ, int level, int offset, int *entries, int *num_entries)
+/** Appends the numbers of all directly allocated buffer entries from the subtree
+rooted at the buffer entry {level, offset} to <entries[]>, in depth-first order. **/
+{
+ int i,l;
+ if(ab_occ[ab_get_1d_pos(ab_conf,level,offset)] == 0) return;
+ if(ab_entry_is_whole(ab_conf,ab_occ,level,offset) == YEP){
+  entries[(*num_entries)++]=ab_get_1d_pos(ab_conf,level,offset);
+ }else{
+  l=ab_get_1st_child(ab_conf,level,offset);
+  for(i=0;i<ab_conf.buf_branch;i++) ab_collect_entries(ab_conf,ab_occ,level+1,l+i,entries,num_entries);
+ }
+ return;
+}
+
 static size_t ab_get_offset(ab_conf_t ab_conf, int level, int offset, const size_t *blck_sizes)
 /** This function returns a byte offset in the argument buffer space
 corresponding to a given buffer entry {level, offset}.
@@ -321,7 +377,7 @@ int arg_buf_deallocate(int gpu_beg, int gpu_end)
 #endif
 #pragma omp flush
  err_code=0;
- if(abh_occ != NULL) free(abh_occ); abh_occ=NULL; abh_occ_size=0; max_args_host=0;
+ if(abh_occ != NULL) free(abh_occ); abh_occ=NULL; abh_occ_size=0; max_args_host=0; abh_relocator=NULL;
  for(i=0;i<MAX_GPUS_PER_NODE;i++){
   if(abg_occ[i] != NULL) free(abg_occ[i]); abg_occ[i]=NULL; abg_occ_size[i]=0; max_args_gpu[i]=0;
  }
@@ -778,6 +834,125 @@ INPUT:
  return err_code;
 }
 
+int arg_buf_set_relocator_host(buf_entry_relocator_t relocator)
+/** Registers the relocator of Host argument buffer entries which is used by arg_buf_defrag_host().
+Passing NULL unregisters the relocator, thus disabling the defragmentation. **/
+{
+#ifndef NO_OMP
+ omp_set_nest_lock(&mem_lock);
+#endif
+#pragma omp flush
+ if(bufs_ready == 0){
+#ifndef NO_OMP
+  omp_unset_nest_lock(&mem_lock);
+#endif
+  return -1;
+ }
+ abh_relocator=relocator;
+#pragma omp flush
+#ifndef NO_OMP
+ omp_unset_nest_lock(&mem_lock);
+#endif
+ return 0;
+}
+
+int arg_buf_defrag_host(size_t bsize)
+/** Performs a defragmentation pass over the Host argument buffer in order to free up a buffer entry
+suitable for a block of size <bsize> when the total free space is sufficient but fragmented.
+Among the buffer entries of the matching level, the one with the least occupied space, all
+directly allocated sub-entries of which are relocatable, is chosen. Its sub-entries are then
+relocated elsewhere (larger ones first) by the relocator registered via arg_buf_set_relocator_host(),
+which is responsible for moving the data and updating all references to the relocated entries.
+The chosen buffer entry is reserved during the pass, such that no relocated data lands inside it.
+RETURN STATUS:
+ # 0 - success (a subsequent get_buf_entry_host() for <bsize> bytes will succeed, unless raced);
+ # TRY_LATER - defragmentation is currently impossible (not enough free space, no relocator, immovable entries);
+ # DEVICE_UNABLE - the argument buffer can never satisfy this request;
+ # Other - an error occurred.
+**/
+{
+ int i,j,l,m,n,lev,nent,best,num_entries,dev_id,err_code;
+ size_t cost,best_cost,vocc;
+ int *entries;
+ ab_conf_t ab_conf;
+#ifndef NO_OMP
+ omp_set_nest_lock(&mem_lock);
+#endif
+#pragma omp flush
+ if(bufs_ready == 0){
+#ifndef NO_OMP
+  omp_unset_nest_lock(&mem_lock);
+#endif
+  return -1;
+ }
+ if(bsize > blck_sizes_host[0]){
+#ifndef NO_OMP
+  omp_unset_nest_lock(&mem_lock);
+#endif
+  return DEVICE_UNABLE;
+ }
+ ab_conf.buf_top=BLCK_BUF_TOP_HOST; ab_conf.buf_depth=BLCK_BUF_DEPTH_HOST; ab_conf.buf_branch=BLCK_BUF_BRANCH_HOST;
+ lev=0; while(lev < ab_conf.buf_depth-1){if(blck_sizes_host[lev+1] < bsize) break; lev++;} //target buffer level
+ entries=NULL;
+ if(abh_relocator != NULL && abh_defrag_active == 0 && arg_buf_host_size-occ_size_host >= blck_sizes_host[lev])
+  entries=(int*)malloc(abh_occ_size*sizeof(int));
+ if(entries == NULL){ //no relocator, recursive call, not enough free space in total, or out of memory
+#ifndef NO_OMP
+  omp_unset_nest_lock(&mem_lock);
+#endif
+  return TRY_LATER;
+ }
+ abh_defrag_active=1; err_code=TRY_LATER; dev_id=encode_device_id(DEV_HOST,0);
+//Choose the cheapest relocatable buffer entry at the target level:
+ nent=ab_conf.buf_top; for(i=0;i<lev;i++) nent*=ab_conf.buf_branch;
+ best=-1; best_cost=blck_sizes_host[lev]; //fully occupied entries are never candidates
+ for(j=0;j<nent;j++){
+  m=ab_get_1d_pos(ab_conf,lev,j); cost=abh_occ[m];
+  if(cost >= best_cost) continue;
+  l=j; for(i=lev;i>0;i--){ //skip entries residing inside a directly allocated ancestor entry
+   l=ab_get_parent(ab_conf,i,l); if(ab_entry_is_whole(ab_conf,abh_occ,i-1,l) == YEP) break;
+  }
+  if(i > 0) continue;
+  num_entries=0; ab_collect_entries(ab_conf,abh_occ,lev,j,entries,&num_entries);
+  for(n=0;n<num_entries;n++){if(abh_relocator(dev_id,entries[n],0) != YEP) break;}
+  if(n < num_entries) continue; //immovable sub-entry
+  best=j; best_cost=cost;
+  if(cost == 0) break;
+ }
+//Relocate all sub-entries of the chosen buffer entry:
+ if(best >= 0){
+  m=ab_get_1d_pos(ab_conf,lev,best);
+  num_entries=0; ab_collect_entries(ab_conf,abh_occ,lev,best,entries,&num_entries);
+  for(n=1;n<num_entries;n++){ //lower entry numbers correspond to larger blocks: relocate them first
+   i=entries[n]; j=n-1; while(j >= 0 && entries[j] > i){entries[j+1]=entries[j]; j--;} entries[j+1]=i;
+  }
+  vocc=blck_sizes_host[lev]-abh_occ[m]; //reserve the chosen entry by virtually occupying its free space
+  l=best; i=lev; abh_occ[m]+=vocc;
+  while(i>0){l=ab_get_parent(ab_conf,i,l); i--; abh_occ[ab_get_1d_pos(ab_conf,i,l)]+=vocc;}
+  err_code=0;
+  for(n=0;n<num_entries;n++){
+   i=ab_get_2d_pos(ab_conf,entries[n],&j,&l); if(i != 0){err_code=1; break;}
+   i=abh_relocator(dev_id,entries[n],1); if(i != 0){err_code=TRY_LATER; break;}
+   abh_defrag_moves++; abh_defrag_bytes+=blck_sizes_host[j];
+   l=best; i=lev; abh_occ[m]+=blck_sizes_host[j]; vocc+=blck_sizes_host[j]; //keep the vacated space reserved
+   while(i>0){l=ab_get_parent(ab_conf,i,l); i--; abh_occ[ab_get_1d_pos(ab_conf,i,l)]+=blck_sizes_host[j];}
+  }
+  l=best; i=lev; abh_occ[m]-=vocc; //release the reservation
+  while(i>0){l=ab_get_parent(ab_conf,i,l); i--; abh_occ[ab_get_1d_pos(ab_conf,i,l)]-=vocc;}
+  if(err_code == 0) abh_defrag_passes++;
+  if(LOGGING){
+   printf("\n#DEBUG(TALSH:mem_manager): Host Buffer defragmentation for %lu B: Status %d: %d entries relocated\n",bsize,err_code,n);
+   fflush(stdout);
+  }
+ }
+ abh_defrag_active=0; free(entries);
+#pragma omp flush
+#ifndef NO_OMP
+ omp_unset_nest_lock(&mem_lock);
+#endif
+ return err_code;
+}
+
 #ifndef NO_GPU
 int get_buf_entry_gpu(int gpu_num, size_t bsize, char **entry_ptr, int *entry_num)
 /** This function returns a pointer to a free argument buffer space in the GPU#gpu_num argument buffer.
@@ -1211,6 +1386,9 @@ int mem_print_stats(int dev_id) //print memory statistics for Device <dev_id>
     printf(" Number of occupied entries      : %d\n",num_args_host);
     printf(" Size of occupied entries (bytes): %lu\n",occ_size_host);
 //  printf(" Size of all arguments (bytes)   : %lu\n",args_size_host);
+    printf(" Defragmentation passes          : %lu\n",abh_defrag_passes);
+    printf(" Relocated entries               : %lu\n",abh_defrag_moves);
+    printf(" Size of relocated data (bytes)  : %lu\n",abh_defrag_bytes);
     break;
 #ifndef NO_GPU
    case DEV_NVIDIA_GPU:
@@ -1253,6 +1431,50 @@ int mem_print_stats(int dev_id) //print memory statistics for Device <dev_id>
 }
 
 //Generic memory slab API:
+// Slab free list helpers (lock-free LIFO of entry numbers with an ABA tag):
+static inline unsigned long long slab_tag_head(unsigned long long tag, unsigned int entry_num)
+{
+ return ((tag<<32)|((unsigned long long)entry_num));
+}
+
+static int slab_pop_free(slab_t * slab, unsigned int * entry_num)
+/** Pops a free entry number from the global free list of the slab. **/
+{
+ unsigned long long head,next_head;
+ unsigned int n;
+
+ head=slab->free_head.load(std::memory_order_acquire);
+ do{
+  n=(unsigned int)(head&SLAB_ENTRY_MASK);
+  if(n == SLAB_NULL_ENTRY) return TRY_LATER; //no free entries left
+  next_head=slab_tag_head((head>>32)+1ULL,slab->free_links[n].load(std::memory_order_relaxed));
+ }while(!slab->free_head.compare_exchange_weak(head,next_head,std::memory_order_acq_rel,std::memory_order_acquire));
+ *entry_num=n;
+ return 0;
+}
+
+static void slab_push_free(slab_t * slab, unsigned int entry_num)
+/** Pushes a free entry number back to the global free list of the slab. **/
+{
+ unsigned long long head,next_head;
+
+ head=slab->free_head.load(std::memory_order_relaxed);
+ do{
+  slab->free_links[entry_num].store((unsigned int)(head&SLAB_ENTRY_MASK),std::memory_order_relaxed);
+  next_head=slab_tag_head((head>>32)+1ULL,entry_num);
+ }while(!slab->free_head.compare_exchange_weak(head,next_head,std::memory_order_release,std::memory_order_relaxed));
+ return;
+}
+
+static unsigned int slab_thread_slot()
+/** Returns a persistent slot number for the calling thread (used for choosing its magazine). **/
+{
+ static std::atomic<unsigned int> num_slots(0);
+ static thread_local unsigned int slot=SLAB_NULL_ENTRY;
+ if(slot == SLAB_NULL_ENTRY) slot=num_slots.fetch_add(1U,std::memory_order_relaxed)%SLAB_NULL_ENTRY;
+ return slot;
+}
+
 int slab_create(slab_t ** slab)
 /** Allocates an empty slab object on heap. **/
 {
@@ -1264,7 +1486,9 @@ int slab_clean(slab_t * slab)
 /** Cleans a statically declared (undefined) slab_t to an empty state.
     Do not call this function on a non-empty slab_t, use slab_destruct() instead! **/
 {
- slab->max_entries=0; slab->entry_size=0; slab->slab_base=NULL; slab->free_entries=NULL;
+ slab->max_entries=0; slab->entry_size=0; slab->slab_base=NULL; slab->free_links=NULL; slab->entry_used=NULL;
+ slab->magazines=NULL; slab->num_mags=0; slab->mag_size=0;
+ slab->free_head.store(slab_tag_head(0ULL,SLAB_NULL_ENTRY),std::memory_order_relaxed);
  return 0;
 }
 
@@ -1273,15 +1497,18 @@ int slab_construct(slab_t * slab, size_t slab_entry_size, size_t slab_max_entrie
 #else
 int slab_construct(slab_t * slab, size_t slab_entry_size, size_t slab_max_entries, size_t align)
 #endif
-/** Constructs a user-defined slab. **/
+/** Constructs a user-defined slab. The slab can be shared by concurrent threads:
+    Entries are acquired/released via a lock-free (ABA-tagged) free list. **/
 {
- size_t j,l;
+ size_t l;
 #ifndef NO_GPU
  hipError_t err;
 #endif
 
  if(slab == NULL || slab_entry_size == 0 || slab_max_entries == 0) return -1;
- slab->slab_base=NULL; slab->free_entries=NULL; slab->max_entries=0;
+ if(slab_max_entries >= (size_t)SLAB_NULL_ENTRY) return -1; //entry numbers must fit into 32 bits
+ slab->slab_base=NULL; slab->free_links=NULL; slab->entry_used=NULL; slab->max_entries=0;
+ slab->magazines=NULL; slab->num_mags=0; slab->mag_size=0;
  if(align == 0){
   slab->entry_size = slab_entry_size;
  }else{
@@ -1291,8 +1518,10 @@ int slab_construct(slab_t * slab, size_t slab_entry_size, size_t slab_max_entrie
    slab->entry_size = slab_entry_size;
   }
  }
- slab->free_entries=(void**)malloc(sizeof(void*)*slab_max_entries);
- if(slab->free_entries == NULL){slab->entry_size=0; return 1;}
+ slab->free_links=new(std::nothrow) std::atomic<unsigned int>[slab_max_entries];
+ if(slab->free_links == NULL){slab->entry_size=0; return 1;}
+ slab->entry_used=new(std::nothrow) std::atomic<unsigned char>[slab_max_entries];
+ if(slab->entry_used == NULL){delete [] slab->free_links; slab->free_links=NULL; slab->entry_size=0; return 1;}
 #ifndef NO_GPU
  if(mapped == 0){
   slab->slab_base=(void*)malloc((slab->entry_size)*slab_max_entries);
@@ -1305,46 +1534,107 @@ int slab_construct(slab_t * slab, size_t slab_entry_size, size_t slab_max_entrie
  slab->slab_base=(void*)malloc((slab->entry_size)*slab_max_entries);
 #endif
  if(slab->slab_base == NULL){
-  free(slab->free_entries); slab->entry_size=0; return 2;
+  delete [] slab->entry_used; slab->entry_used=NULL;
+  delete [] slab->free_links; slab->free_links=NULL; slab->entry_size=0; return 2;
  }else{
   slab->max_entries=slab_max_entries;
   slab->alignment=MAX(align,1);
-  slab->first_free=0; j=0;
-  for(l=0;l<slab_max_entries;l++){
-   slab->free_entries[l]=(void*)(&(((char*)(slab->slab_base))[j]));
-   j=j+slab->entry_size;
-  }
+  for(l=0;l<slab_max_entries;l++) slab->entry_used[l].store(0,std::memory_order_relaxed);
+  for(l=0;l<slab_max_entries-1;l++) slab->free_links[l].store((unsigned int)(l+1),std::memory_order_relaxed);
+  slab->free_links[slab_max_entries-1].store(SLAB_NULL_ENTRY,std::memory_order_relaxed);
+  slab->free_head.store(slab_tag_head(0ULL,0U),std::memory_order_release);
  }
  return 0;
 }
 
+int slab_set_magazines(slab_t * slab, unsigned int num_mags, unsigned int mag_size)
+/** Enables per-thread magazines (small caches of free entries) in a constructed slab.
+    Each thread is mapped to one of <num_mags> magazines, each caching up to <mag_size> entries,
+    which removes contention on the global free list for threads reusing their own entries.
+    Must be called before any slab entry is acquired. **/
+{
+ slab_mag_t * mags;
+ unsigned int i;
+
+ if(slab == NULL) return -1;
+ if(slab->max_entries == 0 || slab->slab_base == NULL || slab->free_links == NULL) return -2;
+ if(slab->magazines != NULL) return 1; //magazines have already been set
+ if(num_mags == 0 || mag_size == 0 || mag_size > SLAB_MAG_MAX_SIZE) return -3;
+ mags=new(std::nothrow) slab_mag_t[num_mags]; if(mags == NULL) return TRY_LATER;
+ for(i=0;i<num_mags;i++){mags[i].busy.clear(); mags[i].count=0;}
+ slab->num_mags=num_mags; slab->mag_size=mag_size;
+ slab->magazines=(void*)mags;
+ std::atomic_thread_fence(std::memory_order_release);
+ return 0;
+}
+
 int slab_entry_get(slab_t * slab, void ** slab_entry)
-/** Gets a slab entry. **/
+/** Gets a slab entry (thread-safe). **/
 {
+ slab_mag_t * mags, * mag;
+ unsigned int i,m,n;
+ int errc;
+
  if(slab == NULL) return -1;
- if(slab->max_entries == 0 || slab->slab_base == NULL || slab->free_entries == NULL) return -2;
- if(slab->first_free < slab->max_entries){
-  *slab_entry=slab->free_entries[(slab->first_free)++];
- }else{
-  return TRY_LATER; //no free entries left
+ if(slab->max_entries == 0 || slab->slab_base == NULL || slab->free_links == NULL) return -2;
+ mags=(slab_mag_t*)(slab->magazines);
+ if(mags != NULL){ //try the magazine of the current thread first
+  mag=&(mags[slab_thread_slot()%(slab->num_mags)]);
+  if(!mag->busy.test_and_set(std::memory_order_acquire)){
+   if(mag->count > 0){
+    n=mag->entries[--(mag->count)]; mag->busy.clear(std::memory_order_release);
+    slab->entry_used[n].store(1,std::memory_order_relaxed);
+    *slab_entry=(void*)(&(((char*)(slab->slab_base))[n*(slab->entry_size)]));
+    return 0;
+   }
+   mag->busy.clear(std::memory_order_release);
+  }
  }
+ errc=slab_pop_free(slab,&n);
+ if(errc == TRY_LATER && mags != NULL){ //steal a cached entry from any magazine
+  m=slab_thread_slot();
+  for(i=0;i<slab->num_mags;i++){
+   mag=&(mags[(m+i)%(slab->num_mags)]);
+   if(!mag->busy.test_and_set(std::memory_order_acquire)){
+    if(mag->count > 0){n=mag->entries[--(mag->count)]; errc=0;}
+    mag->busy.clear(std::memory_order_release);
+    if(errc == 0) break;
+   }
+  }
+ }
+ if(errc != 0) return TRY_LATER; //no free entries left
+ slab->entry_used[n].store(1,std::memory_order_relaxed);
+ *slab_entry=(void*)(&(((char*)(slab->slab_base))[n*(slab->entry_size)]));
  return 0;
 }
 
 int slab_entry_release(slab_t * slab, void * slab_entry)
-/** Releases a slab entry. **/
+/** Releases a slab entry (thread-safe). Returns 1 if the entry is not in use (double release). **/
 {
+ slab_mag_t * mags, * mag;
  size_t addr,base;
+ unsigned int n;
+ unsigned char used;
 
  if(slab == NULL) return -1;
- if(slab->max_entries == 0 || slab->slab_base == NULL || slab->free_entries == NULL) return -2;
+ if(slab->max_entries == 0 || slab->slab_base == NULL || slab->free_links == NULL) return -2;
  base=(size_t)(slab->slab_base); addr=(size_t)(slab_entry);
  if(addr < base || addr >= base + (slab->max_entries)*(slab->entry_size) || (addr-base)%(slab->alignment) != 0) return -3;
- if(slab->first_free > 0 && slab->first_free <= slab->max_entries){
-  slab->free_entries[--(slab->first_free)]=slab_entry;
- }else{
-  return 1; //no slab entries were in use or corrupted
+ if((addr-base)%(slab->entry_size) != 0) return 1; //corrupted slab entry address
+ n=(unsigned int)((addr-base)/(slab->entry_size));
+ used=1; if(!slab->entry_used[n].compare_exchange_strong(used,0,std::memory_order_acq_rel)) return 1; //entry is not in use (double release)
+ mags=(slab_mag_t*)(slab->magazines);
+ if(mags != NULL){ //keep the entry in the magazine of the current thread, if possible
+  mag=&(mags[slab_thread_slot()%(slab->num_mags)]);
+  if(!mag->busy.test_and_set(std::memory_order_acquire)){
+   if(mag->count < slab->mag_size){
+    mag->entries[(mag->count)++]=n; mag->busy.clear(std::memory_order_release);
+    return 0;
+   }
+   mag->busy.clear(std::memory_order_release);
+  }
  }
+ slab_push_free(slab,n);
  return 0;
 }
 
@@ -1422,12 +1712,18 @@ int slab_destruct(slab_t * slab)
  }else{
   if(slab->max_entries > 0){slab->max_entries=0; errc=NOT_CLEAN;}
  }
- if(slab->free_entries != NULL){
+ if(slab->free_links != NULL){
   if(slab->max_entries == 0) errc=NOT_CLEAN;
-  free(slab->free_entries); slab->free_entries=NULL;
+  delete [] slab->free_links; slab->free_links=NULL;
  }else{
   if(slab->max_entries > 0){slab->max_entries=0; errc=NOT_CLEAN;}
  }
+ if(slab->entry_used != NULL){delete [] slab->entry_used; slab->entry_used=NULL;}
+ if(slab->magazines != NULL){
+  delete [] (slab_mag_t*)(slab->magazines); slab->magazines=NULL;
+ }
+ slab->num_mags=0; slab->mag_size=0;
+ slab->free_head.store(slab_tag_head(0ULL,SLAB_NULL_ENTRY),std::memory_order_relaxed);
  slab->max_entries=0;
  slab->entry_size=0;
  return errc; //either success (0) or NOT_CLEAN (warning)
@@ -1444,12 +1740,98 @@ int slab_destroy(slab_t * slab)
  return errc; //either success (0) or NOT_CLEAN (warning)
 }
 
+//Object pool API:
+int obj_pool_construct(obj_pool_t * pool, size_t obj_size, size_t max_pooled, unsigned int num_mags)
+/** Constructs an object pool for objects of size <obj_size> bytes: Up to <max_pooled> objects
+    are served from a slab with per-thread magazines (no heap traffic in steady state),
+    further objects are served from the heap. If the slab cannot be constructed,
+    the pool is still usable (heap only) and a non-zero status is returned. **/
+{
+ int errc;
+
+ if(pool == NULL || obj_size == 0) return -1;
+ pool->obj_size=obj_size;
+ pool->pool_gets.store(0ULL); pool->heap_gets.store(0ULL); pool->num_used.store(0LL);
+ errc=slab_clean(&(pool->slab));
+ if(max_pooled > 0){
+#ifndef NO_GPU
+  errc=slab_construct(&(pool->slab),obj_size,max_pooled,sizeof(void*),0);
+#else
+  errc=slab_construct(&(pool->slab),obj_size,max_pooled,sizeof(void*));
+#endif
+  if(errc == 0 && num_mags > 0){
+   errc=slab_set_magazines(&(pool->slab),num_mags);
+   if(errc != 0){errc=slab_destruct(&(pool->slab)); errc=slab_clean(&(pool->slab)); return 2;}
+  }
+  if(errc != 0){errc=slab_clean(&(pool->slab)); return 1;}
+ }
+ return 0;
+}
+
+int obj_pool_get(obj_pool_t * pool, void ** obj)
+/** Acquires an object from the pool (thread-safe). Returns TRY_LATER if out of memory. **/
+{
+ int errc;
+
+ if(pool == NULL || obj == NULL) return -1;
+ if(pool->obj_size == 0) return -2;
+ errc=TRY_LATER;
+ if(pool->slab.max_entries > 0) errc=slab_entry_get(&(pool->slab),obj);
+ if(errc == 0){
+  pool->pool_gets.fetch_add(1ULL,std::memory_order_relaxed);
+ }else{
+  *obj=malloc(pool->obj_size); if(*obj == NULL) return TRY_LATER;
+  pool->heap_gets.fetch_add(1ULL,std::memory_order_relaxed);
+ }
+ pool->num_used.fetch_add(1LL,std::memory_order_relaxed);
+ return 0;
+}
+
+int obj_pool_release(obj_pool_t * pool, void * obj)
+/** Returns an object acquired via obj_pool_get() back to the pool (thread-safe). **/
+{
+ size_t offset;
+ int errc;
+
+ if(pool == NULL || obj == NULL) return -1;
+ if(pool->slab.max_entries > 0 && slab_get_entry_offset(&(pool->slab),obj,&offset) == 0){
+  errc=slab_entry_release(&(pool->slab),obj); if(errc != 0) return 1;
+ }else{
+  free(obj);
+ }
+ pool->num_used.fetch_sub(1LL,std::memory_order_relaxed);
+ return 0;
+}
+
+int obj_pool_get_stats(obj_pool_t * pool, unsigned long long * pool_gets, unsigned long long * heap_gets, long long * num_used)
+/** Returns the object pool usage counters (any of the output arguments can be NULL). **/
+{
+ if(pool == NULL) return -1;
+ if(pool_gets != NULL) *pool_gets=pool->pool_gets.load(std::memory_order_relaxed);
+ if(heap_gets != NULL) *heap_gets=pool->heap_gets.load(std::memory_order_relaxed);
+ if(num_used != NULL) *num_used=pool->num_used.load(std::memory_order_relaxed);
+ return 0;
+}
+
+int obj_pool_destruct(obj_pool_t * pool)
+/** Destructs an object pool. All pooled objects must have been released. **/
+{
+ int errc;
+
+ if(pool == NULL) return -1;
+ errc=0;
+ if(pool->num_used.load() != 0) errc=NOT_CLEAN;
+ if(pool->slab.max_entries > 0){if(slab_destruct(&(pool->slab)) != 0) errc=NOT_CLEAN;}
+ pool->obj_size=0;
+ return errc;
+}
+
 //Other memory allocation API:
 int host_mem_alloc(void **host_ptr, size_t tsize, size_t align)
 {
  if(tsize > 0){
   if(align > 1){ //non-trivial alignment
-   *host_ptr=(void*)malloc(tsize); //`Replace this with memalign()
+   if(posix_memalign(host_ptr,align,tsize) != 0) *host_ptr=NULL; //<align> must be a power of two multiple of sizeof(void*)
   }else{ //no aligment
    *host_ptr=(void*)malloc(tsize);
   }
@@ -1461,7 +1843,7 @@ int host_mem_alloc(void **host_ptr, size_t tsize, size_t align)
 int host_mem_free(void *host_ptr)
 {
  if(host_ptr != NULL){
-  free(host_ptr); //`Do I need to use another free() for aligned memory?
+  free(host_ptr); //also valid for memory obtained from posix_memalign()
  }else{
   return 1;
  }
@@ -1514,6 +1896,59 @@ int host_mem_unregister(void *host_ptr){
 #endif
 }
 
+int host_mem_map_file(void **host_ptr, size_t tsize, const char *file_name, int map_mode, int map_advice)
+/** Maps <tsize> bytes of a file into the Host memory (see MEM_MAP_XXX in tensor_algebra.h).
+In the MEM_MAP_CREATE mode, the file is created if needed and resized to exactly <tsize> bytes.
+In other modes, the file must already exist and be at least <tsize> bytes long. The memory
+access advice is only a hint, thus its failure is ignored. A negative return status indicates
+invalid arguments, a positive one indicates a system failure. **/
+{
+ int fd,prot,flags,adv;
+ struct stat fst;
+ void *ptr;
+
+ if(host_ptr == NULL) return -1;
+ *host_ptr=NULL;
+ if(file_name == NULL || tsize == 0) return -2;
+ switch(map_mode){
+  case MEM_MAP_OPEN: fd=open(file_name,O_RDWR); prot=PROT_READ|PROT_WRITE; flags=MAP_SHARED; break;
+  case MEM_MAP_CREATE: fd=open(file_name,O_RDWR|O_CREAT,0644); prot=PROT_READ|PROT_WRITE; flags=MAP_SHARED; break;
+  case MEM_MAP_PRIVATE: fd=open(file_name,O_RDONLY); prot=PROT_READ|PROT_WRITE; flags=MAP_PRIVATE; break;
+  default: return -3;
+ }
+ switch(map_advice){
+  case MEM_MAP_ADVICE_NORMAL: adv=MADV_NORMAL; break;
+  case MEM_MAP_ADVICE_SEQUENTIAL: adv=MADV_SEQUENTIAL; break;
+  case MEM_MAP_ADVICE_RANDOM: adv=MADV_RANDOM; break;
+  case MEM_MAP_ADVICE_WILLNEED: adv=MADV_WILLNEED; break;
+  default: if(fd >= 0) close(fd); return -4;
+ }
+ if(fd < 0) return 1;
+ if(fstat(fd,&fst) != 0){close(fd); return 2;}
+ if(map_mode == MEM_MAP_CREATE){
+  if((size_t)(fst.st_size) != tsize){
+   if(ftruncate(fd,(off_t)tsize) != 0){close(fd); return 3;}
+  }
+ }else{
+  if((size_t)(fst.st_size) < tsize){close(fd); return 4;} //file is too short
+ }
+ ptr=mmap(NULL,tsize,prot,flags,fd,0);
+ close(fd); //the mapping keeps its own reference to the file
+ if(ptr == MAP_FAILED) return 5;
+ if(adv != MADV_NORMAL) madvise(ptr,tsize,adv);
+ *host_ptr=ptr;
+ return 0;
+}
+
+int host_mem_unmap_file(void *host_ptr, size_t tsize)
+/** Unmaps a file mapped by host_mem_map_file(). Modifications made in the shared
+mapping modes are written back to the file by the operating system. **/
+{
+ if(host_ptr == NULL || tsize == 0) return -1;
+ if(munmap(host_ptr,tsize) != 0) return 1;
+ return 0;
+}
+
 int mem_allocate(int dev_id, size_t bytes, int in_buffer, void ** mem_ptr)
 /** Allocates a memory segment on any device, either from the TAL-SH buffer
 or via a system call. If the memory allocation is unsuccessful, returns
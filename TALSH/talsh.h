@@ -21,6 +21,45 @@ LICENSE: BSD 3-Clause **/
 #define TALSH_CPTAL_MIN_BUF_SIZE 1073741824 //minimun Host argument buffer size that can be used effectively by CP-TAL
 #define TALSH_NO_HOST_BUFFER 16777216 //nominal Host argument buffer size when it is not needed by the application
 #define TALSH_GFLOP_THRESH_GPU 4 //minimal GFlop count to consider executing on a GPU
+#define TALSH_SMALL_TENSOR_VOLUME 4096 //default max tensor volume for the native small-tensor Host path (0:disabled)
+
+//TAL-SH COMPLEX GEMM FORMULATIONS (native Host slice kernels on split-complex panels):
+#define TALSH_CGEMM_4M 0 //four real products (default)
+#define TALSH_CGEMM_3M 1 //three real products (25% fewer multiplications, slightly lower accuracy)
+
+//TAL-SH COMPLEX STORAGE LAYOUTS (Host image of a C4/C8 tensor, see talshTensorSetComplexLayout):
+#define TALSH_CPLX_INTERLEAVED 0 //interleaved real/imaginary parts (default)
+#define TALSH_CPLX_SPLIT 1       //split-complex: all real parts followed by all imaginary parts
+
+//TAL-SH HOST TENSOR CONTRACTION STRATEGIES (autotuning, see talshSetAutotune):
+#define TALSH_HOST_CTR_SCATTER_BLAS 0   //CP-TAL: scatter tensor transpose + BLAS GEMM
+#define TALSH_HOST_CTR_SHMEM_BLAS 1     //CP-TAL: cache-efficient tensor transpose + BLAS GEMM
+#define TALSH_HOST_CTR_SCATTER_NATIVE 2 //CP-TAL: scatter tensor transpose + native matmult
+#define TALSH_HOST_CTR_SHMEM_NATIVE 3   //CP-TAL: cache-efficient tensor transpose + native matmult
+#define TALSH_HOST_CTR_SLICE 4          //native slice kernel (no tensor transposes)
+#define TALSH_HOST_CTR_STRATEGIES 5     //number of Host tensor contraction strategies
+#define TALSH_AUTOTUNE_DB_ENV "TALSH_AUTOTUNE_DB" //environment variable naming the autotuning database loaded by talshInit
+
+//TAL-SH HOST BLAS BACKENDS (runtime BLAS dispatch, see tensor_algebra.h):
+#define TALSH_BLAS_NONE BLAS_BACKEND_NONE         //no BLAS: in-house matrix multiplication kernels only
+#define TALSH_BLAS_GENERIC BLAS_BACKEND_GENERIC   //BLAS without thread control (e.g., reference BLAS)
+#define TALSH_BLAS_OPENBLAS BLAS_BACKEND_OPENBLAS //OpenBLAS
+#define TALSH_BLAS_MKL BLAS_BACKEND_MKL           //Intel MKL
+#define TALSH_BLAS_BLIS BLAS_BACKEND_BLIS         //BLIS
+#define TALSH_BLAS_LIB_ENV "TALSH_BLAS_LIB" //environment variable naming a BLAS library loaded by talshInit
+
+//TAL-SH RANDOM INITIALIZATION DISTRIBUTIONS (counter-based generator, see tensor_algebra.h):
+#define TALSH_RANDOM_UNIFORM RANDOM_UNIFORM //uniform on [0,1) (each real component)
+#define TALSH_RANDOM_NORMAL RANDOM_NORMAL   //standard normal (each real component)
+
+//TAL-SH TENSOR FILE I/O FLAGS (bitwise OR):
+#define TALSH_IO_DEFAULT 0  //buffered I/O, no compression
+#define TALSH_IO_COMPRESS 1 //lossless compression of the tensor body chunks
+#define TALSH_IO_DIRECT 2   //direct I/O bypassing the page cache (falls back to buffered I/O if unsupported)
+
+//TAL-SH TENSOR BODY COMPRESSION MODES:
+#define TALSH_ZIP_LOSSLESS 0 //lossless compression (byte shuffle + LZ)
+#define TALSH_ZIP_LOSSY 1    //error-bounded lossy compression (absolute error bound per real component)
 
 //TAL-SH ERROR CODES (keep consistent with "talshf.F90"):
 #define TALSH_SUCCESS 0
@@ -106,6 +145,15 @@ typedef struct{
  int source_image;      //specific body image of that tensor block participating in the operation
 } talshTensArg_t;
 
+// Digital (pre-parsed) tensor operation pattern (see talshContrPatternParse):
+typedef struct{
+ int drank;                       //destination tensor rank
+ int lrank;                       //left tensor rank
+ int rrank;                       //right tensor rank (0 for unary tensor operations)
+ int conj_bits;                   //argument complex conjugation bits: {0:D,1:L,2:R}
+ int dig_ptrn[MAX_TENSOR_RANK*2]; //digital pattern [0:lrank+rrank-1]: X>0: paired with dimension X of D; X<0: contracted with dimension -X of the other argument
+} talsh_contr_ptrn_t;
+
 // TAL-SH task (interoperable):
 typedef struct{
  void * task_p;    //pointer to the corresponding device-kind-specific task object
@@ -118,6 +166,7 @@ typedef struct{
  double data_vol;  //total data volume (information)
  double flops;     //number of floating point operations (information)
  double exec_time; //execution time in seconds (information)
+ int nonfinite;    //NaN/Inf screening flags (bits {0:D,1:L,2:R} set for arguments found to hold NaN/Inf)
 } talsh_task_t;
 
 // Basic tensor operation:
@@ -132,6 +181,7 @@ typedef struct{
  talsh_tens_t tens_arg[MAX_TENSOR_OPERANDS];         //actual tensor operands (actual TAL-SH tensors)
  talsh_task_t task_handle;                           //task handle
  int exec_dev_id;                                    //execution device id (flat device id)
+ int zero_copy;                                      //YEP: executed directly on the tensor slice views (no argument copies)
  int stage;                                          //tensor operation stage
  double time_started;
  double time_scheduled;
@@ -208,6 +258,33 @@ extern "C"{
  size_t talshDeviceBufferFreeSize(int dev_num,
                                   int dev_kind = DEV_NULL);
  size_t talshDeviceBufferFreeSize_(int dev_num, int dev_kind);
+//  Defragment the Host argument buffer to accommodate a tensor body of a given size (bytes):
+ int talshHostBufferDefrag(size_t bytes);
+ int talshHostBufferDefrag_(size_t bytes);
+//  Enable/disable automatic defragmentation of the Host argument buffer on tensor construction:
+ void talshSetHostBufferAutoDefrag(int auto_defrag);
+//  Set the max tensor volume for the native small-tensor Host path (0 disables it), returns the previous value:
+ size_t talshSetSmallTensorVolume(size_t max_volume);
+//  Select the complex GEMM formulation for the native Host slice kernels (TALSH_CGEMM_XX), returns the previous one:
+ int talshSetComplexGemmMode(int mode);
+//  Enable/disable NaN/Inf screening of Host tensor operations (results in talshTaskNonFinite), returns the previous setting:
+ int talshSetNonFiniteCheck(int enable);
+//  Enable/disable autotuning of Host tensor contractions, optionally loading a tuning database, returns the previous setting:
+ int talshSetAutotune(int enable,
+                      const char * db_file = NULL);
+//  Save the autotuning database (NULL: the database file set by talshSetAutotune or TALSH_AUTOTUNE_DB):
+ int talshAutotuneSave(const char * db_file = NULL);
+//  Query the number of tuned Host contraction plans and the number of plans whose candidates are still being timed:
+ int talshAutotuneStats(int * num_tuned,
+                        int * num_pending);
+//  Load a BLAS library (OpenBLAS, MKL, BLIS, reference BLAS) for Host tensor contractions, returns the backend (TALSH_BLAS_XXX):
+ int talshBlasLoad(const char * lib_path);
+//  Query the active Host BLAS backend (TALSH_BLAS_XXX):
+ int talshBlasBackend();
+//  Set the number of Host BLAS threads (0: size of the executing Host team) and whether BLAS calls
+//  inside parallel regions (parallel batch execution) are enforced to be single-threaded:
+ void talshSetBlasThreads(int num_threads,
+                          int serial_in_parallel = YEP);
 //  Get the device argument buffer base pointer:
  void * talshDeviceBufferBasePtr(int dev_num,
                                  int dev_kind = DEV_NULL);
@@ -227,6 +304,10 @@ extern "C"{
  int talshStats(int dev_id = -1,
                 int dev_kind = DEV_NULL);
  int talshStats_(int dev_id, int dev_kind);
+//  Query the allocation counters of the internal object pools (tasks, tensor blocks, tensor shapes, tensor operations):
+ int talshObjectPoolStats(unsigned long long * pool_allocs,  //out: number of objects served from the pools
+                          unsigned long long * heap_allocs,  //out: number of objects served from the heap (pools exhausted)
+                          long long * num_used);             //out: number of objects currently in use
 // TAL-SH tensor block API:
 //  Create an empty tensor block:
  int talshTensorCreate(talsh_tens_t ** tens_block);
@@ -247,10 +328,48 @@ extern "C"{
                           double init_val_imag = 0.0);
  int talshTensorConstruct_(talsh_tens_t * tens_block, int data_kind, int tens_rank, const int tens_dims[], int dev_id,
                            void * ext_mem, int in_hab, talsh_tens_init_i init_method, double init_val_real, double init_val_imag);
-//  Import external data for the tensor body:
+//  Construct a tensor block on Host with its body residing in a memory-mapped file:
+ int talshTensorConstructMapped(talsh_tens_t * tens_block,
+                                int data_kind,
+                                int tens_rank,
+                                const int tens_dims[],
+                                const char * file_name,
+                                int map_mode = MEM_MAP_OPEN,
+                                int map_advice = MEM_MAP_ADVICE_NORMAL);
+//  Save a tensor block into a TAL-SH tensor file:
+ int talshTensorSave(talsh_tens_t * tens_block,
+                     const char * file_name,
+                     const size_t * signature = NULL,
+                     int io_flags = TALSH_IO_DEFAULT,
+                     size_t chunk_size = 0);
+//  Load a tensor block from a TAL-SH tensor file (constructs the tensor block on Host):
+ int talshTensorLoad(talsh_tens_t * tens_block,
+                     const char * file_name,
+                     size_t * signature = NULL,
+                     int io_flags = TALSH_IO_DEFAULT);
+//  Import external data for the tensor body (parallel, with on-the-fly data kind conversion,
+//  asynchronous if a TAL-SH task is provided; the external data must persist until completion):
  int talshTensorImportData(talsh_tens_t * tens_block,
                            int data_kind,
-                           const void * ext_data);
+                           const void * ext_data,
+                           talsh_task_t * talsh_task = NULL);
+//  Export the tensor body into external data (parallel, with on-the-fly data kind conversion,
+//  asynchronous if a TAL-SH task is provided):
+ int talshTensorExportData(talsh_tens_t * tens_block,
+                           int data_kind,
+                           void * ext_data,
+                           talsh_task_t * talsh_task = NULL);
+//  Initialize/transform the Host tensor body tile by tile in parallel via a user-defined function
+//  (tile_volume = 0 selects the default tile volume):
+ int talshTensorApplyTiles(talsh_tens_t * tens_block,
+                           talsh_tens_tile_init_i tile_func,
+                           void * context = NULL,
+                           size_t tile_volume = 0);
+//  Initialize the Host tensor body with pseudo-random numbers (TALSH_RANDOM_XXX), bitwise
+//  reproducible for a given seed regardless of the number of threads:
+ int talshTensorInitRandom(talsh_tens_t * tens_block,
+                           unsigned long long seed,
+                           int distribution = TALSH_RANDOM_UNIFORM);
 //  Destruct a tensor block:
  int talshTensorDestruct(talsh_tens_t * tens_block);
 //  Destroy a tensor block:
@@ -299,6 +418,21 @@ extern "C"{
                                    int data_kind,
                                    int dev_id,
                                    int dev_kind = DEV_NULL);
+//  Convert the Host image of a complex tensor (C4/C8) into the split-complex (real/imaginary) layout:
+ int talshTensorComplexSplit(const talsh_tens_t * tens_block,
+                             void * real_part,
+                             void * imag_part,
+                             int data_kind);
+//  Overwrite the Host image of a complex tensor (C4/C8) from the split-complex (real/imaginary) layout:
+ int talshTensorComplexMerge(talsh_tens_t * tens_block,
+                             const void * real_part,
+                             const void * imag_part,
+                             int data_kind);
+//  Set the storage layout of the Host image of a complex tensor (C4/C8), converting it in place:
+ int talshTensorSetComplexLayout(talsh_tens_t * tens_block,
+                                 int layout);
+//  Get the storage layout of the Host image of a complex tensor (TALSH_CPLX_XXX):
+ int talshTensorComplexLayout(const talsh_tens_t * tens_block);
 //  Get the scalar value of the rank-0 tensor:
  int talshTensorGetScalar(talsh_tens_t * tens_block,
                           double * scalar_real,
@@ -327,6 +461,28 @@ extern "C"{
  int talshTensorSliceDestruct(talsh_tens_slice_t * slice);
 //  Destroy a TAL-SH tensor slice:
  int talshTensorSliceDestroy(talsh_tens_slice_t * slice);
+//  Tensor contraction directly on tensor slices residing on Host (zero-copy, blocking):
+//  dslice += lslice * rslice * scale. All parent tensors must have an available Host image
+//  of the same data kind, otherwise TALSH_NOT_AVAILABLE is returned. The destination slice
+//  must not overlap with the input slices.
+ int talshTensorSliceContract(const char * cptrn,
+                              talsh_tens_slice_t * dslice,
+                              const talsh_tens_slice_t * lslice,
+                              const talsh_tens_slice_t * rslice,
+                              double scale_real = 1.0,
+                              double scale_imag = 0.0);
+//  Tensor addition directly on tensor slices residing on Host (zero-copy, blocking):
+//  dslice += lslice * scale
+ int talshTensorSliceAdd(const char * cptrn,
+                         talsh_tens_slice_t * dslice,
+                         const talsh_tens_slice_t * lslice,
+                         double scale_real = 1.0,
+                         double scale_imag = 0.0);
+//  Tensor copy (permutation) directly on tensor slices residing on Host (zero-copy, blocking):
+//  dslice = lslice
+ int talshTensorSliceCopy(const char * cptrn,
+                          talsh_tens_slice_t * dslice,
+                          const talsh_tens_slice_t * lslice);
 // TAL-SH task API:
 //  Create a clean (defined-empty) TAL-SH task:
  int talshTaskCreate(talsh_task_t ** talsh_task);
@@ -368,6 +524,9 @@ extern "C"{
                    double * output = NULL,
                    double * mmul = NULL);
  int talshTaskTime_(talsh_task_t * talsh_task, double * total, double * comput, double * input, double * output, double * mmul);
+//  Get the NaN/Inf screening flags of a completed TAL-SH task (bits {0:D,1:L,2:R}, see talshSetNonFiniteCheck):
+ int talshTaskNonFinite(talsh_task_t * talsh_task,
+                        int * flags);
 //  Print TAL-SH task info:
  void talshTaskPrint(const talsh_task_t * talsh_task);
 // TAL-SH tensor operations API:
@@ -451,6 +610,15 @@ extern "C"{
                              int dev_id,               //in: device id (flat or kind-specific)
                              int dev_kind = DEV_NULL); //in: device kind (if present, <dev_id> is kind-specific)
  int talshTensorDiscardOther_(talsh_tens_t * tens, int dev_id, int dev_kind);
+//  Compress the tensor body (all body images are released, the body is decompressed on first use):
+ int talshTensorCompress(talsh_tens_t * tens_block,
+                         int zip_mode = TALSH_ZIP_LOSSLESS,
+                         double tolerance = 0.0);
+//  Decompress the tensor body into a Host image:
+ int talshTensorDecompress(talsh_tens_t * tens_block);
+//  Check whether the tensor body is compressed:
+ int talshTensorIsCompressed(const talsh_tens_t * tens_block,
+                             size_t * zip_size = NULL);
 //  Tensor initialization to a scalar value:
  int talshTensorInit(talsh_tens_t * dtens,              //inout: tensor block
                      double val_real,                   //in: initialization value (real part)
@@ -491,6 +659,9 @@ extern "C"{
                        talsh_task_t * talsh_task = NULL);     //inout: TAL-SH task handle
  int talshTensorInsert_(talsh_tens_t * dtens, talsh_tens_t * ltens, const int * offsets,
                         int dev_id, int dev_kind, int copy_ctrl, int accumulative, talsh_task_t * talsh_task);
+//  Symbolic tensor operation pattern conversion into the digital form (parse once, use many times):
+ int talshContrPatternParse(const char * cptrn,               //in: C-string: symbolic pattern, e.g. "D(a,b)+=L(a,c)*R(c,b)"
+                            talsh_contr_ptrn_t * dig_ptrn);   //out: digital pattern
 //  Tensor copy (with an optional permutation of indices):
  int talshTensorCopy(const char * cptrn,                    //in: C-string: symbolic copy pattern, e.g. "D(a,b,c,d)=L(c,d,b,a)"
                      talsh_tens_t * dtens,                  //inout: destination tensor block
@@ -501,6 +672,14 @@ extern "C"{
                      talsh_task_t * talsh_task = NULL);     //inout: TAL-SH task handle
  int talshTensorCopy_(const char * cptrn, talsh_tens_t * dtens, talsh_tens_t * ltens,
                       int dev_id, int dev_kind, int copy_ctrl, talsh_task_t * talsh_task);
+//  Tensor copy with a pre-parsed (digital) pattern:
+ int talshTensorCopyDig(const talsh_contr_ptrn_t * dig_ptrn, //in: digital copy pattern
+                        talsh_tens_t * dtens,                //inout: destination tensor block
+                        talsh_tens_t * ltens,                //inout: source tensor block
+                        int dev_id = DEV_DEFAULT,            //in: device id (flat or kind-specific)
+                        int dev_kind = DEV_DEFAULT,          //in: device kind (if present, <dev_id> is kind-specific)
+                        int copy_ctrl = COPY_MT,             //in: copy control (COPY_XX), defaults to COPY_MT
+                        talsh_task_t * talsh_task = NULL);   //inout: TAL-SH task handle
 //  Tensor addition:
  int talshTensorAdd(const char * cptrn,                    //in: C-string: symbolic addition pattern, e.g. "D(a,b,c,d)+=L(c,d,b,a)"
                     talsh_tens_t * dtens,                  //inout: destination tensor block
@@ -513,6 +692,16 @@ extern "C"{
                     talsh_task_t * talsh_task = NULL);     //inout: TAL-SH task handle
  int talshTensorAdd_(const char * cptrn, talsh_tens_t * dtens, talsh_tens_t * ltens, double scale_real, double scale_imag,
                      int dev_id, int dev_kind, int copy_ctrl, talsh_task_t * talsh_task);
+//  Tensor addition with a pre-parsed (digital) pattern:
+ int talshTensorAddDig(const talsh_contr_ptrn_t * dig_ptrn, //in: digital addition pattern
+                       talsh_tens_t * dtens,                //inout: destination tensor block
+                       talsh_tens_t * ltens,                //inout: source tensor block
+                       double scale_real = 1.0,             //in: scaling value (real part), defaults to 1
+                       double scale_imag = 0.0,             //in: scaling value (imaginary part), defaults to 0
+                       int dev_id = DEV_DEFAULT,            //in: device id (flat or kind-specific)
+                       int dev_kind = DEV_DEFAULT,          //in: device kind (if present, <dev_id> is kind-specific)
+                       int copy_ctrl = COPY_MT,             //in: copy control (COPY_XX), defaults to COPY_MT
+                       talsh_task_t * talsh_task = NULL);   //inout: TAL-SH task handle
 //  Tensor contraction:
  int talshTensorContract(const char * cptrn,                //in: C-string: symbolic contraction pattern, e.g. "D(a,b,c,d)+=L(c,i,j,a)*R(b,j,d,i)"
                          talsh_tens_t * dtens,              //inout: destination tensor block
@@ -528,6 +717,18 @@ extern "C"{
  int talshTensorContract_(const char * cptrn, talsh_tens_t * dtens, talsh_tens_t * ltens, talsh_tens_t * rtens,
                           double scale_real, double scale_imag, int dev_id, int dev_kind,
                           int copy_ctrl, int accumulative, talsh_task_t * talsh_task);
+//  Tensor contraction with a pre-parsed (digital) pattern:
+ int talshTensorContractDig(const talsh_contr_ptrn_t * dig_ptrn, //in: digital contraction pattern
+                            talsh_tens_t * dtens,                //inout: destination tensor block
+                            talsh_tens_t * ltens,                //inout: left source tensor block
+                            talsh_tens_t * rtens,                //inout: right source tensor block
+                            double scale_real = 1.0,             //in: scaling value (real part), defaults to 1
+                            double scale_imag = 0.0,             //in: scaling value (imaginary part), defaults to 0
+                            int dev_id = DEV_DEFAULT,            //in: device id (flat or kind-specific)
+                            int dev_kind = DEV_DEFAULT,          //in: device kind (if present, <dev_id> is kind-specific)
+                            int copy_ctrl = COPY_MTT,            //in: copy control (COPY_XXX), defaults to COPY_MTT
+                            int accumulative = YEP,              //in: accumulate in (default) VS overwrite destination tensor: [YEP|NOPE]
+                            talsh_task_t * talsh_task = NULL);   //inout: TAL-SH task (must be clean)
 //  Tensor contraction (extra large):
  int talshTensorContractXL(const char * cptrn,          //in: C-string: symbolic contraction pattern, e.g. "D(a,b,c,d)+=L(c,i,j,a)*R(b,j,d,i)"
                            talsh_tens_t * dtens,        //inout: destination tensor block
@@ -554,6 +755,25 @@ extern "C"{
                              const char absorb = 'N',     //in: whether or not to absorb the middle factor stens into other factors
                              int dev_id = DEV_DEFAULT,    //in: device id (flat or kind-specific)
                              int dev_kind = DEV_DEFAULT); //in: device kind (if present, <dev_id> is kind-specific)
+//  Truncated tensor decomposition via SVD (Host only):
+//   Only the leading singular triplets are retained, at most <max_rank> of them (0: no limit)
+//   and none with a singular value below <rel_threshold> times the largest one. The factors keep
+//   their shapes, being zero-padded beyond the achieved rank. Large matricizations are decomposed
+//   via the randomized range finder with power iterations, the sketch growing until it captures
+//   all singular values above the threshold when no rank limit is given.
+//   The discarded weight is the squared 2-norm of the discarded part relative to that of dtens.
+ int talshTensorDecomposeSVDTrunc(const char * cptrn,        //in: C-string: symbolic decomposition pattern, e.g. "D(a,b,c,d)=L(c,i,j,a)*R(b,j,d,i)"
+                                  talsh_tens_t * dtens,      //in: tensor block to be decomposed
+                                  talsh_tens_t * ltens,      //inout: left tensor factor
+                                  talsh_tens_t * rtens,      //inout: right tensor factor
+                                  talsh_tens_t * stens,      //inout: middle tensor factor (singular values), may be empty on entrance
+                                  const char absorb,         //in: whether or not to absorb the middle factor stens into other factors
+                                  int max_rank,              //in: max number of retained singular triplets (0: no limit)
+                                  double rel_threshold,      //in: relative singular value cutoff (0: none)
+                                  int * achieved_rank,       //out: number of retained singular triplets (may be NULL)
+                                  double * discarded_weight, //out: relative discarded weight (may be NULL)
+                                  int dev_id = DEV_DEFAULT,  //in: device id (flat or kind-specific)
+                                  int dev_kind = DEV_DEFAULT); //in: device kind (if present, <dev_id> is kind-specific)
 //  Tensor decomposition via SVD with singular values absorbed into the left factor:
  int talshTensorDecomposeSVDL(const char * cptrn,          //in: C-string: symbolic decomposition pattern, e.g. "D(a,b,c,d)=L(c,i,j,a)*R(b,j,d,i)"
                               talsh_tens_t * dtens,        //in: tensor block to be decomposed
@@ -582,7 +802,16 @@ extern "C"{
                                  talsh_tens_t * dtens,        //inout: on entrance tensor block to be orthogonalized, on exit orthogonalized tensor block
                                  int dev_id = DEV_DEFAULT,    //in: device id (flat or kind-specific)
                                  int dev_kind = DEV_DEFAULT); //in: device kind (if present, <dev_id> is kind-specific)
-//  Tensor orthogonalization via MGS (D=Q from QR):
+//  Tensor decomposition via thin QR (Host only, CholeskyQR2 with the MGS fallback for rank-deficient tensors):
+//   The open indices of qtens form the rows of the tall-skinny matricization of dtens,
+//   the volume of the contracted indices must coincide with the volume of the open indices of rtens:
+ int talshTensorDecomposeQR(const char * cptrn,          //in: C-string: symbolic decomposition pattern, e.g. "D(a,b,c,d)=Q(c,i,a)*R(i,d,b)"
+                            talsh_tens_t * dtens,        //in: tensor block to be decomposed
+                            talsh_tens_t * qtens,        //inout: isometric tensor factor Q
+                            talsh_tens_t * rtens,        //inout: upper-triangular tensor factor R
+                            int dev_id = DEV_DEFAULT,    //in: device id (flat or kind-specific)
+                            int dev_kind = DEV_DEFAULT); //in: device kind (if present, <dev_id> is kind-specific)
+//  Tensor orthogonalization via QR (D=Q from QR, Host only):
  int talshTensorOrthogonalizeMGS(talsh_tens_t * dtens,        //inout: on entrance tensor block to be orthogonalized, on exit orthogonalized tensor block
                                  int num_iso_dims,            //in: number of the isometric tensor dimensions
                                  int * iso_dims,              //in: ordered list of the isometric tensor dimensions (tensor dimension numeration starts from 0)
@@ -0,0 +1,347 @@
+/** ExaTensor::TAL-SH: Runtime BLAS dispatch on Host.
+REVISION: 2026/10/19
+
+Copyright (C) 2014-2022 Dmitry I. Lyakh (Liakh)
+Copyright (C) 2014-2022 Oak Ridge National Laboratory (UT-Battelle)
+
+LICENSE: BSD 3-Clause
+-------------------------------------------------------------------
+
+FOR DEVELOPER(s):
+ # All BLAS calls issued by CP-TAL go through this layer. The active
+   BLAS backend is either the BLAS linked at build time (unless NO_BLAS)
+   or a BLAS library loaded at run time via dlopen() (cpu_blas_load),
+   which also makes BLAS available to NO_BLAS builds.
+ # The BLAS vendor is recognized by its thread control API, which is then
+   used to set the number of BLAS threads explicitly for each call:
+    - Intel MKL: mkl_set_num_threads_local() (per call, restored after the call);
+    - OpenBLAS: openblas_set_num_threads() (process-global, only changed outside
+      parallel regions, never raised above the share of a concurrent call);
+    - BLIS: bli_thread_set_num_threads() (same as OpenBLAS);
+    - Other (reference) BLAS: no thread control.
+ # The number of threads of a BLAS call is tied to the executing Host team:
+   Outside OpenMP parallel regions the thread budget is either the configured
+   number of BLAS threads or the size of the team the calling thread would fork,
+   which is split among all BLAS calls in flight (application threads may call
+   BLAS concurrently): Each call gets an even share of the budget, limited to
+   the threads not used by other calls, but at least one thread;
+   inside a parallel region (parallel batch execution) it is one thread
+   if single-threaded BLAS is enforced there (default), otherwise the size
+   of the nested team. This avoids oversubscription of the cores when BLAS
+   is called concurrently from multiple OpenMP or application threads.
+ # Batched GEMM (hyper-contractions) is executed either by a single strided
+   batched GEMM call (MKL), or in parallel over the batch with single-threaded
+   BLAS calls (when the batch is large enough and single-threaded BLAS inside
+   parallel regions is enforced), or as a loop of multi-threaded GEMM calls.
+**/
+
+#include "tensor_algebra.h"
+
+#include <cstdio>
+#include <cstdint>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+#include <dlfcn.h>
+
+#ifndef NO_OMP
+#include <omp.h>
+#endif
+
+//Fortran BLAS interfaces (all data kinds):
+typedef void (*blas_gemm_t)(const char * transa, const char * transb, const int * m, const int * n, const int * k,
+                            const void * alpha, const void * a, const int * lda, const void * b, const int * ldb,
+                            const void * beta, void * c, const int * ldc);
+typedef void (*blas_gemm_batch_strided_t)(const char * transa, const char * transb, const int * m, const int * n, const int * k,
+                                          const void * alpha, const void * a, const int * lda, const int * stridea,
+                                          const void * b, const int * ldb, const int * strideb,
+                                          const void * beta, void * c, const int * ldc, const int * stridec,
+                                          const int * batch_size);
+//Vendor thread control interfaces:
+typedef int (*mkl_set_num_threads_local_t)(int nthreads);
+typedef void (*openblas_set_num_threads_t)(int nthreads);
+typedef int (*openblas_get_num_threads_t)(void);
+typedef void (*bli_thread_set_num_threads_t)(int64_t nthreads);
+typedef int64_t (*bli_thread_get_num_threads_t)(void);
+
+//BLAS backend:
+typedef struct{
+ int kind;                                   //BLAS backend kind (BLAS_BACKEND_XXX)
+ void * lib;                                 //dynamic library handle (NULL: linked at build time)
+ blas_gemm_t gemm[4];                        //GEMM for R4, R8, C4, C8
+ blas_gemm_batch_strided_t gemm_batch[4];    //strided batched GEMM for R4, R8, C4, C8 (optional)
+ mkl_set_num_threads_local_t mkl_set_local;  //MKL thread control
+ openblas_set_num_threads_t openblas_set;    //OpenBLAS thread control
+ openblas_get_num_threads_t openblas_get;
+ bli_thread_set_num_threads_t blis_set;      //BLIS thread control
+ bli_thread_get_num_threads_t blis_get;
+} cpu_blas_backend_t;
+
+#ifndef NO_BLAS
+extern "C"{
+void sgemm_(const char*, const char*, const int*, const int*, const int*, const void*, const void*, const int*,
+            const void*, const int*, const void*, void*, const int*);
+void dgemm_(const char*, const char*, const int*, const int*, const int*, const void*, const void*, const int*,
+            const void*, const int*, const void*, void*, const int*);
+void cgemm_(const char*, const char*, const int*, const int*, const int*, const void*, const void*, const int*,
+            const void*, const int*, const void*, void*, const int*);
+void zgemm_(const char*, const char*, const int*, const int*, const int*, const void*, const void*, const int*,
+            const void*, const int*, const void*, void*, const int*);
+}
+#endif
+
+static int VERBOSE=1;                   //verbosity for error messages
+static cpu_blas_backend_t blas_backend; //active BLAS backend
+static bool blas_backend_set=false;     //whether the active BLAS backend has been set up
+static int blas_num_threads=0;          //number of BLAS threads outside parallel regions (0: size of the executing Host team)
+static int blas_serial_in_parallel=YEP; //enforce single-threaded BLAS inside parallel regions (parallel batch execution)
+static std::atomic<int> blas_calls_in_flight(0); //number of BLAS calls in flight issued outside parallel regions
+static std::atomic<int> blas_threads_in_use(0);  //number of BLAS threads used by those calls
+static std::mutex blas_threads_lock;             //serializes changes of the process-global number of BLAS threads
+
+static int cpu_blas_kind_index(int datk)
+/** Maps a data kind to the index of its BLAS routine. **/
+{
+ switch(datk){
+  case R4: return 0;
+  case R8: return 1;
+  case C4: return 2;
+  case C8: return 3;
+ }
+ return -1;
+}
+
+static void * cpu_blas_symbol(void * lib, const char * name)
+/** Looks up a symbol in a dynamic library (NULL: in the running process). **/
+{
+ return dlsym(((lib != NULL)?lib:RTLD_DEFAULT),name);
+}
+
+static void cpu_blas_probe(cpu_blas_backend_t * backend)
+/** Recognizes the BLAS vendor by its thread control API and looks up the optional batched GEMM. **/
+{
+ const char * batch_names[4]={"sgemm_batch_strided_","dgemm_batch_strided_","cgemm_batch_strided_","zgemm_batch_strided_"};
+ backend->mkl_set_local=(mkl_set_num_threads_local_t)cpu_blas_symbol(backend->lib,"mkl_set_num_threads_local");
+ backend->openblas_set=(openblas_set_num_threads_t)cpu_blas_symbol(backend->lib,"openblas_set_num_threads");
+ backend->openblas_get=(openblas_get_num_threads_t)cpu_blas_symbol(backend->lib,"openblas_get_num_threads");
+ backend->blis_set=(bli_thread_set_num_threads_t)cpu_blas_symbol(backend->lib,"bli_thread_set_num_threads");
+ backend->blis_get=(bli_thread_get_num_threads_t)cpu_blas_symbol(backend->lib,"bli_thread_get_num_threads");
+ for(int i=0; i<4; ++i) backend->gemm_batch[i]=(blas_gemm_batch_strided_t)cpu_blas_symbol(backend->lib,batch_names[i]);
+ if(backend->mkl_set_local != NULL){
+  backend->kind=BLAS_BACKEND_MKL;
+ }else if(backend->openblas_set != NULL && backend->openblas_get != NULL){
+  backend->kind=BLAS_BACKEND_OPENBLAS;
+ }else if(backend->blis_set != NULL && backend->blis_get != NULL){
+  backend->kind=BLAS_BACKEND_BLIS;
+ }else{
+  backend->kind=BLAS_BACKEND_GENERIC;
+ }
+ return;
+}
+
+static const cpu_blas_backend_t * cpu_blas_active()
+/** Returns the active BLAS backend (the BLAS linked at build time is set up on first use). **/
+{
+#pragma omp critical(cpu_blas_backend)
+ if(!blas_backend_set){
+  blas_backend.kind=BLAS_BACKEND_NONE; blas_backend.lib=NULL;
+  for(int i=0; i<4; ++i){blas_backend.gemm[i]=NULL; blas_backend.gemm_batch[i]=NULL;}
+  blas_backend.mkl_set_local=NULL; blas_backend.openblas_set=NULL; blas_backend.openblas_get=NULL;
+  blas_backend.blis_set=NULL; blas_backend.blis_get=NULL;
+#ifndef NO_BLAS
+  blas_backend.gemm[0]=&sgemm_; blas_backend.gemm[1]=&dgemm_;
+  blas_backend.gemm[2]=&cgemm_; blas_backend.gemm[3]=&zgemm_;
+  cpu_blas_probe(&blas_backend);
+#endif
+  blas_backend_set=true;
+ }
+ return &blas_backend;
+}
+
+int cpu_blas_call_begin()
+/** Registers a BLAS call issued by the current thread and returns its number of threads.
+    Outside parallel regions, the thread budget is split among all BLAS calls in flight.
+    Each call must be completed by cpu_blas_call_end() with the returned number of threads. **/
+{
+ int budget,calls,used,nthreads;
+#ifndef NO_OMP
+ if(omp_in_parallel()){
+  if(blas_serial_in_parallel != NOPE) return 1;
+  return omp_get_max_threads(); //size of the nested team
+ }
+ budget=((blas_num_threads > 0)?blas_num_threads:omp_get_max_threads()); //size of the team the calling thread would fork
+#else
+ budget=((blas_num_threads > 0)?blas_num_threads:1);
+#endif
+ calls=++blas_calls_in_flight;
+ used=blas_threads_in_use.load();
+ do{
+  nthreads=std::max(1,std::min(budget/calls,budget-used)); //even share of the threads left unused by other calls
+ }while(!blas_threads_in_use.compare_exchange_weak(used,used+nthreads));
+ return nthreads;
+}
+
+void cpu_blas_call_end(int nthreads)
+/** Completes a BLAS call registered by cpu_blas_call_begin(), releasing its threads. **/
+{
+#ifndef NO_OMP
+ if(omp_in_parallel()) return;
+#endif
+ blas_threads_in_use-=nthreads;
+ --blas_calls_in_flight;
+ return;
+}
+
+static int cpu_blas_threads_begin(const cpu_blas_backend_t * backend, int nthreads)
+/** Sets the number of BLAS threads for the upcoming call(s), returns the value to be restored by cpu_blas_threads_end().
+    The process-global setting (OpenBLAS, BLIS) is only raised by a call without concurrent calls in flight,
+    thus no call runs with more threads than its share. **/
+{
+ int prev=0;
+ bool in_parallel=false;
+#ifndef NO_OMP
+ in_parallel=(omp_in_parallel() != 0);
+#endif
+ switch(backend->kind){
+  case BLAS_BACKEND_MKL:
+   prev=backend->mkl_set_local(nthreads); //thread-local setting
+   break;
+  case BLAS_BACKEND_OPENBLAS:
+   if(!in_parallel){ //global setting: threads inside parallel regions do not touch it
+    std::lock_guard<std::mutex> guard(blas_threads_lock);
+    const int current=backend->openblas_get();
+    if(nthreads < current || (nthreads > current && blas_calls_in_flight.load() <= 1)) backend->openblas_set(nthreads);
+   }
+   break;
+  case BLAS_BACKEND_BLIS:
+   if(!in_parallel){ //global setting: threads inside parallel regions do not touch it
+    std::lock_guard<std::mutex> guard(blas_threads_lock);
+    const int64_t current=backend->blis_get();
+    if((int64_t)nthreads < current || ((int64_t)nthreads > current && blas_calls_in_flight.load() <= 1)) backend->blis_set((int64_t)nthreads);
+   }
+   break;
+ }
+ return prev;
+}
+
+static void cpu_blas_threads_end(const cpu_blas_backend_t * backend, int prev)
+/** Restores the thread-local number of BLAS threads set by cpu_blas_threads_begin(). **/
+{
+ if(backend->kind == BLAS_BACKEND_MKL) backend->mkl_set_local(prev);
+ return;
+}
+
+int cpu_blas_load(const char * lib_path)
+/** Loads a BLAS library (OpenBLAS, MKL, BLIS, reference BLAS) at run time and makes it the active BLAS backend.
+    Returns the recognized backend kind (BLAS_BACKEND_XXX) on success, -1 if the library cannot be loaded,
+    -2 if it does not provide the Fortran GEMM interface. Must not be called concurrently with BLAS calls. **/
+{
+ const char * gemm_names[4]={"sgemm_","dgemm_","cgemm_","zgemm_"};
+ cpu_blas_backend_t backend;
+
+ if(lib_path == NULL) return -1;
+ cpu_blas_active();
+ backend.lib=dlopen(lib_path,RTLD_NOW|RTLD_LOCAL);
+ if(backend.lib == NULL){
+  if(VERBOSE) printf("#ERROR(cpu_blas_load): Unable to load %s: %s\n",lib_path,dlerror());
+  return -1;
+ }
+ for(int i=0; i<4; ++i){
+  backend.gemm[i]=(blas_gemm_t)cpu_blas_symbol(backend.lib,gemm_names[i]);
+  if(backend.gemm[i] == NULL){
+   if(VERBOSE) printf("#ERROR(cpu_blas_load): Library %s does not provide %s\n",lib_path,gemm_names[i]);
+   dlclose(backend.lib);
+   return -2;
+  }
+ }
+ cpu_blas_probe(&backend);
+ //The previously loaded library is not closed since its threads may still be referenced:
+#pragma omp critical(cpu_blas_backend)
+ blas_backend=backend;
+ return backend.kind;
+}
+
+int cpu_blas_backend()
+/** Returns the kind of the active BLAS backend (BLAS_BACKEND_XXX). **/
+{
+ return cpu_blas_active()->kind;
+}
+
+void cpu_blas_set_threads(int num_threads, int serial_in_parallel)
+/** Sets the number of BLAS threads used outside parallel regions (0: size of the executing Host team)
+    and whether BLAS calls inside parallel regions are enforced to be single-threaded (YEP/NOPE). **/
+{
+ blas_num_threads=((num_threads > 0)?num_threads:0);
+ blas_serial_in_parallel=((serial_in_parallel != NOPE)?YEP:NOPE);
+#pragma omp flush
+ return;
+}
+
+int cpu_blas_gemm(int datk, const char * transa, const char * transb, int m, int n, int k,
+                  const void * alpha, const void * a, int lda, const void * b, int ldb,
+                  const void * beta, void * c, int ldc)
+/** C = alpha * op(A) * op(B) + beta * C via the active BLAS backend with the number of threads
+    tied to the executing Host team. Returns 0 on success, non-zero if no BLAS is available. **/
+{
+ const int kid=cpu_blas_kind_index(datk); if(kid < 0) return 1;
+ const cpu_blas_backend_t * backend=cpu_blas_active();
+ if(backend->gemm[kid] == NULL) return 2;
+ const int nthreads=cpu_blas_call_begin();
+ const int prev=cpu_blas_threads_begin(backend,nthreads);
+ backend->gemm[kid](transa,transb,&m,&n,&k,alpha,a,&lda,b,&ldb,beta,c,&ldc);
+ cpu_blas_threads_end(backend,prev);
+ cpu_blas_call_end(nthreads);
+ return 0;
+}
+
+int cpu_blas_gemm_batch(int datk, const char * transa, const char * transb, int batch, int m, int n, int k,
+                        const void * alpha, const void * a, int lda, size_t stride_a,
+                        const void * b, int ldb, size_t stride_b,
+                        const void * beta, void * c, int ldc, size_t stride_c)
+/** Strided batched GEMM: C[i] = alpha * op(A[i]) * op(B[i]) + beta * C[i], i=0..batch-1,
+    where the matrices of each batch are stored with the given strides (in elements).
+    Returns 0 on success, non-zero if no BLAS is available. **/
+{
+ int datk_size;
+ const int kid=cpu_blas_kind_index(datk); if(kid < 0) return 1;
+ if(tens_valid_data_kind(datk,&datk_size) != YEP) return 1;
+ const cpu_blas_backend_t * backend=cpu_blas_active();
+ if(backend->gemm[kid] == NULL) return 2;
+ if(batch <= 0) return 0;
+ const int nthreads=cpu_blas_call_begin();
+ if(backend->gemm_batch[kid] != NULL &&
+    stride_a <= INT32_MAX && stride_b <= INT32_MAX && stride_c <= INT32_MAX){ //vendor strided batched GEMM
+  const int sa=(int)stride_a, sb=(int)stride_b, sc=(int)stride_c;
+  const int prev=cpu_blas_threads_begin(backend,nthreads);
+  backend->gemm_batch[kid](transa,transb,&m,&n,&k,alpha,a,&lda,&sa,b,&ldb,&sb,beta,c,&ldc,&sc,&batch);
+  cpu_blas_threads_end(backend,prev);
+  cpu_blas_call_end(nthreads);
+  return 0;
+ }
+ const char * abody=(const char*)a;
+ const char * bbody=(const char*)b;
+ char * cbody=(char*)c;
+ const size_t sa=stride_a*datk_size, sb=stride_b*datk_size, sc=stride_c*datk_size;
+#ifndef NO_OMP
+ if(blas_serial_in_parallel != NOPE && nthreads > 1 && batch >= nthreads){ //parallel batch with single-threaded BLAS
+  if(backend->kind == BLAS_BACKEND_OPENBLAS || backend->kind == BLAS_BACKEND_BLIS) cpu_blas_threads_begin(backend,1);
+#pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+  for(int i=0; i<batch; ++i){
+   const int prev=cpu_blas_threads_begin(backend,1);
+   backend->gemm[kid](transa,transb,&m,&n,&k,alpha,abody+i*sa,&lda,bbody+i*sb,&ldb,beta,cbody+i*sc,&ldc);
+   cpu_blas_threads_end(backend,prev);
+  }
+  cpu_blas_call_end(nthreads);
+  return 0;
+ }
+#endif
+ const int prev=cpu_blas_threads_begin(backend,nthreads); //loop of multi-threaded GEMM calls
+ for(int i=0; i<batch; ++i){
+  backend->gemm[kid](transa,transb,&m,&n,&k,alpha,abody+i*sa,&lda,bbody+i*sb,&ldb,beta,cbody+i*sc,&ldc);
+ }
+ cpu_blas_threads_end(backend,prev);
+ cpu_blas_call_end(nthreads);
+ return 0;
+}
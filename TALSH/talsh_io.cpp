@@ -0,0 +1,842 @@
+/** ExaTensor::TAL-SH: Tensor persistence and compression: Binary tensor file format, compressed tensor bodies.
+REVISION: 2026/10/19
+
+Copyright (C) 2014-2022 Dmitry I. Lyakh (Liakh)
+Copyright (C) 2014-2022 Oak Ridge National Laboratory (UT-Battelle)
+
+LICENSE: BSD 3-Clause
+-------------------------------------------------------------------
+
+FOR DEVELOPER(s):
+ # TAL-SH tensor file layout (native byte order, recorded in the header):
+   [Header region]: talsh_tens_file_header_t, followed by
+                    int64_t dims[rank], uint64_t signature[rank],
+                    talsh_tens_file_chunk_t chunks[num_chunks];
+                    the header region is zero-padded to TALSH_IO_ALIGN.
+   [Body region]: <num_chunks> chunk slots of <slot_size> bytes each,
+                  starting at <data_offset>. Chunk #k holds the tensor body
+                  bytes [k*chunk_size:min((k+1)*chunk_size,body_size)),
+                  stored either as is or compressed (when its stored size
+                  is smaller than its raw size). The unused tail of a slot
+                  is never written, thus it stays a hole in sparse files.
+ # Each chunk carries a checksum of its raw (uncompressed) data, hence
+   both the storage and the decompression are verified upon loading.
+   The header region is protected by its own checksum.
+ # Chunks are independent, thus they are compressed/written and
+   read/decompressed by multiple OpenMP threads concurrently via
+   positioned I/O (pwrite/pread) using large aligned transfers,
+   optionally bypassing the page cache (O_DIRECT).
+ # Compression: Byte shuffle (grouping the bytes of the same significance
+   of all real components together) followed by an LZ77-style codec
+   with a 64KB window. It is lossless and fast, and it is mostly efficient
+   on tensors with many zeros or repeated/smooth values.
+ # In-memory compressed tensor bodies (cold tensor images) consist of
+   independently (de)compressed blocks of TALSH_ZIP_BLOCK_SIZE raw bytes,
+   each stored as is, losslessly compressed, or quantized (lossy mode).
+   Quantization maps each real component <x> to the integer q=round(x/(2*tol)),
+   such that |x-q*2*tol| <= tol; the zigzag-encoded differences of consecutive
+   integers are then losslessly compressed. Blocks which cannot be quantized
+   (non-finite values, integer overflow) fall back to lossless compression.
+**/
+
+#include "talsh.h"
+#include "mem_manager.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <cmath>
+
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifndef NO_OMP
+#include <omp.h>
+#endif
+
+#define TALSH_IO_MAGIC "TALSHTNS"
+#define TALSH_IO_VERSION 1
+#define TALSH_IO_BYTE_ORDER 0x01020304U
+#define TALSH_IO_ALIGN 4096                     //alignment of all file transfers (bytes)
+#define TALSH_IO_CHUNK_SIZE (16*1024*1024)      //default chunk size (bytes)
+
+static int VERBOSE=1; //verbosity for errors
+
+#define TALSH_LZ_HASH_LOG 14                    //log2 of the LZ hash table size
+#define TALSH_LZ_MIN_MATCH 4                    //minimal LZ match length (bytes)
+#define TALSH_LZ_MAX_OFFSET 65535               //LZ window size (bytes)
+
+#define TALSH_ZIP_BLOCK_SIZE (1024*1024)        //raw size of independently compressed blocks of a tensor body (bytes)
+#define TALSH_ZIP_BLOCK_RAW 0                   //block is stored as is
+#define TALSH_ZIP_BLOCK_LZ 1                    //block is losslessly compressed
+#define TALSH_ZIP_BLOCK_QUANT 2                 //block is quantized and then losslessly compressed
+
+//PROTOTYPES OF IMPORTED FUNCTIONS:
+extern "C"{
+// Pinning of tensor bodies against relocation in the Host argument buffer (talshc.cpp):
+int talsh_tensor_pin(const talsh_tens_t * talsh_tens, unsigned long long * serial);
+void talsh_tensor_unpin(const talsh_tens_t * talsh_tens, unsigned long long serial);
+// Restoring the interleaved layout of a split-complex tensor body (talshc.cpp):
+int talsh_tensor_interleave(talsh_tens_t * talsh_tens);
+}
+
+//TYPES:
+// Tensor file header:
+typedef struct{
+ char magic[8];          //TALSH_IO_MAGIC (not null-terminated)
+ uint32_t byte_order;    //TALSH_IO_BYTE_ORDER as written by the producer
+ uint32_t version;       //file format version
+ int32_t data_kind;      //tensor data kind: {R4,R8,C4,C8}
+ int32_t rank;           //tensor rank
+ uint32_t flags;         //TALSH_IO_XXX flags used when writing the file
+ uint32_t reserved;      //reserved (zero)
+ uint64_t volume;        //tensor volume (number of elements)
+ uint64_t body_size;     //tensor body size (bytes)
+ uint64_t chunk_size;    //raw size of each chunk except possibly the last one (bytes)
+ uint64_t num_chunks;    //number of chunks
+ uint64_t data_offset;   //file offset of the first chunk slot (aligned)
+ uint64_t slot_size;     //file space reserved for each chunk (aligned)
+ uint64_t head_checksum; //checksum of the whole header region (computed with this field set to zero)
+} talsh_tens_file_header_t;
+
+// Tensor file chunk descriptor:
+typedef struct{
+ uint64_t stored_size;   //stored size of the chunk (bytes): Equal to its raw size if not compressed
+ uint64_t checksum;      //checksum of the raw (uncompressed) chunk data
+} talsh_tens_file_chunk_t;
+
+// Compressed tensor body header:
+typedef struct{
+ uint64_t body_size;     //raw size of the tensor body (bytes)
+ uint64_t block_size;    //raw size of each block except possibly the last one (bytes)
+ uint64_t num_blocks;    //number of blocks
+ int32_t data_kind;      //tensor data kind: {R4,R8,C4,C8}
+ int32_t zip_mode;       //compression mode: {TALSH_ZIP_LOSSLESS,TALSH_ZIP_LOSSY}
+ double tolerance;       //absolute error bound (lossy mode)
+} talsh_zip_header_t;
+
+// Compressed tensor body block descriptor:
+typedef struct{
+ uint64_t offset;        //offset of the stored block data (bytes) from the end of the block table
+ uint64_t size;          //stored size of the block (bytes)
+ uint32_t method;        //storage method: {TALSH_ZIP_BLOCK_RAW,TALSH_ZIP_BLOCK_LZ,TALSH_ZIP_BLOCK_QUANT}
+ uint32_t reserved;      //reserved (zero)
+} talsh_zip_block_t;
+
+
+//DATA COMPRESSION AND CHECKSUMS:
+static inline uint32_t talsh_lz_read32(const unsigned char * p)
+{
+ uint32_t w; memcpy(&w,p,sizeof(w));
+ return w;
+}
+
+static inline size_t talsh_io_align_up(size_t n)
+{
+ return ((n+(TALSH_IO_ALIGN-1))/TALSH_IO_ALIGN)*TALSH_IO_ALIGN;
+}
+
+static unsigned char * talsh_lz_put_length(unsigned char * op, const unsigned char * oend, size_t len)
+/** Writes the extension bytes of a length which does not fit in a token nibble.
+    Returns NULL if the output buffer is exhausted. **/
+{
+ while(len >= 255){
+  if(op >= oend) return NULL;
+  *op++=255; len-=255;
+ }
+ if(op >= oend) return NULL;
+ *op++=(unsigned char)len;
+ return op;
+}
+
+static size_t talsh_lz_compress(const unsigned char * src, size_t src_size, unsigned char * dst, size_t dst_capacity)
+/** LZ77-style compression of <src> into <dst>. Each sequence consists of a token byte
+    (high nibble: number of literals, low nibble: match length minus TALSH_LZ_MIN_MATCH,
+    with 15 signalling extension bytes), literals, a 2-byte match offset and the extended
+    match length. The last sequence only has literals. Returns the compressed size,
+    or zero if the compressed data does not fit into <dst_capacity> bytes. **/
+{
+ uint32_t htab[1<<TALSH_LZ_HASH_LOG];
+ const unsigned char * oend = dst+dst_capacity;
+ unsigned char * op = dst;
+ size_t ip,anchor,ref,ml,ll;
+
+ if(src_size > 0xFFFFFFFFUL) return 0; //positions are stored as 32-bit integers
+ memset(htab,0,sizeof(htab));
+ ip=0; anchor=0;
+ while(ip+TALSH_LZ_MIN_MATCH <= src_size){
+  uint32_t seq=talsh_lz_read32(src+ip);
+  uint32_t h=(seq*2654435761U)>>(32-TALSH_LZ_HASH_LOG);
+  ref=htab[h]; htab[h]=(uint32_t)ip;
+  if(ref < ip && ip-ref <= TALSH_LZ_MAX_OFFSET && talsh_lz_read32(src+ref) == seq){
+   ml=TALSH_LZ_MIN_MATCH; while(ip+ml < src_size && src[ref+ml] == src[ip+ml]) ++ml;
+   ll=ip-anchor;
+   if(op >= oend) return 0;
+   unsigned char * token = op++;
+   *token=(unsigned char)(((ll < 15 ? ll : 15)<<4) | (ml-TALSH_LZ_MIN_MATCH < 15 ? ml-TALSH_LZ_MIN_MATCH : 15));
+   if(ll >= 15){op=talsh_lz_put_length(op,oend,ll-15); if(op == NULL) return 0;}
+   if((size_t)(oend-op) < ll+2) return 0;
+   memcpy(op,src+anchor,ll); op+=ll;
+   *op++=(unsigned char)((ip-ref)&0xFF); *op++=(unsigned char)((ip-ref)>>8);
+   if(ml-TALSH_LZ_MIN_MATCH >= 15){op=talsh_lz_put_length(op,oend,ml-TALSH_LZ_MIN_MATCH-15); if(op == NULL) return 0;}
+   ip+=ml; anchor=ip;
+  }else{
+   ++ip;
+  }
+ }
+ ll=src_size-anchor; //last literals
+ if(op >= oend) return 0;
+ unsigned char * token = op++;
+ *token=(unsigned char)((ll < 15 ? ll : 15)<<4);
+ if(ll >= 15){op=talsh_lz_put_length(op,oend,ll-15); if(op == NULL) return 0;}
+ if((size_t)(oend-op) < ll) return 0;
+ memcpy(op,src+anchor,ll); op+=ll;
+ return (size_t)(op-dst);
+}
+
+static int talsh_lz_decompress(const unsigned char * src, size_t src_size, unsigned char * dst, size_t dst_size)
+/** Decompresses the output of talsh_lz_compress(). All accesses are bounds checked,
+    thus corrupted input never causes a buffer overrun. Returns zero on success,
+    non-zero if the input is corrupted or does not decompress into exactly <dst_size> bytes. **/
+{
+ const unsigned char * ip = src;
+ const unsigned char * iend = src+src_size;
+ size_t op,ll,ml,off;
+
+ op=0;
+ while(ip < iend){
+  unsigned int token = *ip++;
+  ll=(token>>4);
+  if(ll == 15){
+   unsigned int b;
+   do{if(ip >= iend) return 1; b=*ip++; ll+=b;}while(b == 255);
+  }
+  if((size_t)(iend-ip) < ll || dst_size-op < ll) return 2;
+  memcpy(dst+op,ip,ll); ip+=ll; op+=ll;
+  if(ip == iend) break; //last sequence
+  if(iend-ip < 2) return 3;
+  off=(size_t)ip[0] | ((size_t)ip[1]<<8); ip+=2;
+  if(off == 0 || off > op) return 4;
+  ml=(token&15);
+  if(ml == 15){
+   unsigned int b;
+   do{if(ip >= iend) return 5; b=*ip++; ml+=b;}while(b == 255);
+  }
+  ml+=TALSH_LZ_MIN_MATCH;
+  if(dst_size-op < ml) return 6;
+  if(off >= ml){
+   memcpy(dst+op,dst+op-off,ml); op+=ml;
+  }else{ //overlapping match (run)
+   for(size_t i=0;i<ml;++i){dst[op]=dst[op-off]; ++op;}
+  }
+ }
+ return (op == dst_size) ? 0 : 7;
+}
+
+static void talsh_byte_shuffle(const unsigned char * src, size_t src_size, size_t elem_size, unsigned char * dst)
+/** Groups the bytes of the same significance of all elements together. **/
+{
+ size_t n = src_size/elem_size;
+ for(size_t b=0;b<elem_size;++b){
+  unsigned char * d = dst+b*n;
+  for(size_t i=0;i<n;++i) d[i]=src[i*elem_size+b];
+ }
+ if(n*elem_size < src_size) memcpy(dst+n*elem_size,src+n*elem_size,src_size-n*elem_size);
+ return;
+}
+
+static void talsh_byte_unshuffle(const unsigned char * src, size_t src_size, size_t elem_size, unsigned char * dst)
+/** Inverse of talsh_byte_shuffle(). **/
+{
+ size_t n = src_size/elem_size;
+ for(size_t b=0;b<elem_size;++b){
+  const unsigned char * s = src+b*n;
+  for(size_t i=0;i<n;++i) dst[i*elem_size+b]=s[i];
+ }
+ if(n*elem_size < src_size) memcpy(dst+n*elem_size,src+n*elem_size,src_size-n*elem_size);
+ return;
+}
+
+size_t talsh_data_compress(const void * src, size_t src_size, size_t elem_size, void * dst, size_t dst_capacity, void * work)
+/** Lossless compression of <src_size> bytes of data consisting of elements of size <elem_size>
+    (byte shuffle followed by LZ compression). <work> is a scratch buffer of size <src_size>
+    (only needed when <elem_size> > 1). Returns the compressed size, or zero
+    if the compressed data would not fit into <dst_capacity> bytes. **/
+{
+ const unsigned char * in = (const unsigned char*)src;
+ if(src == NULL || dst == NULL || src_size == 0) return 0;
+ if(elem_size > 1){
+  if(work == NULL) return 0;
+  talsh_byte_shuffle(in,src_size,elem_size,(unsigned char*)work);
+  in=(const unsigned char*)work;
+ }
+ return talsh_lz_compress(in,src_size,(unsigned char*)dst,dst_capacity);
+}
+
+int talsh_data_decompress(const void * src, size_t src_size, size_t elem_size, void * dst, size_t dst_size, void * work)
+/** Decompresses the output of talsh_data_compress() into exactly <dst_size> bytes.
+    <work> is a scratch buffer of size <dst_size> (only needed when <elem_size> > 1).
+    Returns zero on success, non-zero on corrupted input. **/
+{
+ int errc;
+ if(src == NULL || dst == NULL) return -1;
+ if(elem_size > 1){
+  if(work == NULL) return -2;
+  errc=talsh_lz_decompress((const unsigned char*)src,src_size,(unsigned char*)work,dst_size);
+  if(errc == 0) talsh_byte_unshuffle((const unsigned char*)work,dst_size,elem_size,(unsigned char*)dst);
+ }else{
+  errc=talsh_lz_decompress((const unsigned char*)src,src_size,(unsigned char*)dst,dst_size);
+ }
+ return errc;
+}
+
+uint64_t talsh_data_checksum(const void * src, size_t src_size)
+/** Returns a 64-bit checksum of the data (multiplicative mixing of 64-bit words). **/
+{
+ const uint64_t p1 = 0x9E3779B185EBCA87ULL;
+ const uint64_t p2 = 0xC2B2AE3D27D4EB4FULL;
+ const unsigned char * p = (const unsigned char*)src;
+ uint64_t h = 0x27D4EB2F165667C5ULL ^ ((uint64_t)src_size*p1);
+ size_t i,n = src_size/8;
+ for(i=0;i<n;++i){
+  uint64_t w; memcpy(&w,p+i*8,8);
+  h^=w*p2; h=((h<<31)|(h>>33))*p1;
+ }
+ if(n*8 < src_size){
+  uint64_t w = 0; memcpy(&w,p+n*8,src_size-n*8);
+  h^=w*p2; h=((h<<31)|(h>>33))*p1;
+ }
+ h^=(h>>33); h*=p2; h^=(h>>29);
+ return h;
+}
+
+
+//TENSOR FILE I/O:
+static int talsh_io_pwrite(int fd, const void * buf, size_t count, size_t offset)
+/** Writes exactly <count> bytes at the file offset <offset>. Returns 0 or errno. **/
+{
+ const char * p = (const char*)buf;
+ while(count > 0){
+  ssize_t n = pwrite(fd,p,count,(off_t)offset);
+  if(n < 0){if(errno == EINTR) continue; return errno;}
+  if(n == 0) return EIO;
+  p+=n; count-=(size_t)n; offset+=(size_t)n;
+ }
+ return 0;
+}
+
+static int talsh_io_pread(int fd, void * buf, size_t count, size_t offset, size_t min_count)
+/** Reads up to <count> bytes from the file offset <offset>, requiring at least <min_count> bytes
+    (an aligned read may legitimately hit the end of file). Returns 0 or errno. **/
+{
+ char * p = (char*)buf;
+ size_t done = 0;
+ while(done < count){
+  ssize_t n = pread(fd,p+done,count-done,(off_t)(offset+done));
+  if(n < 0){if(errno == EINTR) continue; return errno;}
+  if(n == 0) break;
+  done+=(size_t)n;
+ }
+ return (done >= min_count) ? 0 : EIO;
+}
+
+static int talsh_io_open(const char * file_name, int oflags, int io_flags, int * direct)
+/** Opens a file, with O_DIRECT if requested and supported by the file system. **/
+{
+ int fd = -1;
+ *direct=NOPE;
+#ifdef O_DIRECT
+ if((io_flags & TALSH_IO_DIRECT) != 0){
+  fd=open(file_name,oflags|O_DIRECT,0644);
+  if(fd >= 0){*direct=YEP; return fd;}
+  if(errno != EINVAL) return -1; //file system without direct I/O support: Fall back to buffered I/O
+ }
+#endif
+ fd=open(file_name,oflags,0644);
+ return fd;
+}
+
+static void * talsh_io_host_body(const talsh_tens_t * tens_block, int * data_kind)
+/** Returns a pointer to an available Host image of the tensor body, NULL if there is none. **/
+{
+ int host_id = talshFlatDevId(DEV_HOST,0);
+ for(int i=0;i<tens_block->ndev;++i){
+  if(tens_block->dev_rsc[i].dev_id == host_id && tens_block->avail[i] == YEP && tens_block->dev_rsc[i].gmem_p != NULL){
+   *data_kind=tens_block->data_kind[i];
+   return tens_block->dev_rsc[i].gmem_p;
+  }
+ }
+ return NULL;
+}
+
+static size_t talsh_io_elem_size(int data_kind)
+/** Size of a real component of a tensor element (unit of byte shuffling). **/
+{
+ switch(data_kind){
+  case R4: case C4: return sizeof(float);
+  case R8: case C8: return sizeof(double);
+ }
+ return 1;
+}
+
+static int talsh_tensor_save_body(talsh_tens_t * tens_block, const char * file_name, const size_t * signature,
+                                  int io_flags, size_t chunk_size)
+/** Writes a pinned tensor block into a TAL-SH tensor file (see talshTensorSave()). **/
+{
+ int i,errc,data_kind,dksize,rank,fd,direct;
+ size_t volume,body_size,num_chunks,elem_size,meta_size,data_offset,final_size;
+ const char * body;
+
+ body=(const char*)talsh_io_host_body(tens_block,&data_kind);
+ if(body == NULL){
+  errc=talshTensorPlace(tens_block,0,DEV_HOST,NULL,COPY_K); if(errc != TALSH_SUCCESS) return errc;
+  body=(const char*)talsh_io_host_body(tens_block,&data_kind); if(body == NULL) return TALSH_FAILURE;
+ }
+ if(tens_valid_data_kind(data_kind,&dksize) != YEP || data_kind == NO_TYPE) return TALSH_FAILURE;
+ rank=talshTensorRank(tens_block); if(rank < 0) return TALSH_FAILURE;
+ volume=talshTensorVolume(tens_block);
+ body_size=volume*dksize; elem_size=talsh_io_elem_size(data_kind);
+ if(chunk_size == 0) chunk_size=TALSH_IO_CHUNK_SIZE;
+ chunk_size=talsh_io_align_up(chunk_size); //aligned chunks never split tensor elements
+ num_chunks=(body_size+chunk_size-1)/chunk_size;
+ meta_size=sizeof(talsh_tens_file_header_t)+rank*(sizeof(int64_t)+sizeof(uint64_t))+num_chunks*sizeof(talsh_tens_file_chunk_t);
+ data_offset=talsh_io_align_up(meta_size);
+ //Open the file:
+ fd=talsh_io_open(file_name,O_WRONLY|O_CREAT|O_TRUNC,io_flags,&direct);
+ if(fd < 0){
+  if(VERBOSE) printf("#ERROR(talshTensorSave): Unable to open file %s: Error %d\n",file_name,errno);
+  return TALSH_FAILURE;
+ }
+ //Write chunks in parallel:
+ std::vector<talsh_tens_file_chunk_t> chunks(num_chunks);
+ std::vector<int> chunk_errc(num_chunks,0);
+ const int compress = ((io_flags & TALSH_IO_COMPRESS) != 0) ? YEP : NOPE;
+#pragma omp parallel shared(chunks,chunk_errc,body,fd,direct,chunk_size,num_chunks,body_size,elem_size,data_offset)
+ {
+  void * buf = NULL;
+  void * work = NULL;
+  int ierr = 0;
+  if(direct == YEP || compress == YEP) ierr=host_mem_alloc(&buf,chunk_size,TALSH_IO_ALIGN);
+  if(ierr == 0 && compress == YEP && elem_size > 1) ierr=host_mem_alloc(&work,chunk_size,TALSH_IO_ALIGN);
+#pragma omp for schedule(dynamic)
+  for(size_t k=0;k<num_chunks;++k){
+   if(ierr != 0){chunk_errc[k]=ENOMEM; continue;}
+   const char * src = body+k*chunk_size;
+   size_t raw_size = body_size-k*chunk_size; if(raw_size > chunk_size) raw_size=chunk_size;
+   size_t stored_size = 0;
+   chunks[k].checksum=talsh_data_checksum(src,raw_size);
+   if(compress == YEP) stored_size=talsh_data_compress(src,raw_size,elem_size,buf,raw_size-1,work);
+   const void * out = buf;
+   if(stored_size == 0){ //store as is
+    stored_size=raw_size;
+    if(direct == YEP){memcpy(buf,src,raw_size);}else{out=src;}
+   }
+   chunks[k].stored_size=stored_size;
+   size_t wsize = stored_size;
+   if(direct == YEP){ //direct I/O requires aligned transfers
+    wsize=talsh_io_align_up(stored_size);
+    if(wsize > stored_size) memset(((char*)buf)+stored_size,0,wsize-stored_size);
+   }
+   chunk_errc[k]=talsh_io_pwrite(fd,out,wsize,data_offset+k*chunk_size);
+  }
+  if(work != NULL) host_mem_free(work);
+  if(buf != NULL) host_mem_free(buf);
+ }
+ errc=TALSH_SUCCESS;
+ for(size_t k=0;k<num_chunks;++k){
+  if(chunk_errc[k] != 0){
+   if(VERBOSE) printf("#ERROR(talshTensorSave): Unable to write chunk %lu of file %s: Error %d\n",k,file_name,chunk_errc[k]);
+   errc=TALSH_FAILURE; break;
+  }
+ }
+ //Write the header region:
+ if(errc == TALSH_SUCCESS){
+  void * meta = NULL;
+  if(host_mem_alloc(&meta,data_offset,TALSH_IO_ALIGN) == 0){
+   memset(meta,0,data_offset);
+   talsh_tens_file_header_t * header = (talsh_tens_file_header_t*)meta;
+   memcpy(header->magic,TALSH_IO_MAGIC,sizeof(header->magic));
+   header->byte_order=TALSH_IO_BYTE_ORDER; header->version=TALSH_IO_VERSION;
+   header->data_kind=data_kind; header->rank=rank; header->flags=(uint32_t)io_flags;
+   header->volume=volume; header->body_size=body_size;
+   header->chunk_size=chunk_size; header->num_chunks=num_chunks;
+   header->data_offset=data_offset; header->slot_size=chunk_size;
+   int64_t * fdims = (int64_t*)(header+1);
+   uint64_t * fsign = (uint64_t*)(fdims+rank);
+   for(i=0;i<rank;++i){
+    fdims[i]=tens_block->shape_p->dims[i];
+    fsign[i]=(signature != NULL) ? signature[i] : 0;
+   }
+   if(num_chunks > 0) memcpy((void*)(fsign+rank),chunks.data(),num_chunks*sizeof(talsh_tens_file_chunk_t));
+   header->head_checksum=talsh_data_checksum(meta,meta_size);
+   i=talsh_io_pwrite(fd,meta,(direct == YEP) ? data_offset : meta_size,0);
+   if(i != 0){
+    if(VERBOSE) printf("#ERROR(talshTensorSave): Unable to write the header of file %s: Error %d\n",file_name,i);
+    errc=TALSH_FAILURE;
+   }
+   host_mem_free(meta);
+  }else{
+   errc=TALSH_FAILURE;
+  }
+ }
+ //Trim the alignment padding of the last chunk:
+ if(errc == TALSH_SUCCESS){
+  final_size=data_offset;
+  if(num_chunks > 0) final_size+=(num_chunks-1)*chunk_size+chunks[num_chunks-1].stored_size;
+  if(ftruncate(fd,(off_t)final_size) != 0) errc=TALSH_FAILURE;
+ }
+ if(close(fd) != 0 && errc == TALSH_SUCCESS) errc=TALSH_FAILURE;
+ return errc;
+}
+
+int talshTensorSave(talsh_tens_t * tens_block, //in: defined tensor block (a Host image will be created if absent)
+                    const char * file_name,    //in: file name
+                    const size_t * signature,  //in: tensor signature to be stored: signature[0:rank-1] (optional)
+                    int io_flags,              //in: I/O flags: Bitwise OR of TALSH_IO_XXX
+                    size_t chunk_size)         //in: raw chunk size in bytes (0: default)
+/** Saves a tensor block into a TAL-SH tensor file (the file is overwritten).
+    The tensor body is split into independently checksummed (and optionally
+    compressed) chunks which are written by multiple threads concurrently.
+    If the tensor block has no Host image, it will be copied to Host first. **/
+{
+ int errc,pinned;
+ unsigned long long serial;
+
+ if(tens_block == NULL || file_name == NULL) return TALSH_INVALID_ARGS;
+ if((io_flags & ~(TALSH_IO_COMPRESS|TALSH_IO_DIRECT)) != 0) return TALSH_INVALID_ARGS;
+ if(talshTensorIsEmpty(tens_block) != NOPE) return TALSH_OBJECT_IS_EMPTY;
+ errc=talshTensorInUse(tens_block); if(errc == YEP) return TALSH_IN_PROGRESS; if(errc != NOPE) return errc;
+ errc=talsh_tensor_interleave(tens_block); if(errc != TALSH_SUCCESS) return errc; //files store the interleaved layout
+ pinned=talsh_tensor_pin(tens_block,&serial); //the body must not be relocated while being written
+ errc=talsh_tensor_save_body(tens_block,file_name,signature,io_flags,chunk_size);
+ if(pinned == YEP) talsh_tensor_unpin(tens_block,serial);
+ return errc;
+}
+
+int talshTensorLoad(talsh_tens_t * tens_block, //out: tensor block constructed on Host (must be empty on entrance)
+                    const char * file_name,    //in: file name
+                    size_t * signature,        //out: stored tensor signature: signature[0:rank-1] (optional, must have MAX_TENSOR_RANK entries)
+                    int io_flags)              //in: I/O flags: Only TALSH_IO_DIRECT matters
+/** Loads a tensor block from a TAL-SH tensor file. The tensor block is constructed
+    on Host and its body chunks are read, decompressed and verified by multiple
+    threads concurrently. Returns TALSH_OBJECT_BROKEN if the file is corrupted. **/
+{
+ int i,errc,dksize,fd,direct,rank,data_kind,pinned;
+ int tdims[MAX_TENSOR_RANK];
+ unsigned long long serial;
+ size_t elem_size,meta_size,chunk_size,num_chunks,body_size,data_offset;
+ void * meta;
+ char * body;
+
+ if(tens_block == NULL || file_name == NULL) return TALSH_INVALID_ARGS;
+ if((io_flags & ~(TALSH_IO_COMPRESS|TALSH_IO_DIRECT)) != 0) return TALSH_INVALID_ARGS;
+ if(talshTensorIsEmpty(tens_block) != YEP) return TALSH_OBJECT_NOT_EMPTY;
+ fd=talsh_io_open(file_name,O_RDONLY,io_flags,&direct);
+ if(fd < 0){
+  if(VERBOSE) printf("#ERROR(talshTensorLoad): Unable to open file %s: Error %d\n",file_name,errno);
+  return TALSH_FAILURE;
+ }
+ //Read and validate the header region:
+ meta=NULL; errc=TALSH_SUCCESS;
+ if(host_mem_alloc(&meta,TALSH_IO_ALIGN,TALSH_IO_ALIGN) != 0){close(fd); return TALSH_FAILURE;}
+ if(talsh_io_pread(fd,meta,TALSH_IO_ALIGN,0,sizeof(talsh_tens_file_header_t)) != 0) errc=TALSH_OBJECT_BROKEN;
+ talsh_tens_file_header_t header;
+ if(errc == TALSH_SUCCESS){
+  memcpy(&header,meta,sizeof(header));
+  if(memcmp(header.magic,TALSH_IO_MAGIC,sizeof(header.magic)) != 0 ||
+     header.byte_order != TALSH_IO_BYTE_ORDER || header.version != TALSH_IO_VERSION ||
+     header.rank < 0 || header.rank > MAX_TENSOR_RANK ||
+     tens_valid_data_kind(header.data_kind,&dksize) != YEP || header.data_kind == NO_TYPE ||
+     header.chunk_size == 0 || header.chunk_size%TALSH_IO_ALIGN != 0 || header.slot_size < header.chunk_size ||
+     header.volume == 0 || header.body_size != header.volume*dksize ||
+     header.num_chunks != (header.body_size+header.chunk_size-1)/header.chunk_size ||
+     header.data_offset%TALSH_IO_ALIGN != 0) errc=TALSH_OBJECT_BROKEN;
+ }
+ if(errc == TALSH_SUCCESS){
+  rank=header.rank; data_kind=header.data_kind;
+  chunk_size=header.chunk_size; num_chunks=header.num_chunks; body_size=header.body_size;
+  data_offset=header.data_offset;
+  meta_size=sizeof(header)+rank*(sizeof(int64_t)+sizeof(uint64_t))+num_chunks*sizeof(talsh_tens_file_chunk_t);
+  if(talsh_io_align_up(meta_size) != data_offset) errc=TALSH_OBJECT_BROKEN;
+ }
+ if(errc == TALSH_SUCCESS && data_offset > TALSH_IO_ALIGN){
+  host_mem_free(meta); meta=NULL;
+  if(host_mem_alloc(&meta,data_offset,TALSH_IO_ALIGN) != 0){close(fd); return TALSH_FAILURE;}
+  if(talsh_io_pread(fd,meta,data_offset,0,meta_size) != 0) errc=TALSH_OBJECT_BROKEN;
+ }
+ if(errc == TALSH_SUCCESS){
+  talsh_tens_file_header_t * hp = (talsh_tens_file_header_t*)meta;
+  hp->head_checksum=0;
+  if(talsh_data_checksum(meta,meta_size) != header.head_checksum) errc=TALSH_OBJECT_BROKEN;
+ }
+ std::vector<talsh_tens_file_chunk_t> chunks;
+ if(errc == TALSH_SUCCESS){
+  const int64_t * fdims = (const int64_t*)(((const talsh_tens_file_header_t*)meta)+1);
+  const uint64_t * fsign = (const uint64_t*)(fdims+rank);
+  size_t vol = 1;
+  for(i=0;i<rank;++i){
+   if(fdims[i] <= 0 || fdims[i] > 0x7FFFFFFF){errc=TALSH_OBJECT_BROKEN; break;}
+   tdims[i]=(int)fdims[i]; vol*=(size_t)fdims[i];
+   if(signature != NULL) signature[i]=(size_t)fsign[i];
+  }
+  if(errc == TALSH_SUCCESS && vol != header.volume) errc=TALSH_OBJECT_BROKEN;
+  if(errc == TALSH_SUCCESS){
+   const talsh_tens_file_chunk_t * fchunks = (const talsh_tens_file_chunk_t*)(fsign+rank);
+   chunks.assign(fchunks,fchunks+num_chunks);
+  }
+ }
+ if(meta != NULL) host_mem_free(meta);
+ if(errc != TALSH_SUCCESS){
+  if(VERBOSE) printf("#ERROR(talshTensorLoad): Invalid tensor file %s\n",file_name);
+  close(fd); return errc;
+ }
+ //Construct the tensor block on Host:
+ errc=talshTensorConstruct(tens_block,data_kind,rank,tdims,talshFlatDevId(DEV_HOST,0),NULL,-1,talsh_tens_no_init);
+ if(errc != TALSH_SUCCESS){close(fd); return errc;}
+ pinned=talsh_tensor_pin(tens_block,&serial); //the body must not be relocated while being read
+ body=(char*)talsh_io_host_body(tens_block,&data_kind);
+ if(body == NULL){i=talshTensorDestruct(tens_block); close(fd); return TALSH_FAILURE;}
+ //Read chunks in parallel:
+ elem_size=talsh_io_elem_size(data_kind);
+ const size_t slot_size = header.slot_size;
+ std::vector<int> chunk_errc(num_chunks,0);
+#pragma omp parallel shared(chunks,chunk_errc,body,fd,direct,chunk_size,slot_size,num_chunks,body_size,elem_size,data_offset)
+ {
+  void * buf = NULL;
+  void * work = NULL;
+  int ierr = host_mem_alloc(&buf,chunk_size,TALSH_IO_ALIGN);
+  if(ierr == 0 && elem_size > 1) ierr=host_mem_alloc(&work,chunk_size,TALSH_IO_ALIGN);
+#pragma omp for schedule(dynamic)
+  for(size_t k=0;k<num_chunks;++k){
+   if(ierr != 0){chunk_errc[k]=ENOMEM; continue;}
+   char * dst = body+k*chunk_size;
+   size_t raw_size = body_size-k*chunk_size; if(raw_size > chunk_size) raw_size=chunk_size;
+   size_t stored_size = chunks[k].stored_size;
+   if(stored_size == 0 || stored_size > raw_size){chunk_errc[k]=EILSEQ; continue;}
+   size_t offset = data_offset+k*slot_size;
+   if(stored_size == raw_size){ //stored as is
+    if(direct == YEP){
+     chunk_errc[k]=talsh_io_pread(fd,buf,talsh_io_align_up(raw_size),offset,raw_size);
+     if(chunk_errc[k] == 0) memcpy(dst,buf,raw_size);
+    }else{
+     chunk_errc[k]=talsh_io_pread(fd,dst,raw_size,offset,raw_size);
+    }
+   }else{ //compressed
+    chunk_errc[k]=talsh_io_pread(fd,buf,(direct == YEP) ? talsh_io_align_up(stored_size) : stored_size,offset,stored_size);
+    if(chunk_errc[k] == 0){
+     if(talsh_data_decompress(buf,stored_size,elem_size,dst,raw_size,work) != 0) chunk_errc[k]=EILSEQ;
+    }
+   }
+   if(chunk_errc[k] == 0 && talsh_data_checksum(dst,raw_size) != chunks[k].checksum) chunk_errc[k]=EILSEQ;
+  }
+  if(work != NULL) host_mem_free(work);
+  if(buf != NULL) host_mem_free(buf);
+ }
+ close(fd);
+ for(size_t k=0;k<num_chunks;++k){
+  if(chunk_errc[k] != 0){
+   if(VERBOSE) printf("#ERROR(talshTensorLoad): Unable to read chunk %lu of file %s: Error %d\n",k,file_name,chunk_errc[k]);
+   errc=(chunk_errc[k] == EILSEQ || chunk_errc[k] == EIO) ? TALSH_OBJECT_BROKEN : TALSH_FAILURE;
+   break;
+  }
+ }
+ if(pinned == YEP) talsh_tensor_unpin(tens_block,serial);
+ if(errc != TALSH_SUCCESS) i=talshTensorDestruct(tens_block);
+ return errc;
+}
+
+
+//TENSOR BODY COMPRESSION:
+template <typename T>
+static int talsh_quantize(const T * src, size_t n, size_t stride, double step, uint32_t * dst)
+/** Quantizes <n> real components with the step <step> and stores the zigzag-encoded
+    differences between the integers of the same component (<stride> components per element).
+    Returns non-zero if some component is not finite or its integer does not fit. **/
+{
+ const double lim = 1073741823.0; //differences must fit in 32 bits
+ for(size_t i=0;i<n;++i){
+  double x = ((double)src[i])/step;
+  if(!(std::fabs(x) <= lim)) return 1; //also traps NaN
+  int32_t q = (int32_t)std::llround(x);
+  int32_t p = 0;
+  if(i >= stride) p=(int32_t)std::llround(((double)src[i-stride])/step);
+  int32_t d = q-p;
+  dst[i]=(((uint32_t)d)<<1)^((uint32_t)(d>>31));
+ }
+ return 0;
+}
+
+template <typename T>
+static void talsh_dequantize(const uint32_t * src, size_t n, size_t stride, double step, T * dst)
+/** Inverse of talsh_quantize(). **/
+{
+ int32_t q[2] = {0,0};
+ for(size_t i=0;i<n;++i){
+  int32_t d = (int32_t)((src[i]>>1)^(0U-(src[i]&1U)));
+  size_t c = i%stride;
+  q[c]+=d;
+  dst[i]=(T)(((double)q[c])*step);
+ }
+ return;
+}
+
+static size_t talsh_zip_block(const char * src, size_t raw_size, int data_kind, int zip_mode, double tolerance,
+                              char * dst, void * qbuf, void * work, uint32_t * method)
+/** Compresses a single block of a tensor body into <dst> (capacity <raw_size>). **/
+{
+ size_t stored_size = 0;
+ size_t elem_size = talsh_io_elem_size(data_kind);
+ if(zip_mode == TALSH_ZIP_LOSSY && tolerance > 0.0){
+  size_t n = raw_size/elem_size;
+  size_t stride = (data_kind == C4 || data_kind == C8) ? 2 : 1;
+  int ierr = 1;
+  if(elem_size == sizeof(float)){
+   ierr=talsh_quantize((const float*)src,n,stride,2.0*tolerance,(uint32_t*)qbuf);
+  }else if(elem_size == sizeof(double)){
+   ierr=talsh_quantize((const double*)src,n,stride,2.0*tolerance,(uint32_t*)qbuf);
+  }
+  if(ierr == 0){
+   stored_size=talsh_data_compress(qbuf,n*sizeof(uint32_t),sizeof(uint32_t),dst,raw_size-1,work);
+   if(stored_size > 0){*method=TALSH_ZIP_BLOCK_QUANT; return stored_size;}
+  }
+ }
+ stored_size=talsh_data_compress(src,raw_size,elem_size,dst,raw_size-1,work);
+ if(stored_size > 0){*method=TALSH_ZIP_BLOCK_LZ; return stored_size;}
+ memcpy(dst,src,raw_size); *method=TALSH_ZIP_BLOCK_RAW;
+ return raw_size;
+}
+
+static int talsh_unzip_block(const char * src, size_t stored_size, uint32_t method, int data_kind, double tolerance,
+                             char * dst, size_t raw_size, void * qbuf, void * work)
+/** Decompresses a single block of a tensor body. **/
+{
+ int errc = 0;
+ size_t elem_size = talsh_io_elem_size(data_kind);
+ switch(method){
+  case TALSH_ZIP_BLOCK_RAW:
+   if(stored_size != raw_size) return 1;
+   memcpy(dst,src,raw_size);
+   break;
+  case TALSH_ZIP_BLOCK_LZ:
+   errc=talsh_data_decompress(src,stored_size,elem_size,dst,raw_size,work);
+   break;
+  case TALSH_ZIP_BLOCK_QUANT:
+  {
+   size_t n = raw_size/elem_size;
+   size_t stride = (data_kind == C4 || data_kind == C8) ? 2 : 1;
+   errc=talsh_data_decompress(src,stored_size,sizeof(uint32_t),qbuf,n*sizeof(uint32_t),work);
+   if(errc == 0){
+    if(elem_size == sizeof(float)){
+     talsh_dequantize((const uint32_t*)qbuf,n,stride,2.0*tolerance,(float*)dst);
+    }else{
+     talsh_dequantize((const uint32_t*)qbuf,n,stride,2.0*tolerance,(double*)dst);
+    }
+   }
+   break;
+  }
+  default:
+   errc=2;
+ }
+ return errc;
+}
+
+int talsh_body_compress(const void * body,  //in: tensor body
+                        size_t body_size,   //in: tensor body size (bytes)
+                        int data_kind,      //in: data kind: {R4,R8,C4,C8}
+                        int zip_mode,       //in: compression mode: {TALSH_ZIP_LOSSLESS,TALSH_ZIP_LOSSY}
+                        double tolerance,   //in: absolute error bound (lossy mode)
+                        void ** zip_data,   //out: compressed tensor body (malloc'ed, to be freed by free())
+                        size_t * zip_size)  //out: size of the compressed tensor body (bytes)
+/** Compresses a tensor body block-wise in parallel. Returns 0 on success,
+    TRY_LATER if no enough memory, or another non-zero error code. **/
+{
+ int dks;
+ size_t block_size,num_blocks,meta_size,pos;
+ char * out;
+
+ if(body == NULL || body_size == 0 || zip_data == NULL || zip_size == NULL) return -1;
+ if(tens_valid_data_kind(data_kind,&dks) != YEP || data_kind == NO_TYPE) return -2;
+ if(zip_mode != TALSH_ZIP_LOSSLESS && zip_mode != TALSH_ZIP_LOSSY) return -3;
+ if(zip_mode == TALSH_ZIP_LOSSY && !(tolerance > 0.0)) return -4;
+ *zip_data=NULL; *zip_size=0;
+ block_size=TALSH_ZIP_BLOCK_SIZE;
+ num_blocks=(body_size+block_size-1)/block_size;
+ meta_size=sizeof(talsh_zip_header_t)+num_blocks*sizeof(talsh_zip_block_t);
+ out=(char*)malloc(meta_size+body_size); //blocks are compressed in place of their raw positions first
+ if(out == NULL) return TRY_LATER;
+ talsh_zip_header_t * header = (talsh_zip_header_t*)out;
+ talsh_zip_block_t * blocks = (talsh_zip_block_t*)(header+1);
+ char * data = out+meta_size;
+ header->body_size=body_size; header->block_size=block_size; header->num_blocks=num_blocks;
+ header->data_kind=data_kind; header->zip_mode=zip_mode; header->tolerance=tolerance;
+ std::vector<int> block_errc(num_blocks,0);
+#pragma omp parallel shared(body,body_size,data_kind,zip_mode,tolerance,blocks,data,block_size,num_blocks,block_errc)
+ {
+  void * qbuf = malloc(block_size);
+  void * work = malloc(block_size);
+#pragma omp for schedule(dynamic)
+  for(size_t k=0;k<num_blocks;++k){
+   if(qbuf == NULL || work == NULL){block_errc[k]=TRY_LATER; continue;}
+   size_t raw_size = body_size-k*block_size; if(raw_size > block_size) raw_size=block_size;
+   uint32_t method = TALSH_ZIP_BLOCK_RAW;
+   blocks[k].size=talsh_zip_block(((const char*)body)+k*block_size,raw_size,data_kind,zip_mode,tolerance,
+                                  data+k*block_size,qbuf,work,&method);
+   blocks[k].method=method; blocks[k].reserved=0;
+  }
+  if(work != NULL) free(work);
+  if(qbuf != NULL) free(qbuf);
+ }
+ for(size_t k=0;k<num_blocks;++k){if(block_errc[k] != 0){free(out); return block_errc[k];}}
+ pos=0; //compact the stored blocks
+ for(size_t k=0;k<num_blocks;++k){
+  if(pos != k*block_size) memmove(data+pos,data+k*block_size,blocks[k].size);
+  blocks[k].offset=pos; pos+=blocks[k].size;
+ }
+ char * shrunk = (char*)realloc(out,meta_size+pos); if(shrunk != NULL) out=shrunk;
+ *zip_data=(void*)out; *zip_size=meta_size+pos;
+ return 0;
+}
+
+int talsh_body_decompress(const void * zip_data, //in: compressed tensor body (output of talsh_body_compress())
+                          size_t zip_size,       //in: size of the compressed tensor body (bytes)
+                          void * body,           //out: tensor body
+                          size_t body_size)      //in: tensor body size (bytes)
+/** Decompresses a tensor body block-wise in parallel. Returns 0 on success. **/
+{
+ size_t meta_size;
+
+ if(zip_data == NULL || body == NULL || zip_size < sizeof(talsh_zip_header_t)) return -1;
+ const talsh_zip_header_t * header = (const talsh_zip_header_t*)zip_data;
+ if(header->body_size != body_size || header->block_size == 0) return -2;
+ const size_t block_size = header->block_size;
+ const size_t num_blocks = header->num_blocks;
+ if(num_blocks != (body_size+block_size-1)/block_size) return -3;
+ meta_size=sizeof(talsh_zip_header_t)+num_blocks*sizeof(talsh_zip_block_t);
+ if(zip_size < meta_size) return -4;
+ const talsh_zip_block_t * blocks = (const talsh_zip_block_t*)(header+1);
+ const char * data = ((const char*)zip_data)+meta_size;
+ const size_t data_size = zip_size-meta_size;
+ const int data_kind = header->data_kind;
+ const double tolerance = header->tolerance;
+ std::vector<int> block_errc(num_blocks,0);
+#pragma omp parallel shared(body,body_size,data_kind,tolerance,blocks,data,data_size,block_size,num_blocks,block_errc)
+ {
+  void * qbuf = malloc(block_size);
+  void * work = malloc(block_size);
+#pragma omp for schedule(dynamic)
+  for(size_t k=0;k<num_blocks;++k){
+   if(qbuf == NULL || work == NULL){block_errc[k]=TRY_LATER; continue;}
+   size_t raw_size = body_size-k*block_size; if(raw_size > block_size) raw_size=block_size;
+   if(blocks[k].offset > data_size || blocks[k].size > data_size-blocks[k].offset){block_errc[k]=-5; continue;}
+   block_errc[k]=talsh_unzip_block(data+blocks[k].offset,blocks[k].size,blocks[k].method,data_kind,tolerance,
+                                   ((char*)body)+k*block_size,raw_size,qbuf,work);
+  }
+  if(work != NULL) free(work);
+  if(qbuf != NULL) free(qbuf);
+ }
+ for(size_t k=0;k<num_blocks;++k){if(block_errc[k] != 0) return block_errc[k];}
+ return 0;
+}
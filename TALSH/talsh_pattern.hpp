@@ -0,0 +1,215 @@
+/** ExaTensor::TAL-SH: C++ tensor operation pattern (compile-time parsing)
+REVISION: 2026/10/19
+
+Copyright (C) 2014-2022 Dmitry I. Lyakh (Liakh)
+Copyright (C) 2014-2022 Oak Ridge National Laboratory (UT-Battelle)
+
+LICENSE: BSD 3-Clause
+
+A symbolic tensor operation pattern, e.g. "D(a,b)+=L(a,c)*R(c,b)", is converted
+into the digital form (talsh_contr_ptrn_t) either at compile time, when the
+pattern object is declared constexpr, or once at run time. Tensor operations
+accepting a ContractionPattern skip the run-time pattern parsing entirely:
+
+ constexpr talsh::ContractionPattern ptrn("D(a,b)+=L(a,c)*R(c,b)"); //invalid pattern = compilation error
+ dtens.contractAccumulate(nullptr,ptrn,ltens,rtens,DEV_HOST,0,1.0);
+
+Supported syntax: D(...)=L(...) or D(...)+=L(...) for unary tensor operations,
+D(...)=L(...)*R(...) or D(...)+=L(...)*R(...) for tensor contractions,
+alphanumeric (plus underscore) index labels separated by "," or "|",
+an optional "+" suffix after a tensor name (complex conjugation) or an index label
+(contravariance, ignored). Scalar factors inside the pattern are not supported. **/
+
+#ifndef TALSH_PATTERN_HPP_
+#define TALSH_PATTERN_HPP_
+
+#include "talsh.h" //TAL-SH C header
+
+#include <string>
+#include <stdexcept>
+#include <iostream>
+#include <cassert>
+
+namespace talsh{
+
+namespace detail{
+
+//Integer sequence (C++11):
+template <int... I> struct IndexSeq{};
+template <int N, int... I> struct MakeIndexSeq: MakeIndexSeq<N-1,N-1,I...>{};
+template <int... I> struct MakeIndexSeq<0,I...>{using type = IndexSeq<I...>;};
+
+//Pattern parsing primitives (C++11 constexpr, <s[0:n-1]> is the pattern string):
+constexpr bool isLabelChar(char c){
+ return ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_');
+}
+constexpr bool isSeparator(char c){return (c == ',' || c == '|');}
+
+//Number of tensor arguments:
+constexpr int numArgs(const char * s, int n, int pos = 0){
+ return (pos >= n) ? 0 : (((s[pos] == '(') ? 1 : 0) + numArgs(s,n,pos+1));
+}
+//Position of the opening parenthesis of tensor argument #arg (n if absent):
+constexpr int argOpen(const char * s, int n, int arg, int pos = 0){
+ return (pos >= n) ? n : ((s[pos] == '(') ? ((arg == 0) ? pos : argOpen(s,n,arg-1,pos+1)) : argOpen(s,n,arg,pos+1));
+}
+//Position of the first closing parenthesis at or after <pos> (n if absent):
+constexpr int findClose(const char * s, int n, int pos){
+ return (pos >= n) ? n : ((s[pos] == ')') ? pos : findClose(s,n,pos+1));
+}
+//Position of the closing parenthesis of tensor argument #arg:
+constexpr int argClose(const char * s, int n, int arg){return findClose(s,n,argOpen(s,n,arg)+1);}
+//Number of index separators in s[b:e-1]:
+constexpr int countSeparators(const char * s, int b, int e){
+ return (b >= e) ? 0 : ((isSeparator(s[b]) ? 1 : 0) + countSeparators(s,b+1,e));
+}
+//Rank of tensor argument #arg (0 if absent):
+constexpr int argRank(const char * s, int n, int arg){
+ return (arg >= numArgs(s,n)) ? 0 :
+        ((argClose(s,n,arg) == argOpen(s,n,arg) + 1) ? 0 :
+         (1 + countSeparators(s,argOpen(s,n,arg)+1,argClose(s,n,arg))));
+}
+//Position of the first character after <i> index separators starting from <pos>:
+constexpr int skipSeparators(const char * s, int n, int pos, int i){
+ return (i == 0 || pos >= n) ? pos : (isSeparator(s[pos]) ? skipSeparators(s,n,pos+1,i-1) : skipSeparators(s,n,pos+1,i));
+}
+//Position right after the index label starting at <pos>:
+constexpr int labelEnd(const char * s, int n, int pos){
+ return (pos >= n || isSeparator(s[pos]) || s[pos] == ')') ? pos : labelEnd(s,n,pos+1);
+}
+//Beginning of index label #i in tensor argument #arg:
+constexpr int labelBegin(const char * s, int n, int arg, int i){return skipSeparators(s,n,argOpen(s,n,arg)+1,i);}
+//End of index label #i in tensor argument #arg (without the contravariance suffix):
+constexpr int labelStop(const char * s, int n, int arg, int i){
+ return (labelEnd(s,n,labelBegin(s,n,arg,i)) > labelBegin(s,n,arg,i) &&
+         s[labelEnd(s,n,labelBegin(s,n,arg,i))-1] == '+') ?
+        (labelEnd(s,n,labelBegin(s,n,arg,i)) - 1) : labelEnd(s,n,labelBegin(s,n,arg,i));
+}
+//Returns TRUE if s[b1:e1-1] and s[b2:e2-1] are the same label:
+constexpr bool labelsEqual(const char * s, int b1, int e1, int b2, int e2){
+ return (e1 - b1 != e2 - b2) ? false : ((b1 >= e1) ? true : (s[b1] == s[b2] && labelsEqual(s,b1+1,e1,b2+1,e2)));
+}
+//Position (1-based) of the index label s[b:e-1] in tensor argument #arg (0 if absent):
+constexpr int findLabel(const char * s, int n, int arg, int b, int e, int i = 0){
+ return (i >= argRank(s,n,arg)) ? 0 :
+        (labelsEqual(s,b,e,labelBegin(s,n,arg,i),labelStop(s,n,arg,i)) ? (i + 1) : findLabel(s,n,arg,b,e,i+1));
+}
+//Digital pattern value for index #i of input tensor argument #arg (0 if unpaired):
+constexpr int digitOf(const char * s, int n, int arg, int i){
+ return (findLabel(s,n,0,labelBegin(s,n,arg,i),labelStop(s,n,arg,i)) > 0) ?
+        findLabel(s,n,0,labelBegin(s,n,arg,i),labelStop(s,n,arg,i)) :
+        -findLabel(s,n,3-arg,labelBegin(s,n,arg,i),labelStop(s,n,arg,i));
+}
+//Digital pattern value at position <k> (0-based, over the left and then right tensor dimensions):
+constexpr int digit(const char * s, int n, int k){
+ return (k >= argRank(s,n,1) + argRank(s,n,2)) ? 0 :
+        ((k < argRank(s,n,1)) ? digitOf(s,n,1,k) : digitOf(s,n,2,k-argRank(s,n,1)));
+}
+//Complex conjugation bits:
+constexpr int conjBits(const char * s, int n, int arg = 0){
+ return (arg >= numArgs(s,n)) ? 0 :
+        ((((argOpen(s,n,arg) > 0 && s[argOpen(s,n,arg)-1] == '+') ? 1 : 0) << arg) + conjBits(s,n,arg+1));
+}
+
+//Validation (each failed check throws, which is a compilation error in a constant expression):
+constexpr bool labelCharsOk(const char * s, int b, int e){
+ return (b >= e) ? true : (isLabelChar(s[b]) && labelCharsOk(s,b+1,e));
+}
+constexpr bool tensorNameOk(const char * s, int n, int arg){
+ return (argOpen(s,n,arg) > 0 && isLabelChar(s[argOpen(s,n,arg)-1])) ||
+        (argOpen(s,n,arg) > 1 && s[argOpen(s,n,arg)-1] == '+' && isLabelChar(s[argOpen(s,n,arg)-2]));
+}
+constexpr bool argLabelsOk(const char * s, int n, int arg, int i = 0){
+ return (i >= argRank(s,n,arg)) ? true :
+        (labelStop(s,n,arg,i) > labelBegin(s,n,arg,i) &&
+         labelCharsOk(s,labelBegin(s,n,arg,i),labelStop(s,n,arg,i)) &&
+         findLabel(s,n,arg,labelBegin(s,n,arg,i),labelStop(s,n,arg,i)) == i + 1 && //no repeated labels
+         argLabelsOk(s,n,arg,i+1));
+}
+constexpr bool inputLabelsPaired(const char * s, int n, int arg, int i = 0){
+ return (i >= argRank(s,n,arg)) ? true : (digitOf(s,n,arg,i) != 0 && inputLabelsPaired(s,n,arg,i+1));
+}
+constexpr bool outputLabelsPaired(const char * s, int n, int i = 0){
+ return (i >= argRank(s,n,0)) ? true :
+        ((findLabel(s,n,1,labelBegin(s,n,0,i),labelStop(s,n,0,i)) > 0 ||
+          findLabel(s,n,2,labelBegin(s,n,0,i),labelStop(s,n,0,i)) > 0) && outputLabelsPaired(s,n,i+1));
+}
+constexpr bool check(bool ok, const char * message){
+ return ok ? true : throw std::invalid_argument(message);
+}
+constexpr bool patternOk(const char * s, int n){
+ return check(numArgs(s,n) == 2 || numArgs(s,n) == 3,
+              "#ERROR(talsh::ContractionPattern): Pattern must have two or three tensor arguments!") &&
+        check(tensorNameOk(s,n,0) && tensorNameOk(s,n,1) && (numArgs(s,n) == 2 || tensorNameOk(s,n,2)),
+              "#ERROR(talsh::ContractionPattern): Missing tensor name!") &&
+        check(argClose(s,n,0) < argOpen(s,n,1) && argClose(s,n,1) < argOpen(s,n,2) &&
+              argClose(s,n,numArgs(s,n)-1) == n - 1,
+              "#ERROR(talsh::ContractionPattern): Unbalanced parentheses!") &&
+        check(s[argClose(s,n,0)+1] == '=' || (s[argClose(s,n,0)+1] == '+' && s[argClose(s,n,0)+2] == '='),
+              "#ERROR(talsh::ContractionPattern): Expected = or += after the destination tensor!") &&
+        check(numArgs(s,n) == 2 || s[argClose(s,n,1)+1] == '*',
+              "#ERROR(talsh::ContractionPattern): Expected * between the input tensors!") &&
+        check(argRank(s,n,0) <= MAX_TENSOR_RANK && argRank(s,n,1) <= MAX_TENSOR_RANK && argRank(s,n,2) <= MAX_TENSOR_RANK,
+              "#ERROR(talsh::ContractionPattern): Tensor rank exceeds MAX_TENSOR_RANK!") &&
+        check(argLabelsOk(s,n,0) && argLabelsOk(s,n,1) && argLabelsOk(s,n,2),
+              "#ERROR(talsh::ContractionPattern): Invalid or repeated index label!") &&
+        check(inputLabelsPaired(s,n,1) && inputLabelsPaired(s,n,2) && outputLabelsPaired(s,n),
+              "#ERROR(talsh::ContractionPattern): Unpaired index label!");
+}
+
+} //namespace detail
+
+
+/** Digital tensor operation pattern (tensor copy, addition or contraction). **/
+class ContractionPattern{
+
+public:
+
+ /** Parses a pattern string literal. Declare the object constexpr to parse at compile time. **/
+ template <std::size_t N>
+ constexpr explicit ContractionPattern(const char (&pattern)[N]):
+  ContractionPattern(pattern,static_cast<int>(N-1),typename detail::MakeIndexSeq<MAX_TENSOR_RANK*2>::type())
+ {}
+
+ /** Parses a pattern string once at run time. **/
+ explicit ContractionPattern(const std::string & pattern)
+ {
+  int errc = talshContrPatternParse(pattern.c_str(),&ptrn_);
+  if(errc != TALSH_SUCCESS)
+   std::cout << "#ERROR(talsh::ContractionPattern): Invalid tensor operation pattern: " << pattern << std::endl;
+  assert(errc == TALSH_SUCCESS);
+ }
+
+ ContractionPattern(const ContractionPattern &) = default;
+ ContractionPattern & operator=(const ContractionPattern &) = default;
+ ~ContractionPattern() = default;
+
+ /** Returns the rank of the destination tensor. **/
+ constexpr int getDestRank() const {return ptrn_.drank;}
+ /** Returns the rank of the left tensor. **/
+ constexpr int getLeftRank() const {return ptrn_.lrank;}
+ /** Returns the rank of the right tensor (0 for unary tensor operations). **/
+ constexpr int getRightRank() const {return ptrn_.rrank;}
+ /** Returns the argument complex conjugation bits: {0:D,1:L,2:R}. **/
+ constexpr int getConjBits() const {return ptrn_.conj_bits;}
+ /** Returns the digital pattern value at position <k> (see talsh_contr_ptrn_t). **/
+ constexpr int getDigit(int k) const {return ptrn_.dig_ptrn[k];}
+
+ /** Returns a pointer to the underlying C digital pattern. **/
+ const talsh_contr_ptrn_t * get() const {return &ptrn_;}
+
+private:
+
+ template <int... I>
+ constexpr ContractionPattern(const char * s, int n, detail::IndexSeq<I...>):
+  ptrn_{(detail::patternOk(s,n) ? detail::argRank(s,n,0) : -1),
+        detail::argRank(s,n,1),detail::argRank(s,n,2),detail::conjBits(s,n),
+        {detail::digit(s,n,I)...}}
+ {}
+
+ talsh_contr_ptrn_t ptrn_; //digital tensor operation pattern
+};
+
+} //namespace talsh
+
+#endif //TALSH_PATTERN_HPP_
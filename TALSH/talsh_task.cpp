@@ -1,5 +1,5 @@
 /** ExaTensor::TAL-SH: Device-unified user-level C++ API implementation.
-REVISION: 2020/06/19
+REVISION: 2026/10/19
 
 Copyright (C) 2014-2022 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2014-2022 Oak Ridge National Laboratory (UT-Battelle)
@@ -24,6 +24,25 @@ TensorTask::TensorTask():
 }
 
 
+TensorTask::TensorTask(TensorTask && task_handle) noexcept:
+ num_tensors_(0)
+{
+ int errc = talshTaskClean(&talsh_task_);
+ assert(errc == TALSH_SUCCESS);
+ this->moveFrom(task_handle);
+}
+
+
+TensorTask & TensorTask::operator=(TensorTask && task_handle) noexcept
+{
+ if(this != &task_handle){
+  this->wait();
+  this->moveFrom(task_handle);
+ }
+ return *this;
+}
+
+
 TensorTask::~TensorTask()
 {
  this->wait();
@@ -32,6 +51,24 @@ TensorTask::~TensorTask()
 }
 
 
+void TensorTask::moveFrom(TensorTask & task_handle)
+/** Takes over the (possibly active) TAL-SH task from another handle (this handle must be empty).
+    The participating tensors are redirected to this handle, the other handle becomes empty. **/
+{
+ talsh_task_ = task_handle.talsh_task_;
+ num_tensors_ = task_handle.num_tensors_;
+ for(int i = 0; i < num_tensors_; ++i){
+  Tensor * tensor = task_handle.used_tensors_[i];
+  used_tensors_[i] = tensor;
+  if(tensor->getWriteTask() == &task_handle) tensor->resetWriteTask(this);
+ }
+ task_handle.num_tensors_ = 0;
+ int errc = talshTaskClean(&(task_handle.talsh_task_));
+ assert(errc == TALSH_SUCCESS);
+ return;
+}
+
+
 bool TensorTask::isEmpty()
 {
  return (talshTaskIsEmpty(&talsh_task_) == YEP);
@@ -129,4 +166,145 @@ talsh_task_t * TensorTask::getTalshTaskPtr()
  return &talsh_task_;
 }
 
+
+TaskGroup::~TaskGroup()
+{
+ this->waitAll();
+}
+
+
+TensorTask & TaskGroup::addTask(unsigned int * task_id)
+{
+ tasks_.emplace_back(new TaskEntry());
+ ++num_pending_;
+ if(task_id != nullptr) *task_id = tasks_.size() - 1;
+ return tasks_.back()->task;
+}
+
+
+unsigned int TaskGroup::addTask(TensorTask && task)
+{
+ unsigned int task_id;
+ this->addTask(&task_id) = std::move(task);
+ return task_id;
+}
+
+
+unsigned int TaskGroup::getNumTasks() const
+{
+ return tasks_.size();
+}
+
+
+unsigned int TaskGroup::getNumPending() const
+{
+ return num_pending_;
+}
+
+
+TensorTask & TaskGroup::getTask(unsigned int task_id)
+{
+ assert(task_id < tasks_.size());
+ return tasks_[task_id]->task;
+}
+
+
+TaskGroup & TaskGroup::then(unsigned int task_id, Continuation func)
+{
+ assert(task_id < tasks_.size());
+ TaskEntry & entry = *(tasks_[task_id]);
+ if(entry.completed){
+  func(entry.success);
+ }else{
+  entry.continuations.emplace_back(std::move(func));
+ }
+ return *this;
+}
+
+
+TaskGroup & TaskGroup::whenAll(Continuation func)
+{
+ all_continuations_.emplace_back(std::move(func));
+ this->fireAll();
+ return *this;
+}
+
+
+TaskGroup & TaskGroup::whenAny(AnyContinuation func)
+{
+ for(unsigned int i = 0; i < tasks_.size(); ++i){
+  if(tasks_[i]->completed) func(i,tasks_[i]->success);
+ }
+ any_continuations_.emplace_back(std::move(func));
+ return *this;
+}
+
+
+bool TaskGroup::testTask(unsigned int task_id)
+/** Tests a pending task for completion. Upon completion, executes its continuations
+    (which may append new tasks to the group) and returns TRUE. **/
+{
+ TaskEntry * entry = tasks_[task_id].get();
+ if(entry->completed) return true;
+ int status = TALSH_TASK_EMPTY;
+ if(!(entry->task.test(&status))) return false;
+ entry->completed = true;
+ entry->success = (status == TALSH_TASK_COMPLETED || status == TALSH_TASK_EMPTY);
+ if(!(entry->success)) all_success_ = false;
+ --num_pending_;
+ std::vector<Continuation> continuations(std::move(entry->continuations));
+ entry->continuations.clear();
+ for(auto & func: continuations) func(entry->success);
+ for(unsigned int i = 0; i < any_continuations_.size(); ++i) any_continuations_[i](task_id,entry->success);
+ return true;
+}
+
+
+void TaskGroup::fireAll()
+{
+ if(num_pending_ == 0 && !all_continuations_.empty()){
+  std::vector<Continuation> continuations(std::move(all_continuations_));
+  all_continuations_.clear();
+  for(auto & func: continuations) func(all_success_);
+ }
+ return;
+}
+
+
+bool TaskGroup::progress()
+{
+ for(unsigned int i = 0; i < tasks_.size(); ++i) this->testTask(i); //tasks_ may grow during the loop
+ this->fireAll();
+ return (num_pending_ == 0);
+}
+
+
+bool TaskGroup::waitAll()
+{
+ while(!(this->progress()));
+ return all_success_;
+}
+
+
+int TaskGroup::waitAny(bool * success)
+{
+ while(true){
+  bool unreported = false;
+  for(unsigned int i = 0; i < tasks_.size(); ++i){
+   TaskEntry * entry = tasks_[i].get();
+   if(!(entry->reported)){
+    unreported = true;
+    if(this->testTask(i)){
+     entry->reported = true;
+     if(success != nullptr) *success = entry->success;
+     this->fireAll();
+     return static_cast<int>(i);
+    }
+   }
+  }
+  if(!unreported) break;
+ }
+ return -1;
+}
+
 } //namespace talsh
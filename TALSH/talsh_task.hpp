@@ -1,5 +1,5 @@
 /** ExaTensor::TAL-SH: C++ TAL-SH task
-REVISION: 2020/07/21
+REVISION: 2026/10/19
 
 Copyright (C) 2014-2022 Dmitry I. Lyakh (Liakh)
 Copyright (C) 2014-2022 Oak Ridge National Laboratory (UT-Battelle)
@@ -12,6 +12,9 @@ LICENSE: BSD 3-Clause **/
 #include "talsh.h" //TAL-SH C header
 
 #include <tuple>
+#include <vector>
+#include <memory>
+#include <functional>
 
 namespace talsh{
 
@@ -26,8 +29,8 @@ public:
 
  TensorTask(const TensorTask & task_handle) = delete;
  TensorTask & operator=(const TensorTask & task_handle) = delete;
- TensorTask(TensorTask && task_handle) = delete;
- TensorTask & operator=(TensorTask && task_handle) = delete;
+ TensorTask(TensorTask && task_handle) noexcept;
+ TensorTask & operator=(TensorTask && task_handle) noexcept;
  ~TensorTask();
 
  /** Returns TRUE if the TAL-SH task handle is empty. **/
@@ -69,11 +72,96 @@ private:
  unsigned int num_tensors_;                   //number of participating tensors in this TAL-SH task
  Tensor * used_tensors_[MAX_TENSOR_OPERANDS]; //non-owning pointers to the tensors participating in this task
 
+//Private methods:
+ void moveFrom(TensorTask & task_handle);
+
 //Friends:
  friend class Tensor;
 
 };
 
+
+/** Group of TAL-SH tasks with future-like composition:
+    Continuations attached to individual tasks (then), to the completion
+    of all tasks (whenAll), or to the completion of each task (whenAny) are
+    executed on the thread that observes the completion, which happens inside
+    progress(), waitAll() or waitAny(). Continuations may add new tasks
+    to the same group (pipelining). The group is not thread-safe. **/
+class TaskGroup{
+
+public:
+
+ /** Continuation: Receives TRUE if the task(s) completed successfully. **/
+ using Continuation = std::function<void (bool)>;
+ /** Continuation: Receives the id of the completed task and its success status. **/
+ using AnyContinuation = std::function<void (unsigned int, bool)>;
+
+ TaskGroup() = default;
+
+ TaskGroup(const TaskGroup & task_group) = delete;
+ TaskGroup & operator=(const TaskGroup & task_group) = delete;
+ TaskGroup(TaskGroup && task_group) = default;
+ TaskGroup & operator=(TaskGroup && task_group) = default;
+ ~TaskGroup();
+
+ /** Creates a new empty task in the group, to be passed to a tensor operation
+     before the group is progressed (an empty task counts as completed).
+     The returned reference stays valid for the lifetime of the group. **/
+ TensorTask & addTask(unsigned int * task_id = nullptr); //out: task id within the group
+ /** Moves an existing task into the group and returns its id within the group. **/
+ unsigned int addTask(TensorTask && task);
+
+ /** Returns the total number of tasks in the group. **/
+ unsigned int getNumTasks() const;
+ /** Returns the number of tasks in the group that have not completed yet. **/
+ unsigned int getNumPending() const;
+ /** Returns a task by its id. **/
+ TensorTask & getTask(unsigned int task_id);
+
+ /** Attaches a continuation to a specific task, executed once upon its completion
+     (immediately if the task has already completed). **/
+ TaskGroup & then(unsigned int task_id, Continuation func);
+ /** Attaches a continuation executed once all tasks of the group have completed
+     (including tasks added later). **/
+ TaskGroup & whenAll(Continuation func);
+ /** Attaches a continuation executed upon completion of each task of the group. **/
+ TaskGroup & whenAny(AnyContinuation func);
+
+ /** Tests all pending tasks once (non-blocking) and executes the continuations of the completed ones.
+     Returns TRUE if all tasks of the group have completed. **/
+ bool progress();
+ /** Returns upon completion of all tasks of the group (executing their continuations).
+     Returns TRUE if all tasks completed successfully. **/
+ bool waitAll();
+ /** Returns upon completion of any task of the group whose completion has not been returned
+     by waitAny() yet. Returns the id of that task or -1 if no such task is left.
+     <success> (optional) will contain the completion status of the task. **/
+ int waitAny(bool * success = nullptr);
+
+private:
+
+ //Task entry:
+ struct TaskEntry{
+  TensorTask task;                         //TAL-SH task
+  std::vector<Continuation> continuations; //continuations attached to this task
+  bool completed = false;                  //TRUE if the task has completed
+  bool success = false;                    //TRUE if the task has completed successfully
+  bool reported = false;                   //TRUE if the task completion has been returned by waitAny()
+ };
+
+ //Private methods:
+ bool testTask(unsigned int task_id); //tests a task for completion and executes its continuations
+ void fireAll();                      //executes whenAll continuations if all tasks have completed
+
+//Data members:
+ std::vector<std::unique_ptr<TaskEntry>> tasks_; //tasks of the group
+ std::vector<Continuation> all_continuations_;   //continuations executed upon completion of all tasks
+ std::vector<AnyContinuation> any_continuations_; //continuations executed upon completion of each task
+ unsigned int num_pending_ = 0;                  //number of tasks that have not completed yet
+ bool all_success_ = true;                       //TRUE if all completed tasks succeeded
+
+};
+
 } //namespace talsh
 
 #endif //TALSH_TASK_HPP_
@@ -47,11 +47,29 @@ FOR DEVELOPER(s):
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
+#include <cstring>
+#include <cmath>
+#include <climits>
+
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include <mutex>
+#include <type_traits>
 
 #ifndef NO_OMP
 #include <omp.h>
 #endif
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #ifdef USE_HIP
 #include "talsh_complex.hip.h"
 #include "device_algebra.hip.h"
@@ -64,13 +82,22 @@ FOR DEVELOPER(s):
 //PARAMETERS:
 static int VERBOSE=1;     //verbosity for errors
 static int LOGGING_OPS=0; //logging basic tensor operations: Add, Contract
+static const size_t SMALL_TENSOR_FMA_MULT=16; //max FMA count of a small tensor contraction (in units of the max tensor volume)
+static const size_t OBJ_POOL_SIZE=4096; //max number of pooled objects of each kind (tasks, tensor blocks, tensor operations)
+static const int TENS_REGISTRY_SHARDS=64; //number of independently locked shards of the tensor registry
+static const size_t SVD_RAND_MIN_DIM=256; //min matrix dimension for the randomized range finder in the truncated SVD (smaller: Jacobi SVD)
+static const int SVD_RAND_OVERSAMPLE=10;  //oversampling of the randomized range finder
+static const size_t SVD_RAND_BLOCK=32;    //initial sketch rank of the randomized range finder without a rank limit (doubled until sufficient)
+static const int SVD_RAND_POWER_ITER=2;   //number of power iterations of the randomized range finder
+static const int SVD_JACOBI_MAX_SWEEPS=64; //max number of one-sided Jacobi sweeps
+static const size_t QR_ROW_BLOCK=1024;     //row block size of the tall-skinny QR (unit of thread parallelism)
+static const size_t TENS_TILE_VOLUME=32768; //default tile volume of tile-parallel user-defined tensor initialization
+static const size_t DATA_XFER_PAGE=4096;   //data import/export chunks are aligned to memory pages (first-touch NUMA placement)
+static const size_t DATA_XFER_NT_MIN=(size_t)(1)<<25; //min tensor body size (bytes) for non-temporal stores on data import/export
 
 //GLOBALS:
 // General:
 int talsh_on=0;             //TAL-SH initialization flag (1:initalized; 0:not)
-#ifndef NO_OMP
-static omp_nest_lock_t talsh_lock; //TAL-SH global lock for thread safety
-#endif
 clock_t talsh_begin_time;   //TAL-SH begin time (zero time reference)
 // Accelerator configuration:
 int talsh_gpu_beg;          //first Nvidia GPU in the assigned range
@@ -80,16 +107,96 @@ int talsh_cpu=DEV_OFF;                      //current CPU status: {DEV_OFF,DEV_O
 int talsh_gpu[MAX_GPUS_PER_NODE]={DEV_OFF}; //current GPU status: {DEV_OFF,DEV_ON,DEV_ON_BLAS}
 int talsh_mic[MAX_MICS_PER_NODE]={DEV_OFF}; //current MIC status: {DEV_OFF,DEV_ON,DEV_ON_BLAS}
 int talsh_amd[MAX_AMDS_PER_NODE]={DEV_OFF}; //current AMD status: {DEV_OFF,DEV_ON,DEV_ON_BLAS}
+// Host argument buffer defragmentation:
+static int talsh_hab_auto_defrag=1; //automatic defragmentation of the Host argument buffer on tensor construction (0:off)
+// Native small-tensor Host path:
+static size_t talsh_small_volume=TALSH_SMALL_TENSOR_VOLUME; //max tensor volume processed natively on Host (0:off)
+// Complex GEMM formulation on split-complex panels (Host slice kernels):
+static int talsh_cgemm_mode=TALSH_CGEMM_4M;
+// Split-complex storage layout of Host images (number of tensors currently stored split):
+static std::atomic<int> talsh_num_split(0);
+// NaN/Inf screening of Host tensor operations:
+static int talsh_nonfinite_check=NOPE;
+// Autotuning of Host tensor contractions:
+static int talsh_autotune=NOPE;       //autotuning switch
+static std::string talsh_autotune_db; //autotuning database file (empty: none)
 // Failure statistics:
-unsigned long long int not_clean_count=0LL; //number of times a NOT_CLEAN status was returned (possible indication of a memory leak)
+std::atomic<unsigned long long> not_clean_count(0ULL); //number of times a NOT_CLEAN status was returned (possible indication of a memory leak)
 
 //INTERNAL TYPES:
+// Tensors pinned by a Host operation (their body images are not relocated in the Host argument buffer):
+typedef struct{
+ int num_pinned;                                 //number of pinned tensors
+ const talsh_tens_t * tens[MAX_TENSOR_OPERANDS]; //pinned tensors
+ unsigned long long serial[MAX_TENSOR_OPERANDS]; //registration serial numbers of the pinned tensors
+} talsh_tens_pins_t;
 // Host task:
 typedef struct{
- int task_error; //task error code (-1:empty or in progress; 0:success; >0:error code)
+ std::atomic<int> task_error; //task error code (-1:empty or in progress; 0:success; >0:error code), set asynchronously by data transfers
  int host_id;    //-1:uninitialized (empty task); 0:initialized (non-empty)
  unsigned int coherence; //coherence control value
+ talsh_tens_pins_t pins; //tensor arguments pinned until the Host task is destroyed
+ std::atomic<std::thread*> worker; //asynchronous data transfer thread (NULL: none), joined once the task is over
 } host_task_t;
+// Object pools:
+enum{
+ TALSH_POOL_TASK,      //talsh_task_t
+ TALSH_POOL_HOST_TASK, //host_task_t
+ TALSH_POOL_TENS,      //talsh_tens_t
+ TALSH_POOL_TENS_IMG,  //talsh_tens_t image arrays {dev_rsc,data_kind,avail}
+ TALSH_POOL_TENS_OP,   //talsh_tens_op_t
+ TALSH_NUM_POOLS
+};
+// Tensor decomposition kinds:
+enum{
+ TALSH_DECOMP_SVD,       //full SVD via the device runtime
+ TALSH_DECOMP_SVD_TRUNC, //truncated SVD (native Host path)
+ TALSH_DECOMP_QR         //thin QR (native Host path)
+};
+
+// Registered tensor (registry entry):
+typedef struct{
+ int body_exposed; //non-zero if the tensor body has been exposed via a direct pointer (not relocatable)
+ int pin_count;    //number of Host operations currently using the tensor body (pinned bodies are not relocatable)
+ unsigned long long serial; //registration serial number (distinguishes tensors constructed at the same address)
+ void * map_addr;  //base address of the memory-mapped file holding the tensor body (NULL: none)
+ size_t map_size;  //size of the memory-mapped region in bytes
+ void * zip_data;  //compressed tensor body (NULL: not compressed), the tensor has no body images while compressed
+ size_t zip_size;  //size of the compressed tensor body in bytes
+ int zip_kind;     //data kind of the compressed tensor body
+ int cplx_split;   //YEP if the Host image #0 of the complex tensor is stored in the split-complex layout
+} talsh_tens_reg_t;
+
+// Registry of constructed tensors (sharded by the tensor address, each shard has its own lock,
+// such that threads constructing/destructing disjoint tensors do not serialize on a global lock).
+// Lock ordering: The Host argument buffer relocator (talsh_hab_relocator) is called with the
+// memory manager lock held and locks one registry shard, thus no registry shard lock may be held
+// while (de)allocating argument buffer entries. Bodies pinned in the registry by Host operations
+// are never relocated, hence their pointers may be used without holding any lock:
+typedef struct{
+#ifndef NO_OMP
+ omp_nest_lock_t lock; //shard lock
+#endif
+ std::unordered_map<const talsh_tens_t*,talsh_tens_reg_t> entries; //registry entries
+} talsh_tens_reg_shard_t;
+static talsh_tens_reg_shard_t talsh_tens_registry[TENS_REGISTRY_SHARDS];
+// Owners of the Host argument buffer entries holding tensor body images (reverse map of the registry):
+// Filled when a registered tensor acquires a body image in the Host argument buffer and cleared when
+// the image is released. Its lock is innermost: No other lock may be acquired while holding it.
+static std::mutex talsh_hab_owners_lock;
+static std::unordered_map<int,const talsh_tens_t*> talsh_hab_owners; //buffer entry number --> owning tensor
+
+// Host tasks running an asynchronous data transfer thread (joined on runtime shutdown at the latest):
+static std::mutex talsh_xfer_lock;
+static std::unordered_set<host_task_t*> talsh_xfer_tasks;
+
+// Autotuned Host tensor contraction plan (autotuning table entry):
+typedef struct{
+ int strategy; //tuned contraction strategy TALSH_HOST_CTR_XXX (-1: candidates are still being timed)
+ int trials;   //number of candidate strategies timed so far
+ double time[TALSH_HOST_CTR_STRATEGIES]; //measured execution time of each candidate strategy (s)
+} talsh_autotune_entry_t;
+static std::unordered_map<std::string,talsh_autotune_entry_t> talsh_autotune_table; //autotuning table (key: contraction plan)
 
 //PROTOTYPES OF IMPORTED FUNCTIONS:
 extern "C"{
@@ -103,8 +210,13 @@ int cpu_tensor_block_add(const int * contr_ptrn, void * lftr, void * dftr,
                          double scale_real, double scale_imag, int arg_conj);
 int cpu_tensor_block_contract(const int * contr_ptrn, void * lftr, void * rftr, void * dftr,
                               double scale_real, double scale_imag, int arg_conj, int accumulative);
+int cpu_tensor_block_contract_algs(const int * contr_ptrn, void * lftr, void * rftr, void * dftr,
+                                   double scale_real, double scale_imag, int arg_conj, int accumulative,
+                                   int trn_alg, int mm_alg);
 int cpu_tensor_block_decompose_svd(const char absorb, void * dftr, void * lftr, void * rftr, void * sftr);
 int cpu_print_stats();
+void cpu_set_algorithms(int trn_alg, int mm_alg);
+void cpu_get_algorithms(int * trn_alg, int * mm_alg);
 // Contraction pattern conversion:
 int talsh_get_contr_ptrn_str2dig(const char * c_str, int * dig_ptrn,
                                  int * drank, int * lrank, int * rrank, int * conj_bits);
@@ -119,7 +231,7 @@ extern "C"{
 // Error counters:
 static void talsh_raise_not_clean();
 // Tensor body image info (exported to talshf.F90):
-int talsh_tensor_image_info(const talsh_tens_t * talsh_tens, //in: TAL-SH tensor block
+int talsh_tensor_image_info(talsh_tens_t * talsh_tens,       //inout: TAL-SH tensor block (the interleaved layout is restored)
                             int image_id,                    //in: tensor body image id
                             int * dev_id,                    //out: flat device id where the image resides
                             int * data_kind,                 //out: data kind of the image
@@ -138,28 +250,152 @@ static int host_task_record(host_task_t * host_task, unsigned int coh_ctrl, unsi
 static int host_task_status(host_task_t * host_task);
 static int host_task_error_code(const host_task_t * host_task);
 static int host_task_destroy(host_task_t * host_task);
+static void host_task_join(host_task_t * host_task);
+static void host_task_join_all();
 static void host_task_print(const host_task_t * host_task);
 // C tensor block aliasing:
-static int talsh_tensor_c_assoc(const talsh_tens_t * talsh_tens, int image_id, tensBlck_t ** tensC);
+static int talsh_tensor_c_assoc(talsh_tens_t * talsh_tens, int image_id, tensBlck_t ** tensC);
 static int talsh_tensor_c_dissoc(tensBlck_t * tensC);
+// Registry of constructed tensors (used for relocating tensor bodies in the Host argument buffer):
+static void talsh_tensor_register(const talsh_tens_t * talsh_tens);
+static void talsh_tensor_unregister(const talsh_tens_t * talsh_tens, talsh_tens_reg_t * reg_entry = NULL);
+static void talsh_tensor_expose_body(const talsh_tens_t * talsh_tens);
+static void talsh_tensor_hab_own(const talsh_tens_t * talsh_tens);
+static void talsh_tensor_hab_disown(const talsh_tens_t * talsh_tens, int image_id);
+int talsh_tensor_pin(const talsh_tens_t * talsh_tens, unsigned long long * serial); //also used by talsh_io.cpp
+void talsh_tensor_unpin(const talsh_tens_t * talsh_tens, unsigned long long serial); //also used by talsh_io.cpp
+static void talsh_tensor_pins_clean(talsh_tens_pins_t * pins);
+static void talsh_tensor_pins_add(talsh_tens_pins_t * pins, const talsh_tens_t * talsh_tens);
+static void talsh_tensor_pins_release(talsh_tens_pins_t * pins);
+static int talsh_hab_relocator(int dev_id, int entry_num, int action);
+// Compressed tensor bodies:
+static int talsh_tensor_is_compressed(const talsh_tens_t * talsh_tens, size_t * zip_size = NULL, int * zip_kind = NULL);
+static int talsh_tensor_inflate(talsh_tens_t * talsh_tens);
+// Split-complex storage layout of Host images:
+static int talsh_tensor_is_split(const talsh_tens_t * talsh_tens);
+static int talsh_tensor_complex_convert(talsh_tens_t * talsh_tens, int layout);
+int talsh_tensor_interleave(talsh_tens_t * talsh_tens); //also used by talsh_io.cpp
 // Additional TAL-SH tensor API:
 static int talshTensorIsHealthy(const talsh_tens_t * talsh_tens);
+// Native small-tensor Host path (bypasses <tensor_block_t> association):
+static int talsh_small_op_ok(const talsh_tens_t * dtens, int dimg, const talsh_tens_t * ltens, int limg,
+                             const talsh_tens_t * rtens, int rimg, int conj_bits, double scale_imag);
+static int talsh_small_tensor_contract(const int * contr_ptrn, talsh_tens_t * dtens, talsh_tens_t * ltens, int limg,
+                                       talsh_tens_t * rtens, int rimg, double scale_real, double scale_imag,
+                                       int conj_bits, int accumulative, int * nonfinite = NULL);
+static int talsh_op_nonfinite(int dflag, const talsh_tens_t * dtens, const talsh_tens_t * ltens, int limg,
+                              const talsh_tens_t * rtens, int rimg);
+static int talsh_small_tensor_scale(talsh_tens_t * dtens, double scale_real, double scale_imag);
+// Native split-complex Host path (operands stay in the split-complex layout):
+static int talsh_split_op_ok(const int * contr_ptrn, const talsh_tens_t * dtens, int dimg, const talsh_tens_t * ltens, int limg,
+                             const talsh_tens_t * rtens, int rimg, int conj_bits);
+static int talsh_split_tensor_elementwise(const int * contr_ptrn, talsh_tens_t * dtens, talsh_tens_t * ltens, int limg,
+                                          talsh_tens_t * rtens, int rimg, double scale_real, double scale_imag,
+                                          int conj_bits, int accumulative);
+static int talsh_split_tensor_scale(talsh_tens_t * dtens, double scale_real, double scale_imag);
+// Native truncated SVD and QR on Host:
+static int talsh_tensor_svd_trunc(talsh_tens_t * dtens, int dimg, int nlu, talsh_tens_t * ltens, talsh_tens_t * rtens,
+                                  talsh_tens_t * stens, const char absorb, int max_rank, double rel_threshold,
+                                  int * achieved_rank, double * discarded_weight);
+static int talsh_tensor_qr(talsh_tens_t * dtens, int dimg, int nlu, talsh_tens_t * qtens, talsh_tens_t * rtens);
+// Zero-copy operations on tensor slice views residing on Host:
+static int talsh_tensor_host_image(const talsh_tens_t * tens, int * data_kind);
+static int talsh_tensor_slice_op(const char * cptrn, talsh_tens_slice_t * dslice, const talsh_tens_slice_t * lslice,
+                                 const talsh_tens_slice_t * rslice, double scale_real, double scale_imag, int accumulative,
+                                 int * nonfinite = NULL);
+static int talsh_tens_op_zero_copy_ok(const talsh_tens_op_t * tens_op);
+// Autotuning of Host tensor contractions:
+static std::string talsh_autotune_key(const int * contr_ptrn, int conj_bits, int data_kind,
+                                      const talsh_tens_t * ltens, const talsh_tens_t * rtens);
+static int talsh_autotune_candidates(int drank, int conj_bits, int data_kind, double scale_imag, int * cand);
+static int talsh_autotune_select(const std::string & key, int ncand, const int * cand, int * trial);
+static void talsh_autotune_record(const std::string & key, int ncand, const int * cand, int strategy, double exec_time);
+static int talsh_autotune_load(const char * db_file);
+static int talsh_host_tensor_contract_slice(const int * contr_ptrn, talsh_tens_t * dtens, talsh_tens_t * ltens, int limg,
+                                            talsh_tens_t * rtens, int rimg, double scale_real, double scale_imag,
+                                            int conj_bits, int accumulative, int * nonfinite);
+static int talsh_host_tensor_contract_tuned(const int * contr_ptrn, talsh_tens_t * dtens, void * dftr,
+                                            talsh_tens_t * ltens, int limg, void * lftr,
+                                            talsh_tens_t * rtens, int rimg, void * rftr,
+                                            double scale_real, double scale_imag, int conj_bits, int accumulative,
+                                            int * nonfinite);
+// Parallel tensor data import/export:
+static int talsh_tensor_data_transfer(talsh_tens_t * tens_block, int data_kind, void * ext_data,
+                                      int import, talsh_task_t * talsh_task);
+static int talsh_tensor_decompose(int decomp_kind, const char * cptrn, talsh_tens_t * dtens, talsh_tens_t * ltens,
+                                  talsh_tens_t * rtens, talsh_tens_t * stens, const char absorb, int max_rank,
+                                  double rel_threshold, int * achieved_rank, double * discarded_weight, int dev_id, int dev_kind);
+// Tensor operation dispatchers (symbolic or digital pattern):
+static int talsh_contr_ptrn_get(const char * cptrn, const talsh_contr_ptrn_t * dig_ptrn, int * contr_ptrn,
+                                int * drank, int * lrank, int * rrank, int * conj_bits);
+static void talsh_contr_ptrn_print(const char * cptrn, const talsh_contr_ptrn_t * dig_ptrn);
+static int talsh_tensor_copy(const char * cptrn, const talsh_contr_ptrn_t * dig_ptrn, talsh_tens_t * dtens, talsh_tens_t * ltens,
+                             int dev_id, int dev_kind, int copy_ctrl, talsh_task_t * talsh_task);
+static int talsh_tensor_add(const char * cptrn, const talsh_contr_ptrn_t * dig_ptrn, talsh_tens_t * dtens, talsh_tens_t * ltens,
+                            double scale_real, double scale_imag, int dev_id, int dev_kind, int copy_ctrl, talsh_task_t * talsh_task);
+static int talsh_tensor_contract(const char * cptrn, const talsh_contr_ptrn_t * dig_ptrn,
+                                 talsh_tens_t * dtens, talsh_tens_t * ltens, talsh_tens_t * rtens,
+                                 double scale_real, double scale_imag, int dev_id, int dev_kind,
+                                 int copy_ctrl, int accumulative, talsh_task_t * talsh_task);
 // Additional TAL-SH task API:
 static int talshTaskConstruct(talsh_task_t * talsh_task, int dev_kind, int coh_ctrl, int data_kind = NO_TYPE);
 static int talshTaskSetArg(talsh_task_t * talsh_task, talsh_tens_t * talsh_tens_p, int image_id);
 static int talshTaskFinalize(talsh_task_t * talsh_task, int task_status);
 }
 
+// Split-complex layout conversions:
+template <typename R>
+static void talsh_complex_split(size_t vol, const std::complex<R> * cbody, R * rbody, R * ibody);
+template <typename R>
+static void talsh_complex_merge(size_t vol, std::complex<R> * cbody, const R * rbody, const R * ibody);
+template <typename R>
+static void talsh_complex_relayout(size_t vol, void * body, void * temp, int split);
+
 //INTERNAL FUNCTIONS:
 // Error counters:
 static void talsh_raise_not_clean(){++not_clean_count;}
 
+// Object pools:
+static obj_pool_t * talsh_obj_pool(int pool_kind)
+/** Returns the object pool of a given kind, constructed on first use. The pools live until
+    program termination since TAL-SH objects may be created before talshInit() and destroyed
+    after talshShutdown(). Steady-state creation/destruction of pooled objects causes no heap traffic. **/
+{
+ static obj_pool_t pools[TALSH_NUM_POOLS];
+ static const int ready =
+  obj_pool_construct(&(pools[TALSH_POOL_TASK]),sizeof(talsh_task_t),OBJ_POOL_SIZE) +
+  obj_pool_construct(&(pools[TALSH_POOL_HOST_TASK]),sizeof(host_task_t),OBJ_POOL_SIZE) +
+  obj_pool_construct(&(pools[TALSH_POOL_TENS]),sizeof(talsh_tens_t),OBJ_POOL_SIZE) +
+  obj_pool_construct(&(pools[TALSH_POOL_TENS_IMG]),TALSH_MAX_DEV_PRESENT*(sizeof(talsh_dev_rsc_t)+2*sizeof(int)),OBJ_POOL_SIZE) +
+  obj_pool_construct(&(pools[TALSH_POOL_TENS_OP]),sizeof(talsh_tens_op_t),OBJ_POOL_SIZE/4);
+ (void)ready;
+ return &(pools[pool_kind]);
+}
+
+static void talsh_obj_pool_print_stats()
+/** Prints the usage counters of the object pools. **/
+{
+ static const char * pool_name[TALSH_NUM_POOLS]={"talsh_task_t","host_task_t","talsh_tens_t","tensor images","talsh_tens_op_t"};
+ unsigned long long pool_gets,heap_gets;
+ long long num_used;
+
+ printf("\nTAL-SH: Object pools (pooled allocations / heap allocations / in use):\n");
+ for(int i=0;i<TALSH_NUM_POOLS;++i){
+  if(obj_pool_get_stats(talsh_obj_pool(i),&pool_gets,&heap_gets,&num_used) == 0)
+   printf(" %-16s: %llu / %llu / %lld\n",pool_name[i],pool_gets,heap_gets,num_used);
+ }
+ if(tensShape_pool_stats(0,&pool_gets,&heap_gets,&num_used) == 0)
+  printf(" %-16s: %llu / %llu / %lld\n","tensor shapes",pool_gets,heap_gets,num_used);
+ if(tensShape_pool_stats(1,&pool_gets,&heap_gets,&num_used) == 0)
+  printf(" %-16s: %llu / %llu / %lld\n","shape indices",pool_gets,heap_gets,num_used);
+ return;
+}
+
 // Host task API:
 static int host_task_create(host_task_t ** host_task)
 /** Creates an empty (clean) Host task. **/
 {
- *host_task=(host_task_t*)malloc(sizeof(host_task_t));
- if(*host_task == NULL) return TRY_LATER;
+ if(obj_pool_get(talsh_obj_pool(TALSH_POOL_HOST_TASK),(void**)host_task) != 0){*host_task=NULL; return TRY_LATER;}
  return host_task_clean(*host_task);
 }
 
@@ -168,6 +404,8 @@ static int host_task_clean(host_task_t * host_task)
  if(host_task == NULL) return TALSH_INVALID_ARGS;
  host_task->task_error=-1;
  host_task->host_id=-1;
+ host_task->worker=NULL;
+ talsh_tensor_pins_clean(&(host_task->pins));
  return TALSH_SUCCESS;
 }
 
@@ -204,6 +442,7 @@ static int host_task_status(host_task_t * host_task)
  if(host_task == NULL) return TALSH_INVALID_ARGS;
  errc=host_task_is_empty(host_task);
  if(errc == NOPE){
+  if(host_task->task_error >= 0) host_task_join(host_task); //the data transfer thread (if any) is done
   if(host_task->task_error == 0){
    return TALSH_TASK_COMPLETED;
   }else if(host_task->task_error > 0){
@@ -223,17 +462,50 @@ static int host_task_error_code(const host_task_t * host_task)
 static int host_task_destroy(host_task_t * host_task)
 {
  if(host_task == NULL) return TALSH_INVALID_ARGS;
- free(host_task);
+ host_task_join(host_task);
+ talsh_tensor_pins_release(&(host_task->pins));
+ if(obj_pool_release(talsh_obj_pool(TALSH_POOL_HOST_TASK),host_task) != 0) return TALSH_FAILURE;
  return TALSH_SUCCESS;
 }
 
+static void host_task_join(host_task_t * host_task)
+/** Joins the asynchronous data transfer thread of a Host task (no action if none). **/
+{
+ std::thread * worker=host_task->worker.exchange(NULL);
+ if(worker != NULL){
+  {std::lock_guard<std::mutex> guard(talsh_xfer_lock); talsh_xfer_tasks.erase(host_task);}
+  if(worker->joinable()) worker->join();
+  delete worker;
+ }
+ return;
+}
+
+static void host_task_join_all()
+/** Joins the data transfer threads of all Host tasks (runtime shutdown). **/
+{
+ std::vector<std::thread*> workers;
+ {
+  std::lock_guard<std::mutex> guard(talsh_xfer_lock);
+  for(auto host_task: talsh_xfer_tasks){
+   std::thread * worker=host_task->worker.exchange(NULL);
+   if(worker != NULL) workers.push_back(worker);
+  }
+  talsh_xfer_tasks.clear();
+ }
+ for(auto worker: workers){
+  if(worker->joinable()) worker->join();
+  delete worker;
+ }
+ return;
+}
+
 static void host_task_print(const host_task_t * host_task)
 /** Prints Host task info. **/
 {
 #pragma omp flush
  if(host_task != NULL){
   printf("#MESSAGE: Printing Host task info:\n");
-  printf(" Host task status       : %d\n",host_task->task_error);
+  printf(" Host task status       : %d\n",host_task->task_error.load());
   printf(" Host task device id    : %d\n",host_task->host_id);
   printf(" Host task coherence_var: %u\n",host_task->coherence);
   printf("#END OF MESSAGE\n");
@@ -242,7 +514,7 @@ static void host_task_print(const host_task_t * host_task)
 }
 
 // Tensor image API:
-int talsh_tensor_image_info(const talsh_tens_t * talsh_tens, int image_id,
+int talsh_tensor_image_info(talsh_tens_t * talsh_tens, int image_id,
                             int * dev_id, int * data_kind, void ** gmem_p, int * buf_entry)
 /** Returns the information on a specific tensor body image. A return status
     TALSH_NOT_ALLOWED indicates that the image is no longer available (discarded). **/
@@ -253,6 +525,7 @@ int talsh_tensor_image_info(const talsh_tens_t * talsh_tens, int image_id,
  if(talshTensorIsEmpty(talsh_tens) != NOPE) return TALSH_OBJECT_IS_EMPTY;
  if(talshTensorIsHealthy(talsh_tens) != YEP) return TALSH_FAILURE;
  if(image_id < 0 || image_id >= talsh_tens->ndev) return TALSH_INVALID_ARGS;
+ if(talsh_tensor_interleave(talsh_tens) != TALSH_SUCCESS) return TALSH_FAILURE; //CP-TAL assumes the interleaved layout
  drsc=&(talsh_tens->dev_rsc[image_id]);
  if(tensDevRsc_is_empty(drsc) != NOPE) return TALSH_FAILURE;
  if(talsh_tens->avail[image_id] == YEP){
@@ -278,6 +551,7 @@ static int talsh_tensor_image_discard(talsh_tens_t * talsh_tens, int image_id)
  if(image_id < 0 || image_id >= talsh_tens->ndev) return TALSH_INVALID_ARGS;
  n=0; for(i=0;i<talsh_tens->ndev;++i){if(i != image_id && talsh_tens->avail[i] == YEP) ++n;}
  if(n == 0) return TALSH_NOT_ALLOWED; //at least one tensor body image must exist, otherwise just destroy the tensor
+ talsh_tensor_hab_disown(talsh_tens,image_id);
  errc=tensDevRsc_release_all(&(talsh_tens->dev_rsc[image_id]));
  if(errc != 0 && errc != NOT_CLEAN) errc=TALSH_FAILURE;
  if(image_id < talsh_tens->ndev-1){
@@ -302,6 +576,7 @@ static int talsh_tensor_image_discard_other(talsh_tens_t * talsh_tens, int image
  errc=TALSH_SUCCESS;
  for(i=0;i<talsh_tens->ndev;++i){
   if(i != image_id){
+   talsh_tensor_hab_disown(talsh_tens,i);
    j=tensDevRsc_release_all(&(talsh_tens->dev_rsc[i]));
    if(j != 0){if(j == NOT_CLEAN){if(errc == TALSH_SUCCESS) errc=j;}else{errc=TALSH_FAILURE;}}
   }else{
@@ -316,7 +591,7 @@ static int talsh_tensor_image_discard_other(talsh_tens_t * talsh_tens, int image
  return errc;
 }
 
-static int talsh_tensor_c_assoc(const talsh_tens_t * talsh_tens, //in: TAL-SH tensor
+static int talsh_tensor_c_assoc(talsh_tens_t * talsh_tens,       //inout: TAL-SH tensor (the interleaved layout is restored)
                                 int image_id,                    //in: id of the tensor body image to be used
                                 tensBlck_t ** tensC)             //out: newly created <tensBlck_t> object
 /** Creates a <tensBlck_t> object for a specific image of <talsh_tens>.
@@ -334,6 +609,7 @@ static int talsh_tensor_c_assoc(const talsh_tens_t * talsh_tens, //in: TAL-SH te
  if(talshTensorIsHealthy(talsh_tens) != YEP) return TALSH_FAILURE;
  if(image_id < 0 || image_id >= talsh_tens->ndev) return TALSH_INVALID_ARGS;
  if(tens_valid_data_kind(talsh_tens->data_kind[image_id]) != YEP) return TALSH_FAILURE;
+ errc=talsh_tensor_interleave(talsh_tens); if(errc != TALSH_SUCCESS) return errc;
  if(talsh_tens->avail[image_id] == YEP){
   src_rsc_p=&(talsh_tens->dev_rsc[image_id]);
   errc=tensBlck_create(&ctens); if(errc){if(errc != TRY_LATER) errc=TALSH_FAILURE; return errc;}
@@ -487,12 +763,352 @@ int talshDetermineOptimalDevice(const talsh_tens_t * tens0, const talsh_tens_t *
  return devid;
 }
 
+// Registry of constructed tensors:
+static talsh_tens_reg_shard_t & talsh_tensor_registry_lock(const talsh_tens_t * talsh_tens)
+/** Locks and returns the registry shard holding the entry of a given tensor. **/
+{
+ size_t h=reinterpret_cast<size_t>(talsh_tens);
+ talsh_tens_reg_shard_t & shard=talsh_tens_registry[((h>>4)^(h>>12))%TENS_REGISTRY_SHARDS];
+#ifndef NO_OMP
+ omp_set_nest_lock(&(shard.lock));
+#endif
+ return shard;
+}
+
+static void talsh_tensor_registry_unlock(talsh_tens_reg_shard_t & shard)
+/** Unlocks a registry shard. **/
+{
+#ifndef NO_OMP
+ omp_unset_nest_lock(&(shard.lock));
+#endif
+ return;
+}
+
+static void talsh_tensor_register(const talsh_tens_t * talsh_tens)
+/** Registers a newly constructed tensor. **/
+{
+ static std::atomic<unsigned long long> serial(1ULL);
+ talsh_tens_reg_shard_t & shard=talsh_tensor_registry_lock(talsh_tens);
+ talsh_tens_reg_t & reg_entry = shard.entries[talsh_tens];
+ reg_entry.body_exposed=0; reg_entry.pin_count=0; reg_entry.serial=serial.fetch_add(1ULL,std::memory_order_relaxed);
+ reg_entry.map_addr=NULL; reg_entry.map_size=0;
+ reg_entry.zip_data=NULL; reg_entry.zip_size=0; reg_entry.zip_kind=NO_TYPE;
+ reg_entry.cplx_split=NOPE;
+ talsh_tensor_registry_unlock(shard);
+ return;
+}
+
+static void talsh_tensor_unregister(const talsh_tens_t * talsh_tens, talsh_tens_reg_t * reg_entry)
+/** Unregisters a tensor being destructed. If <reg_entry> is present, the registry
+    entry of the tensor is returned there (an unregistered tensor returns a clean entry). **/
+{
+ talsh_tens_reg_shard_t & shard=talsh_tensor_registry_lock(talsh_tens);
+ auto it=shard.entries.find(talsh_tens);
+ if(reg_entry != NULL){
+  if(it != shard.entries.end()){
+   *reg_entry=it->second;
+  }else{
+   reg_entry->body_exposed=0; reg_entry->pin_count=0; reg_entry->serial=0ULL;
+   reg_entry->map_addr=NULL; reg_entry->map_size=0;
+   reg_entry->zip_data=NULL; reg_entry->zip_size=0; reg_entry->zip_kind=NO_TYPE;
+   reg_entry->cplx_split=NOPE;
+  }
+ }
+ if(it != shard.entries.end()){
+  if(it->second.cplx_split == YEP) --talsh_num_split;
+  shard.entries.erase(it);
+ }
+ talsh_tensor_registry_unlock(shard);
+ return;
+}
+
+static void talsh_tensor_expose_body(const talsh_tens_t * talsh_tens)
+/** Marks the body of a registered tensor as exposed to the user via a direct pointer,
+    thus prohibiting its relocation for the rest of the tensor lifetime. **/
+{
+ talsh_tens_reg_shard_t & shard=talsh_tensor_registry_lock(talsh_tens);
+ auto it=shard.entries.find(talsh_tens);
+ if(it != shard.entries.end()) it->second.body_exposed=1;
+ talsh_tensor_registry_unlock(shard);
+ return;
+}
+
+static void talsh_tensor_hab_own(const talsh_tens_t * talsh_tens)
+/** Records a tensor as the owner of the Host argument buffer entries holding its body images. **/
+{
+ const int host_id=talshFlatDevId(DEV_HOST,0);
+ std::lock_guard<std::mutex> guard(talsh_hab_owners_lock);
+ for(int i=0;i<talsh_tens->ndev;++i){
+  const talsh_dev_rsc_t & drsc=talsh_tens->dev_rsc[i];
+  if(drsc.dev_id == host_id && drsc.buf_entry >= 0 && drsc.mem_attached == 0) talsh_hab_owners[drsc.buf_entry]=talsh_tens;
+ }
+ return;
+}
+
+static void talsh_tensor_hab_disown(const talsh_tens_t * talsh_tens, int image_id)
+/** Forgets the owner of the Host argument buffer entry holding a tensor body image about to be released. **/
+{
+ const talsh_dev_rsc_t & drsc=talsh_tens->dev_rsc[image_id];
+ if(drsc.dev_id != talshFlatDevId(DEV_HOST,0) || drsc.buf_entry < 0) return;
+ std::lock_guard<std::mutex> guard(talsh_hab_owners_lock);
+ auto it=talsh_hab_owners.find(drsc.buf_entry);
+ if(it != talsh_hab_owners.end() && it->second == talsh_tens) talsh_hab_owners.erase(it);
+ return;
+}
+
+int talsh_tensor_pin(const talsh_tens_t * talsh_tens, unsigned long long * serial)
+/** Pins the body images of a registered tensor for the duration of a Host operation using them:
+    A pinned body image is not relocated by the defragmentation of the Host argument buffer.
+    Since the relocator holds the registry shard lock while moving a body image, the body
+    pointers read after pinning stay valid until the tensor is unpinned. Returns YEP if pinned
+    (<serial> identifies the registered tensor for talsh_tensor_unpin()), NOPE otherwise. **/
+{
+ int res=NOPE;
+ talsh_tens_reg_shard_t & shard=talsh_tensor_registry_lock(talsh_tens);
+ auto it=shard.entries.find(talsh_tens);
+ if(it != shard.entries.end()){++(it->second.pin_count); *serial=it->second.serial; res=YEP;}
+ talsh_tensor_registry_unlock(shard);
+ return res;
+}
+
+void talsh_tensor_unpin(const talsh_tens_t * talsh_tens, unsigned long long serial)
+/** Unpins the body images of a tensor pinned by talsh_tensor_pin(). No action
+    if the tensor has been destructed meanwhile (serial number mismatch). **/
+{
+ talsh_tens_reg_shard_t & shard=talsh_tensor_registry_lock(talsh_tens);
+ auto it=shard.entries.find(talsh_tens);
+ if(it != shard.entries.end()){
+  if(it->second.serial == serial && it->second.pin_count > 0) --(it->second.pin_count);
+ }
+ talsh_tensor_registry_unlock(shard);
+ return;
+}
+
+static void talsh_tensor_pins_clean(talsh_tens_pins_t * pins)
+{
+ pins->num_pinned=0;
+ return;
+}
+
+static void talsh_tensor_pins_add(talsh_tens_pins_t * pins, const talsh_tens_t * talsh_tens)
+/** Pins a tensor and records it in a list of pinned tensors (unregistered tensors are skipped). **/
+{
+ unsigned long long serial;
+
+ if(pins->num_pinned >= MAX_TENSOR_OPERANDS) return;
+ if(talsh_tensor_pin(talsh_tens,&serial) == YEP){
+  pins->tens[pins->num_pinned]=talsh_tens; pins->serial[pins->num_pinned]=serial; ++(pins->num_pinned);
+ }
+ return;
+}
+
+static void talsh_tensor_pins_release(talsh_tens_pins_t * pins)
+/** Unpins all tensors recorded in a list of pinned tensors. **/
+{
+ for(int i=0;i<pins->num_pinned;++i) talsh_tensor_unpin(pins->tens[i],pins->serial[i]);
+ pins->num_pinned=0;
+ return;
+}
+
+static int talsh_hab_relocator(int dev_id, int entry_num, int action)
+/** Relocator of Host argument buffer entries occupied by tensor bodies (see arg_buf_defrag_host()).
+    Only the body images owned by registered tensors which are neither in use, nor pinned by
+    a Host operation (inputs included), nor exposed via a direct body pointer, are relocatable.
+    In case GPU tasks are still in flight, no image is relocatable since their Host-side data
+    transfers may still be pending. The owning tensor is looked up in the reverse map of the
+    registry. Action 0 returns YEP/NOPE (relocatable or not), action 1 relocates the tensor
+    body image (0:success). **/
+{
+ int i,dks,errc;
+ size_t tsize;
+ talsh_tens_t * tens;
+ talsh_tens_reg_shard_t * shard;
+ talsh_dev_rsc_t drsc;
+ bool found;
+
+ errc=NOPE; tens=NULL; i=-1; shard=NULL; found=false;
+#ifndef NO_GPU
+ if(gpu_tasks_in_flight() == 0){
+#endif
+  if(dev_id == talshFlatDevId(DEV_HOST,0)){
+   {std::lock_guard<std::mutex> guard(talsh_hab_owners_lock);
+    auto own=talsh_hab_owners.find(entry_num);
+    if(own != talsh_hab_owners.end()) tens=(talsh_tens_t*)(own->second);
+   }
+   if(tens != NULL){ //the shard owning the tensor stays locked until the relocation
+    shard=&(talsh_tensor_registry_lock(tens)); found=true;
+    auto reg=shard->entries.find(tens); //the owner could have been destructed meanwhile
+    if(reg != shard->entries.end()){
+     for(i=0;i<tens->ndev;++i){
+      if(tens->dev_rsc[i].dev_id == dev_id && tens->dev_rsc[i].buf_entry == entry_num) break;
+     }
+     if(i < tens->ndev){
+      if(reg->second.body_exposed == 0 && reg->second.pin_count == 0 &&
+         tens->dev_rsc[i].mem_attached == 0 && talshTensorInUse(tens) == NOPE) errc=YEP;
+     }
+    }
+   }
+  }
+#ifndef NO_GPU
+ }
+#endif
+ if(action != 0){
+  if(errc == YEP){
+   errc=TALSH_FAILURE;
+   if(tens_valid_data_kind(tens->data_kind[i],&dks) == YEP){
+    tsize=talshTensorVolume(tens)*dks;
+    if(tensDevRsc_clean(&drsc) == 0){
+     errc=tensDevRsc_allocate_mem(&drsc,dev_id,tsize,YEP);
+     if(errc == 0){
+      memcpy(drsc.gmem_p,tens->dev_rsc[i].gmem_p,tsize);
+      talsh_tensor_hab_disown(tens,i);
+      errc=tensDevRsc_release_all(&(tens->dev_rsc[i]));
+      tens->dev_rsc[i]=drsc;
+      talsh_tensor_hab_own(tens);
+      if(errc == NOT_CLEAN){talsh_raise_not_clean(); errc=0;}
+     }
+    }
+   }
+  }else{
+   errc=TALSH_NOT_ALLOWED;
+  }
+ }
+ if(found) talsh_tensor_registry_unlock(*shard);
+ return errc;
+}
+
+static int talsh_tensor_is_compressed(const talsh_tens_t * talsh_tens, size_t * zip_size, int * zip_kind)
+/** Returns YEP if the tensor body is currently compressed (see talshTensorCompress()), NOPE otherwise.
+    Only a tensor without body images can be compressed, thus other tensors are not looked up. **/
+{
+ int res;
+
+ res=NOPE; if(zip_size != NULL) *zip_size=0; if(zip_kind != NULL) *zip_kind=NO_TYPE;
+ if(talsh_tens->ndev != 0 || talsh_tens->shape_p == NULL) return res;
+ talsh_tens_reg_shard_t & shard=talsh_tensor_registry_lock(talsh_tens);
+ auto it=shard.entries.find(talsh_tens);
+ if(it != shard.entries.end()){
+  if(it->second.zip_data != NULL){
+   res=YEP;
+   if(zip_size != NULL) *zip_size=it->second.zip_size;
+   if(zip_kind != NULL) *zip_kind=it->second.zip_kind;
+  }
+ }
+ talsh_tensor_registry_unlock(shard);
+ return res;
+}
+
+static int talsh_tensor_inflate(talsh_tens_t * talsh_tens)
+/** Decompresses a compressed tensor body into a new Host image (no action for uncompressed tensors).
+    The Host image is allocated in the Host argument buffer, falling back to regular Host memory. **/
+{
+ int errc,dks,host_id,zip_kind;
+ size_t tsize,zip_size;
+ void * zip_data;
+
+ if(talsh_tens->ndev != 0 || talsh_tens->shape_p == NULL || talsh_tens->dev_rsc == NULL) return TALSH_SUCCESS;
+ zip_data=NULL; zip_size=0; zip_kind=NO_TYPE;
+ talsh_tens_reg_shard_t & shard=talsh_tensor_registry_lock(talsh_tens);
+ auto it=shard.entries.find(talsh_tens);
+ if(it != shard.entries.end()){zip_data=it->second.zip_data; zip_size=it->second.zip_size; zip_kind=it->second.zip_kind;}
+ talsh_tensor_registry_unlock(shard);
+ if(zip_data == NULL) return TALSH_SUCCESS;
+ if(tens_valid_data_kind(zip_kind,&dks) != YEP) return TALSH_FAILURE;
+ tsize=talshTensorVolume(talsh_tens)*dks;
+ host_id=talshFlatDevId(DEV_HOST,0);
+ errc=tensDevRsc_allocate_mem(&(talsh_tens->dev_rsc[0]),host_id,tsize,YEP);
+ if(errc == TRY_LATER && talsh_hab_auto_defrag != 0){
+  if(arg_buf_defrag_host(tsize) == 0) errc=tensDevRsc_allocate_mem(&(talsh_tens->dev_rsc[0]),host_id,tsize,YEP);
+ }
+ if(errc != 0) errc=tensDevRsc_allocate_mem(&(talsh_tens->dev_rsc[0]),host_id,tsize,NOPE); //regular Host memory
+ if(errc != 0) return TRY_LATER;
+ errc=talsh_body_decompress(zip_data,zip_size,talsh_tens->dev_rsc[0].gmem_p,tsize);
+ if(errc != 0){
+  errc=tensDevRsc_release_all(&(talsh_tens->dev_rsc[0]));
+  if(VERBOSE) printf("#ERROR(talsh_tensor_inflate): Corrupted compressed tensor body\n");
+  return TALSH_OBJECT_BROKEN;
+ }
+ talsh_tens->data_kind[0]=zip_kind; talsh_tens->avail[0]=YEP; talsh_tens->ndev=1;
+ talsh_tensor_hab_own(talsh_tens);
+ talsh_tens_reg_shard_t & shard_upd=talsh_tensor_registry_lock(talsh_tens);
+ it=shard_upd.entries.find(talsh_tens);
+ if(it != shard_upd.entries.end()){it->second.zip_data=NULL; it->second.zip_size=0; it->second.zip_kind=NO_TYPE;}
+ talsh_tensor_registry_unlock(shard_upd);
+ free(zip_data);
+ return TALSH_SUCCESS;
+}
+
+static int talsh_tensor_is_split(const talsh_tens_t * talsh_tens)
+/** Returns YEP if the Host image of the tensor is stored in the split-complex layout, NOPE otherwise. **/
+{
+ int res=NOPE;
+
+ if(talsh_num_split.load() == 0) return res; //no split tensors at all
+ talsh_tens_reg_shard_t & shard=talsh_tensor_registry_lock(talsh_tens);
+ auto it=shard.entries.find(talsh_tens);
+ if(it != shard.entries.end()) res=it->second.cplx_split;
+ talsh_tensor_registry_unlock(shard);
+ return res;
+}
+
+static int talsh_tensor_complex_convert(talsh_tens_t * talsh_tens, int layout)
+/** Converts the Host image #0 of a registered complex tensor (C4/C8) into the given storage
+    layout TALSH_CPLX_XXX in place. The split-complex layout (all real parts followed by all
+    imaginary parts) requires the Host image to be the only tensor body image. **/
+{
+ int errc,dks,split;
+ size_t tsize;
+ void * temp;
+
+ split=((layout == TALSH_CPLX_SPLIT)?YEP:NOPE);
+ errc=((split == YEP)?TALSH_FAILURE:TALSH_SUCCESS); //unregistered tensors are interleaved
+ talsh_tens_reg_shard_t & shard=talsh_tensor_registry_lock(talsh_tens);
+ auto it=shard.entries.find(talsh_tens);
+ if(it != shard.entries.end()){
+  errc=TALSH_SUCCESS;
+  if(it->second.cplx_split != split){
+   errc=TALSH_NOT_ALLOWED;
+   if(talsh_tens->ndev == 1 && talsh_tens->dev_rsc[0].dev_id == talshFlatDevId(DEV_HOST,0) &&
+      (talsh_tens->data_kind[0] == C4 || talsh_tens->data_kind[0] == C8)){
+    errc=TRY_LATER;
+    if(tens_valid_data_kind(talsh_tens->data_kind[0],&dks) == YEP){
+     tsize=talshTensorVolume(talsh_tens)*dks;
+     temp=malloc(tsize);
+     if(temp != NULL){
+      if(talsh_tens->data_kind[0] == C4){
+       talsh_complex_relayout<float>(talshTensorVolume(talsh_tens),talsh_tens->dev_rsc[0].gmem_p,temp,split);
+      }else{
+       talsh_complex_relayout<double>(talshTensorVolume(talsh_tens),talsh_tens->dev_rsc[0].gmem_p,temp,split);
+      }
+      free(temp);
+      it->second.cplx_split=split;
+      if(split == YEP){++talsh_num_split;}else{--talsh_num_split;}
+      errc=TALSH_SUCCESS;
+     }
+    }
+   }
+  }
+ }
+ talsh_tensor_registry_unlock(shard);
+ return errc;
+}
+
+int talsh_tensor_interleave(talsh_tens_t * talsh_tens)
+/** Restores the interleaved layout of a tensor body stored in the split-complex layout
+    (no action otherwise). Called by all paths accessing the tensor body other than
+    the native split-complex Host kernels. **/
+{
+ if(talsh_tensor_is_split(talsh_tens) != YEP) return TALSH_SUCCESS;
+ return talsh_tensor_complex_convert(talsh_tens,TALSH_CPLX_INTERLEAVED);
+}
+
 static int talsh_choose_image_for_device(talsh_tens_t * tens, unsigned int coh_ctrl, int * copied, int dvk, int dvn)
 /** For a given execution device <[dvk,dvn]>, chooses the most appropriate
     tensor body image to be used on that device. Priority is given to the
     same device, then to the same device kind, then to the Host. If no image
     is found in that sequence, a blocking copy will be posted to the Host,
     thus creating an additional image of the tensor body (on Host).
+    A compressed tensor body is decompressed into a Host image first.
     A negative return code indicates an error. **/
 {
  int i,image_id,host_image,dn,dk,coh;
@@ -500,6 +1116,7 @@ static int talsh_choose_image_for_device(talsh_tens_t * tens, unsigned int coh_c
  *copied=0; image_id=-1; host_image=-1;
  if(tens == NULL) return -1;
  if(talshTensorIsEmpty(tens) != NOPE) return -2;
+ if(talsh_tensor_inflate(tens) != TALSH_SUCCESS) return -8;
  if(talshTensorIsHealthy(tens) != YEP) return -3;
  for(i=0;i<tens->ndev;++i){
   if(tens->avail[i] == YEP){
@@ -612,9 +1229,29 @@ int talshInit(size_t * host_buf_size,    //inout: Host Argument Buffer size in b
  }
 #endif
  talsh_gpu_beg=gpu_beg; talsh_gpu_end=gpu_end;
+ for(i=0;i<TENS_REGISTRY_SHARDS;i++){
 #ifndef NO_OMP
- omp_init_nest_lock(&talsh_lock);
+  omp_init_nest_lock(&(talsh_tens_registry[i].lock));
 #endif
+  talsh_tens_registry[i].entries.clear();
+ }
+ talsh_hab_owners.clear();
+ i=arg_buf_set_relocator_host(&talsh_hab_relocator);
+ const char * blas_lib=getenv(TALSH_BLAS_LIB_ENV); //BLAS library to be loaded at run time
+ if(blas_lib != NULL){
+  if(blas_lib[0] != '\0'){
+   errc=talshBlasLoad(blas_lib);
+   if(errc < 0) printf("#WARNING(TALSH::talshInit): Unable to load the BLAS library %s\n",blas_lib);
+  }
+ }
+ if(cpu_blas_backend() != BLAS_BACKEND_NONE) talsh_cpu=DEV_ON_BLAS;
+ const char * autotune_db=getenv(TALSH_AUTOTUNE_DB_ENV); //autotuning database of Host tensor contractions
+ if(autotune_db != NULL){
+  if(autotune_db[0] != '\0'){
+   errc=talshSetAutotune(YEP,autotune_db);
+   if(errc != YEP && errc != NOPE) printf("#WARNING(TALSH::talshInit): Unable to load the autotuning database %s\n",autotune_db);
+  }
+ }
  talsh_on=1; talsh_begin_time=clock();
 #pragma omp flush
  return TALSH_SUCCESS;
@@ -628,6 +1265,15 @@ int talshShutdown()
 #pragma omp flush
  if(talsh_on == 0) return TALSH_NOT_INITIALIZED;
  talshSetMemAllocPolicyHost(TALSH_MEM_ALLOC_POLICY_HOST,TALSH_MEM_ALLOC_FALLBACK_HOST,&i);
+ host_task_join_all(); //pending data transfers still access the argument buffer
+ i=arg_buf_set_relocator_host(NULL);
+ for(i=0;i<TENS_REGISTRY_SHARDS;i++) talsh_tens_registry[i].entries.clear();
+ talsh_hab_owners.clear();
+ if(talsh_autotune != NOPE && !talsh_autotune_db.empty()){ //persist the tuned Host contraction plans
+  i=talshAutotuneSave(NULL);
+  if(i != TALSH_SUCCESS) printf("#WARNING(TALSH::talshShutdown): Unable to save the autotuning database %s\n",talsh_autotune_db.c_str());
+ }
+ talsh_autotune=NOPE; talsh_autotune_db.clear(); talsh_autotune_table.clear();
  errc=arg_buf_deallocate(talsh_gpu_beg,talsh_gpu_end);
  talsh_gpu_beg=0; talsh_gpu_end=-1; talsh_on=0;
  talsh_cpu=DEV_OFF;
@@ -635,7 +1281,7 @@ int talshShutdown()
  for(i=0;i<MAX_MICS_PER_NODE;i++) talsh_mic[i]=DEV_OFF;
  for(i=0;i<MAX_AMDS_PER_NODE;i++) talsh_amd[i]=DEV_OFF;
 #ifndef NO_OMP
- omp_destroy_nest_lock(&talsh_lock);
+ for(i=0;i<TENS_REGISTRY_SHARDS;i++) omp_destroy_nest_lock(&(talsh_tens_registry[i].lock));
 #endif
 #pragma omp flush
  if(errc) return TALSH_FAILURE;
@@ -983,6 +1629,161 @@ size_t talshDeviceBufferFreeSize_(int dev_num, int dev_kind) //Fortran wrapper
  return talshDeviceBufferFreeSize(dev_num,dev_kind);
 }
 
+int talshHostBufferDefrag(size_t bytes) //in: size (bytes) of a tensor body the Host argument buffer is defragmented for
+/** Defragments the Host argument buffer by relocating idle tensor bodies residing in it, such that
+    a tensor body of size <bytes> could be allocated there afterwards. A return status TRY_LATER
+    indicates that the defragmentation is currently impossible (not enough free space in total or
+    the tensor bodies occupying the chosen buffer region are in use). The bodies of the tensor
+    arguments of Host operations are pinned until their Host tasks are destructed, thus they are
+    never relocated underneath a Host operation executed concurrently by another thread. **/
+{
+ int errc;
+
+#pragma omp flush
+ if(talsh_on == 0) return TALSH_NOT_INITIALIZED;
+ errc=arg_buf_defrag_host(bytes);
+ if(errc != 0 && errc != TRY_LATER && errc != DEVICE_UNABLE) errc=TALSH_FAILURE;
+ return errc;
+}
+
+int talshHostBufferDefrag_(size_t bytes) //Fortran wrapper
+{
+ return talshHostBufferDefrag(bytes);
+}
+
+void talshSetHostBufferAutoDefrag(int auto_defrag) //in: 0 disables, non-zero enables (default)
+/** Enables/disables the automatic defragmentation of the Host argument buffer,
+    which is triggered when a tensor body cannot be allocated there due to fragmentation. **/
+{
+ talsh_hab_auto_defrag=auto_defrag;
+#pragma omp flush
+ return;
+}
+
+size_t talshSetSmallTensorVolume(size_t max_volume) //in: max tensor volume (0 disables the native small-tensor path)
+/** Sets the max tensor volume below which Host tensor operations (copy, addition, contraction, scaling)
+    are executed natively in C++, bypassing the Fortran <tensor_block_t> association. Returns the previous value. **/
+{
+ size_t prev=talsh_small_volume;
+ talsh_small_volume=max_volume;
+#pragma omp flush
+ return prev;
+}
+
+int talshSetComplexGemmMode(int mode) //in: TALSH_CGEMM_4M (default) or TALSH_CGEMM_3M
+/** Selects the formulation of complex tensor contractions executed by the native Host slice kernels
+    on split-complex (real/imaginary) panels. Returns the previous mode or TALSH_INVALID_ARGS. **/
+{
+ if(mode != TALSH_CGEMM_4M && mode != TALSH_CGEMM_3M) return TALSH_INVALID_ARGS;
+ int prev=talsh_cgemm_mode;
+ talsh_cgemm_mode=mode;
+#pragma omp flush
+ return prev;
+}
+
+int talshSetAutotune(int enable,          //in: YEP enables, NOPE disables (default)
+                     const char * db_file) //in: autotuning database file (NULL: keep the current one)
+/** Enables/disables autotuning of Host tensor contractions. On the first encounters of a new
+    contraction plan (data kind, conjugation, tensor shapes, contraction pattern, number of threads)
+    each candidate strategy (TALSH_HOST_CTR_XXX) executes it once and gets timed; the fastest one is
+    then used for all later encounters of the same plan. If <db_file> is given, the tuned plans stored
+    there are loaded (a missing file starts a new database) and the database is saved back to it by
+    talshShutdown(). Autotuned Host contractions may be issued concurrently from multiple threads
+    (candidate timings are then affected by the concurrent load). Returns the previous setting or an error code. **/
+{
+ int prev=talsh_autotune;
+ if(db_file != NULL){
+  talsh_autotune_db=db_file;
+  int errc=talsh_autotune_load(db_file); if(errc != TALSH_SUCCESS) return errc;
+ }
+ talsh_autotune=((enable != NOPE)?YEP:NOPE);
+#pragma omp flush
+ return prev;
+}
+
+int talshAutotuneSave(const char * db_file) //in: autotuning database file (NULL: the current one)
+/** Saves the tuned Host contraction plans into a text database (one plan per line). **/
+{
+ const std::string file_name=((db_file != NULL)?std::string(db_file):talsh_autotune_db);
+ if(file_name.empty()) return TALSH_INVALID_ARGS;
+ FILE * db=fopen(file_name.c_str(),"w");
+ if(db == NULL){
+  if(VERBOSE) printf("#ERROR(talshAutotuneSave): Unable to open file %s\n",file_name.c_str());
+  return TALSH_FAILURE;
+ }
+ int errc=TALSH_SUCCESS;
+ if(fprintf(db,"#TAL-SH autotuning database: <plan> <strategy> <time>\n") < 0) errc=TALSH_FAILURE;
+#pragma omp critical(talsh_autotune)
+ for(const auto & entry: talsh_autotune_table){
+  const int strategy=entry.second.strategy;
+  if(strategy >= 0){
+   if(fprintf(db,"%s %d %.6e\n",entry.first.c_str(),strategy,entry.second.time[strategy]) < 0) errc=TALSH_FAILURE;
+  }
+ }
+ if(fclose(db) != 0) errc=TALSH_FAILURE;
+ return errc;
+}
+
+int talshAutotuneStats(int * num_tuned,   //out: number of tuned Host contraction plans
+                       int * num_pending) //out: number of Host contraction plans whose candidates are still being timed
+/** Queries the state of the autotuning table. **/
+{
+ if(num_tuned == NULL || num_pending == NULL) return TALSH_INVALID_ARGS;
+ *num_tuned=0; *num_pending=0;
+#pragma omp critical(talsh_autotune)
+ for(const auto & entry: talsh_autotune_table){
+  if(entry.second.strategy >= 0){++(*num_tuned);}else{++(*num_pending);}
+ }
+ return TALSH_SUCCESS;
+}
+
+int talshBlasLoad(const char * lib_path) //in: BLAS library (file name or path)
+/** Loads a BLAS library at run time and makes it the Host BLAS backend of CP-TAL tensor contractions,
+    which then use BLAS GEMM (see talsh_blas.cpp). Must not be called concurrently with Host tensor operations.
+    Returns the recognized backend kind (TALSH_BLAS_XXX) or an error code. **/
+{
+ int trn_alg,mm_alg;
+
+ if(lib_path == NULL) return TALSH_INVALID_ARGS;
+ int kind=cpu_blas_load(lib_path);
+ if(kind == -1) return TALSH_NOT_AVAILABLE;
+ if(kind < 0) return TALSH_FAILURE;
+ cpu_get_algorithms(&trn_alg,&mm_alg);
+ cpu_set_algorithms(trn_alg,BLAS_ON);
+ if(talsh_on != 0) talsh_cpu=DEV_ON_BLAS;
+#pragma omp flush
+ return kind;
+}
+
+int talshBlasBackend()
+/** Returns the active Host BLAS backend (TALSH_BLAS_XXX). **/
+{
+ return cpu_blas_backend();
+}
+
+void talshSetBlasThreads(int num_threads,        //in: number of BLAS threads outside parallel regions (0: size of the executing Host team)
+                         int serial_in_parallel) //in: YEP (default) enforces single-threaded BLAS inside parallel regions
+/** Sets the number of threads of Host BLAS calls. By default, each BLAS call uses the threads of the Host team
+    executing it, and BLAS calls issued inside parallel regions (e.g., parallel batched GEMM) are single-threaded,
+    which avoids oversubscription of the cores by nested BLAS threading. **/
+{
+ cpu_blas_set_threads(num_threads,serial_in_parallel);
+ return;
+}
+
+int talshSetNonFiniteCheck(int enable) //in: YEP enables, NOPE disables (default)
+/** Enables/disables NaN/Inf screening of Host tensor copies, additions and contractions.
+    The native kernels screen the destination in their output epilogue; otherwise the
+    destination is screened by a single vectorized pass. NaN/Inf propagate from the inputs
+    into the destination, so the inputs are only screened when the destination is flagged.
+    The results are reported by talshTaskNonFinite(). Returns the previous setting. **/
+{
+ int prev=talsh_nonfinite_check;
+ talsh_nonfinite_check=((enable != NOPE)?YEP:NOPE);
+#pragma omp flush
+ return prev;
+}
+
 void * talshDeviceBufferBasePtr(int dev_num, int dev_kind)
 {
  void * base_ptr = NULL;
@@ -1098,6 +1899,7 @@ int talshStats(int dev_id,   //in: device id (either flat or kind specific devic
    break;
   case DEV_HOST:
    rc=cpu_print_stats();
+   talsh_obj_pool_print_stats();
    break;
   case DEV_NVIDIA_GPU:
 #ifndef NO_GPU
@@ -1131,12 +1933,34 @@ int talshStats_(int dev_id, int dev_kind) //Fortran wrapper
  return talshStats(dev_id,dev_kind);
 }
 
+int talshObjectPoolStats(unsigned long long * pool_allocs, //out: number of objects served from the pools
+                         unsigned long long * heap_allocs, //out: number of objects served from the heap (pools exhausted)
+                         long long * num_used)             //out: number of objects currently in use
+/** Returns the allocation counters accumulated over all internal object pools. **/
+{
+ unsigned long long pool_gets,heap_gets;
+ long long nused;
+ int i,errc;
+
+ if(pool_allocs == NULL || heap_allocs == NULL || num_used == NULL) return TALSH_INVALID_ARGS;
+ *pool_allocs=0ULL; *heap_allocs=0ULL; *num_used=0LL;
+ for(i=0;i<TALSH_NUM_POOLS+2;++i){
+  if(i < TALSH_NUM_POOLS){
+   errc=obj_pool_get_stats(talsh_obj_pool(i),&pool_gets,&heap_gets,&nused);
+  }else{
+   errc=tensShape_pool_stats(i-TALSH_NUM_POOLS,&pool_gets,&heap_gets,&nused);
+  }
+  if(errc != 0) return TALSH_FAILURE;
+  *pool_allocs+=pool_gets; *heap_allocs+=heap_gets; *num_used+=nused;
+ }
+ return TALSH_SUCCESS;
+}
+
 // TAL-SH tensor block API:
 int talshTensorCreate(talsh_tens_t ** tens_block) //out: pointer to a newly created empty tensor block
 /** Returns a pointer to a newly created empty tensor block (0:Success; TRY_LATER:Short on memory). **/
 {
- *tens_block=(talsh_tens_t*)malloc(sizeof(talsh_tens_t));
- if(*tens_block == NULL) return TRY_LATER;
+ if(obj_pool_get(talsh_obj_pool(TALSH_POOL_TENS),(void**)tens_block) != 0){*tens_block=NULL; return TRY_LATER;}
  return talshTensorClean(*tens_block);
 }
 
@@ -1211,23 +2035,16 @@ int talshTensorConstruct(talsh_tens_t * tens_block,     //inout: empty tensor bl
  //Device resource storage:
  if(tens_block->dev_rsc_len == 0 && tens_block->dev_rsc == NULL &&
     tens_block->data_kind == NULL && tens_block->avail == NULL){ //tensor block must be defined-empty
-  tens_block->dev_rsc=(talsh_dev_rsc_t*)malloc(TALSH_MAX_DEV_PRESENT*sizeof(talsh_dev_rsc_t));
-  if(tens_block->dev_rsc != NULL){
+  //All image arrays {dev_rsc,data_kind,avail} share a single pooled block:
+  if(obj_pool_get(talsh_obj_pool(TALSH_POOL_TENS_IMG),(void**)(&(tens_block->dev_rsc))) == 0){
    tens_block->dev_rsc_len=TALSH_MAX_DEV_PRESENT; tens_block->ndev=0;
    for(j=0;j<TALSH_MAX_DEV_PRESENT;++j){i=tensDevRsc_clean(&(tens_block->dev_rsc[j]));}
-   tens_block->data_kind=(int*)malloc(TALSH_MAX_DEV_PRESENT*sizeof(int));
-   if(tens_block->data_kind != NULL){
-    for(j=0;j<TALSH_MAX_DEV_PRESENT;++j){tens_block->data_kind[j]=NO_TYPE;}
-    tens_block->avail=(int*)malloc(TALSH_MAX_DEV_PRESENT*sizeof(int));
-    if(tens_block->avail != NULL){
-     for(j=0;j<TALSH_MAX_DEV_PRESENT;++j){tens_block->avail[j]=NOPE;}
-    }else{
-     i=talshTensorDestruct(tens_block); return TRY_LATER;
-    }
-   }else{
-    i=talshTensorDestruct(tens_block); return TRY_LATER;
-   }
+   tens_block->data_kind=(int*)(&(tens_block->dev_rsc[TALSH_MAX_DEV_PRESENT]));
+   for(j=0;j<TALSH_MAX_DEV_PRESENT;++j){tens_block->data_kind[j]=NO_TYPE;}
+   tens_block->avail=&(tens_block->data_kind[TALSH_MAX_DEV_PRESENT]);
+   for(j=0;j<TALSH_MAX_DEV_PRESENT;++j){tens_block->avail[j]=NOPE;}
   }else{
+   tens_block->dev_rsc=NULL;
    i=talshTensorDestruct(tens_block); return TRY_LATER;
   }
  }else{
@@ -1246,6 +2063,9 @@ int talshTensorConstruct(talsh_tens_t * tens_block,     //inout: empty tensor bl
     tsize=tvol*dksize;
     if(tsize <= 0){i=talshTensorDestruct(tens_block); return TALSH_INTEGER_OVERFLOW;}
     errc=tensDevRsc_allocate_mem(&(tens_block->dev_rsc[0]),dev_id,tsize,use_hab);
+    if(errc == TRY_LATER && dev_kind == DEV_HOST && use_hab == YEP && talsh_hab_auto_defrag != 0){ //fragmented Host buffer
+     if(arg_buf_defrag_host(tsize) == 0) errc=tensDevRsc_allocate_mem(&(tens_block->dev_rsc[0]),dev_id,tsize,use_hab);
+    }
     if(errc != 0 && errc != TRY_LATER && errc != DEVICE_UNABLE) errc=TALSH_FAILURE;
     if(errc != 0){i=talshTensorDestruct(tens_block); return errc;}
     tens_block->data_kind[0]=data_kind; tens_block->avail[0]=YEP; tens_block->ndev=1;
@@ -1297,6 +2117,8 @@ int talshTensorConstruct(talsh_tens_t * tens_block,     //inout: empty tensor bl
    }
   }
  }
+ talsh_tensor_register(tens_block);
+ talsh_tensor_hab_own(tens_block);
 #pragma omp flush
  return errc;
 }
@@ -1308,80 +2130,200 @@ int talshTensorConstruct_(talsh_tens_t * tens_block, int data_kind, int tens_ran
                              ext_mem, in_hab, init_method, init_val_real, init_val_imag);
 }
 
-int talshTensorImportData(talsh_tens_t * tens_block, //inout: defined tensor block
-                          int data_kind,             //in: imported data kind: {R4,R8,C4,C8}
-                          const void * ext_data)     //in: pointer to the imported external data
-/** Imports tensor body by copying data from <ext_data> into tensor body on Host. **/
-{
- int errc;
- size_t l,vol;
- void * body_ptr;
+int talshTensorConstructMapped(talsh_tens_t * tens_block, //inout: empty tensor block on entrance, constructed tensor block on exit
+                               int data_kind,             //in: data kind: {R4,R8,C4,C8}
+                               int tens_rank,             //in: tensor block rank (number of dimensions)
+                               const int tens_dims[],     //in: tensor block dimension extents
+                               const char * file_name,    //in: name of the file holding the tensor body
+                               int map_mode,              //in: file mapping mode: {MEM_MAP_OPEN,MEM_MAP_CREATE,MEM_MAP_PRIVATE}
+                               int map_advice)            //in: memory access advice: {MEM_MAP_ADVICE_NORMAL,...}
+/** Constructs a tensor block on Host whose body resides in a file mapped into the Host memory,
+    thus the data is used directly from the page cache without being read and copied. The file
+    contents are interpreted as the tensor body (no initialization is performed here):
+     MEM_MAP_OPEN: An existing file (at least as large as the tensor body) is mapped in shared mode,
+                   hence all modifications of the tensor body will persist in the file;
+     MEM_MAP_CREATE: Same as MEM_MAP_OPEN, but the file is created if it does not exist and is resized
+                     to the size of the tensor body (the newly added space reads as zeros);
+     MEM_MAP_PRIVATE: An existing file is mapped in private copy-on-write mode, hence all modifications
+                      of the tensor body will be discarded upon the tensor block destruction.
+    The file is unmapped when the tensor block is destructed. **/
+{
+ int i,dksize,errc;
+ size_t tvol,tsize;
+ void * body_p;
 
 #pragma omp flush
  if(talsh_on == 0) return TALSH_NOT_INITIALIZED;
- errc=TALSH_SUCCESS;
- if(tens_block == NULL) return TALSH_INVALID_ARGS;
- if(talshTensorIsEmpty(tens_block) == YEP) return TALSH_OBJECT_IS_EMPTY;
- errc=talshTensorGetBodyAccess(tens_block,&body_ptr,data_kind,0,DEV_HOST);
+ if(tens_block == NULL || file_name == NULL) return TALSH_INVALID_ARGS;
+ if(talshTensorIsEmpty(tens_block) != YEP) return TALSH_OBJECT_NOT_EMPTY;
+ if(data_kind == NO_TYPE || tens_valid_data_kind(data_kind,&dksize) != YEP) return TALSH_INVALID_ARGS;
+ if(tens_rank < 0 || tens_rank > MAX_TENSOR_RANK) return TALSH_INVALID_ARGS;
+ if(tens_rank > 0 && tens_dims == NULL) return TALSH_INVALID_ARGS;
+ tvol=1;
+ for(i=0;i<tens_rank;++i){
+  if(tens_dims[i] <= 0) return TALSH_INVALID_ARGS;
+  if(tvol > ((size_t)(-1))/((size_t)tens_dims[i])/((size_t)dksize)) return TALSH_INTEGER_OVERFLOW;
+  tvol*=((size_t)tens_dims[i]);
+ }
+ tsize=tvol*dksize;
+ errc=host_mem_map_file(&body_p,tsize,file_name,map_mode,map_advice);
+ if(errc != 0){
+  if(errc < 0) return TALSH_INVALID_ARGS;
+  if(VERBOSE) printf("#ERROR(talshTensorConstructMapped): Unable to map file %s: Error %d\n",file_name,errc);
+  return TALSH_FAILURE;
+ }
+ errc=talshTensorConstruct(tens_block,data_kind,tens_rank,tens_dims,talshFlatDevId(DEV_HOST,0),body_p);
  if(errc == TALSH_SUCCESS){
-  vol=talshTensorVolume(tens_block);
-  if(vol > 0){
-   float * dr4p = (float*)body_ptr;
-   const float * sr4p = (const float*)ext_data;
-   double * dr8p = (double*)body_ptr;
-   const double * sr8p = (const double*)ext_data;
-   talshComplex4 * dc4p = (talshComplex4*)body_ptr;
-   const talshComplex4 * sc4p = (const talshComplex4*)ext_data;
-   talshComplex8 * dc8p = (talshComplex8*)body_ptr;
-   const talshComplex8 * sc8p = (const talshComplex8*)ext_data;
-   switch(data_kind){
-    case R4:
-#pragma omp parallel for shared(vol,dr4p,sr4p) schedule(guided)
-     for(l=0;l<vol;++l) dr4p[l]=sr4p[l];
-     break;
-    case R8:
-#pragma omp parallel for shared(vol,dr8p,sr8p) schedule(guided)
-     for(l=0;l<vol;++l) dr8p[l]=sr8p[l];
-     break;
-    case C4:
-#pragma omp parallel for shared(vol,dc4p,sc4p) schedule(guided)
-     for(l=0;l<vol;++l) dc4p[l]=sc4p[l];
-     break;
-    case C8:
-#pragma omp parallel for shared(vol,dc8p,sc8p) schedule(guided)
-     for(l=0;l<vol;++l) dc8p[l]=sc8p[l];
-     break;
-    default:
-     errc=TALSH_INVALID_ARGS;
-   }
-  }else{
-   errc=TALSH_FAILURE;
-  }
+  talsh_tens_reg_shard_t & shard=talsh_tensor_registry_lock(tens_block);
+  auto it=shard.entries.find(tens_block);
+  if(it != shard.entries.end()){it->second.map_addr=body_p; it->second.map_size=tsize;}
+  talsh_tensor_registry_unlock(shard);
+ }else{
+  i=host_mem_unmap_file(body_p,tsize);
  }
+#pragma omp flush
  return errc;
 }
 
-int talshTensorDestruct(talsh_tens_t * tens_block) //in: non-NULL pointer to a tensor block (empty tensor block on exit)
-/** Destructs a tensor block and sets its status to empty. **/
+int talshTensorImportData(talsh_tens_t * tens_block, //inout: defined tensor block
+                          int data_kind,             //in: imported data kind: {R4,R8,C4,C8}
+                          const void * ext_data,     //in: pointer to the imported external data
+                          talsh_task_t * talsh_task) //inout: TAL-SH task (asynchronous import), NULL: blocking
+/** Imports tensor body by copying data from <ext_data> into tensor body on Host.
+    If the tensor has no Host image of <data_kind>, the data is converted on the fly
+    into the data kind of its Host image (precision change or real into complex). **/
 {
- int i,j,errc;
+ return talsh_tensor_data_transfer(tens_block,data_kind,(void*)ext_data,YEP,talsh_task);
+}
+
+int talshTensorExportData(talsh_tens_t * tens_block, //in: defined tensor block
+                          int data_kind,             //in: exported data kind: {R4,R8,C4,C8}
+                          void * ext_data,           //out: pointer to the external data buffer
+                          talsh_task_t * talsh_task) //inout: TAL-SH task (asynchronous export), NULL: blocking
+/** Exports tensor body by copying the tensor body from Host into <ext_data>.
+    If the tensor has no Host image of <data_kind>, the data is converted on the fly
+    from the data kind of its Host image (precision change or real into complex). **/
+{
+ return talsh_tensor_data_transfer(tens_block,data_kind,ext_data,NOPE,talsh_task);
+}
+
+int talshTensorApplyTiles(talsh_tens_t * tens_block,       //inout: defined tensor block with a Host image
+                          talsh_tens_tile_init_i tile_func, //in: user-defined tile initialization/transformation function
+                          void * context,                   //in: user context passed to <tile_func>
+                          size_t tile_volume)               //in: approximate tile volume (0:default)
+/** Applies a user-defined function to the Host tensor body tile by tile in parallel. The tiles are
+    contiguous: All leading dimensions up to some dimension <k> are full, dimension <k> is chunked,
+    and the trailing dimensions are fixed, which gives about <tile_volume> elements per tile.
+    All other tensor images are discarded. **/
+{
+ int errc,himg,rank,k;
+ size_t inner,chunk,nchunks,outer,ntiles;
 
 #pragma omp flush
  if(talsh_on == 0) return TALSH_NOT_INITIALIZED;
- errc=TALSH_SUCCESS;
- if(tens_block == NULL) return TALSH_INVALID_ARGS;
- if(tens_block->shape_p != NULL){
-  i=tensShape_destroy(tens_block->shape_p); tens_block->shape_p=NULL;
-  if(i == 0 || i == NOT_CLEAN){
-   if(errc == 0) errc=i;
-   if(i == NOT_CLEAN && VERBOSE != 0) printf("#ERROR(talshTensorDestruct): Unable to cleanly destroy tensor shape!\n");
-  }else{
+ if(tens_block == NULL || tile_func == NULL) return TALSH_INVALID_ARGS;
+ if(talshTensorIsEmpty(tens_block) != NOPE) return TALSH_OBJECT_IS_EMPTY;
+ if(talshTensorIsHealthy(tens_block) != YEP) return TALSH_FAILURE;
+ if(talshTensorInUse(tens_block) != NOPE) return TALSH_NOT_ALLOWED;
+ errc=talsh_tensor_inflate(tens_block); if(errc != TALSH_SUCCESS) return errc;
+ errc=talsh_tensor_interleave(tens_block); if(errc != TALSH_SUCCESS) return errc;
+ himg=-1;
+ for(int i=0; i<tens_block->ndev; ++i){
+  if(tens_block->dev_rsc[i].dev_id == talshFlatDevId(DEV_HOST,0)){himg=i; break;}
+ }
+ if(himg < 0) return TALSH_NOT_FOUND;
+ talsh_tensor_expose_body(tens_block);
+ errc=talsh_tensor_image_discard_other(tens_block,himg); if(errc != TALSH_SUCCESS) return TALSH_FAILURE;
+ const int data_kind=tens_block->data_kind[0];
+ int dksize; if(talshValidDataKind(data_kind,&dksize) != YEP) return TALSH_FAILURE;
+ char * body=static_cast<char*>(tens_block->dev_rsc[0].gmem_p);
+ const int * dims=talshTensorDimExtents(tens_block,&rank);
+ if(tile_volume == 0) tile_volume=TENS_TILE_VOLUME;
+ //Tiling: dims[0:k-1] full, dims[k] chunked, dims[k+1:rank-1] fixed:
+ inner=1; k=0;
+ while(k < rank && inner*dims[k] <= tile_volume){inner*=dims[k]; ++k;}
+ if(k < rank){
+  chunk=std::max(tile_volume/inner,(size_t)1); nchunks=(dims[k]+chunk-1)/chunk;
+  outer=1; for(int i=k+1; i<rank; ++i) outer*=dims[i];
+ }else{
+  chunk=1; nchunks=1; outer=1;
+ }
+ ntiles=nchunks*outer;
+ int failed=0;
+#pragma omp parallel for schedule(dynamic) reduction(+:failed)
+ for(long long t=0; t<(long long)ntiles; ++t){
+  talsh_tens_dense_t tile;
+  size_t j=(size_t)t%nchunks, o=(size_t)t/nchunks;
+  tile.num_dim=rank; tile.data_kind=data_kind;
+  for(int i=0; i<k; ++i){tile.bases[i]=0; tile.dims[i]=dims[i];}
+  size_t offset=0;
+  if(k < rank){
+   tile.bases[k]=j*chunk; tile.dims[k]=std::min(chunk,(size_t)dims[k]-j*chunk);
+   offset=inner*(j*chunk+(size_t)dims[k]*o);
+   for(int i=k+1; i<rank; ++i){tile.bases[i]=o%dims[i]; tile.dims[i]=1; o/=dims[i];}
+  }
+  tile.body=static_cast<void*>(body+offset*dksize);
+  if(tile_func(&tile,context) != 0) ++failed;
+ }
+ if(failed != 0) return TALSH_FAILURE;
+ return TALSH_SUCCESS;
+}
+
+int talshTensorInitRandom(talsh_tens_t * tens_block, //inout: defined tensor block with a Host image
+                          unsigned long long seed,   //in: random seed
+                          int distribution)          //in: distribution (TALSH_RANDOM_XXX)
+/** Fills the Host tensor body with pseudo-random numbers from a counter-based generator:
+    Each element depends only on <seed> and its position in the tensor body, thus the result
+    is bitwise identical for any number of threads. All other tensor images are discarded. **/
+{
+ int errc,himg;
+
+#pragma omp flush
+ if(talsh_on == 0) return TALSH_NOT_INITIALIZED;
+ if(tens_block == NULL) return TALSH_INVALID_ARGS;
+ if(distribution != TALSH_RANDOM_UNIFORM && distribution != TALSH_RANDOM_NORMAL) return TALSH_INVALID_ARGS;
+ if(talshTensorIsEmpty(tens_block) != NOPE) return TALSH_OBJECT_IS_EMPTY;
+ if(talshTensorIsHealthy(tens_block) != YEP) return TALSH_FAILURE;
+ if(talshTensorInUse(tens_block) != NOPE) return TALSH_NOT_ALLOWED;
+ errc=talsh_tensor_inflate(tens_block); if(errc != TALSH_SUCCESS) return errc;
+ errc=talsh_tensor_interleave(tens_block); if(errc != TALSH_SUCCESS) return errc;
+ himg=-1;
+ for(int i=0; i<tens_block->ndev; ++i){
+  if(tens_block->dev_rsc[i].dev_id == talshFlatDevId(DEV_HOST,0)){himg=i; break;}
+ }
+ if(himg < 0) return TALSH_NOT_FOUND;
+ talsh_tensor_expose_body(tens_block);
+ errc=talsh_tensor_image_discard_other(tens_block,himg); if(errc != TALSH_SUCCESS) return TALSH_FAILURE;
+ errc=tens_random_fill(tens_block->dev_rsc[0].gmem_p,0,talshTensorVolume(tens_block),
+                       tens_block->data_kind[0],seed,distribution);
+ if(errc != 0) return TALSH_FAILURE;
+ return TALSH_SUCCESS;
+}
+
+int talshTensorDestruct(talsh_tens_t * tens_block) //in: non-NULL pointer to a tensor block (empty tensor block on exit)
+/** Destructs a tensor block and sets its status to empty. **/
+{
+ int i,j,errc;
+ talsh_tens_reg_t reg_entry;
+
+#pragma omp flush
+ if(talsh_on == 0) return TALSH_NOT_INITIALIZED;
+ errc=TALSH_SUCCESS;
+ if(tens_block == NULL) return TALSH_INVALID_ARGS;
+ talsh_tensor_unregister(tens_block,&reg_entry);
+ if(tens_block->shape_p != NULL){
+  i=tensShape_destroy(tens_block->shape_p); tens_block->shape_p=NULL;
+  if(i == 0 || i == NOT_CLEAN){
+   if(errc == 0) errc=i;
+   if(i == NOT_CLEAN && VERBOSE != 0) printf("#ERROR(talshTensorDestruct): Unable to cleanly destroy tensor shape!\n");
+  }else{
    errc=TALSH_FAILURE;
   }
  }
  if(tens_block->ndev > tens_block->dev_rsc_len){tens_block->ndev=tens_block->dev_rsc_len; errc=TALSH_FAILURE;}
  if(tens_block->dev_rsc != NULL){
   for(j=0;j<tens_block->ndev;++j){
+   talsh_tensor_hab_disown(tens_block,j);
    i=tensDevRsc_release_all(&(tens_block->dev_rsc[j]));
    if(i == 0 || i == NOT_CLEAN){
     if(errc == 0) errc=i;
@@ -1390,10 +2332,15 @@ int talshTensorDestruct(talsh_tens_t * tens_block) //in: non-NULL pointer to a t
     errc=TALSH_FAILURE;
    }
   }
-  free(tens_block->dev_rsc); tens_block->dev_rsc=NULL;
+  i=obj_pool_release(talsh_obj_pool(TALSH_POOL_TENS_IMG),tens_block->dev_rsc); if(i != 0) errc=TALSH_FAILURE;
+  tens_block->dev_rsc=NULL;
+ }
+ tens_block->data_kind=NULL; tens_block->avail=NULL; //stored in the same block as .dev_rsc
+ if(reg_entry.zip_data != NULL) free(reg_entry.zip_data); //compressed tensor body
+ if(reg_entry.map_addr != NULL){ //unmap the file holding the tensor body
+  i=host_mem_unmap_file(reg_entry.map_addr,reg_entry.map_size);
+  if(i != 0 && errc == TALSH_SUCCESS) errc=NOT_CLEAN;
  }
- if(tens_block->data_kind != NULL){free(tens_block->data_kind); tens_block->data_kind=NULL;}
- if(tens_block->avail != NULL){free(tens_block->avail); tens_block->avail=NULL;}
  i=talshTensorClean(tens_block); //set to an empty status
 #pragma omp flush
  return errc;
@@ -1405,7 +2352,7 @@ int talshTensorDestroy(talsh_tens_t * tens_block) //in: non-NULL pointer to a te
  int errc;
  if(tens_block == NULL) return TALSH_INVALID_ARGS;
  errc=talshTensorDestruct(tens_block);
- free(tens_block);
+ if(obj_pool_release(talsh_obj_pool(TALSH_POOL_TENS),tens_block) != 0 && errc == TALSH_SUCCESS) errc=TALSH_FAILURE;
  return errc;
 }
 
@@ -1492,6 +2439,9 @@ int talshTensorDataKind(const talsh_tens_t * tens_block, int * num_images, int *
  if(talshTensorIsEmpty(tens_block) != NOPE) return TALSH_OBJECT_IS_EMPTY;
  *num_images=tens_block->ndev;
  for(i=0;i<(*num_images);++i) data_kinds[i]=tens_block->data_kind[i];
+ if(*num_images == 0){ //compressed tensor body counts as a single image
+  if(talsh_tensor_is_compressed(tens_block,NULL,&(data_kinds[0])) == YEP) *num_images=1;
+ }
  return TALSH_SUCCESS;
 }
 
@@ -1515,6 +2465,7 @@ int talshTensorInUse(const talsh_tens_t * tens_block)
  if(talsh_on == 0) return TALSH_NOT_INITIALIZED;
  if(tens_block == NULL) return TALSH_INVALID_ARGS;
  if(talshTensorIsEmpty(tens_block) != NOPE) return TALSH_OBJECT_IS_EMPTY;
+ if(talsh_tensor_is_compressed(tens_block) == YEP) return NOPE; //compressed tensor body is not in use
  if(talshTensorIsHealthy(tens_block) != YEP) return TALSH_FAILURE;
  for(i=0;i<tens_block->ndev;++i) if(tens_block->avail[i] != YEP) return YEP;
  return NOPE;
@@ -1587,11 +2538,13 @@ int talshTensorGetBodyAccess(talsh_tens_t * tens_block,
  if(talshTensorIsEmpty(tens_block) != NOPE) return TALSH_OBJECT_IS_EMPTY;
  if(talshTensorIsHealthy(tens_block) != YEP) return TALSH_FAILURE;
  if(talshTensorInUse(tens_block) != NOPE) return TALSH_NOT_ALLOWED;
+ errc=talsh_tensor_inflate(tens_block); if(errc != TALSH_SUCCESS) return errc; //compressed body is decompressed on access
+ errc=talsh_tensor_interleave(tens_block); if(errc != TALSH_SUCCESS) return errc; //the user sees the interleaved layout
  if(dev_kind != DEV_NULL) dev_id=talshFlatDevId(dev_kind,dev_id);
  if(dev_id >= 0 && dev_id < DEV_MAX){
   for(i=0;i<tens_block->ndev;++i){
    if(tens_block->dev_rsc[i].dev_id == dev_id && tens_block->data_kind[i] == data_kind){
-    *body_p=tens_block->dev_rsc[i].gmem_p;
+    *body_p=tens_block->dev_rsc[i].gmem_p; talsh_tensor_expose_body(tens_block);
     errc=talsh_tensor_image_discard_other(tens_block,i);
     if(errc != TALSH_SUCCESS) errc=TALSH_FAILURE;
     return errc;
@@ -1614,7 +2567,10 @@ int talshTensorGetBodyAccessConst(const talsh_tens_t * tens_block,
                                   int dev_id,
                                   int dev_kind)
 /** Based on the requested data kind and device, returns a constant pointer to the body
-    of the matching tensor image (if any). If no match, TALSH_NOT_FOUND is returned. **/
+    of the matching tensor image (if any). If no match, TALSH_NOT_FOUND is returned.
+    A compressed tensor body has no images until it is decompressed (see talshTensorDecompress()).
+    A tensor body stored in the split-complex layout cannot be restored through a constant
+    handle, thus TALSH_NOT_ALLOWED is returned for it (see talshTensorSetComplexLayout()). **/
 {
  int i,errc;
 
@@ -1625,11 +2581,12 @@ int talshTensorGetBodyAccessConst(const talsh_tens_t * tens_block,
  if(talshTensorIsEmpty(tens_block) != NOPE) return TALSH_OBJECT_IS_EMPTY;
  if(talshTensorIsHealthy(tens_block) != YEP) return TALSH_FAILURE;
  if(talshTensorInUse(tens_block) != NOPE) return TALSH_NOT_ALLOWED;
+ if(talsh_tensor_is_split(tens_block) == YEP) return TALSH_NOT_ALLOWED; //the user sees the interleaved layout only
  if(dev_kind != DEV_NULL) dev_id=talshFlatDevId(dev_kind,dev_id);
  if(dev_id >= 0 && dev_id < DEV_MAX){
   for(i=0;i<tens_block->ndev;++i){
    if(tens_block->dev_rsc[i].dev_id == dev_id && tens_block->data_kind[i] == data_kind){
-    *body_p=tens_block->dev_rsc[i].gmem_p;
+    *body_p=tens_block->dev_rsc[i].gmem_p; talsh_tensor_expose_body(tens_block);
     return errc;
    }
   }
@@ -1639,6 +2596,112 @@ int talshTensorGetBodyAccessConst(const talsh_tens_t * tens_block,
  return TALSH_NOT_FOUND;
 }
 
+int talshTensorComplexSplit(const talsh_tens_t * tens_block,
+                            void * real_part,
+                            void * imag_part,
+                            int data_kind)
+/** Converts the Host image of a complex tensor (C4 or C8) into the split-complex layout:
+    two real arrays (R4 or R8, respectively) of the tensor volume each. A tensor body
+    already stored in the split-complex layout is copied as is. **/
+{
+ int errc,split;
+ const void * body_p;
+
+ if(tens_block == NULL || real_part == NULL || imag_part == NULL) return TALSH_INVALID_ARGS;
+ if(data_kind != C4 && data_kind != C8) return TALSH_INVALID_ARGS;
+ size_t vol=talshTensorVolume(tens_block);
+ split=NOPE;
+ if(talsh_tensor_is_split(tens_block) == YEP){ //the split layout is copied directly
+  errc=TALSH_NOT_FOUND;
+  talsh_tens_reg_shard_t & shard=talsh_tensor_registry_lock(tens_block); //the layout is not converted meanwhile
+  auto it=shard.entries.find(tens_block);
+  if(it != shard.entries.end() && it->second.cplx_split == YEP){
+   split=YEP;
+   if(tens_block->data_kind[0] == data_kind){
+    const size_t rsize=((data_kind == C4)?sizeof(float):sizeof(double));
+    const char * rbody=(const char*)(tens_block->dev_rsc[0].gmem_p);
+    std::memcpy(real_part,rbody,vol*rsize);
+    std::memcpy(imag_part,rbody+vol*rsize,vol*rsize);
+    errc=TALSH_SUCCESS;
+   }
+  }
+  talsh_tensor_registry_unlock(shard);
+  if(split == YEP) return errc;
+ }
+ errc=talshTensorGetBodyAccessConst(tens_block,&body_p,data_kind,0,DEV_HOST);
+ if(errc != TALSH_SUCCESS) return errc;
+ if(data_kind == C4){
+  talsh_complex_split<float>(vol,(const std::complex<float>*)body_p,(float*)real_part,(float*)imag_part);
+ }else{
+  talsh_complex_split<double>(vol,(const std::complex<double>*)body_p,(double*)real_part,(double*)imag_part);
+ }
+ return TALSH_SUCCESS;
+}
+
+int talshTensorComplexMerge(talsh_tens_t * tens_block,
+                            const void * real_part,
+                            const void * imag_part,
+                            int data_kind)
+/** Overwrites the Host image of a complex tensor (C4 or C8) from the split-complex layout.
+    All other tensor images will be discarded. **/
+{
+ void * body_p;
+
+ if(real_part == NULL || imag_part == NULL) return TALSH_INVALID_ARGS;
+ if(data_kind != C4 && data_kind != C8) return TALSH_INVALID_ARGS;
+ int errc=talshTensorGetBodyAccess(tens_block,&body_p,data_kind,0,DEV_HOST);
+ if(errc != TALSH_SUCCESS) return errc;
+ size_t vol=talshTensorVolume(tens_block);
+ if(data_kind == C4){
+  talsh_complex_merge<float>(vol,(std::complex<float>*)body_p,(const float*)real_part,(const float*)imag_part);
+ }else{
+  talsh_complex_merge<double>(vol,(std::complex<double>*)body_p,(const double*)real_part,(const double*)imag_part);
+ }
+ return TALSH_SUCCESS;
+}
+
+int talshTensorSetComplexLayout(talsh_tens_t * tens_block, //inout: defined complex tensor block (C4 or C8) with a Host image
+                                int layout)                //in: storage layout: {TALSH_CPLX_INTERLEAVED,TALSH_CPLX_SPLIT}
+/** Converts the Host image of a complex tensor into the given storage layout in place. All other
+    tensor images are discarded. The tensor copy, addition (with a permutation and/or conjugation
+    of the input), scaling and Hadamard product on Host then operate on the split-complex layout
+    directly if all their operands are stored split. Any other access to the tensor body (other
+    operations, body access, data export, placement on other devices, etc.) restores the
+    interleaved layout first, thus the split layout is transparent to the user. The only
+    exception is the read-only body access (talshTensorGetBodyAccessConst()), which cannot
+    convert a constant tensor and returns TALSH_NOT_ALLOWED until the layout is restored. **/
+{
+ int i,errc,himg;
+
+#pragma omp flush
+ if(talsh_on == 0) return TALSH_NOT_INITIALIZED;
+ if(tens_block == NULL) return TALSH_INVALID_ARGS;
+ if(layout != TALSH_CPLX_INTERLEAVED && layout != TALSH_CPLX_SPLIT) return TALSH_INVALID_ARGS;
+ if(talshTensorIsEmpty(tens_block) != NOPE) return TALSH_OBJECT_IS_EMPTY;
+ if(talshTensorIsHealthy(tens_block) != YEP) return TALSH_FAILURE;
+ if(talshTensorInUse(tens_block) != NOPE) return TALSH_NOT_ALLOWED;
+ if(layout == TALSH_CPLX_INTERLEAVED) return talsh_tensor_interleave(tens_block);
+ himg=-1;
+ for(i=0;i<tens_block->ndev;++i){
+  if(tens_block->dev_rsc[i].dev_id == talshFlatDevId(DEV_HOST,0) && tens_block->avail[i] == YEP){himg=i; break;}
+ }
+ if(himg < 0) return TALSH_NOT_FOUND;
+ if(tens_block->data_kind[himg] != C4 && tens_block->data_kind[himg] != C8) return TALSH_INVALID_ARGS;
+ errc=talsh_tensor_image_discard_other(tens_block,himg); if(errc != TALSH_SUCCESS) return TALSH_FAILURE;
+ errc=talsh_tensor_complex_convert(tens_block,layout);
+#pragma omp flush
+ return errc;
+}
+
+int talshTensorComplexLayout(const talsh_tens_t * tens_block) //in: defined tensor block
+/** Returns the storage layout of the Host image of a tensor (TALSH_CPLX_XXX). **/
+{
+ if(tens_block == NULL) return TALSH_INVALID_ARGS;
+ if(talshTensorIsEmpty(tens_block) != NOPE) return TALSH_OBJECT_IS_EMPTY;
+ if(talsh_tensor_is_split(tens_block) == YEP) return TALSH_CPLX_SPLIT;
+ return TALSH_CPLX_INTERLEAVED;
+}
+
 int talshTensorGetScalar(talsh_tens_t * tens_block, double * scalar_real, double * scalar_imag)
 {
  int errc,i,j,n,dh,dev[TALSH_MAX_DEV_PRESENT],dtk[TALSH_MAX_DEV_PRESENT];
@@ -1652,6 +2715,7 @@ int talshTensorGetScalar(talsh_tens_t * tens_block, double * scalar_real, double
  if(talshTensorIsEmpty(tens_block) != NOPE) return TALSH_OBJECT_IS_EMPTY;
  if(talshTensorIsHealthy(tens_block) != YEP) return TALSH_FAILURE;
  if(talshTensorRank(tens_block) != 0) return TALSH_INVALID_ARGS;
+ errc=talsh_tensor_inflate(tens_block); if(errc != TALSH_SUCCESS) return errc;
  dh=talshFlatDevId(DEV_HOST,0); j=-1;
  errc=talshTensorPresence(tens_block,&n,dev,dtk);
  if(errc == TALSH_SUCCESS && n > 0){
@@ -1689,8 +2753,8 @@ int talshTensorGetScalar(talsh_tens_t * tens_block, double * scalar_real, double
 static int talshTensorIsHealthy(const talsh_tens_t * talsh_tens)
 /** Returns YEP is the TAL-SH tensor is fine, NOPE otherwise. A return
     status TALSH_OBJECT_IS_EMPTY indicates that the tensor is empty.
-    Note that this function assumes at least one tensor body image
-    to be present for healthy tensors. **/
+    A healthy tensor has at least one tensor body image, unless its
+    body is compressed (see talshTensorCompress()). **/
 {
  int errc;
 
@@ -1699,7 +2763,8 @@ static int talshTensorIsHealthy(const talsh_tens_t * talsh_tens)
  errc=talshTensorIsEmpty(talsh_tens);
  if(errc == NOPE){
   if(talsh_tens->dev_rsc == NULL || talsh_tens->data_kind == NULL || talsh_tens->avail == NULL ||
-     talsh_tens->ndev <= 0 || talsh_tens->ndev > talsh_tens->dev_rsc_len) return NOPE;
+     talsh_tens->ndev < 0 || talsh_tens->ndev > talsh_tens->dev_rsc_len) return NOPE;
+  if(talsh_tens->ndev == 0 && talsh_tensor_is_compressed(talsh_tens) != YEP) return NOPE;
  }else if(errc == YEP){
   return TALSH_OBJECT_IS_EMPTY;
  }else{
@@ -1931,13 +2996,33 @@ int talshTensorSliceDestroy(talsh_tens_slice_t * slice)
  return errc;
 }
 
+int talshTensorSliceContract(const char * cptrn, talsh_tens_slice_t * dslice, const talsh_tens_slice_t * lslice,
+                             const talsh_tens_slice_t * rslice, double scale_real, double scale_imag)
+/** Contracts two tensor slices into the destination tensor slice in-place (Host). **/
+{
+ if(rslice == NULL) return TALSH_INVALID_ARGS;
+ return talsh_tensor_slice_op(cptrn,dslice,lslice,rslice,scale_real,scale_imag,YEP);
+}
+
+int talshTensorSliceAdd(const char * cptrn, talsh_tens_slice_t * dslice, const talsh_tens_slice_t * lslice,
+                        double scale_real, double scale_imag)
+/** Adds a tensor slice to the destination tensor slice in-place (Host). **/
+{
+ return talsh_tensor_slice_op(cptrn,dslice,lslice,NULL,scale_real,scale_imag,YEP);
+}
+
+int talshTensorSliceCopy(const char * cptrn, talsh_tens_slice_t * dslice, const talsh_tens_slice_t * lslice)
+/** Copies (permutes) a tensor slice into the destination tensor slice in-place (Host). **/
+{
+ return talsh_tensor_slice_op(cptrn,dslice,lslice,NULL,1.0,0.0,NOPE);
+}
+
 // TAL-SH task API:
 int talshTaskCreate(talsh_task_t ** talsh_task)
 /** Creates a clean <talsh_task_t> object on heap. **/
 {
  if(talsh_task == NULL) return TALSH_INVALID_ARGS;
- *talsh_task=(talsh_task_t*)malloc(sizeof(talsh_task_t));
- if(*talsh_task == NULL) return TRY_LATER;
+ if(obj_pool_get(talsh_obj_pool(TALSH_POOL_TASK),(void**)talsh_task) != 0){*talsh_task=NULL; return TRY_LATER;}
  return talshTaskClean(*talsh_task);
 }
 
@@ -1959,6 +3044,7 @@ int talshTaskClean(talsh_task_t * talsh_task)
  talsh_task->data_vol=0.0;
  talsh_task->flops=0.0;
  talsh_task->exec_time=0.0;
+ talsh_task->nonfinite=0;
 #pragma omp flush
  return TALSH_SUCCESS;
 }
@@ -2057,6 +3143,9 @@ static int talshTaskSetArg(talsh_task_t * talsh_task, talsh_tens_t * talsh_tens_
  talsh_task->tens_args[talsh_task->num_args].tens_p=talsh_tens_p;
  talsh_task->tens_args[talsh_task->num_args].source_image=image_id;
  ++(talsh_task->num_args);
+ //Host task arguments (inputs included) stay pinned until the Host task is destroyed:
+ if(talsh_task->dev_kind == DEV_HOST && talsh_task->task_p != NULL)
+  talsh_tensor_pins_add(&(((host_task_t*)(talsh_task->task_p))->pins),talsh_tens_p);
 #pragma omp flush
  return TALSH_SUCCESS;
 }
@@ -2122,6 +3211,7 @@ static int talshTaskFinalize(talsh_task_t * talsh_task, int task_status)
            if(tensDevRsc_device_id(&(talsh_tens->dev_rsc[talsh_tens->ndev-1])) != src_dev_id){
             talsh_tens->data_kind[talsh_tens->ndev-1]=talsh_task->data_kind;
             talsh_tens->avail[talsh_tens->ndev-1]=YEP;
+            talsh_tensor_hab_own(talsh_tens);
            }else{ //this should never happen as cuda_task_finalize() has already nullified the <dst_rsc> pointer
             printf("#WARNING(talshc:talshTaskFinalize): I am surprised we are here!"); //trap
             if(tensDevRsc_same(&(talsh_tens->dev_rsc[image_id]),&(talsh_tens->dev_rsc[talsh_tens->ndev-1])) != YEP) return TALSH_FAILURE;
@@ -2256,7 +3346,7 @@ int talshTaskDestroy(talsh_task_t * talsh_task)
 
  if(talsh_task == NULL) return TALSH_INVALID_ARGS;
  errc=talshTaskDestruct(talsh_task);
- free(talsh_task);
+ if(obj_pool_release(talsh_obj_pool(TALSH_POOL_TASK),talsh_task) != 0 && errc == TALSH_SUCCESS) errc=TALSH_FAILURE;
  return errc;
 }
 
@@ -2565,6 +3655,26 @@ int talshTaskTime_(talsh_task_t * talsh_task, double * total, double * comput, d
  return talshTaskTime(talsh_task,total,comput,input,output,mmul);
 }
 
+int talshTaskNonFinite(talsh_task_t * talsh_task, //in: completed TAL-SH task
+                       int * flags)               //out: NaN/Inf flags (bits {0:D,1:L,2:R})
+/** Returns the NaN/Inf screening flags of a completed TAL-SH task: A bit is set
+    if the corresponding tensor argument was found to hold a NaN or Inf after the operation.
+    The flags are only collected while the screening is enabled (talshSetNonFiniteCheck). **/
+{
+ int sts,errc;
+
+#pragma omp flush
+ if(talsh_on == 0) return TALSH_NOT_INITIALIZED;
+ if(talsh_task == NULL || flags == NULL) return TALSH_INVALID_ARGS;
+ if(talsh_task->task_p == NULL) return TALSH_OBJECT_IS_EMPTY;
+ if(talshTaskComplete(talsh_task,&sts,&errc) == NOPE){
+  if(errc != TALSH_SUCCESS) return TALSH_FAILURE;
+  return TALSH_IN_PROGRESS;
+ }
+ *flags=talsh_task->nonfinite;
+ return TALSH_SUCCESS;
+}
+
 void talshTaskPrint(const talsh_task_t * talsh_task)
 /** Prints TAL-SH task info. **/
 {
@@ -2600,8 +3710,7 @@ int talshTensorOpCreate(talsh_tens_op_t ** tens_op)
 /** Creates an empty tensor operation. **/
 {
  if(tens_op == NULL) return TALSH_INVALID_ARGS;
- *tens_op = (talsh_tens_op_t*)malloc(sizeof(talsh_tens_op_t));
- if(*tens_op == NULL) return TRY_LATER;
+ if(obj_pool_get(talsh_obj_pool(TALSH_POOL_TENS_OP),(void**)tens_op) != 0){*tens_op = NULL; return TRY_LATER;}
  return talshTensorOpClean(*tens_op);
 }
 
@@ -2622,6 +3731,7 @@ int talshTensorOpClean(talsh_tens_op_t * tens_op)
   tens_op->alpha_real = 0.0;
   tens_op->alpha_imag = 0.0;
   tens_op->exec_dev_id = DEV_NULL;
+  tens_op->zero_copy = NOPE;
   errc = talshTaskClean(&(tens_op->task_handle));
   if(errc == TALSH_SUCCESS){
    for(int i = 0; i < MAX_TENSOR_OPERANDS; ++i){
@@ -2715,7 +3825,8 @@ int talshTensorOpActivate(talsh_tens_op_t * tens_op)
  int errc = TALSH_SUCCESS;
  if(tens_op->opkind != TALSH_TENSOR_NOOP){
   tens_op->time_started = time_sys_sec();
-  for(int i = 0; i < tens_op->num_args; ++i){
+  tens_op->zero_copy = talsh_tens_op_zero_copy_ok(tens_op); //Host operands: no argument tensors needed
+  for(int i = 0; i < tens_op->num_args && tens_op->zero_copy == NOPE; ++i){
    talsh_tens_slice_t * slice = &(tens_op->tens_slice[i]);
    const talsh_tens_t * host_tensor = slice->tensor;
    talsh_tens_t * tensor = &(tens_op->tens_arg[i]);
@@ -2739,7 +3850,7 @@ int talshTensorOpLoadInput(talsh_tens_op_t * tens_op)
  if(tens_op == NULL) return TALSH_INVALID_ARGS;
  int errc = TALSH_SUCCESS;
  if(tens_op->stage == TALSH_OP_RESOURCED){
-  for(int i = 1; i < tens_op->num_args; ++i){ //input slices only
+  for(int i = 1; i < tens_op->num_args && tens_op->zero_copy == NOPE; ++i){ //input slices only
    talsh_tens_t * dtens = &(tens_op->tens_arg[i]);
    talsh_tens_t * ltens = tens_op->tens_slice[i].tensor;
    int nd = talshTensorRank(ltens);
@@ -2782,6 +3893,18 @@ int talshTensorOpExecute(talsh_tens_op_t * tens_op, int dev_id, int dev_kind)
    tens_op->time_scheduled = time_sys_sec();
    switch(tens_op->opkind){
    case TALSH_TENSOR_CONTRACT:
+    if(tens_op->zero_copy != NOPE){ //synchronous execution directly on the slice views
+     if(dev_kind == DEV_HOST){
+      int dnf = NOPE;
+      errc = talsh_tensor_slice_op(tens_op->symb_pattern,&(tens_op->tens_slice[0]),&(tens_op->tens_slice[1]),
+                                   &(tens_op->tens_slice[2]),tens_op->alpha_real,tens_op->alpha_imag,YEP,
+                                   (talsh_nonfinite_check != NOPE)?&dnf:NULL);
+      if(errc == TALSH_SUCCESS && dnf == YEP) tens_op->task_handle.nonfinite = 1; //destination slice flagged
+     }else{
+      errc = TALSH_INVALID_ARGS;
+     }
+     break;
+    }
     errc = talshTensorContract(tens_op->symb_pattern,
                                &(tens_op->tens_arg[0]),&(tens_op->tens_arg[1]),&(tens_op->tens_arg[2]),
                                tens_op->alpha_real,tens_op->alpha_imag,
@@ -2810,7 +3933,9 @@ int talshTensorOpTest(talsh_tens_op_t * tens_op, int * completed, int wait)
  *completed = NOPE;
  int errc = TALSH_SUCCESS;
  if(tens_op->stage == TALSH_OP_SCHEDULED){
-  if(wait == YEP){
+  if(tens_op->zero_copy != NOPE){
+   *completed = YEP; //executed synchronously
+  }else if(wait == YEP){
    errc = talshTaskWait(&(tens_op->task_handle),&sts);
    if(errc == TALSH_SUCCESS && sts == TALSH_TASK_COMPLETED) *completed = YEP;
   }else{
@@ -2835,7 +3960,7 @@ int talshTensorOpStoreOutput(talsh_tens_op_t * tens_op)
  if(tens_op == NULL) return TALSH_INVALID_ARGS;
  int errc = TALSH_SUCCESS;
  if(tens_op->stage == TALSH_OP_COMPLETED){
-  if(tens_op->num_args > 0){
+  if(tens_op->num_args > 0 && tens_op->zero_copy == NOPE){
    talsh_tens_t * ltens = &(tens_op->tens_arg[0]);
    talsh_tens_t * dtens = tens_op->tens_slice[0].tensor;
    int nd = talshTensorRank(dtens);
@@ -2859,11 +3984,12 @@ int talshTensorOpDeactivate(talsh_tens_op_t * tens_op)
  if(tens_op == NULL) return TALSH_INVALID_ARGS;
  int errc = TALSH_SUCCESS; int ier = TALSH_SUCCESS;
  if(tens_op->stage == TALSH_OP_RESOURCED || tens_op->stage == TALSH_OP_STORED){
-  if(tens_op->stage == TALSH_OP_STORED) ier = talshTaskDestruct(&(tens_op->task_handle));
-  for(int i = tens_op->num_args - 1; i >= 0; --i){
+  if(tens_op->stage == TALSH_OP_STORED && tens_op->zero_copy == NOPE) ier = talshTaskDestruct(&(tens_op->task_handle));
+  for(int i = tens_op->num_args - 1; i >= 0 && tens_op->zero_copy == NOPE; --i){
    errc = talshTensorDestruct(&(tens_op->tens_arg[i])); if(errc != TALSH_SUCCESS) break;
   }
   if(errc == TALSH_SUCCESS){
+   tens_op->zero_copy = NOPE;
    if(tens_op->stage == TALSH_OP_STORED){
     tens_op->stage = TALSH_OP_RETIRED;
    }else if(tens_op->stage == TALSH_OP_RESOURCED){
@@ -2922,7 +4048,7 @@ int talshTensorOpDestroy(talsh_tens_op_t * tens_op)
 {
  if(tens_op == NULL) return TALSH_INVALID_ARGS;
  int errc = talshTensorOpDestruct(tens_op);
- free(tens_op);
+ if(obj_pool_release(talsh_obj_pool(TALSH_POOL_TENS_OP),tens_op) != 0 && errc == TALSH_SUCCESS) errc = TALSH_FAILURE;
  return errc;
 }
 
@@ -3343,6 +4469,9 @@ int talshTensorPlace(talsh_tens_t * tens,
  if(tens == NULL){tsk->task_error=100; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_INVALID_ARGS;}
  if(talshTensorIsEmpty(tens) != NOPE){tsk->task_error=101; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_OBJECT_IS_EMPTY;}
  if(talshTensorIsHealthy(tens) != YEP){tsk->task_error=102; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;}
+ if(talsh_tensor_inflate(tens) != TALSH_SUCCESS || talsh_tensor_interleave(tens) != TALSH_SUCCESS){
+  tsk->task_error=102; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TRY_LATER;
+ }
  if(dev_kind == DEV_DEFAULT){devid=dev_id;}else{devid=talshFlatDevId(dev_kind,dev_id);}
  dvn=talshKindDevId(devid,&dvk); if(dvn < 0){tsk->task_error=103; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_INVALID_ARGS;} //[dvk,dvn]: destination device
  if(copy_ctrl < 0 || copy_ctrl == COPY_D || copy_ctrl == COPY_T){ //'Discard' and 'Temporary' do not make sense here
@@ -3500,6 +4629,7 @@ int talshTensorDiscard(talsh_tens_t * tens,
  for(i=0;i<tens->ndev;++i){
   if(tens->avail[i] == YEP){ //images to be discarded cannot be discarded again
    if(tens->dev_rsc[i].dev_id == devid){
+    talsh_tensor_hab_disown(tens,i);
     j=tensDevRsc_release_all(&(tens->dev_rsc[i]));
     if(j != 0 && errc != TALSH_FAILURE){if(j == NOT_CLEAN){errc=NOT_CLEAN;}else{errc=TALSH_FAILURE;}}
    }else{
@@ -3541,26 +4671,1637 @@ int talshTensorDiscardOther(talsh_tens_t * tens,
  for(i=0;i<tens->ndev;++i){
   if(tens->avail[i] == YEP){ //images to be discarded cannot be discarded again
    if(tens->dev_rsc[i].dev_id != devid){
+    talsh_tensor_hab_disown(tens,i);
     j=tensDevRsc_release_all(&(tens->dev_rsc[i]));
     if(j != 0 && errc != TALSH_FAILURE){if(j == NOT_CLEAN){errc=NOT_CLEAN;}else{errc=TALSH_FAILURE;}}
    }else{
     if(i > k){
      tens->dev_rsc[k]=tens->dev_rsc[i]; tens->data_kind[k]=tens->data_kind[i]; tens->avail[k]=tens->avail[i];
     }
-    ++k;
+    ++k;
+   }
+  }else{
+   ++k;
+  }
+ }
+ tens->ndev=k;
+#pragma omp flush
+ return errc;
+}
+
+int talshTensorDiscardOther_(talsh_tens_t * tens, int dev_id, int dev_kind) //Fortran wrapper
+{
+ return talshTensorDiscardOther(tens,dev_id,dev_kind);
+}
+
+int talshTensorCompress(talsh_tens_t * tens_block, //inout: defined tensor block
+                        int zip_mode,              //in: compression mode: {TALSH_ZIP_LOSSLESS,TALSH_ZIP_LOSSY}
+                        double tolerance)          //in: absolute error bound per real component (TALSH_ZIP_LOSSY only)
+/** Compresses the tensor body into regular Host memory and releases all tensor body images,
+    thus freeing the space they occupied in device buffers. The tensor body will automatically
+    be decompressed into a new Host image on its first subsequent use (or by talshTensorDecompress()).
+    Previously obtained pointers to the tensor body become invalid. Tensors with an externally
+    provided (attached) body storage cannot be compressed. If the tensor block has no Host image,
+    it will be copied to Host first. In the lossy mode, each real component of the restored tensor
+    body will differ from the original value by no more than <tolerance> (plus the rounding error of
+    the data kind); blocks that cannot be quantized (non-finite values) are compressed losslessly. **/
+{
+ int i,j,errc,dks,host_image;
+ size_t tsize,zip_size;
+ void * zip_data;
+ talsh_tens_pins_t pins;
+
+#pragma omp flush
+ if(talsh_on == 0) return TALSH_NOT_INITIALIZED;
+ if(tens_block == NULL) return TALSH_INVALID_ARGS;
+ if(zip_mode != TALSH_ZIP_LOSSLESS && zip_mode != TALSH_ZIP_LOSSY) return TALSH_INVALID_ARGS;
+ if(zip_mode == TALSH_ZIP_LOSSY && !(tolerance > 0.0)) return TALSH_INVALID_ARGS;
+ if(talshTensorIsEmpty(tens_block) != NOPE) return TALSH_OBJECT_IS_EMPTY;
+ if(talsh_tensor_is_compressed(tens_block) == YEP) return TALSH_SUCCESS; //already compressed
+ errc=talshTensorInUse(tens_block); if(errc == YEP) return TALSH_IN_PROGRESS; if(errc != NOPE) return TALSH_FAILURE;
+ for(i=0;i<tens_block->ndev;++i){if(tens_block->dev_rsc[i].mem_attached != 0) return TALSH_NOT_ALLOWED;}
+ errc=talsh_tensor_interleave(tens_block); if(errc != TALSH_SUCCESS) return errc; //the body is compressed interleaved
+ host_image=-1;
+ for(i=0;i<tens_block->ndev;++i){
+  if(tens_block->dev_rsc[i].dev_id == talshFlatDevId(DEV_HOST,0)){host_image=i; break;}
+ }
+ if(host_image < 0){
+  errc=talshTensorPlace(tens_block,0,DEV_HOST,NULL,COPY_K); if(errc != TALSH_SUCCESS) return errc;
+  host_image=tens_block->ndev-1; //newly added Host image is the last
+  if(tens_block->dev_rsc[host_image].dev_id != talshFlatDevId(DEV_HOST,0)) return TALSH_FAILURE; //trap
+ }
+ if(tens_valid_data_kind(tens_block->data_kind[host_image],&dks) != YEP) return TALSH_FAILURE;
+ tsize=talshTensorVolume(tens_block)*dks;
+ talsh_tensor_pins_clean(&pins);
+ talsh_tensor_pins_add(&pins,tens_block); //the Host image must not be relocated while being compressed
+ errc=talsh_body_compress(tens_block->dev_rsc[host_image].gmem_p,tsize,tens_block->data_kind[host_image],
+                          zip_mode,tolerance,&zip_data,&zip_size);
+ talsh_tensor_pins_release(&pins);
+ if(errc != 0) return (errc == TRY_LATER) ? TRY_LATER : TALSH_FAILURE;
+ talsh_tens_reg_shard_t & shard=talsh_tensor_registry_lock(tens_block);
+ auto it=shard.entries.find(tens_block);
+ bool registered=(it != shard.entries.end());
+ if(registered){
+  it->second.zip_data=zip_data; it->second.zip_size=zip_size; it->second.zip_kind=tens_block->data_kind[host_image];
+  it->second.body_exposed=0; //the new body will be allocated upon decompression
+ }
+ talsh_tensor_registry_unlock(shard);
+ if(!registered){free(zip_data); return TALSH_FAILURE;} //unregistered tensor
+ errc=TALSH_SUCCESS;
+ for(i=0;i<tens_block->ndev;++i){
+  talsh_tensor_hab_disown(tens_block,i);
+  j=tensDevRsc_release_all(&(tens_block->dev_rsc[i]));
+  if(j != 0){talsh_raise_not_clean(); errc=NOT_CLEAN;}
+  tens_block->data_kind[i]=NO_TYPE; tens_block->avail[i]=NOPE;
+ }
+ tens_block->ndev=0;
+#pragma omp flush
+ return errc;
+}
+
+int talshTensorDecompress(talsh_tens_t * tens_block) //inout: defined tensor block
+/** Decompresses a compressed tensor body into a new Host image (no action if not compressed). **/
+{
+ int errc;
+
+#pragma omp flush
+ if(talsh_on == 0) return TALSH_NOT_INITIALIZED;
+ if(tens_block == NULL) return TALSH_INVALID_ARGS;
+ if(talshTensorIsEmpty(tens_block) != NOPE) return TALSH_OBJECT_IS_EMPTY;
+ errc=talsh_tensor_inflate(tens_block);
+#pragma omp flush
+ return errc;
+}
+
+int talshTensorIsCompressed(const talsh_tens_t * tens_block, //in: defined tensor block
+                            size_t * zip_size)               //out: size of the compressed tensor body in bytes (optional)
+/** Returns YEP if the tensor body is currently compressed, NOPE otherwise. **/
+{
+ if(tens_block == NULL) return TALSH_INVALID_ARGS;
+ if(talshTensorIsEmpty(tens_block) != NOPE) return TALSH_OBJECT_IS_EMPTY;
+ return talsh_tensor_is_compressed(tens_block,zip_size);
+}
+
+//NATIVE SMALL-TENSOR HOST PATH:
+template <typename T>
+static inline T talsh_small_conj(T val){return val;}
+template <>
+inline std::complex<float> talsh_small_conj(std::complex<float> val){return std::conj(val);}
+template <>
+inline std::complex<double> talsh_small_conj(std::complex<double> val){return std::conj(val);}
+
+template <typename T>
+static inline T talsh_small_scalar(double re, double){return static_cast<T>(re);}
+template <>
+inline std::complex<float> talsh_small_scalar(double re, double im){return std::complex<float>(re,im);}
+template <>
+inline std::complex<double> talsh_small_scalar(double re, double im){return std::complex<double>(re,im);}
+
+//Branch-free NaN/Inf test (all exponent bits set), also valid under relaxed floating point models:
+static inline int talsh_nonfinite(float val){
+ uint32_t w; std::memcpy(&w,&val,sizeof(w)); return (int)((w&0x7F800000U) == 0x7F800000U);}
+static inline int talsh_nonfinite(double val){
+ uint64_t w; std::memcpy(&w,&val,sizeof(w)); return (int)((w&0x7FF0000000000000ULL) == 0x7FF0000000000000ULL);}
+template <typename R>
+static inline int talsh_nonfinite(std::complex<R> val){return talsh_nonfinite(val.real())|talsh_nonfinite(val.imag());}
+
+template <typename T>
+static int talsh_small_contract_kernel(const int * contr_ptrn, //in: digital contraction pattern
+                                       int drank, const int * ddims, T * dbody,
+                                       int lrank, const int * ldims, const T * lbody,
+                                       int rrank, const int * rdims, const T * rbody, //rbody = NULL: unary operation
+                                       T alpha, bool conj_l, bool conj_r, bool accumulate, bool screen)
+/** D(+)=L*R*alpha for column-major dense tensors (a simple loop nest, small volumes only).
+    If <screen>, returns non-zero when a NaN/Inf has been written into D (fused into the output epilogue). **/
+{
+ size_t lstr[MAX_TENSOR_RANK],rstr[MAX_TENSOR_RANK];   //strides of the input tensors
+ size_t dlstr[MAX_TENSOR_RANK],drstr[MAX_TENSOR_RANK]; //strides of the output dimensions in the input tensors
+ size_t cext[MAX_TENSOR_RANK],clstr[MAX_TENSOR_RANK],crstr[MAX_TENSOR_RANK]; //contracted dimensions
+ size_t dind[MAX_TENSOR_RANK],cind[MAX_TENSOR_RANK];
+ size_t s,dvol,cvol,loff,roff,lo,ro;
+ int i,k,ncd,nonfin;
+
+ s=1; for(i=0;i<lrank;++i){lstr[i]=s; s*=ldims[i];}
+ s=1; for(i=0;i<rrank;++i){rstr[i]=s; s*=rdims[i];}
+ dvol=1; for(i=0;i<drank;++i){dlstr[i]=0; drstr[i]=0; dind[i]=0; dvol*=ddims[i];}
+ for(i=0;i<lrank;++i){if(contr_ptrn[i] > 0) dlstr[contr_ptrn[i]-1]=lstr[i];}
+ for(i=0;i<rrank;++i){if(contr_ptrn[lrank+i] > 0) drstr[contr_ptrn[lrank+i]-1]=rstr[i];}
+ ncd=0; cvol=1;
+ for(i=0;i<lrank;++i){
+  if(contr_ptrn[i] < 0){
+   cext[ncd]=ldims[i]; clstr[ncd]=lstr[i]; crstr[ncd]=rstr[-contr_ptrn[i]-1]; cind[ncd]=0;
+   cvol*=cext[ncd]; ++ncd;
+  }
+ }
+ const T one = talsh_small_scalar<T>(1.0,0.0);
+ loff=0; roff=0; nonfin=0;
+ for(size_t d=0; d<dvol; ++d){
+  T sum = talsh_small_scalar<T>(0.0,0.0);
+  lo=loff; ro=roff;
+  for(size_t c=0; c<cvol; ++c){
+   T lval = lbody[lo]; if(conj_l) lval=talsh_small_conj(lval);
+   T rval = one; if(rbody != NULL){rval=rbody[ro]; if(conj_r) rval=talsh_small_conj(rval);}
+   sum+=lval*rval;
+   for(k=0;k<ncd;++k){ //next contracted multi-index
+    if(++cind[k] < cext[k]){lo+=clstr[k]; ro+=crstr[k]; break;}
+    lo-=(cext[k]-1)*clstr[k]; ro-=(cext[k]-1)*crstr[k]; cind[k]=0;
+   }
+  }
+  if(accumulate){dbody[d]+=alpha*sum;}else{dbody[d]=alpha*sum;}
+  if(screen) nonfin|=talsh_nonfinite(dbody[d]);
+  for(k=0;k<drank;++k){ //next output multi-index
+   if(++dind[k] < (size_t)ddims[k]){loff+=dlstr[k]; roff+=drstr[k]; break;}
+   loff-=(ddims[k]-1)*dlstr[k]; roff-=(ddims[k]-1)*drstr[k]; dind[k]=0;
+  }
+ }
+ return nonfin;
+}
+
+static int talsh_small_op_ok(const talsh_tens_t * dtens, int dimg, const talsh_tens_t * ltens, int limg,
+                             const talsh_tens_t * rtens, int rimg, int conj_bits, double scale_imag)
+/** Returns YEP if the Host tensor operation can be executed via the native small-tensor path. **/
+{
+ size_t dvol,lvol,rvol;
+ int dtk;
+
+ if(talsh_small_volume == 0) return NOPE;
+ if((conj_bits&1) != 0) return NOPE; //conjugated destination is handled by CP-TAL
+ dtk=dtens->data_kind[dimg];
+ if(dtk != R4 && dtk != R8 && dtk != C4 && dtk != C8) return NOPE;
+ if((dtk == R4 || dtk == R8) && scale_imag != 0.0) return NOPE;
+ dvol=talshTensorVolume(dtens); if(dvol > talsh_small_volume) return NOPE;
+ if(ltens != NULL){
+  if(ltens->data_kind[limg] != dtk) return NOPE;
+  lvol=talshTensorVolume(ltens); if(lvol > talsh_small_volume) return NOPE;
+  if(rtens != NULL){
+   if(rtens->data_kind[rimg] != dtk) return NOPE;
+   if((conj_bits&4) != 0) return NOPE; //right conjugation follows the CP-TAL GEMM convention
+   rvol=talshTensorVolume(rtens); if(rvol > talsh_small_volume) return NOPE;
+   if(sqrt((double)dvol*(double)lvol*(double)rvol) > (double)(talsh_small_volume*SMALL_TENSOR_FMA_MULT)) return NOPE;
+  }
+ }
+ if(talsh_num_split.load() != 0){ //the small kernels assume the interleaved layout
+  if(talsh_tensor_is_split(dtens) == YEP) return NOPE;
+  if(ltens != NULL){if(talsh_tensor_is_split(ltens) == YEP) return NOPE;}
+  if(rtens != NULL){if(talsh_tensor_is_split(rtens) == YEP) return NOPE;}
+ }
+ return YEP;
+}
+
+static int talsh_small_tensor_contract(const int * contr_ptrn, talsh_tens_t * dtens, talsh_tens_t * ltens, int limg,
+                                       talsh_tens_t * rtens, int rimg, double scale_real, double scale_imag,
+                                       int conj_bits, int accumulative, int * nonfinite)
+/** Native small-tensor Host path for tensor copy, addition (rtens = NULL) and contraction.
+    The destination tensor must have its only (Host) body image #0. If <nonfinite> is not NULL,
+    the destination is screened for NaN/Inf while being written (YEP/NOPE is returned there). **/
+{
+ const int * rdims = NULL;
+ void * rbody = NULL;
+ int rrank = 0, nonfin = 0;
+ bool conj_l = ((conj_bits&2) != 0), conj_r = ((conj_bits&4) != 0), accum = (accumulative != NOPE);
+ bool screen = (nonfinite != NULL);
+
+ if(rtens != NULL){
+  rrank=rtens->shape_p->num_dim; rdims=rtens->shape_p->dims; rbody=rtens->dev_rsc[rimg].gmem_p;
+ }
+ switch(dtens->data_kind[0]){
+  case R4:
+   nonfin=talsh_small_contract_kernel<float>(contr_ptrn,
+    dtens->shape_p->num_dim,dtens->shape_p->dims,(float*)(dtens->dev_rsc[0].gmem_p),
+    ltens->shape_p->num_dim,ltens->shape_p->dims,(const float*)(ltens->dev_rsc[limg].gmem_p),
+    rrank,rdims,(const float*)rbody,talsh_small_scalar<float>(scale_real,scale_imag),conj_l,conj_r,accum,screen);
+   break;
+  case R8:
+   nonfin=talsh_small_contract_kernel<double>(contr_ptrn,
+    dtens->shape_p->num_dim,dtens->shape_p->dims,(double*)(dtens->dev_rsc[0].gmem_p),
+    ltens->shape_p->num_dim,ltens->shape_p->dims,(const double*)(ltens->dev_rsc[limg].gmem_p),
+    rrank,rdims,(const double*)rbody,talsh_small_scalar<double>(scale_real,scale_imag),conj_l,conj_r,accum,screen);
+   break;
+  case C4:
+   nonfin=talsh_small_contract_kernel<std::complex<float> >(contr_ptrn,
+    dtens->shape_p->num_dim,dtens->shape_p->dims,(std::complex<float>*)(dtens->dev_rsc[0].gmem_p),
+    ltens->shape_p->num_dim,ltens->shape_p->dims,(const std::complex<float>*)(ltens->dev_rsc[limg].gmem_p),
+    rrank,rdims,(const std::complex<float>*)rbody,talsh_small_scalar<std::complex<float> >(scale_real,scale_imag),
+    conj_l,conj_r,accum,screen);
+   break;
+  case C8:
+   nonfin=talsh_small_contract_kernel<std::complex<double> >(contr_ptrn,
+    dtens->shape_p->num_dim,dtens->shape_p->dims,(std::complex<double>*)(dtens->dev_rsc[0].gmem_p),
+    ltens->shape_p->num_dim,ltens->shape_p->dims,(const std::complex<double>*)(ltens->dev_rsc[limg].gmem_p),
+    rrank,rdims,(const std::complex<double>*)rbody,talsh_small_scalar<std::complex<double> >(scale_real,scale_imag),
+    conj_l,conj_r,accum,screen);
+   break;
+  default:
+   return TALSH_INVALID_ARGS;
+ }
+ if(nonfinite != NULL) *nonfinite=((nonfin != 0)?YEP:NOPE);
+ return TALSH_SUCCESS;
+}
+
+static int talsh_op_nonfinite(int dflag, const talsh_tens_t * dtens, const talsh_tens_t * ltens, int limg,
+                              const talsh_tens_t * rtens, int rimg)
+/** Returns the NaN/Inf flags (bits {0:D,1:L,2:R}) of a completed Host tensor operation.
+    <dflag> is YEP/NOPE if the destination (body image #0) has already been screened
+    in the kernel epilogue, otherwise it is screened here. The inputs are only
+    screened when the destination is flagged (NaN/Inf propagate into it). **/
+{
+ int flags=0;
+
+ if(dflag != YEP && dflag != NOPE)
+  dflag=tens_nonfinite_check(dtens->dev_rsc[0].gmem_p,talshTensorVolume(dtens),dtens->data_kind[0]);
+ if(dflag == YEP){
+  flags|=1;
+  if(ltens != NULL){
+   if(tens_nonfinite_check(ltens->dev_rsc[limg].gmem_p,talshTensorVolume(ltens),ltens->data_kind[limg]) == YEP) flags|=2;
+  }
+  if(rtens != NULL){
+   if(tens_nonfinite_check(rtens->dev_rsc[rimg].gmem_p,talshTensorVolume(rtens),rtens->data_kind[rimg]) == YEP) flags|=4;
+  }
+ }
+ return flags;
+}
+
+template <typename T>
+static void talsh_small_scale_kernel(size_t vol, T * dbody, T alpha)
+{
+ for(size_t i=0; i<vol; ++i) dbody[i]*=alpha;
+ return;
+}
+
+static int talsh_small_tensor_scale(talsh_tens_t * dtens, double scale_real, double scale_imag)
+/** Native small-tensor Host path for tensor scaling (body image #0). **/
+{
+ size_t vol=talshTensorVolume(dtens);
+ void * body=dtens->dev_rsc[0].gmem_p;
+
+ switch(dtens->data_kind[0]){
+  case R4: talsh_small_scale_kernel<float>(vol,(float*)body,talsh_small_scalar<float>(scale_real,scale_imag)); break;
+  case R8: talsh_small_scale_kernel<double>(vol,(double*)body,talsh_small_scalar<double>(scale_real,scale_imag)); break;
+  case C4: talsh_small_scale_kernel<std::complex<float> >(vol,(std::complex<float>*)body,
+                                                           talsh_small_scalar<std::complex<float> >(scale_real,scale_imag)); break;
+  case C8: talsh_small_scale_kernel<std::complex<double> >(vol,(std::complex<double>*)body,
+                                                            talsh_small_scalar<std::complex<double> >(scale_real,scale_imag)); break;
+  default: return TALSH_INVALID_ARGS;
+ }
+ return TALSH_SUCCESS;
+}
+
+//NATIVE SPLIT-COMPLEX HOST PATH:
+template <typename R>
+static void talsh_split_elementwise_kernel(const int * contr_ptrn, //in: digital pattern (all operand dimensions are uncontracted)
+                                           int drank, const int * ddims, R * dre, R * dim,
+                                           const R * lre, const R * lim,
+                                           const R * rre, const R * rim, //rre = NULL: unary operation
+                                           R alpha_re, R alpha_im, bool conj_l, bool accumulate)
+/** D(+)=L*R*alpha (Hadamard product) or D(+)=L*alpha (rre = NULL) for column-major split-complex tensors,
+    with the dimensions of L and R being a permutation of the dimensions of D. The outer dimensions
+    of D are distributed among threads, the leading dimension of D is streamed by separate real
+    and imaginary loops without any complex arithmetic on interleaved pairs. **/
+{
+ size_t lstr[MAX_TENSOR_RANK],rstr[MAX_TENSOR_RANK]; //strides of the input tensors along the output dimensions
+ size_t s,dvol,lead,nout,ls0,rs0;
+ int i;
+
+ dvol=1; for(i=0;i<drank;++i){lstr[i]=0; rstr[i]=0; dvol*=ddims[i];}
+ s=1; for(i=0;i<drank;++i){lstr[contr_ptrn[i]-1]=s; s*=ddims[contr_ptrn[i]-1];}
+ if(rre != NULL){s=1; for(i=0;i<drank;++i){rstr[contr_ptrn[drank+i]-1]=s; s*=ddims[contr_ptrn[drank+i]-1];}}
+ if(dvol == 0) return;
+ lead=1; ls0=0; rs0=0;
+ if(drank > 0){lead=ddims[0]; ls0=lstr[0]; rs0=rstr[0];}
+ nout=dvol/lead;
+ const R lsgn=(conj_l?R(-1):R(1));
+#pragma omp parallel for schedule(static)
+ for(long long o=0; o<(long long)nout; ++o){
+  size_t loff=0,roff=0,q=o;
+  for(int k=1;k<drank;++k){const size_t ik=q%ddims[k]; q/=ddims[k]; loff+=ik*lstr[k]; roff+=ik*rstr[k];}
+  R * dr=dre+o*lead; R * di=dim+o*lead;
+  const R * lr=lre+loff; const R * li=lim+loff;
+  if(rre == NULL){
+   for(size_t j=0; j<lead; ++j){
+    const R xr=lr[j*ls0], xi=lsgn*li[j*ls0];
+    const R vr=alpha_re*xr-alpha_im*xi, vi=alpha_re*xi+alpha_im*xr;
+    if(accumulate){dr[j]+=vr; di[j]+=vi;}else{dr[j]=vr; di[j]=vi;}
+   }
+  }else{
+   const R * rr=rre+roff; const R * ri=rim+roff;
+   for(size_t j=0; j<lead; ++j){
+    const R xr=lr[j*ls0], xi=lsgn*li[j*ls0], yr=rr[j*rs0], yi=ri[j*rs0];
+    const R pr=xr*yr-xi*yi, pi=xr*yi+xi*yr;
+    const R vr=alpha_re*pr-alpha_im*pi, vi=alpha_re*pi+alpha_im*pr;
+    if(accumulate){dr[j]+=vr; di[j]+=vi;}else{dr[j]=vr; di[j]=vi;}
+   }
+  }
+ }
+ return;
+}
+
+template <typename R>
+static void talsh_split_scale_kernel(size_t vol, R * dre, R * dim, R alpha_re, R alpha_im)
+{
+#pragma omp parallel for schedule(static)
+ for(long long l=0; l<(long long)vol; ++l){
+  const R xr=dre[l], xi=dim[l];
+  dre[l]=alpha_re*xr-alpha_im*xi; dim[l]=alpha_re*xi+alpha_im*xr;
+ }
+ return;
+}
+
+template <typename R>
+static void talsh_split_elementwise(const int * contr_ptrn, talsh_tens_t * dtens, const void * lbody, const void * rbody,
+                                    double scale_real, double scale_imag, bool conj_l, bool accumulate)
+{
+ const size_t vol=talshTensorVolume(dtens);
+ R * d=static_cast<R*>(dtens->dev_rsc[0].gmem_p);
+ const R * l=static_cast<const R*>(lbody);
+ const R * r=static_cast<const R*>(rbody);
+ talsh_split_elementwise_kernel<R>(contr_ptrn,dtens->shape_p->num_dim,dtens->shape_p->dims,d,d+vol,l,l+vol,
+                                   r,((r != NULL)?r+vol:NULL),R(scale_real),R(scale_imag),conj_l,accumulate);
+ return;
+}
+
+static int talsh_split_op_ok(const int * contr_ptrn, const talsh_tens_t * dtens, int dimg, const talsh_tens_t * ltens, int limg,
+                             const talsh_tens_t * rtens, int rimg, int conj_bits)
+/** Returns YEP if the Host tensor operation can be executed natively on the split-complex layout:
+    All operands are complex tensors of the same data kind stored in the split-complex layout and,
+    for binary/ternary operations, each operand dimension is an uncontracted destination dimension
+    (transpose, addition, Hadamard product). The destination and the right operand are not conjugated. **/
+{
+ int i,drank,dtk;
+
+ if(talsh_num_split.load() == 0) return NOPE;
+ if((conj_bits&5) != 0) return NOPE;
+ dtk=dtens->data_kind[dimg];
+ if((dtk != C4 && dtk != C8) || dimg != 0) return NOPE;
+ if(talsh_tensor_is_split(dtens) != YEP) return NOPE;
+ if(ltens != NULL){
+  drank=dtens->shape_p->num_dim;
+  if(limg != 0 || ltens->data_kind[limg] != dtk || ltens->shape_p->num_dim != drank) return NOPE;
+  for(i=0;i<drank;++i){if(contr_ptrn[i] <= 0) return NOPE;}
+  if(talsh_tensor_is_split(ltens) != YEP) return NOPE;
+  if(rtens != NULL){
+   if(rimg != 0 || rtens->data_kind[rimg] != dtk || rtens->shape_p->num_dim != drank) return NOPE;
+   for(i=0;i<drank;++i){if(contr_ptrn[drank+i] <= 0) return NOPE;}
+   if(talsh_tensor_is_split(rtens) != YEP) return NOPE;
+  }
+ }
+ return YEP;
+}
+
+static int talsh_split_tensor_elementwise(const int * contr_ptrn, talsh_tens_t * dtens, talsh_tens_t * ltens, int limg,
+                                          talsh_tens_t * rtens, int rimg, double scale_real, double scale_imag,
+                                          int conj_bits, int accumulative)
+/** Native split-complex Host path for tensor copy, addition (rtens = NULL) and Hadamard product
+    (see talsh_split_op_ok()). The destination tensor must have its only (Host) body image #0. **/
+{
+ const void * rbody = NULL;
+ bool conj_l = ((conj_bits&2) != 0), accum = (accumulative != NOPE);
+
+ if(rtens != NULL) rbody=rtens->dev_rsc[rimg].gmem_p;
+ switch(dtens->data_kind[0]){
+  case C4:
+   talsh_split_elementwise<float>(contr_ptrn,dtens,ltens->dev_rsc[limg].gmem_p,rbody,scale_real,scale_imag,conj_l,accum);
+   break;
+  case C8:
+   talsh_split_elementwise<double>(contr_ptrn,dtens,ltens->dev_rsc[limg].gmem_p,rbody,scale_real,scale_imag,conj_l,accum);
+   break;
+  default:
+   return TALSH_INVALID_ARGS;
+ }
+ return TALSH_SUCCESS;
+}
+
+static int talsh_split_tensor_scale(talsh_tens_t * dtens, double scale_real, double scale_imag)
+/** Native split-complex Host path for tensor scaling (body image #0). **/
+{
+ size_t vol=talshTensorVolume(dtens);
+ void * body=dtens->dev_rsc[0].gmem_p;
+
+ switch(dtens->data_kind[0]){
+  case C4: talsh_split_scale_kernel<float>(vol,(float*)body,((float*)body)+vol,(float)scale_real,(float)scale_imag); break;
+  case C8: talsh_split_scale_kernel<double>(vol,(double*)body,((double*)body)+vol,scale_real,scale_imag); break;
+  default: return TALSH_INVALID_ARGS;
+ }
+ return TALSH_SUCCESS;
+}
+
+template <typename T>
+struct talsh_svd_real{typedef T type;};
+template <typename R>
+struct talsh_svd_real<std::complex<R> >{typedef R type;};
+
+template <typename T> struct talsh_svd_kind;
+template <> struct talsh_svd_kind<float>{static const int value=R4;};
+template <> struct talsh_svd_kind<double>{static const int value=R8;};
+template <> struct talsh_svd_kind<std::complex<float> >{static const int value=C4;};
+template <> struct talsh_svd_kind<std::complex<double> >{static const int value=C8;};
+
+template <typename T>
+static inline T talsh_svd_gauss(std::mt19937_64 & gen, std::normal_distribution<double> & dist){return static_cast<T>(dist(gen));}
+template <>
+inline std::complex<float> talsh_svd_gauss(std::mt19937_64 & gen, std::normal_distribution<double> & dist)
+{double re=dist(gen); double im=dist(gen); return std::complex<float>(re,im);}
+template <>
+inline std::complex<double> talsh_svd_gauss(std::mt19937_64 & gen, std::normal_distribution<double> & dist)
+{double re=dist(gen); double im=dist(gen); return std::complex<double>(re,im);}
+
+template <typename T>
+static inline T talsh_svd_dot(size_t n, const T * x, const T * y) //x^H * y
+{
+ T sum=talsh_small_scalar<T>(0.0,0.0);
+ for(size_t i=0; i<n; ++i) sum+=talsh_small_conj(x[i])*y[i];
+ return sum;
+}
+
+template <typename T>
+static inline typename talsh_svd_real<T>::type talsh_svd_nrm2sq(size_t n, const T * x)
+{
+ typename talsh_svd_real<T>::type sum=0;
+ for(size_t i=0; i<n; ++i) sum+=std::norm(x[i]);
+ return sum;
+}
+
+template <typename T>
+static void talsh_svd_mult_n(size_t m, size_t n, size_t l, const T * a, const T * x, T * y)
+/** Y(m,l) = A(m,n) * X(n,l), column-major. **/
+{
+ const T zero=talsh_small_scalar<T>(0.0,0.0);
+#pragma omp parallel for schedule(static)
+ for(long long c=0; c<(long long)l; ++c){
+  T * yc=&(y[c*m]);
+  for(size_t i=0; i<m; ++i) yc[i]=zero;
+  for(size_t j=0; j<n; ++j){
+   const T xjc=x[c*n+j]; const T * aj=&(a[j*m]);
+   if(xjc != zero){for(size_t i=0; i<m; ++i) yc[i]+=aj[i]*xjc;}
+  }
+ }
+ return;
+}
+
+template <typename T>
+static void talsh_svd_mult_h(size_t m, size_t n, size_t l, const T * a, const T * q, T * z)
+/** Z(n,l) = A(m,n)^H * Q(m,l), column-major. **/
+{
+#pragma omp parallel for schedule(static)
+ for(long long j=0; j<(long long)n; ++j){
+  const T * aj=&(a[j*m]);
+  for(size_t c=0; c<l; ++c) z[c*n+j]=talsh_svd_dot(m,aj,&(q[c*m]));
+ }
+ return;
+}
+
+template <typename T>
+static void talsh_svd_gemm_n(size_t m, size_t n, size_t l, const T * a, const T * x, T * y)
+/** Y(m,l) = A(m,n) * X(n,l), column-major, via the Host BLAS dispatch (in-house product if no BLAS is available). **/
+{
+ const T one=talsh_small_scalar<T>(1.0,0.0), zero=talsh_small_scalar<T>(0.0,0.0);
+ if(std::max(std::max(m,n),l) <= (size_t)INT_MAX){
+  if(cpu_blas_gemm(talsh_svd_kind<T>::value,"N","N",(int)m,(int)l,(int)n,&one,a,(int)m,x,(int)n,&zero,y,(int)m) == 0) return;
+ }
+ talsh_svd_mult_n(m,n,l,a,x,y);
+ return;
+}
+
+template <typename T>
+static void talsh_svd_gemm_h(size_t m, size_t n, size_t l, const T * a, const T * q, T * z)
+/** Z(n,l) = A(m,n)^H * Q(m,l), column-major, via the Host BLAS dispatch (in-house product if no BLAS is available). **/
+{
+ const T one=talsh_small_scalar<T>(1.0,0.0), zero=talsh_small_scalar<T>(0.0,0.0);
+ if(std::max(std::max(m,n),l) <= (size_t)INT_MAX){
+  if(cpu_blas_gemm(talsh_svd_kind<T>::value,"C","N",(int)n,(int)l,(int)m,&one,a,(int)m,q,(int)m,&zero,z,(int)n) == 0) return;
+ }
+ talsh_svd_mult_h(m,n,l,a,q,z);
+ return;
+}
+
+template <typename T>
+static void talsh_svd_orthonormalize(size_t m, size_t l, T * q)
+/** Orthonormalizes the columns of Q(m,l) in place by the twice-iterated modified Gram-Schmidt.
+    Numerically dependent columns are zeroed out. **/
+{
+ typedef typename talsh_svd_real<T>::type RT;
+ const RT tiny=std::numeric_limits<RT>::epsilon()*RT(16);
+ const T zero=talsh_small_scalar<T>(0.0,0.0);
+
+ for(size_t c=0; c<l; ++c){
+  T * qc=&(q[c*m]);
+  RT nrm0=std::sqrt(talsh_svd_nrm2sq(m,qc));
+  for(int pass=0; pass<2; ++pass){
+   for(size_t p=0; p<c; ++p){
+    const T * qp=&(q[p*m]); const T d=talsh_svd_dot(m,qp,qc);
+    if(d != zero){for(size_t i=0; i<m; ++i) qc[i]-=d*qp[i];}
+   }
+  }
+  RT nrm=std::sqrt(talsh_svd_nrm2sq(m,qc));
+  if(nrm > tiny*nrm0 && nrm > RT(0)){
+   const RT inv=RT(1)/nrm; for(size_t i=0; i<m; ++i) qc[i]*=inv;
+  }else{
+   for(size_t i=0; i<m; ++i) qc[i]=zero;
+  }
+ }
+ return;
+}
+
+template <typename T>
+static void talsh_svd_jacobi(size_t p, size_t q, T * x, typename talsh_svd_real<T>::type * sv, T * v)
+/** One-sided (Hestenes) Jacobi SVD of X(p,q): X = W * diag(sv) * V^H.
+    On exit X is overwritten by W (orthonormal columns, zero for null singular values),
+    V(q,q) is unitary, and the singular values are sorted in descending order. **/
+{
+ typedef typename talsh_svd_real<T>::type RT;
+ const RT tol=std::numeric_limits<RT>::epsilon()*std::sqrt(RT(p));
+ const T zero=talsh_small_scalar<T>(0.0,0.0);
+ const T one=talsh_small_scalar<T>(1.0,0.0);
+
+ for(size_t j=0; j<q; ++j){for(size_t i=0; i<q; ++i) v[j*q+i]=((i == j)?one:zero);}
+ bool rotated=true;
+ for(int sweep=0; sweep<SVD_JACOBI_MAX_SWEEPS && rotated; ++sweep){
+  rotated=false;
+  for(size_t i=0; i+1<q; ++i){
+   T * xi=&(x[i*p]); T * vi=&(v[i*q]);
+   for(size_t j=i+1; j<q; ++j){
+    T * xj=&(x[j*p]); T * vj=&(v[j*q]);
+    const RT alpha=talsh_svd_nrm2sq(p,xi);
+    const RT beta=talsh_svd_nrm2sq(p,xj);
+    const T gamma=talsh_svd_dot(p,xi,xj);
+    const RT g=std::abs(gamma);
+    if(g == RT(0) || g <= tol*std::sqrt(alpha*beta)) continue;
+    rotated=true;
+    const RT zeta=(beta-alpha)/(RT(2)*g);
+    const RT t=((zeta >= RT(0))?RT(1):RT(-1))/(std::abs(zeta)+std::sqrt(RT(1)+zeta*zeta));
+    const RT cs=RT(1)/std::sqrt(RT(1)+t*t);
+    const RT sn=cs*t;
+    const T eh=talsh_small_conj(gamma/g); //phase that makes x_i^H x_j real
+    for(size_t k=0; k<p; ++k){
+     const T a=xi[k]; const T b=xj[k]*eh;
+     xi[k]=cs*a-sn*b; xj[k]=sn*a+cs*b;
+    }
+    for(size_t k=0; k<q; ++k){
+     const T a=vi[k]; const T b=vj[k]*eh;
+     vi[k]=cs*a-sn*b; vj[k]=sn*a+cs*b;
+    }
+   }
+  }
+ }
+ //Extract and sort the singular values:
+ std::vector<size_t> ord(q);
+ for(size_t j=0; j<q; ++j){
+  ord[j]=j; sv[j]=std::sqrt(talsh_svd_nrm2sq(p,&(x[j*p])));
+  T * xj=&(x[j*p]);
+  if(sv[j] > RT(0)){const RT inv=RT(1)/sv[j]; for(size_t k=0; k<p; ++k) xj[k]*=inv;}
+ }
+ std::stable_sort(ord.begin(),ord.end(),[sv](size_t i, size_t j){return sv[i] > sv[j];});
+ std::vector<T> tmp(std::max(p,q)*q);
+ std::vector<RT> svs(q);
+ for(size_t j=0; j<q; ++j){svs[j]=sv[ord[j]]; std::copy(&(x[ord[j]*p]),&(x[ord[j]*p])+p,&(tmp[j*p]));}
+ std::copy(tmp.begin(),tmp.begin()+p*q,x);
+ for(size_t j=0; j<q; ++j){sv[j]=svs[j]; std::copy(&(v[ord[j]*q]),&(v[ord[j]*q])+q,&(tmp[j*q]));}
+ std::copy(tmp.begin(),tmp.begin()+q*q,v);
+ return;
+}
+
+template <typename T>
+static void talsh_svd_trunc_kernel(size_t m, size_t n, size_t nv, T * a, T * lmat, T * rmat, T * smat,
+                                   const char absorb, int max_rank, double rel_threshold,
+                                   int * achieved_rank, double * discarded_weight)
+/** Truncated SVD of the matricized tensor A(m,n) = L(m,nv) * diag(S(nv)) * R(nv,n), where R = V^H.
+    Large matrices use the randomized range finder with power iterations (all products via GEMM):
+    Without a rank limit, the sketch rank starts at SVD_RAND_BLOCK and is doubled until the singular
+    values fall below the relative threshold within the sketch (at most the full rank, which makes
+    the range exact). The one-sided Jacobi SVD is only applied to the small projected matrix, or
+    directly to small matrices. The matrix A is destroyed on exit. **/
+{
+ typedef typename talsh_svd_real<T>::type RT;
+ const T zero=talsh_small_scalar<T>(0.0,0.0);
+ size_t mn=std::min(m,n);
+ size_t kmax=std::min(nv,mn); if(max_rank > 0) kmax=std::min(kmax,(size_t)max_rank);
+ double nrmf=0.0;
+ for(size_t i=0; i<m*n; ++i) nrmf+=std::norm(a[i]);
+ std::vector<T> qm,zm,vm,um;
+ std::vector<RT> sv;
+ const T *lbase,*rbase; //L = lbase(m,l), R = rbase(n,l)^H
+ size_t l;
+ if(mn >= SVD_RAND_MIN_DIM){ //randomized range finder
+  size_t kr=((max_rank > 0)?kmax:std::min(kmax,SVD_RAND_BLOCK)); //target rank of the sketch
+  while(true){
+   l=std::min(kr+SVD_RAND_OVERSAMPLE,mn);
+   std::mt19937_64 gen(m*n+l); //reproducible sketch
+   std::normal_distribution<double> dist(0.0,1.0);
+   std::vector<T> om(n*l);
+   for(size_t i=0; i<n*l; ++i) om[i]=talsh_svd_gauss<T>(gen,dist);
+   qm.resize(m*l); zm.resize(n*l);
+   talsh_svd_gemm_n(m,n,l,a,om.data(),qm.data());
+   talsh_svd_orthonormalize(m,l,qm.data());
+   for(int it=0; it<SVD_RAND_POWER_ITER && l<mn; ++it){ //the full-rank sketch spans the range exactly
+    talsh_svd_gemm_h(m,n,l,a,qm.data(),zm.data());
+    talsh_svd_orthonormalize(n,l,zm.data());
+    talsh_svd_gemm_n(m,n,l,a,zm.data(),qm.data());
+    talsh_svd_orthonormalize(m,l,qm.data());
+   }
+   //A ~ Q * Q^H * A = Q * Z^H, Z = W * diag(sv) * V^H => A ~ (Q * V) * diag(sv) * W^H:
+   talsh_svd_gemm_h(m,n,l,a,qm.data(),zm.data());
+   sv.resize(l); vm.resize(l*l);
+   talsh_svd_jacobi(n,l,zm.data(),sv.data(),vm.data());
+   if(kr >= kmax || l >= mn) break; //rank limit reached
+   size_t kf=0; //number of singular values above the threshold
+   while(kf < l && sv[kf] > RT(0) && double(sv[kf]) >= rel_threshold*double(sv[0])) ++kf;
+   if(kf+SVD_RAND_OVERSAMPLE <= l) break; //threshold met within the sketch
+   kr=std::min(kr*2,kmax);
+  }
+  um.resize(m*l);
+  talsh_svd_gemm_n(m,l,l,qm.data(),vm.data(),um.data());
+  lbase=um.data(); rbase=zm.data();
+ }else if(m >= n){ //A = W * diag(sv) * V^H
+  l=n; sv.resize(l); vm.resize(l*l);
+  talsh_svd_jacobi(m,n,a,sv.data(),vm.data());
+  lbase=a; rbase=vm.data();
+ }else{ //A^H = W * diag(sv) * V^H => A = V * diag(sv) * W^H
+  l=m; sv.resize(l); vm.resize(l*l); zm.resize(n*m);
+  for(size_t j=0; j<n; ++j){for(size_t i=0; i<m; ++i) zm[i*n+j]=talsh_small_conj(a[j*m+i]);}
+  talsh_svd_jacobi(n,m,zm.data(),sv.data(),vm.data());
+  lbase=vm.data(); rbase=zm.data();
+ }
+ //Determine the retained rank:
+ size_t k=std::min(kmax,l);
+ while(k > 0 && (sv[k-1] <= RT(0) || double(sv[k-1]) < rel_threshold*double(sv[0]))) --k;
+ double kept=0.0;
+ for(size_t c=0; c<k; ++c) kept+=double(sv[c])*double(sv[c]);
+ *achieved_rank=(int)k;
+ *discarded_weight=((nrmf > 0.0)?std::max(0.0,(nrmf-kept)/nrmf):0.0);
+ //Write the (zero-padded) factors with the requested absorption of singular values:
+ for(size_t c=0; c<nv; ++c){
+  RT lf=RT(1),rf=RT(1);
+  if(c < k){
+   if(absorb == 'L'){lf=sv[c];}else if(absorb == 'R'){rf=sv[c];}else if(absorb == 'S'){lf=std::sqrt(sv[c]); rf=lf;}
+   smat[c]=talsh_small_scalar<T>(double(sv[c]),0.0);
+   for(size_t i=0; i<m; ++i) lmat[c*m+i]=lbase[c*m+i]*lf;
+   for(size_t j=0; j<n; ++j) rmat[j*nv+c]=talsh_small_conj(rbase[c*n+j])*rf;
+  }else{
+   smat[c]=zero;
+   for(size_t i=0; i<m; ++i) lmat[c*m+i]=zero;
+   for(size_t j=0; j<n; ++j) rmat[j*nv+c]=zero;
+  }
+ }
+ return;
+}
+
+static int talsh_tensor_svd_trunc(talsh_tens_t * dtens, int dimg, int nlu, talsh_tens_t * ltens, talsh_tens_t * rtens,
+                                  talsh_tens_t * stens, const char absorb, int max_rank, double rel_threshold,
+                                  int * achieved_rank, double * discarded_weight)
+/** Native truncated SVD on Host. The destination tensor must already be permuted into the matricized
+    form D(left,right) and is destroyed on exit. The left, right and middle tensor factors must have
+    their only (Host) body image #0 and are zero-padded beyond the achieved rank. **/
+{
+ size_t m=1,n,nv;
+ for(int i=0; i<nlu; ++i) m*=dtens->shape_p->dims[i];
+ n=talshTensorVolume(dtens)/m; nv=talshTensorVolume(stens);
+ if(talshTensorVolume(ltens) != m*nv || talshTensorVolume(rtens) != nv*n) return TALSH_INVALID_ARGS;
+ void * dbody=dtens->dev_rsc[dimg].gmem_p;
+ void * lbody=ltens->dev_rsc[0].gmem_p;
+ void * rbody=rtens->dev_rsc[0].gmem_p;
+ void * sbody=stens->dev_rsc[0].gmem_p;
+ switch(dtens->data_kind[dimg]){
+  case R4:
+   talsh_svd_trunc_kernel<float>(m,n,nv,(float*)dbody,(float*)lbody,(float*)rbody,(float*)sbody,
+                                 absorb,max_rank,rel_threshold,achieved_rank,discarded_weight);
+   break;
+  case R8:
+   talsh_svd_trunc_kernel<double>(m,n,nv,(double*)dbody,(double*)lbody,(double*)rbody,(double*)sbody,
+                                  absorb,max_rank,rel_threshold,achieved_rank,discarded_weight);
+   break;
+  case C4:
+   talsh_svd_trunc_kernel<std::complex<float> >(m,n,nv,(std::complex<float>*)dbody,(std::complex<float>*)lbody,
+    (std::complex<float>*)rbody,(std::complex<float>*)sbody,absorb,max_rank,rel_threshold,achieved_rank,discarded_weight);
+   break;
+  case C8:
+   talsh_svd_trunc_kernel<std::complex<double> >(m,n,nv,(std::complex<double>*)dbody,(std::complex<double>*)lbody,
+    (std::complex<double>*)rbody,(std::complex<double>*)sbody,absorb,max_rank,rel_threshold,achieved_rank,discarded_weight);
+   break;
+  default:
+   return TALSH_INVALID_ARGS;
+ }
+ return TALSH_SUCCESS;
+}
+
+template <typename T>
+static void talsh_qr_gram(size_t m, size_t n, const T * a, T * g)
+/** G(n,n) = A(m,n)^H * A(m,n): Each thread accumulates the Gram matrix of its own row blocks,
+    followed by a single reduction of the thread-local Gram matrices. **/
+{
+ const T zero=talsh_small_scalar<T>(0.0,0.0);
+ const size_t nb=(m+QR_ROW_BLOCK-1)/QR_ROW_BLOCK;
+
+ for(size_t i=0; i<n*n; ++i) g[i]=zero;
+#pragma omp parallel
+ {
+  std::vector<T> gl(n*n,zero);
+#pragma omp for schedule(static)
+  for(long long b=0; b<(long long)nb; ++b){
+   const size_t r0=b*QR_ROW_BLOCK, nr=std::min(QR_ROW_BLOCK,m-r0);
+   for(size_t j=0; j<n; ++j){
+    for(size_t i=0; i<=j; ++i) gl[j*n+i]+=talsh_svd_dot(nr,&(a[i*m+r0]),&(a[j*m+r0]));
+   }
+  }
+#pragma omp critical
+  for(size_t i=0; i<n*n; ++i) g[i]+=gl[i];
+ }
+ for(size_t j=0; j<n; ++j){for(size_t i=j+1; i<n; ++i) g[j*n+i]=talsh_small_conj(g[i*n+j]);}
+ return;
+}
+
+template <typename T>
+static bool talsh_qr_cholesky(size_t n, const T * g, T * r)
+/** Cholesky factorization G(n,n) = R^H * R with an upper-triangular R(n,n).
+    Returns false if G is not numerically positive definite. **/
+{
+ typedef typename talsh_svd_real<T>::type RT;
+ const RT tol=std::numeric_limits<RT>::epsilon()*RT(n);
+ const T zero=talsh_small_scalar<T>(0.0,0.0);
+
+ for(size_t i=0; i<n*n; ++i) r[i]=zero;
+ for(size_t j=0; j<n; ++j){
+  RT d=std::real(g[j*n+j]);
+  for(size_t k=0; k<j; ++k) d-=std::norm(r[j*n+k]);
+  if(!(d > tol*std::real(g[j*n+j]))) return false;
+  const RT rjj=std::sqrt(d); r[j*n+j]=talsh_small_scalar<T>(rjj,0.0);
+  for(size_t i=j+1; i<n; ++i){
+   T s=g[i*n+j];
+   for(size_t k=0; k<j; ++k) s-=talsh_small_conj(r[j*n+k])*r[i*n+k];
+   r[i*n+j]=s/rjj;
+  }
+ }
+ return true;
+}
+
+template <typename T>
+static void talsh_qr_trsm(size_t m, size_t n, T * a, const T * r)
+/** A(m,n) := A(m,n) * R(n,n)^(-1) for an upper-triangular R, in parallel over row blocks. **/
+{
+ const size_t nb=(m+QR_ROW_BLOCK-1)/QR_ROW_BLOCK;
+#pragma omp parallel for schedule(static)
+ for(long long b=0; b<(long long)nb; ++b){
+  const size_t r0=b*QR_ROW_BLOCK, nr=std::min(QR_ROW_BLOCK,m-r0);
+  for(size_t j=0; j<n; ++j){
+   T * aj=&(a[j*m+r0]);
+   for(size_t k=0; k<j; ++k){
+    const T rkj=r[j*n+k]; const T * ak=&(a[k*m+r0]);
+    for(size_t i=0; i<nr; ++i) aj[i]-=ak[i]*rkj;
+   }
+   const T rinv=talsh_small_scalar<T>(1.0,0.0)/r[j*n+j];
+   for(size_t i=0; i<nr; ++i) aj[i]*=rinv;
+  }
+ }
+ return;
+}
+
+template <typename T>
+static void talsh_qr_mgs(size_t m, size_t n, T * a, T * r)
+/** Fallback QR via the twice-iterated modified Gram-Schmidt: A(m,n) := Q(m,n), R(n,n) upper-triangular.
+    Numerically dependent columns get zero diagonal elements in R and are replaced in Q by
+    unit vectors orthogonalized against the preceding columns, thus Q is always an isometry. **/
+{
+ typedef typename talsh_svd_real<T>::type RT;
+ const RT tiny=std::numeric_limits<RT>::epsilon()*RT(16);
+ const T zero=talsh_small_scalar<T>(0.0,0.0);
+
+ for(size_t i=0; i<n*n; ++i) r[i]=zero;
+ for(size_t j=0; j<n; ++j){
+  T * aj=&(a[j*m]);
+  const RT nrm0=std::sqrt(talsh_svd_nrm2sq(m,aj));
+  for(int pass=0; pass<2; ++pass){
+   for(size_t k=0; k<j; ++k){
+    const T * ak=&(a[k*m]); const T d=talsh_svd_dot(m,ak,aj);
+    for(size_t i=0; i<m; ++i) aj[i]-=d*ak[i];
+    r[j*n+k]+=d;
+   }
+  }
+  RT nrm=std::sqrt(talsh_svd_nrm2sq(m,aj));
+  if(nrm > tiny*nrm0 && nrm > RT(0)){
+   r[j*n+j]=talsh_small_scalar<T>(nrm,0.0);
+  }else{ //dependent column: complete the orthonormal basis
+   for(size_t e=0; e<m; ++e){
+    for(size_t i=0; i<m; ++i) aj[i]=zero;
+    aj[e]=talsh_small_scalar<T>(1.0,0.0);
+    for(int pass=0; pass<2; ++pass){
+     for(size_t k=0; k<j; ++k){
+      const T * ak=&(a[k*m]); const T d=talsh_svd_dot(m,ak,aj);
+      for(size_t i=0; i<m; ++i) aj[i]-=d*ak[i];
+     }
+    }
+    nrm=std::sqrt(talsh_svd_nrm2sq(m,aj));
+    if(nrm > RT(0.5)) break;
+   }
+  }
+  const RT inv=RT(1)/nrm; for(size_t i=0; i<m; ++i) aj[i]*=inv;
+ }
+ return;
+}
+
+template <typename T>
+static void talsh_qr_kernel(size_t m, size_t n, const T * a, T * q, T * r)
+/** Thin QR of a tall-skinny matrix A(m,n) = Q(m,n) * R(n,n) via CholeskyQR2,
+    falling back to the modified Gram-Schmidt for (numerically) rank-deficient A. **/
+{
+ std::vector<T> g(n*n),r1(n*n),r2(n*n);
+ const T zero=talsh_small_scalar<T>(0.0,0.0);
+
+ std::copy(a,a+m*n,q);
+ bool success=false;
+ talsh_qr_gram(m,n,q,g.data());
+ if(talsh_qr_cholesky(n,g.data(),r1.data())){
+  talsh_qr_trsm(m,n,q,r1.data());
+  talsh_qr_gram(m,n,q,g.data());
+  if(talsh_qr_cholesky(n,g.data(),r2.data())){
+   talsh_qr_trsm(m,n,q,r2.data());
+   for(size_t j=0; j<n; ++j){ //R = R2 * R1
+    for(size_t i=0; i<n; ++i){
+     T s=zero;
+     for(size_t k=i; k<=j; ++k) s+=r2[k*n+i]*r1[j*n+k];
+     r[j*n+i]=s;
+    }
+   }
+   success=true;
+  }
+ }
+ if(!success){
+  std::copy(a,a+m*n,q);
+  talsh_qr_mgs(m,n,q,r);
+ }
+ return;
+}
+
+static int talsh_tensor_qr(talsh_tens_t * dtens, int dimg, int nlu, talsh_tens_t * qtens, talsh_tens_t * rtens)
+/** Native thin QR on Host. The destination tensor must already be permuted into the matricized
+    form D(left,right), with the volume of the left part not smaller than that of the right part,
+    the latter coinciding with the volume of the contracted part. The Q and R tensor factors
+    must have their only (Host) body image #0. **/
+{
+ size_t m=1,n,nv;
+ for(int i=0; i<nlu; ++i) m*=dtens->shape_p->dims[i];
+ n=talshTensorVolume(dtens)/m; nv=talshTensorVolume(rtens)/n;
+ if(nv != n || m < n || talshTensorVolume(qtens) != m*nv) return TALSH_INVALID_ARGS;
+ void * dbody=dtens->dev_rsc[dimg].gmem_p;
+ void * qbody=qtens->dev_rsc[0].gmem_p;
+ void * rbody=rtens->dev_rsc[0].gmem_p;
+ switch(dtens->data_kind[dimg]){
+  case R4: talsh_qr_kernel<float>(m,n,(const float*)dbody,(float*)qbody,(float*)rbody); break;
+  case R8: talsh_qr_kernel<double>(m,n,(const double*)dbody,(double*)qbody,(double*)rbody); break;
+  case C4: talsh_qr_kernel<std::complex<float> >(m,n,(const std::complex<float>*)dbody,
+                                                 (std::complex<float>*)qbody,(std::complex<float>*)rbody); break;
+  case C8: talsh_qr_kernel<std::complex<double> >(m,n,(const std::complex<double>*)dbody,
+                                                  (std::complex<double>*)qbody,(std::complex<double>*)rbody); break;
+  default: return TALSH_INVALID_ARGS;
+ }
+ return TALSH_SUCCESS;
+}
+
+static size_t talsh_slice_strides(const talsh_tens_slice_t * slice, size_t * strides)
+/** Returns the base offset of a tensor slice inside its host-tensor body
+    together with the strides of the host-tensor dimensions (column-major). **/
+{
+ const int rank=slice->shape.num_dim;
+ const int * dims=slice->tensor->shape_p->dims;
+ size_t base=0,stride=1;
+ for(int i=0; i<rank; ++i){
+  strides[i]=stride; base+=slice->bases.offsets[i]*stride; stride*=dims[i];
+ }
+ return base;
+}
+
+static void talsh_slice_offsets(int ndims, const int * ext, const size_t * sa, const size_t * sb,
+                                std::vector<size_t> & oa, std::vector<size_t> & ob)
+/** Tabulates the offsets of all multi-indices of a group of dimensions (first dimension fastest)
+    in two strided operands simultaneously. **/
+{
+ oa.assign(1,0); ob.assign(1,0);
+ for(int d=0; d<ndims; ++d){
+  const size_t old=oa.size();
+  oa.resize(old*ext[d]); ob.resize(old*ext[d]);
+  for(int i=ext[d]-1; i>=0; --i){
+   for(size_t j=0; j<old; ++j){oa[i*old+j]=oa[j]+i*sa[d]; ob[i*old+j]=ob[j]+i*sb[d];}
+  }
+ }
+ return;
+}
+
+typedef struct{
+ std::vector<size_t> lm,dm; //M: offsets of the dimensions shared by L and D
+ std::vector<size_t> rn,dn; //N: offsets of the dimensions shared by R and D
+ std::vector<size_t> lk,rk; //K: offsets of the dimensions contracted between L and R
+ size_t dbase,lbase,rbase;  //base offsets of the slices inside their host-tensor bodies
+} talsh_slice_tables_t;
+
+static void talsh_slice_index_tables(const int * contr_ptrn, const talsh_tens_slice_t * dslice,
+                                     const talsh_tens_slice_t * lslice, const talsh_tens_slice_t * rslice,
+                                     talsh_slice_tables_t * tabs)
+/** Tabulates the M, N, K multi-index offsets of a contraction of tensor slices (rslice = NULL: addition). **/
+{
+ size_t dstr[MAX_TENSOR_RANK],lstr[MAX_TENSOR_RANK],rstr[MAX_TENSOR_RANK];
+ size_t sa[MAX_TENSOR_RANK]={0},sb[MAX_TENSOR_RANK]={0};
+ int ext[MAX_TENSOR_RANK]={0},n;
+
+ const int lrank=lslice->shape.num_dim;
+ const int rrank=((rslice != NULL)?rslice->shape.num_dim:0);
+ tabs->dbase=talsh_slice_strides(dslice,dstr);
+ tabs->lbase=talsh_slice_strides(lslice,lstr);
+ tabs->rbase=((rslice != NULL)?talsh_slice_strides(rslice,rstr):0);
+ n=0;
+ for(int i=0; i<lrank; ++i){
+  if(contr_ptrn[i] > 0){ext[n]=lslice->shape.dims[i]; sa[n]=lstr[i]; sb[n]=dstr[contr_ptrn[i]-1]; ++n;}
+ }
+ talsh_slice_offsets(n,ext,sa,sb,tabs->lm,tabs->dm);
+ n=0;
+ for(int i=0; i<rrank; ++i){
+  if(contr_ptrn[lrank+i] > 0){ext[n]=rslice->shape.dims[i]; sa[n]=rstr[i]; sb[n]=dstr[contr_ptrn[lrank+i]-1]; ++n;}
+ }
+ talsh_slice_offsets(n,ext,sa,sb,tabs->rn,tabs->dn);
+ n=0;
+ for(int i=0; i<lrank; ++i){
+  if(contr_ptrn[i] < 0){ext[n]=lslice->shape.dims[i]; sa[n]=lstr[i]; sb[n]=rstr[-contr_ptrn[i]-1]; ++n;}
+ }
+ talsh_slice_offsets(n,ext,sa,sb,tabs->lk,tabs->rk);
+ return;
+}
+
+template <typename T>
+static int talsh_slice_contract_kernel(const talsh_slice_tables_t & tabs, T * dbody, const T * lbody, const T * rbody,
+                                       T alpha, bool conj_l, bool conj_r, bool accum, bool screen)
+/** Strided GEMM on tensor slice views: D(M,N) (+)= alpha * L(M,K) * R(K,N), where the M, N, K
+    multi-indices are tabulated as offsets into the host-tensor bodies. rbody = NULL means a
+    (permuted) addition/copy D(M) (+)= alpha * L(M). Output blocks are processed in parallel.
+    If <screen>, returns non-zero when a NaN/Inf has been written into D (fused into the output epilogue). **/
+{
+ const size_t MB=64, NB=16;
+ const T zero=talsh_small_scalar<T>(0.0,0.0);
+ const T one=talsh_small_scalar<T>(1.0,0.0);
+ const std::vector<size_t> &lm=tabs.lm, &dm=tabs.dm, &rn=tabs.rn, &dn=tabs.dn, &lk=tabs.lk, &rk=tabs.rk;
+
+ dbody+=tabs.dbase; lbody+=tabs.lbase;
+ if(rbody != NULL) rbody+=tabs.rbase;
+ const size_t msz=lm.size(), nsz=rn.size(), ksz=lk.size();
+ const size_t mbl=(msz+MB-1)/MB, nbl=(nsz+NB-1)/NB;
+ int nonfin=0;
+#pragma omp parallel for schedule(dynamic) reduction(|:nonfin)
+ for(long long blk=0; blk<(long long)(mbl*nbl); ++blk){
+  T acc[MB*NB];
+  const size_t m0=(blk%mbl)*MB, mlen=std::min(MB,msz-m0);
+  const size_t n0=(blk/mbl)*NB, nlen=std::min(NB,nsz-n0);
+  for(size_t i=0; i<MB*NB; ++i) acc[i]=zero;
+  for(size_t k=0; k<ksz; ++k){
+   const T * lp=lbody+lk[k];
+   for(size_t j=0; j<nlen; ++j){
+    T rv=one;
+    if(rbody != NULL){rv=rbody[rk[k]+rn[n0+j]]; if(conj_r) rv=talsh_small_conj(rv);}
+    T * ap=&(acc[j*MB]);
+    if(conj_l){
+     for(size_t i=0; i<mlen; ++i) ap[i]+=talsh_small_conj(lp[lm[m0+i]])*rv;
+    }else{
+     for(size_t i=0; i<mlen; ++i) ap[i]+=lp[lm[m0+i]]*rv;
+    }
+   }
+  }
+  for(size_t j=0; j<nlen; ++j){
+   T * dp=dbody+dn[n0+j];
+   if(accum){
+    for(size_t i=0; i<mlen; ++i) dp[dm[m0+i]]+=alpha*acc[j*MB+i];
+   }else{
+    for(size_t i=0; i<mlen; ++i) dp[dm[m0+i]]=alpha*acc[j*MB+i];
+   }
+   if(screen){
+    for(size_t i=0; i<mlen; ++i) nonfin|=talsh_nonfinite(dp[dm[m0+i]]);
+   }
+  }
+ }
+ return nonfin;
+}
+
+template <typename R>
+static int talsh_slice_contract_split(const talsh_slice_tables_t & tabs, std::complex<R> * dbody,
+                                      const std::complex<R> * lbody, const std::complex<R> * rbody,
+                                      std::complex<R> alpha, bool conj_l, bool conj_r, bool accum, int cgemm_mode,
+                                      bool screen)
+/** Complex strided GEMM on tensor slice views with split-complex (real/imaginary) panels:
+    Each (MB x KB) panel of L and (KB x NB) panel of R is unpacked into separate real and imaginary
+    arrays, such that the inner products are plain real FMA streams. TALSH_CGEMM_4M computes
+    the four real products, TALSH_CGEMM_3M computes Re = Lr*Rr - Li*Ri, Im = (Lr+Li)*(Rr+Ri) - Lr*Rr - Li*Ri.
+    If <screen>, returns non-zero when a NaN/Inf has been written into D (fused into the merge epilogue). **/
+{
+ const size_t MB=64, NB=16, KB=64;
+ const std::vector<size_t> &lm=tabs.lm, &dm=tabs.dm, &rn=tabs.rn, &dn=tabs.dn, &lk=tabs.lk, &rk=tabs.rk;
+ const R lsgn=(conj_l?R(-1):R(1)), rsgn=(conj_r?R(-1):R(1));
+
+ dbody+=tabs.dbase; lbody+=tabs.lbase; rbody+=tabs.rbase;
+ const size_t msz=lm.size(), nsz=rn.size(), ksz=lk.size();
+ const size_t mbl=(msz+MB-1)/MB, nbl=(nsz+NB-1)/NB;
+ int nonfin=0;
+#pragma omp parallel
+ {
+  std::vector<R> buf(KB*MB*3+KB*NB*3+MB*NB*3);
+  R * lre=&(buf[0]); R * lim=lre+KB*MB; R * lsm=lim+KB*MB;
+  R * rre=lsm+KB*MB; R * rim=rre+KB*NB; R * rsm=rim+KB*NB;
+  R * acc0=rsm+KB*NB; R * acc1=acc0+MB*NB; R * acc2=acc1+MB*NB;
+#pragma omp for schedule(dynamic) reduction(|:nonfin)
+  for(long long blk=0; blk<(long long)(mbl*nbl); ++blk){
+   const size_t m0=(blk%mbl)*MB, mlen=std::min(MB,msz-m0);
+   const size_t n0=(blk/mbl)*NB, nlen=std::min(NB,nsz-n0);
+   for(size_t i=0; i<MB*NB*3; ++i) acc0[i]=R(0);
+   for(size_t k0=0; k0<ksz; k0+=KB){
+    const size_t klen=std::min(KB,ksz-k0);
+    //Unpack the panels into the split-complex layout:
+    for(size_t k=0; k<klen; ++k){
+     const std::complex<R> * lp=lbody+lk[k0+k];
+     for(size_t i=0; i<mlen; ++i){
+      const std::complex<R> v=lp[lm[m0+i]];
+      lre[k*MB+i]=v.real(); lim[k*MB+i]=lsgn*v.imag(); lsm[k*MB+i]=lre[k*MB+i]+lim[k*MB+i];
+     }
+     const std::complex<R> * rp=rbody+rk[k0+k];
+     for(size_t j=0; j<nlen; ++j){
+      const std::complex<R> v=rp[rn[n0+j]];
+      rre[k*NB+j]=v.real(); rim[k*NB+j]=rsgn*v.imag(); rsm[k*NB+j]=rre[k*NB+j]+rim[k*NB+j];
+     }
+    }
+    //Real GEMM streams:
+    if(cgemm_mode == TALSH_CGEMM_3M){
+     for(size_t k=0; k<klen; ++k){
+      const R * a0=&(lre[k*MB]); const R * a1=&(lim[k*MB]); const R * a2=&(lsm[k*MB]);
+      for(size_t j=0; j<nlen; ++j){
+       const R b0=rre[k*NB+j], b1=rim[k*NB+j], b2=rsm[k*NB+j];
+       R * c0=&(acc0[j*MB]); R * c1=&(acc1[j*MB]); R * c2=&(acc2[j*MB]);
+       for(size_t i=0; i<mlen; ++i){c0[i]+=a0[i]*b0; c1[i]+=a1[i]*b1; c2[i]+=a2[i]*b2;}
+      }
+     }
+    }else{
+     for(size_t k=0; k<klen; ++k){
+      const R * a0=&(lre[k*MB]); const R * a1=&(lim[k*MB]);
+      for(size_t j=0; j<nlen; ++j){
+       const R b0=rre[k*NB+j], b1=rim[k*NB+j];
+       R * c0=&(acc0[j*MB]); R * c1=&(acc1[j*MB]);
+       for(size_t i=0; i<mlen; ++i){c0[i]+=a0[i]*b0-a1[i]*b1; c1[i]+=a0[i]*b1+a1[i]*b0;}
+      }
+     }
+    }
+   }
+   //Merge back into the interleaved layout:
+   for(size_t j=0; j<nlen; ++j){
+    std::complex<R> * dp=dbody+dn[n0+j];
+    for(size_t i=0; i<mlen; ++i){
+     const size_t l=j*MB+i;
+     const std::complex<R> v=((cgemm_mode == TALSH_CGEMM_3M)?
+                              std::complex<R>(acc0[l]-acc1[l],acc2[l]-acc0[l]-acc1[l]):
+                              std::complex<R>(acc0[l],acc1[l]));
+     if(accum){dp[dm[m0+i]]+=alpha*v;}else{dp[dm[m0+i]]=alpha*v;}
+     if(screen) nonfin|=talsh_nonfinite(dp[dm[m0+i]]);
+    }
+   }
+  }
+ }
+ return nonfin;
+}
+
+template <typename R>
+static void talsh_complex_split(size_t vol, const std::complex<R> * cbody, R * rbody, R * ibody)
+/** Converts an interleaved complex array into the split-complex layout (OpenMP parallel loop). **/
+{
+#pragma omp parallel for schedule(static)
+ for(long long l=0; l<(long long)vol; ++l){rbody[l]=cbody[l].real(); ibody[l]=cbody[l].imag();}
+ return;
+}
+
+template <typename R>
+static void talsh_complex_merge(size_t vol, std::complex<R> * cbody, const R * rbody, const R * ibody)
+/** Converts a split-complex array into the interleaved complex layout (OpenMP parallel loop). **/
+{
+#pragma omp parallel for schedule(static)
+ for(long long l=0; l<(long long)vol; ++l) cbody[l]=std::complex<R>(rbody[l],ibody[l]);
+ return;
+}
+
+static void talsh_stream_copy(void * dst, const void * src, size_t bytes)
+/** Copies memory with non-temporal (cache-bypassing) stores, if available. **/
+{
+#ifdef __SSE2__
+ char * d=static_cast<char*>(dst);
+ const char * s=static_cast<const char*>(src);
+ size_t head=(16-(reinterpret_cast<size_t>(d)%16))%16; if(head > bytes) head=bytes;
+ std::memcpy(d,s,head); d+=head; s+=head; bytes-=head;
+ const size_t n=bytes/16;
+ for(size_t i=0; i<n; ++i) _mm_stream_si128(reinterpret_cast<__m128i*>(d)+i,_mm_loadu_si128(reinterpret_cast<const __m128i*>(s)+i));
+ std::memcpy(d+n*16,s+n*16,bytes-n*16);
+ _mm_sfence();
+#else
+ std::memcpy(dst,src,bytes);
+#endif
+ return;
+}
+
+template <typename R>
+static void talsh_complex_relayout(size_t vol, void * body, void * temp, int split)
+/** Converts a complex tensor body between the interleaved and the split-complex (split = YEP)
+    layouts in place, via a temporary buffer of the same size. **/
+{
+ if(split == YEP){
+  talsh_complex_split<R>(vol,static_cast<const std::complex<R>*>(body),static_cast<R*>(temp),static_cast<R*>(temp)+vol);
+ }else{
+  talsh_complex_merge<R>(vol,static_cast<std::complex<R>*>(temp),static_cast<const R*>(body),static_cast<const R*>(body)+vol);
+ }
+ talsh_stream_copy(body,temp,vol*2*sizeof(R));
+ return;
+}
+
+template <typename D, typename S>
+static inline void talsh_convert_value(D & d, const S & s){d=static_cast<D>(s);}
+template <typename D, typename S>
+static inline void talsh_convert_value(std::complex<D> & d, const S & s){d=std::complex<D>(static_cast<D>(s),D(0));}
+template <typename D, typename S>
+static inline void talsh_convert_value(std::complex<D> & d, const std::complex<S> & s){
+ d=std::complex<D>(static_cast<D>(s.real()),static_cast<D>(s.imag()));}
+
+template <typename D, typename S>
+static void talsh_data_transfer_kernel(size_t vol, D * dst, const S * src)
+/** Copies/converts <vol> elements in parallel: Each thread processes one contiguous
+    page-aligned chunk of the destination, such that the pages are touched by the same
+    threads as on a static-parallel initialization. Large same-kind copies use non-temporal stores. **/
+{
+ const bool streaming=(std::is_same<D,S>::value && vol*sizeof(D) >= DATA_XFER_NT_MIN);
+#pragma omp parallel
+ {
+  size_t nthr=1, tid=0;
+#ifndef NO_OMP
+  nthr=omp_get_num_threads(); tid=omp_get_thread_num();
+#endif
+  const size_t page=std::max(DATA_XFER_PAGE/sizeof(D),(size_t)1);
+  const size_t chunk=((vol+nthr-1)/nthr+page-1)/page*page;
+  const size_t beg=std::min(vol,tid*chunk), end=std::min(vol,beg+chunk);
+  if(end > beg){
+   if(streaming){
+    talsh_stream_copy(static_cast<void*>(dst+beg),static_cast<const void*>(src+beg),(end-beg)*sizeof(D));
+   }else{
+    for(size_t l=beg; l<end; ++l) talsh_convert_value(dst[l],src[l]);
+   }
+  }
+ }
+ return;
+}
+
+static int talsh_data_transfer(size_t vol, int dst_kind, void * dst, int src_kind, const void * src)
+/** Copies/converts a tensor body between two data kinds (complex into real is not allowed). **/
+{
+ switch(dst_kind){
+  case R4:
+   switch(src_kind){
+    case R4: talsh_data_transfer_kernel(vol,(float*)dst,(const float*)src); break;
+    case R8: talsh_data_transfer_kernel(vol,(float*)dst,(const double*)src); break;
+    default: return TALSH_INVALID_ARGS;
+   }
+   break;
+  case R8:
+   switch(src_kind){
+    case R4: talsh_data_transfer_kernel(vol,(double*)dst,(const float*)src); break;
+    case R8: talsh_data_transfer_kernel(vol,(double*)dst,(const double*)src); break;
+    default: return TALSH_INVALID_ARGS;
+   }
+   break;
+  case C4:
+   switch(src_kind){
+    case R4: talsh_data_transfer_kernel(vol,(std::complex<float>*)dst,(const float*)src); break;
+    case R8: talsh_data_transfer_kernel(vol,(std::complex<float>*)dst,(const double*)src); break;
+    case C4: talsh_data_transfer_kernel(vol,(std::complex<float>*)dst,(const std::complex<float>*)src); break;
+    case C8: talsh_data_transfer_kernel(vol,(std::complex<float>*)dst,(const std::complex<double>*)src); break;
+    default: return TALSH_INVALID_ARGS;
+   }
+   break;
+  case C8:
+   switch(src_kind){
+    case R4: talsh_data_transfer_kernel(vol,(std::complex<double>*)dst,(const float*)src); break;
+    case R8: talsh_data_transfer_kernel(vol,(std::complex<double>*)dst,(const double*)src); break;
+    case C4: talsh_data_transfer_kernel(vol,(std::complex<double>*)dst,(const std::complex<float>*)src); break;
+    case C8: talsh_data_transfer_kernel(vol,(std::complex<double>*)dst,(const std::complex<double>*)src); break;
+    default: return TALSH_INVALID_ARGS;
+   }
+   break;
+  default:
+   return TALSH_INVALID_ARGS;
+ }
+ return TALSH_SUCCESS;
+}
+
+static int talsh_tensor_data_transfer(talsh_tens_t * tens_block, int data_kind, void * ext_data,
+                                      int import, talsh_task_t * talsh_task)
+/** Imports (import = YEP) or exports (import = NOPE) the Host tensor body from/into external data.
+    With a TAL-SH task, the transfer is executed asynchronously by a Host thread and the tensor
+    body image remains unavailable until the task is completed. **/
+{
+ int j,errc,himg,hkind,dks;
+ host_task_t * host_task;
+
+#pragma omp flush
+ if(talsh_on == 0) return TALSH_NOT_INITIALIZED;
+ if(tens_block == NULL || ext_data == NULL) return TALSH_INVALID_ARGS;
+ if(talshValidDataKind(data_kind,&dks) != YEP) return TALSH_INVALID_ARGS;
+ if(talshTensorIsEmpty(tens_block) != NOPE) return TALSH_OBJECT_IS_EMPTY;
+ if(talshTensorIsHealthy(tens_block) != YEP) return TALSH_FAILURE;
+ if(talshTensorInUse(tens_block) != NOPE) return TALSH_NOT_ALLOWED;
+ errc=talsh_tensor_inflate(tens_block); if(errc != TALSH_SUCCESS) return errc;
+ errc=talsh_tensor_interleave(tens_block); if(errc != TALSH_SUCCESS) return errc;
+ //Select the Host image (same data kind preferred):
+ himg=-1; hkind=NO_TYPE;
+ for(int i=0; i<tens_block->ndev; ++i){
+  if(tens_block->dev_rsc[i].dev_id == talshFlatDevId(DEV_HOST,0)){
+   if(tens_block->data_kind[i] == data_kind){himg=i; hkind=data_kind; break;}
+   if(himg < 0){himg=i; hkind=tens_block->data_kind[i];}
+  }
+ }
+ if(himg < 0) return TALSH_NOT_FOUND;
+ talsh_tensor_expose_body(tens_block);
+ if(import == YEP){
+  if((hkind == R4 || hkind == R8) && (data_kind == C4 || data_kind == C8)) return TALSH_INVALID_ARGS;
+  errc=talsh_tensor_image_discard_other(tens_block,himg); if(errc != TALSH_SUCCESS) return TALSH_FAILURE;
+  himg=0;
+ }else{
+  if((data_kind == R4 || data_kind == R8) && (hkind == C4 || hkind == C8)) return TALSH_INVALID_ARGS;
+ }
+ const size_t vol=talshTensorVolume(tens_block);
+ void * body=tens_block->dev_rsc[himg].gmem_p;
+ const int dst_kind=((import == YEP)?hkind:data_kind), src_kind=((import == YEP)?data_kind:hkind);
+ void * dst=((import == YEP)?body:ext_data);
+ const void * src=((import == YEP)?ext_data:body);
+ if(talsh_task == NULL) return talsh_data_transfer(vol,dst_kind,dst,src_kind,src); //blocking
+ //Asynchronous transfer:
+ errc=talshTaskConstruct(talsh_task,DEV_HOST,COPY_T,hkind); if(errc != TALSH_SUCCESS) return errc;
+ host_task=(host_task_t*)(talsh_task->task_p);
+ errc=talshTaskSetArg(talsh_task,tens_block,himg);
+ if(errc == TALSH_SUCCESS) errc=host_task_record(host_task,COPY_T,0);
+ if(errc != TALSH_SUCCESS){ //destruct the half-built task
+  j=host_task_destroy(host_task); talsh_task->task_p=NULL; talsh_task->task_error=13;
+  j=talshTaskDestruct(talsh_task);
+  return errc;
+ }
+ host_task->task_error=-1; //scheduled
+ tens_block->avail[himg]=NOPE; //the image is in use until the task is finalized
+#pragma omp flush
+ try{
+  {std::lock_guard<std::mutex> guard(talsh_xfer_lock); talsh_xfer_tasks.insert(host_task);}
+  host_task->worker=new std::thread([=](){
+   int ierr=talsh_data_transfer(vol,dst_kind,dst,src_kind,src);
+   host_task->task_error=((ierr == TALSH_SUCCESS)?0:13);
+  });
+ }catch(...){
+  {std::lock_guard<std::mutex> guard(talsh_xfer_lock); talsh_xfer_tasks.erase(host_task);}
+  host_task->task_error=13; tens_block->avail[himg]=YEP;
+  return TALSH_FAILURE;
+ }
+ return TALSH_SUCCESS;
+}
+
+static int talsh_tensor_host_image(const talsh_tens_t * tens, int * data_kind)
+/** Returns the available Host body image of a tensor and its data kind (-1: none). **/
+{
+ for(int i=0; i<tens->ndev; ++i){
+  if(tens->dev_rsc[i].dev_id == talshFlatDevId(DEV_HOST,0) && tens->avail[i] == YEP){
+   *data_kind=tens->data_kind[i]; return i;
+  }
+ }
+ return -1;
+}
+
+static int talsh_slice_op_exec(const talsh_slice_tables_t & tabs, int dtk, void * dbody, const void * lbody, const void * rbody,
+                               double scale_real, double scale_imag, int conj_bits, int accumulative, int * nonfinite)
+/** Executes a tabulated tensor slice contraction (rbody != NULL) or addition on Host bodies of data kind <dtk>. **/
+{
+ const bool conj_l=((conj_bits&2) != 0), conj_r=((conj_bits&4) != 0), accum=(accumulative != NOPE);
+ const bool screen=(nonfinite != NULL);
+ int nonfin=0;
+ switch(dtk){
+  case R4:
+   nonfin=talsh_slice_contract_kernel<float>(tabs,(float*)dbody,(const float*)lbody,(const float*)rbody,
+    talsh_small_scalar<float>(scale_real,scale_imag),conj_l,conj_r,accum,screen);
+   break;
+  case R8:
+   nonfin=talsh_slice_contract_kernel<double>(tabs,(double*)dbody,(const double*)lbody,(const double*)rbody,
+    talsh_small_scalar<double>(scale_real,scale_imag),conj_l,conj_r,accum,screen);
+   break;
+  case C4:
+   if(rbody != NULL){
+    nonfin=talsh_slice_contract_split<float>(tabs,(std::complex<float>*)dbody,(const std::complex<float>*)lbody,
+     (const std::complex<float>*)rbody,std::complex<float>(scale_real,scale_imag),conj_l,conj_r,accum,talsh_cgemm_mode,screen);
+   }else{
+    nonfin=talsh_slice_contract_kernel<std::complex<float> >(tabs,(std::complex<float>*)dbody,(const std::complex<float>*)lbody,NULL,
+     std::complex<float>(scale_real,scale_imag),conj_l,conj_r,accum,screen);
+   }
+   break;
+  case C8:
+   if(rbody != NULL){
+    nonfin=talsh_slice_contract_split<double>(tabs,(std::complex<double>*)dbody,(const std::complex<double>*)lbody,
+     (const std::complex<double>*)rbody,std::complex<double>(scale_real,scale_imag),conj_l,conj_r,accum,talsh_cgemm_mode,screen);
+   }else{
+    nonfin=talsh_slice_contract_kernel<std::complex<double> >(tabs,(std::complex<double>*)dbody,(const std::complex<double>*)lbody,NULL,
+     std::complex<double>(scale_real,scale_imag),conj_l,conj_r,accum,screen);
+   }
+   break;
+  default:
+   return TALSH_INVALID_ARGS;
+ }
+ if(nonfinite != NULL) *nonfinite=((nonfin != 0)?YEP:NOPE);
+ return TALSH_SUCCESS;
+}
+
+static int talsh_tensor_slice_op(const char * cptrn, talsh_tens_slice_t * dslice, const talsh_tens_slice_t * lslice,
+                                 const talsh_tens_slice_t * rslice, double scale_real, double scale_imag, int accumulative,
+                                 int * nonfinite)
+/** Executes a tensor contraction (rslice != NULL) or addition/copy directly on tensor slice views
+    residing on Host, without extracting the slices into separate tensors. If <nonfinite> is not NULL,
+    the destination slice is screened for NaN/Inf while being written (YEP/NOPE is returned there). **/
+{
+ int contr_ptrn[MAX_TENSOR_RANK*2],drnk,lrnk,rrnk,conj_bits,dimg,limg,rimg,dtk=NO_TYPE,ltk=NO_TYPE,rtk=NO_TYPE;
+ void *dbody,*lbody,*rbody;
+
+ if(talsh_on == 0) return TALSH_NOT_INITIALIZED;
+ if(cptrn == NULL || dslice == NULL || lslice == NULL) return TALSH_INVALID_ARGS;
+ if(dslice->tensor == NULL || lslice->tensor == NULL || (rslice != NULL && rslice->tensor == NULL)) return TALSH_INVALID_ARGS;
+ if(talsh_get_contr_ptrn_str2dig(cptrn,contr_ptrn,&drnk,&lrnk,&rrnk,&conj_bits) != 0) return TALSH_INVALID_ARGS;
+ if(drnk != dslice->shape.num_dim || lrnk != lslice->shape.num_dim) return TALSH_INVALID_ARGS;
+ if(rslice != NULL){
+  if(rrnk != rslice->shape.num_dim) return TALSH_INVALID_ARGS;
+ }else{
+  if(rrnk != 0) return TALSH_INVALID_ARGS;
+ }
+ if((conj_bits&1) != 0) return TALSH_NOT_IMPLEMENTED; //conjugated destination
+ //Check dimension extent consistency:
+ for(int i=0; i<lrnk; ++i){
+  const int j=contr_ptrn[i];
+  if(j > 0){
+   if(lslice->shape.dims[i] != dslice->shape.dims[j-1]) return TALSH_INVALID_ARGS;
+  }else if(j < 0 && rslice != NULL){
+   if(lslice->shape.dims[i] != rslice->shape.dims[-j-1]) return TALSH_INVALID_ARGS;
+  }else{
+   return TALSH_INVALID_ARGS;
+  }
+ }
+ for(int i=0; i<rrnk; ++i){
+  const int j=contr_ptrn[lrnk+i];
+  if(j > 0){
+   if(rslice->shape.dims[i] != dslice->shape.dims[j-1]) return TALSH_INVALID_ARGS;
+  }else if(j == 0){
+   return TALSH_INVALID_ARGS;
+  }
+ }
+ //Decompress compressed operands and restore the interleaved layout of split-complex operands:
+ if(talsh_tensor_inflate(dslice->tensor) != TALSH_SUCCESS || talsh_tensor_inflate(lslice->tensor) != TALSH_SUCCESS) return TRY_LATER;
+ if(rslice != NULL){if(talsh_tensor_inflate(rslice->tensor) != TALSH_SUCCESS) return TRY_LATER;}
+ if(talsh_tensor_interleave(dslice->tensor) != TALSH_SUCCESS || talsh_tensor_interleave(lslice->tensor) != TALSH_SUCCESS) return TRY_LATER;
+ if(rslice != NULL){if(talsh_tensor_interleave(rslice->tensor) != TALSH_SUCCESS) return TRY_LATER;}
+ //Locate Host body images (all operands must share the same data kind):
+ dimg=talsh_tensor_host_image(dslice->tensor,&dtk);
+ limg=talsh_tensor_host_image(lslice->tensor,&ltk);
+ rimg=0; rtk=dtk; rbody=NULL;
+ if(rslice != NULL) rimg=talsh_tensor_host_image(rslice->tensor,&rtk);
+ if(dimg < 0 || limg < 0 || rimg < 0) return TALSH_NOT_AVAILABLE;
+ if(ltk != dtk || rtk != dtk) return TALSH_NOT_AVAILABLE;
+ if((dtk == R4 || dtk == R8) && scale_imag != 0.0) return TALSH_INVALID_ARGS;
+ //The destination image becomes the only valid one:
+ if(dslice->tensor->ndev > 1){
+  int errc=talsh_tensor_image_discard_other(dslice->tensor,dimg); if(errc != TALSH_SUCCESS) return errc;
+  dimg=0;
+ }
+ //Pin the operands while their bodies are being accessed:
+ talsh_tens_pins_t pins;
+ talsh_tensor_pins_clean(&pins);
+ talsh_tensor_pins_add(&pins,dslice->tensor); talsh_tensor_pins_add(&pins,lslice->tensor);
+ if(rslice != NULL) talsh_tensor_pins_add(&pins,rslice->tensor);
+ dbody=dslice->tensor->dev_rsc[dimg].gmem_p;
+ lbody=lslice->tensor->dev_rsc[limg].gmem_p;
+ if(rslice != NULL) rbody=rslice->tensor->dev_rsc[rimg].gmem_p;
+ talsh_slice_tables_t tabs;
+ talsh_slice_index_tables(contr_ptrn,dslice,lslice,rslice,&tabs);
+ const int errc=talsh_slice_op_exec(tabs,dtk,dbody,lbody,rbody,scale_real,scale_imag,conj_bits,accumulative,nonfinite);
+ talsh_tensor_pins_release(&pins);
+ return errc;
+}
+
+static int talsh_tens_op_zero_copy_ok(const talsh_tens_op_t * tens_op)
+/** Returns YEP if the tensor operation can be executed directly on its slice views on Host. **/
+{
+ int contr_ptrn[MAX_TENSOR_RANK*2],drnk,lrnk,rrnk,conj_bits,dtk;
+
+ if(tens_op->opkind != TALSH_TENSOR_CONTRACT || tens_op->num_args != 3) return NOPE;
+ if(tens_op->exec_dev_id != talshFlatDevId(DEV_HOST,0) || tens_op->symb_pattern == NULL) return NOPE;
+ if(talsh_get_contr_ptrn_str2dig(tens_op->symb_pattern,contr_ptrn,&drnk,&lrnk,&rrnk,&conj_bits) != 0) return NOPE;
+ if((conj_bits&1) != 0) return NOPE;
+ for(unsigned int i=0; i<tens_op->num_args; ++i){
+  const talsh_tens_t * tens=tens_op->tens_slice[i].tensor;
+  if(talsh_tensor_host_image(tens,&dtk) < 0 || dtk != tens_op->data_kind) return NOPE;
+ }
+ if(tens_op->tens_slice[0].tensor->ndev != 1) return NOPE; //destination must not have other images
+ return YEP;
+}
+
+static std::string talsh_autotune_key(const int * contr_ptrn, int conj_bits, int data_kind,
+                                      const talsh_tens_t * ltens, const talsh_tens_t * rtens)
+/** Returns the autotuning table key of a Host tensor contraction plan:
+    "<data kind>:<conjugation bits>:<number of threads>:<L extents>:<R extents>:<digital contraction pattern>". **/
+{
+ char buf[64];
+ int nthreads=1;
+#ifndef NO_OMP
+ nthreads=omp_get_max_threads();
+#endif
+ std::snprintf(buf,sizeof(buf),"%d:%d:%d",data_kind,conj_bits,nthreads);
+ std::string key(buf);
+ const talsh_tens_shape_t * shapes[2]={ltens->shape_p,rtens->shape_p};
+ for(int k=0; k<2; ++k){
+  key+=':';
+  for(int i=0; i<shapes[k]->num_dim; ++i){
+   std::snprintf(buf,sizeof(buf),((i > 0)?"x%d":"%d"),shapes[k]->dims[i]); key+=buf;
+  }
+ }
+ key+=':';
+ const int cpl=shapes[0]->num_dim+shapes[1]->num_dim;
+ for(int i=0; i<cpl; ++i){
+  std::snprintf(buf,sizeof(buf),((i > 0)?",%d":"%d"),contr_ptrn[i]); key+=buf;
+ }
+ return key;
+}
+
+static int talsh_autotune_candidates(int drank, int conj_bits, int data_kind, double scale_imag, int * cand)
+/** Lists the candidate strategies (TALSH_HOST_CTR_XXX) applicable to a Host tensor contraction, returns their number. **/
+{
+ int n=0;
+ if(cpu_blas_backend() != BLAS_BACKEND_NONE){ //BLAS linked at build time or loaded at run time
+  cand[n++]=TALSH_HOST_CTR_SCATTER_BLAS;
+  cand[n++]=TALSH_HOST_CTR_SHMEM_BLAS;
+ }
+ cand[n++]=TALSH_HOST_CTR_SCATTER_NATIVE;
+ cand[n++]=TALSH_HOST_CTR_SHMEM_NATIVE;
+ //The native slice kernel writes the destination body directly (scalar destinations live in <tensor_block_t>)
+ //and follows the GEMM convention of the native small-tensor path for the right conjugation:
+ if(drank > 0 && (conj_bits&5) == 0 && ((data_kind != R4 && data_kind != R8) || scale_imag == 0.0)){
+  cand[n++]=TALSH_HOST_CTR_SLICE;
+ }
+ return n;
+}
+
+static int talsh_autotune_select(const std::string & key, int ncand, const int * cand, int * trial)
+/** Returns the strategy to execute a Host tensor contraction plan with: Either the tuned one (*trial = NOPE)
+    or the next candidate to be timed (*trial = YEP). A new plan is added to the autotuning table. **/
+{
+ int strategy=cand[0];
+ *trial=NOPE;
+#pragma omp critical(talsh_autotune)
+ {
+  auto it=talsh_autotune_table.find(key);
+  if(it == talsh_autotune_table.end()){
+   talsh_autotune_entry_t entry;
+   entry.strategy=-1; entry.trials=0;
+   for(int i=0; i<TALSH_HOST_CTR_STRATEGIES; ++i) entry.time[i]=-1.0;
+   it=talsh_autotune_table.emplace(key,entry).first;
+  }
+  const talsh_autotune_entry_t & entry=it->second;
+  if(entry.strategy >= 0){ //tuned plan (a strategy not applicable here falls back to the first candidate)
+   for(int i=0; i<ncand; ++i){if(cand[i] == entry.strategy){strategy=entry.strategy; break;}}
+  }else{ //next untimed candidate
+   for(int i=0; i<ncand; ++i){if(entry.time[cand[i]] < 0.0){strategy=cand[i]; *trial=YEP; break;}}
+  }
+ }
+ return strategy;
+}
+
+static void talsh_autotune_record(const std::string & key, int ncand, const int * cand, int strategy, double exec_time)
+/** Records the execution time of a candidate strategy for a Host tensor contraction plan.
+    Once all candidates have been timed, the fastest one becomes the tuned strategy of the plan. **/
+{
+#pragma omp critical(talsh_autotune)
+ {
+  auto it=talsh_autotune_table.find(key);
+  if(it != talsh_autotune_table.end()){
+   talsh_autotune_entry_t & entry=it->second;
+   if(entry.strategy < 0 && entry.time[strategy] < 0.0){
+    entry.time[strategy]=exec_time;
+    if(++(entry.trials) >= ncand){
+     int best=cand[0];
+     for(int i=1; i<ncand; ++i){if(entry.time[cand[i]] < entry.time[best]) best=cand[i];}
+     entry.strategy=best;
+    }
    }
-  }else{
-   ++k;
   }
  }
- tens->ndev=k;
-#pragma omp flush
- return errc;
+ return;
 }
 
-int talshTensorDiscardOther_(talsh_tens_t * tens, int dev_id, int dev_kind) //Fortran wrapper
+static int talsh_autotune_load(const char * db_file)
+/** Loads tuned Host contraction plans from a text database into the autotuning table
+    (a missing database file is not an error: it will be created on save). **/
 {
- return talshTensorDiscardOther(tens,dev_id,dev_kind);
+ char line[1024],key[1024];
+ int strategy,errc;
+ double exec_time;
+
+ FILE * db=fopen(db_file,"r");
+ if(db == NULL) return TALSH_SUCCESS;
+ errc=TALSH_SUCCESS;
+ while(fgets(line,sizeof(line),db) != NULL){
+  if(line[0] == '#' || line[0] == '\n') continue;
+  if(sscanf(line,"%1023s %d %lf",key,&strategy,&exec_time) != 3 ||
+     strategy < 0 || strategy >= TALSH_HOST_CTR_STRATEGIES){
+   if(VERBOSE) printf("#ERROR(talsh_autotune_load): Invalid entry in the autotuning database %s: %s",db_file,line);
+   errc=TALSH_FAILURE; break;
+  }
+  talsh_autotune_entry_t entry;
+  entry.strategy=strategy; entry.trials=0;
+  for(int i=0; i<TALSH_HOST_CTR_STRATEGIES; ++i) entry.time[i]=-1.0;
+  entry.time[strategy]=exec_time;
+#pragma omp critical(talsh_autotune)
+  talsh_autotune_table[std::string(key)]=entry;
+ }
+ fclose(db);
+ return errc;
+}
+
+static int talsh_host_tensor_contract_slice(const int * contr_ptrn, talsh_tens_t * dtens, talsh_tens_t * ltens, int limg,
+                                            talsh_tens_t * rtens, int rimg, double scale_real, double scale_imag,
+                                            int conj_bits, int accumulative, int * nonfinite)
+/** Executes a Host tensor contraction by the native slice kernel, viewing each tensor
+    as a full slice of itself (the destination body image must be image 0). **/
+{
+ size_t zeros[MAX_TENSOR_RANK]={0};
+ talsh_tens_slice_t dslice,lslice,rslice;
+ talsh_tens_t * tens[3]={dtens,ltens,rtens};
+ talsh_tens_slice_t * slice[3]={&dslice,&lslice,&rslice};
+ for(int i=0; i<3; ++i){
+  slice[i]->tensor=tens[i];
+  slice[i]->bases.num_dim=tens[i]->shape_p->num_dim; slice[i]->bases.offsets=zeros;
+  slice[i]->shape=*(tens[i]->shape_p);
+ }
+ talsh_slice_tables_t tabs;
+ talsh_slice_index_tables(contr_ptrn,&dslice,&lslice,&rslice,&tabs);
+ return talsh_slice_op_exec(tabs,dtens->data_kind[0],dtens->dev_rsc[0].gmem_p,ltens->dev_rsc[limg].gmem_p,
+                            rtens->dev_rsc[rimg].gmem_p,scale_real,scale_imag,conj_bits,accumulative,nonfinite);
+}
+
+static int talsh_host_tensor_contract_tuned(const int * contr_ptrn, talsh_tens_t * dtens, void * dftr,
+                                            talsh_tens_t * ltens, int limg, void * lftr,
+                                            talsh_tens_t * rtens, int rimg, void * rftr,
+                                            double scale_real, double scale_imag, int conj_bits, int accumulative,
+                                            int * nonfinite)
+/** Executes a Host tensor contraction with the autotuned strategy of its contraction plan
+    (or with the next candidate strategy to be timed, see talshSetAutotune). The CP-TAL transpose
+    and matrix multiplication algorithms are passed per call, thus tuned and untuned contractions
+    may be executed concurrently. **/
+{
+ int cand[TALSH_HOST_CTR_STRATEGIES],trial,errc;
+
+ const int datk=dtens->data_kind[0];
+ const std::string key=talsh_autotune_key(contr_ptrn,conj_bits,datk,ltens,rtens);
+ const int ncand=talsh_autotune_candidates(talshTensorRank(dtens),conj_bits,datk,scale_imag,cand);
+ const int strategy=talsh_autotune_select(key,ncand,cand,&trial);
+ const double tms=time_high_sec();
+ if(strategy == TALSH_HOST_CTR_SLICE){
+  errc=talsh_host_tensor_contract_slice(contr_ptrn,dtens,ltens,limg,rtens,rimg,scale_real,scale_imag,
+                                        conj_bits,accumulative,nonfinite);
+ }else{
+  errc=cpu_tensor_block_contract_algs(contr_ptrn,lftr,rftr,dftr,scale_real,scale_imag,conj_bits,accumulative,
+                                      strategy&1,(strategy>>1)&1); //per-call algorithms (global switches stay intact)
+ }
+ if(errc == TALSH_SUCCESS && trial != NOPE) talsh_autotune_record(key,ncand,cand,strategy,time_high_sec()-tms);
+ return errc;
 }
 
 int talshTensorInit(talsh_tens_t * dtens,
@@ -3793,7 +6534,7 @@ int talshTensorScale(talsh_tens_t * dtens,
                      talsh_task_t * talsh_task)
 /** Tensor scaling dispatcher **/
 {
- int j,devid,dvk,dvn,dimg,dcp,errc;
+ int j,devid,dvk,dvn,dimg,dcp,errc,small,split;
  unsigned int coh_ctrl,coh,cohd;
  talsh_task_t * tsk;
  host_task_t * host_task;
@@ -3877,10 +6618,15 @@ int talshTensorScale(talsh_tens_t * dtens,
  //Schedule the tensor operation via the device-kind specific runtime:
  switch(dvk){
   case DEV_HOST:
-   //Associate TAL-SH tensor images with <tensor_block_t> objects:
-   errc=talsh_tensor_f_assoc(dtens,dimg,&dftr);
-   if(errc || dftr == NULL){
-    tsk->task_error=111; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
+   //Small tensors and split-complex tensors are processed natively (no <tensor_block_t> association):
+   split=talsh_split_op_ok(NULL,dtens,dimg,NULL,-1,NULL,-1,0);
+   small=((split == YEP)?YEP:talsh_small_op_ok(dtens,dimg,NULL,-1,NULL,-1,0,val_imag));
+   if(small != YEP){
+    //Associate TAL-SH tensor images with <tensor_block_t> objects:
+    errc=talsh_tensor_f_assoc(dtens,dimg,&dftr);
+    if(errc || dftr == NULL){
+     tsk->task_error=111; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
+    }
    }
    //Get the Host task:
    host_task=(host_task_t*)(tsk->task_p);
@@ -3888,7 +6634,9 @@ int talshTensorScale(talsh_tens_t * dtens,
    //Discard all output images except the source one:
    errc=talsh_tensor_image_discard_other(dtens,dimg); //the only remaining image 0 is the source image
    if(errc != TALSH_SUCCESS){
-    j=talsh_tensor_f_dissoc(dftr); if(j) errc=TALSH_FAILURE;
+    if(small != YEP){
+     j=talsh_tensor_f_dissoc(dftr); if(j) errc=TALSH_FAILURE;
+    }
     j=host_task_record(host_task,coh_ctrl,13);
     j=host_task_destroy(host_task); tsk->task_p=NULL; if(j) errc=TALSH_FAILURE;
     tsk->task_error=112; if(talsh_task == NULL) j=talshTaskDestroy(tsk);
@@ -3898,14 +6646,22 @@ int talshTensorScale(talsh_tens_t * dtens,
    dtens->avail[0] = NOPE;
    //Schedule tensor operation via the device-kind specific runtime:
    ctm=clock();
-   errc=cpu_tensor_block_scale(dftr,val_real,val_imag,0); //blocking call
-   if(errc == TALSH_SUCCESS && talshTensorRank(dtens) == 0){ //an explicit update is needed for scalar destinations
-    j=talsh_update_f_scalar(dftr,dtens->data_kind[0],dtens->dev_rsc[0].gmem_p);
-    if(j) errc=TALSH_FAILURE;
+   if(split == YEP){
+    errc=talsh_split_tensor_scale(dtens,val_real,val_imag); //blocking call
+   }else if(small == YEP){
+    errc=talsh_small_tensor_scale(dtens,val_real,val_imag); //blocking call
+   }else{
+    errc=cpu_tensor_block_scale(dftr,val_real,val_imag,0); //blocking call
+    if(errc == TALSH_SUCCESS && talshTensorRank(dtens) == 0){ //an explicit update is needed for scalar destinations
+     j=talsh_update_f_scalar(dftr,dtens->data_kind[0],dtens->dev_rsc[0].gmem_p);
+     if(j) errc=TALSH_FAILURE;
+    }
    }
    tsk->exec_time=((double)(clock()-ctm))/CLOCKS_PER_SEC;
    //Dissociate <tensor_block_t> objects:
-   j=talsh_tensor_f_dissoc(dftr); if(j) errc=TALSH_FAILURE;
+   if(small != YEP){
+    j=talsh_tensor_f_dissoc(dftr); if(j) errc=TALSH_FAILURE;
+   }
    //Host task finalization and coherence control:
    if(errc){ //task error
     if(errc == TRY_LATER || errc == DEVICE_UNABLE){
@@ -4527,6 +7283,55 @@ int talshTensorInsert_(talsh_tens_t * dtens, talsh_tens_t * ltens, const int * o
  return talshTensorInsert(dtens,ltens,offsets,dev_id,dev_kind,copy_ctrl,accumulative,talsh_task);
 }
 
+int talshContrPatternParse(const char * cptrn,             //in: C-string: symbolic tensor operation pattern
+                           talsh_contr_ptrn_t * dig_ptrn)  //out: digital tensor operation pattern
+/** Converts a symbolic tensor operation pattern into the digital form once,
+    such that it can be reused in multiple tensor operations without parsing. **/
+{
+ int errc;
+
+ if(cptrn == NULL || dig_ptrn == NULL) return TALSH_INVALID_ARGS;
+ errc=talsh_get_contr_ptrn_str2dig(cptrn,dig_ptrn->dig_ptrn,&(dig_ptrn->drank),&(dig_ptrn->lrank),&(dig_ptrn->rrank),
+                                   &(dig_ptrn->conj_bits));
+ if(errc) return TALSH_INVALID_ARGS;
+ return TALSH_SUCCESS;
+}
+
+static int talsh_contr_ptrn_get(const char * cptrn, const talsh_contr_ptrn_t * dig_ptrn, int * contr_ptrn,
+                                int * drank, int * lrank, int * rrank, int * conj_bits)
+/** Returns the digital tensor operation pattern either by parsing the symbolic
+    pattern <cptrn> or by copying the pre-parsed pattern <dig_ptrn> (if not NULL). **/
+{
+ int i,errc;
+
+ errc=0;
+ if(dig_ptrn == NULL){
+  if(cptrn == NULL) return -1;
+  errc=talsh_get_contr_ptrn_str2dig(cptrn,contr_ptrn,drank,lrank,rrank,conj_bits);
+ }else{
+  *drank=dig_ptrn->drank; *lrank=dig_ptrn->lrank; *rrank=dig_ptrn->rrank; *conj_bits=dig_ptrn->conj_bits;
+  if(*drank < 0 || *lrank < 0 || *rrank < 0 ||
+     *drank > MAX_TENSOR_RANK || *lrank > MAX_TENSOR_RANK || *rrank > MAX_TENSOR_RANK) return -2;
+  for(i=0;i<(*lrank)+(*rrank);++i) contr_ptrn[i]=dig_ptrn->dig_ptrn[i];
+ }
+ return errc;
+}
+
+static void talsh_contr_ptrn_print(const char * cptrn, const talsh_contr_ptrn_t * dig_ptrn)
+/** Prints the tensor operation pattern (logging). **/
+{
+ int i;
+
+ if(dig_ptrn == NULL){
+  printf("%s",cptrn);
+ }else{
+  printf("DIG[%d|%d,%d|%d](",dig_ptrn->drank,dig_ptrn->lrank,dig_ptrn->rrank,dig_ptrn->conj_bits);
+  for(i=0;i<dig_ptrn->lrank+dig_ptrn->rrank;++i) printf("%d,",dig_ptrn->dig_ptrn[i]);
+  printf(")");
+ }
+ return;
+}
+
 int talshTensorCopy(const char * cptrn,   //in: tensor copy pattern
                     talsh_tens_t * dtens, //inout: destination tensor block
                     talsh_tens_t * ltens, //inout: left tensor block
@@ -4534,9 +7339,36 @@ int talshTensorCopy(const char * cptrn,   //in: tensor copy pattern
                     int dev_kind,
                     int copy_ctrl,
                     talsh_task_t * talsh_task)
+/** Tensor copy dispatcher (symbolic pattern) **/
+{
+ return talsh_tensor_copy(cptrn,NULL,dtens,ltens,dev_id,dev_kind,copy_ctrl,talsh_task);
+}
+
+int talshTensorCopyDig(const talsh_contr_ptrn_t * dig_ptrn, //in: digital tensor copy pattern
+                       talsh_tens_t * dtens,                //inout: destination tensor block
+                       talsh_tens_t * ltens,                //inout: left tensor block
+                       int dev_id,
+                       int dev_kind,
+                       int copy_ctrl,
+                       talsh_task_t * talsh_task)
+/** Tensor copy dispatcher (digital pattern) **/
+{
+ if(dig_ptrn == NULL) return TALSH_INVALID_ARGS;
+ if(dig_ptrn->rrank != 0) return TALSH_INVALID_ARGS; //unary operation
+ return talsh_tensor_copy(NULL,dig_ptrn,dtens,ltens,dev_id,dev_kind,copy_ctrl,talsh_task);
+}
+
+static int talsh_tensor_copy(const char * cptrn,                  //in: symbolic tensor copy pattern (or NULL)
+                             const talsh_contr_ptrn_t * dig_ptrn, //in: digital tensor copy pattern (or NULL)
+                             talsh_tens_t * dtens,                //inout: destination tensor block
+                             talsh_tens_t * ltens,                //inout: left tensor block
+                             int dev_id,
+                             int dev_kind,
+                             int copy_ctrl,
+                             talsh_task_t * talsh_task)
 /** Tensor copy dispatcher **/
 {
- int j,devid,dvk,dvn,dimg,limg,dcp,lcp,errc;
+ int j,devid,dvk,dvn,dimg,limg,dcp,lcp,errc,small,split,dnf;
  int contr_ptrn[MAX_TENSOR_RANK],cpl,drnk,lrnk,rrnk,conj_bits;
  unsigned int coh_ctrl,coh,cohd,cohl;
  talsh_task_t * tsk;
@@ -4568,7 +7400,7 @@ int talshTensorCopy(const char * cptrn,   //in: tensor copy pattern
   tsk->task_error=102; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
  }
  //Check and parse the index correspondence pattern:
- errc=talsh_get_contr_ptrn_str2dig(cptrn,contr_ptrn,&drnk,&lrnk,&rrnk,&conj_bits);
+ errc=talsh_contr_ptrn_get(cptrn,dig_ptrn,contr_ptrn,&drnk,&lrnk,&rrnk,&conj_bits);
  cpl=lrnk+rrnk;
  if(errc){tsk->task_error=103; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_INVALID_ARGS;}
  //Determine the execution device (devid:[dvk,dvn]):
@@ -4640,15 +7472,20 @@ int talshTensorCopy(const char * cptrn,   //in: tensor copy pattern
  //Schedule the tensor operation via the device-kind specific runtime:
  switch(dvk){
   case DEV_HOST:
-   //Associate TAL-SH tensor images with <tensor_block_t> objects:
-   errc=talsh_tensor_f_assoc(dtens,dimg,&dftr);
-   if(errc || dftr == NULL){
-    tsk->task_error=114; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
-   }
-   errc=talsh_tensor_f_assoc(ltens,limg,&lftr);
-   if(errc || lftr == NULL){
-    errc=talsh_tensor_f_dissoc(dftr);
-    tsk->task_error=115; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
+   //Small tensors and split-complex tensors are processed natively (no <tensor_block_t> association):
+   split=talsh_split_op_ok(contr_ptrn,dtens,dimg,ltens,limg,NULL,-1,conj_bits);
+   small=((split == YEP)?YEP:talsh_small_op_ok(dtens,dimg,ltens,limg,NULL,-1,conj_bits,0.0));
+   if(small != YEP){
+    //Associate TAL-SH tensor images with <tensor_block_t> objects:
+    errc=talsh_tensor_f_assoc(dtens,dimg,&dftr);
+    if(errc || dftr == NULL){
+     tsk->task_error=114; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
+    }
+    errc=talsh_tensor_f_assoc(ltens,limg,&lftr);
+    if(errc || lftr == NULL){
+     errc=talsh_tensor_f_dissoc(dftr);
+     tsk->task_error=115; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
+    }
    }
    //Get the Host task:
    host_task=(host_task_t*)(tsk->task_p);
@@ -4656,8 +7493,10 @@ int talshTensorCopy(const char * cptrn,   //in: tensor copy pattern
    //Discard all output images except the source one:
    errc=talsh_tensor_image_discard_other(dtens,dimg); //the only remaining image 0 is the source image
    if(errc != TALSH_SUCCESS){
-    j=talsh_tensor_f_dissoc(lftr); if(j) errc=TALSH_FAILURE;
-    j=talsh_tensor_f_dissoc(dftr); if(j) errc=TALSH_FAILURE;
+    if(small != YEP){
+     j=talsh_tensor_f_dissoc(lftr); if(j) errc=TALSH_FAILURE;
+     j=talsh_tensor_f_dissoc(dftr); if(j) errc=TALSH_FAILURE;
+    }
     j=host_task_record(host_task,coh_ctrl,13);
     j=host_task_destroy(host_task); tsk->task_p=NULL; if(j) errc=TALSH_FAILURE;
     tsk->task_error=116; if(talsh_task == NULL) j=talshTaskDestroy(tsk);
@@ -4667,16 +7506,26 @@ int talshTensorCopy(const char * cptrn,   //in: tensor copy pattern
    dtens->avail[0] = NOPE;
    if(cohl == COPY_D || (cohl == COPY_M && ltens->dev_rsc[limg].dev_id != devid)) ltens->avail[limg] = NOPE;
    //Schedule tensor operation via the device-kind specific runtime:
-   ctm=clock();
-   errc=cpu_tensor_block_copy(contr_ptrn,lftr,dftr,conj_bits); //blocking call
-   if(errc == TALSH_SUCCESS && talshTensorRank(dtens) == 0){ //an explicit update is needed for scalar destinations
-    j=talsh_update_f_scalar(dftr,dtens->data_kind[0],dtens->dev_rsc[0].gmem_p);
-    if(j) errc=TALSH_FAILURE;
+   ctm=clock(); dnf=-1;
+   if(split == YEP){
+    errc=talsh_split_tensor_elementwise(contr_ptrn,dtens,ltens,limg,NULL,-1,1.0,0.0,conj_bits,NOPE); //blocking call
+   }else if(small == YEP){
+    errc=talsh_small_tensor_contract(contr_ptrn,dtens,ltens,limg,NULL,-1,1.0,0.0,conj_bits,NOPE,
+                                     (talsh_nonfinite_check != NOPE)?&dnf:NULL); //blocking call
+   }else{
+    errc=cpu_tensor_block_copy(contr_ptrn,lftr,dftr,conj_bits); //blocking call
+    if(errc == TALSH_SUCCESS && talshTensorRank(dtens) == 0){ //an explicit update is needed for scalar destinations
+     j=talsh_update_f_scalar(dftr,dtens->data_kind[0],dtens->dev_rsc[0].gmem_p);
+     if(j) errc=TALSH_FAILURE;
+    }
    }
+   if(errc == TALSH_SUCCESS && talsh_nonfinite_check != NOPE) tsk->nonfinite=talsh_op_nonfinite(dnf,dtens,ltens,limg,NULL,-1);
    tsk->exec_time=((double)(clock()-ctm))/CLOCKS_PER_SEC;
    //Dissociate <tensor_block_t> objects:
-   j=talsh_tensor_f_dissoc(lftr); if(j) errc=TALSH_FAILURE;
-   j=talsh_tensor_f_dissoc(dftr); if(j) errc=TALSH_FAILURE;
+   if(small != YEP){
+    j=talsh_tensor_f_dissoc(lftr); if(j) errc=TALSH_FAILURE;
+    j=talsh_tensor_f_dissoc(dftr); if(j) errc=TALSH_FAILURE;
+   }
    //Host task finalization and coherence control:
    if(errc){ //task error
     if(errc == TRY_LATER || errc == DEVICE_UNABLE){
@@ -4801,9 +7650,40 @@ int talshTensorAdd(const char * cptrn,   //in: tensor addition pattern
                    int dev_kind,
                    int copy_ctrl,
                    talsh_task_t * talsh_task)
+/** Tensor addition dispatcher (symbolic pattern) **/
+{
+ return talsh_tensor_add(cptrn,NULL,dtens,ltens,scale_real,scale_imag,dev_id,dev_kind,copy_ctrl,talsh_task);
+}
+
+int talshTensorAddDig(const talsh_contr_ptrn_t * dig_ptrn, //in: digital tensor addition pattern
+                      talsh_tens_t * dtens,                //inout: destination tensor block
+                      talsh_tens_t * ltens,                //inout: left tensor block
+                      double scale_real,
+                      double scale_imag,
+                      int dev_id,
+                      int dev_kind,
+                      int copy_ctrl,
+                      talsh_task_t * talsh_task)
+/** Tensor addition dispatcher (digital pattern) **/
+{
+ if(dig_ptrn == NULL) return TALSH_INVALID_ARGS;
+ if(dig_ptrn->rrank != 0) return TALSH_INVALID_ARGS; //unary operation
+ return talsh_tensor_add(NULL,dig_ptrn,dtens,ltens,scale_real,scale_imag,dev_id,dev_kind,copy_ctrl,talsh_task);
+}
+
+static int talsh_tensor_add(const char * cptrn,                  //in: symbolic tensor addition pattern (or NULL)
+                            const talsh_contr_ptrn_t * dig_ptrn, //in: digital tensor addition pattern (or NULL)
+                            talsh_tens_t * dtens,                //inout: destination tensor block
+                            talsh_tens_t * ltens,                //inout: left tensor block
+                            double scale_real,
+                            double scale_imag,
+                            int dev_id,
+                            int dev_kind,
+                            int copy_ctrl,
+                            talsh_task_t * talsh_task)
 /** Tensor addition dispatcher **/
 {
- int j,devid,dvk,dvn,dimg,limg,dcp,lcp,errc;
+ int j,devid,dvk,dvn,dimg,limg,dcp,lcp,errc,small,split,dnf;
  int contr_ptrn[MAX_TENSOR_RANK],cpl,drnk,lrnk,rrnk,conj_bits;
  unsigned int coh_ctrl,coh,cohd,cohl;
  talsh_task_t * tsk;
@@ -4818,7 +7698,7 @@ int talshTensorAdd(const char * cptrn,   //in: tensor addition pattern
 
 #pragma omp flush
  if(LOGGING_OPS > 0){
-  printf("%s",cptrn); printf(" ");
+  talsh_contr_ptrn_print(cptrn,dig_ptrn); printf(" ");
   talshTensorPrint(dtens); printf(" ");
   talshTensorPrint(ltens); printf(" ");
   printf(": FMA Flop volume = %lu: Time (s) = ",talshTensorVolume(dtens));
@@ -4843,7 +7723,7 @@ int talshTensorAdd(const char * cptrn,   //in: tensor addition pattern
   tsk->task_error=102; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
  }
  //Check and parse the index correspondence pattern:
- errc=talsh_get_contr_ptrn_str2dig(cptrn,contr_ptrn,&drnk,&lrnk,&rrnk,&conj_bits);
+ errc=talsh_contr_ptrn_get(cptrn,dig_ptrn,contr_ptrn,&drnk,&lrnk,&rrnk,&conj_bits);
  cpl=lrnk+rrnk;
  if(errc){tsk->task_error=103; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_INVALID_ARGS;}
  //Determine the execution device (devid:[dvk,dvn]):
@@ -4915,15 +7795,20 @@ int talshTensorAdd(const char * cptrn,   //in: tensor addition pattern
  //Schedule the tensor operation via the device-kind specific runtime:
  switch(dvk){
   case DEV_HOST:
-   //Associate TAL-SH tensor images with <tensor_block_t> objects:
-   errc=talsh_tensor_f_assoc(dtens,dimg,&dftr);
-   if(errc || dftr == NULL){
-    tsk->task_error=114; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
-   }
-   errc=talsh_tensor_f_assoc(ltens,limg,&lftr);
-   if(errc || lftr == NULL){
-    errc=talsh_tensor_f_dissoc(dftr);
-    tsk->task_error=115; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
+   //Small tensors and split-complex tensors are processed natively (no <tensor_block_t> association):
+   split=talsh_split_op_ok(contr_ptrn,dtens,dimg,ltens,limg,NULL,-1,conj_bits);
+   small=((split == YEP)?YEP:talsh_small_op_ok(dtens,dimg,ltens,limg,NULL,-1,conj_bits,scale_imag));
+   if(small != YEP){
+    //Associate TAL-SH tensor images with <tensor_block_t> objects:
+    errc=talsh_tensor_f_assoc(dtens,dimg,&dftr);
+    if(errc || dftr == NULL){
+     tsk->task_error=114; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
+    }
+    errc=talsh_tensor_f_assoc(ltens,limg,&lftr);
+    if(errc || lftr == NULL){
+     errc=talsh_tensor_f_dissoc(dftr);
+     tsk->task_error=115; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
+    }
    }
    //Get the Host task:
    host_task=(host_task_t*)(tsk->task_p);
@@ -4931,8 +7816,10 @@ int talshTensorAdd(const char * cptrn,   //in: tensor addition pattern
    //Discard all output images except the source one:
    errc=talsh_tensor_image_discard_other(dtens,dimg); //the only remaining image 0 is the source image
    if(errc != TALSH_SUCCESS){
-    j=talsh_tensor_f_dissoc(lftr); if(j) errc=TALSH_FAILURE;
-    j=talsh_tensor_f_dissoc(dftr); if(j) errc=TALSH_FAILURE;
+    if(small != YEP){
+     j=talsh_tensor_f_dissoc(lftr); if(j) errc=TALSH_FAILURE;
+     j=talsh_tensor_f_dissoc(dftr); if(j) errc=TALSH_FAILURE;
+    }
     j=host_task_record(host_task,coh_ctrl,13);
     j=host_task_destroy(host_task); tsk->task_p=NULL; if(j) errc=TALSH_FAILURE;
     tsk->task_error=116; if(talsh_task == NULL) j=talshTaskDestroy(tsk);
@@ -4942,16 +7829,26 @@ int talshTensorAdd(const char * cptrn,   //in: tensor addition pattern
    dtens->avail[0] = NOPE;
    if(cohl == COPY_D || (cohl == COPY_M && ltens->dev_rsc[limg].dev_id != devid)) ltens->avail[limg] = NOPE;
    //Schedule tensor operation via the device-kind specific runtime:
-   ctm=clock();
-   errc=cpu_tensor_block_add(contr_ptrn,lftr,dftr,scale_real,scale_imag,conj_bits); //blocking call
-   if(errc == TALSH_SUCCESS && talshTensorRank(dtens) == 0){ //an explicit update is needed for scalar destinations
-    j=talsh_update_f_scalar(dftr,dtens->data_kind[0],dtens->dev_rsc[0].gmem_p);
-    if(j) errc=TALSH_FAILURE;
+   ctm=clock(); dnf=-1;
+   if(split == YEP){
+    errc=talsh_split_tensor_elementwise(contr_ptrn,dtens,ltens,limg,NULL,-1,scale_real,scale_imag,conj_bits,YEP); //blocking call
+   }else if(small == YEP){
+    errc=talsh_small_tensor_contract(contr_ptrn,dtens,ltens,limg,NULL,-1,scale_real,scale_imag,conj_bits,YEP,
+                                     (talsh_nonfinite_check != NOPE)?&dnf:NULL); //blocking call
+   }else{
+    errc=cpu_tensor_block_add(contr_ptrn,lftr,dftr,scale_real,scale_imag,conj_bits); //blocking call
+    if(errc == TALSH_SUCCESS && talshTensorRank(dtens) == 0){ //an explicit update is needed for scalar destinations
+     j=talsh_update_f_scalar(dftr,dtens->data_kind[0],dtens->dev_rsc[0].gmem_p);
+     if(j) errc=TALSH_FAILURE;
+    }
    }
+   if(errc == TALSH_SUCCESS && talsh_nonfinite_check != NOPE) tsk->nonfinite=talsh_op_nonfinite(dnf,dtens,ltens,limg,NULL,-1);
    tsk->exec_time=((double)(clock()-ctm))/CLOCKS_PER_SEC;
    //Dissociate <tensor_block_t> objects:
-   j=talsh_tensor_f_dissoc(lftr); if(j) errc=TALSH_FAILURE;
-   j=talsh_tensor_f_dissoc(dftr); if(j) errc=TALSH_FAILURE;
+   if(small != YEP){
+    j=talsh_tensor_f_dissoc(lftr); if(j) errc=TALSH_FAILURE;
+    j=talsh_tensor_f_dissoc(dftr); if(j) errc=TALSH_FAILURE;
+   }
    //Host task finalization and coherence control:
    if(errc){ //task error
     if(errc == TRY_LATER || errc == DEVICE_UNABLE){
@@ -5081,9 +7978,43 @@ int talshTensorContract(const char * cptrn,        //in: C-string: symbolic cont
                         int copy_ctrl,             //in: copy control (COPY_XXX), defaults to COPY_MTT
                         int accumulative,          //in: accumulate in (default) VS overwrite destination tensor: [YEP|NOPE]
                         talsh_task_t * talsh_task) //inout: TAL-SH task (must be clean on entrance)
+/** Tensor contraction dispatcher (symbolic pattern) **/
+{
+ return talsh_tensor_contract(cptrn,NULL,dtens,ltens,rtens,scale_real,scale_imag,dev_id,dev_kind,copy_ctrl,accumulative,talsh_task);
+}
+
+int talshTensorContractDig(const talsh_contr_ptrn_t * dig_ptrn, //in: digital contraction pattern
+                           talsh_tens_t * dtens,      //inout: destination tensor block
+                           talsh_tens_t * ltens,      //inout: left source tensor block
+                           talsh_tens_t * rtens,      //inout: right source tensor block
+                           double scale_real,         //in: scaling value (real part), defaults to 1
+                           double scale_imag,         //in: scaling value (imaginary part), defaults to 0
+                           int dev_id,                //in: device id (flat or kind-specific)
+                           int dev_kind,              //in: device kind (if present, <dev_id> is kind-specific)
+                           int copy_ctrl,             //in: copy control (COPY_XXX), defaults to COPY_MTT
+                           int accumulative,          //in: accumulate in (default) VS overwrite destination tensor: [YEP|NOPE]
+                           talsh_task_t * talsh_task) //inout: TAL-SH task (must be clean on entrance)
+/** Tensor contraction dispatcher (digital pattern) **/
+{
+ if(dig_ptrn == NULL) return TALSH_INVALID_ARGS;
+ return talsh_tensor_contract(NULL,dig_ptrn,dtens,ltens,rtens,scale_real,scale_imag,dev_id,dev_kind,copy_ctrl,accumulative,talsh_task);
+}
+
+static int talsh_tensor_contract(const char * cptrn,                  //in: symbolic contraction pattern (or NULL)
+                                 const talsh_contr_ptrn_t * dig_ptrn, //in: digital contraction pattern (or NULL)
+                                 talsh_tens_t * dtens,      //inout: destination tensor block
+                                 talsh_tens_t * ltens,      //inout: left source tensor block
+                                 talsh_tens_t * rtens,      //inout: right source tensor block
+                                 double scale_real,         //in: scaling value (real part), defaults to 1
+                                 double scale_imag,         //in: scaling value (imaginary part), defaults to 0
+                                 int dev_id,                //in: device id (flat or kind-specific)
+                                 int dev_kind,              //in: device kind (if present, <dev_id> is kind-specific)
+                                 int copy_ctrl,             //in: copy control (COPY_XXX), defaults to COPY_MTT
+                                 int accumulative,          //in: accumulate in (default) VS overwrite destination tensor: [YEP|NOPE]
+                                 talsh_task_t * talsh_task) //inout: TAL-SH task (must be clean on entrance)
 /** Tensor contraction dispatcher **/
 {
- int j,devid,dvk,dvn,dimg,limg,rimg,dcp,lcp,rcp,errc;
+ int j,devid,dvk,dvn,dimg,limg,rimg,dcp,lcp,rcp,errc,small,split,dnf;
  int contr_ptrn[MAX_TENSOR_RANK*2],cpl,drnk,lrnk,rrnk,conj_bits;
  unsigned int coh_ctrl,coh,cohd,cohl,cohr;
  talsh_task_t * tsk;
@@ -5098,7 +8029,7 @@ int talshTensorContract(const char * cptrn,        //in: C-string: symbolic cont
 
 #pragma omp flush
  if(LOGGING_OPS > 0){
-  printf("%s",cptrn); printf(" ");
+  talsh_contr_ptrn_print(cptrn,dig_ptrn); printf(" ");
   talshTensorPrint(dtens); printf(" ");
   talshTensorPrint(ltens); printf(" ");
   talshTensorPrint(rtens); printf(" ");
@@ -5125,7 +8056,7 @@ int talshTensorContract(const char * cptrn,        //in: C-string: symbolic cont
   tsk->task_error=102; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
  }
  //Check and parse the index correspondence pattern:
- errc=talsh_get_contr_ptrn_str2dig(cptrn,contr_ptrn,&drnk,&lrnk,&rrnk,&conj_bits);
+ errc=talsh_contr_ptrn_get(cptrn,dig_ptrn,contr_ptrn,&drnk,&lrnk,&rrnk,&conj_bits);
  cpl=lrnk+rrnk;
  if(errc){tsk->task_error=103; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_INVALID_ARGS;}
  //Determine the execution device (devid:[dvk,dvn]):
@@ -5210,20 +8141,25 @@ int talshTensorContract(const char * cptrn,        //in: C-string: symbolic cont
  //Schedule tensor operation via the device-kind specific runtime:
  switch(dvk){
   case DEV_HOST:
-   //Associate TAL-SH tensor images with <tensor_block_t> objects:
-   errc=talsh_tensor_f_assoc(dtens,dimg,&dftr);
-   if(errc || dftr == NULL){
-    tsk->task_error=115; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
-   }
-   errc=talsh_tensor_f_assoc(ltens,limg,&lftr);
-   if(errc || lftr == NULL){
-    errc=talsh_tensor_f_dissoc(dftr);
-    tsk->task_error=116; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
-   }
-   errc=talsh_tensor_f_assoc(rtens,rimg,&rftr);
-   if(errc || rftr == NULL){
-    errc=talsh_tensor_f_dissoc(lftr); errc=talsh_tensor_f_dissoc(dftr);
-    tsk->task_error=117; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
+   //Small tensors and split-complex tensors are processed natively (no <tensor_block_t> association):
+   split=talsh_split_op_ok(contr_ptrn,dtens,dimg,ltens,limg,rtens,rimg,conj_bits);
+   small=((split == YEP)?YEP:talsh_small_op_ok(dtens,dimg,ltens,limg,rtens,rimg,conj_bits,scale_imag));
+   if(small != YEP){
+    //Associate TAL-SH tensor images with <tensor_block_t> objects:
+    errc=talsh_tensor_f_assoc(dtens,dimg,&dftr);
+    if(errc || dftr == NULL){
+     tsk->task_error=115; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
+    }
+    errc=talsh_tensor_f_assoc(ltens,limg,&lftr);
+    if(errc || lftr == NULL){
+     errc=talsh_tensor_f_dissoc(dftr);
+     tsk->task_error=116; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
+    }
+    errc=talsh_tensor_f_assoc(rtens,rimg,&rftr);
+    if(errc || rftr == NULL){
+     errc=talsh_tensor_f_dissoc(lftr); errc=talsh_tensor_f_dissoc(dftr);
+     tsk->task_error=117; if(talsh_task == NULL) j=talshTaskDestroy(tsk); return TALSH_FAILURE;
+    }
    }
    //Get the Host task:
    host_task=(host_task_t*)(tsk->task_p);
@@ -5231,9 +8167,11 @@ int talshTensorContract(const char * cptrn,        //in: C-string: symbolic cont
    //Discard all output images except the source one:
    errc=talsh_tensor_image_discard_other(dtens,dimg); //the only remaining image 0 is the source image
    if(errc != TALSH_SUCCESS){
-    j=talsh_tensor_f_dissoc(rftr); if(j) errc=TALSH_FAILURE;
-    j=talsh_tensor_f_dissoc(lftr); if(j) errc=TALSH_FAILURE;
-    j=talsh_tensor_f_dissoc(dftr); if(j) errc=TALSH_FAILURE;
+    if(small != YEP){
+     j=talsh_tensor_f_dissoc(rftr); if(j) errc=TALSH_FAILURE;
+     j=talsh_tensor_f_dissoc(lftr); if(j) errc=TALSH_FAILURE;
+     j=talsh_tensor_f_dissoc(dftr); if(j) errc=TALSH_FAILURE;
+    }
     j=host_task_record(host_task,coh_ctrl,13);
     j=host_task_destroy(host_task); tsk->task_p=NULL; if(j) errc=TALSH_FAILURE;
     tsk->task_error=118; if(talsh_task == NULL) j=talshTaskDestroy(tsk);
@@ -5244,17 +8182,33 @@ int talshTensorContract(const char * cptrn,        //in: C-string: symbolic cont
    if(cohl == COPY_D || (cohl == COPY_M && ltens->dev_rsc[limg].dev_id != devid)) ltens->avail[limg] = NOPE;
    if(cohr == COPY_D || (cohr == COPY_M && rtens->dev_rsc[rimg].dev_id != devid)) rtens->avail[rimg] = NOPE;
    //Schedule tensor operation via the device-kind specific runtime:
-   ctm=clock();
-   errc=cpu_tensor_block_contract(contr_ptrn,lftr,rftr,dftr,scale_real,scale_imag,conj_bits,accumulative); //blocking call
-   if(errc == TALSH_SUCCESS && talshTensorRank(dtens) == 0){ //explicit update is needed for scalar destinations
-    j=talsh_update_f_scalar(dftr,dtens->data_kind[0],dtens->dev_rsc[0].gmem_p);
-    if(j) errc=TALSH_FAILURE;
+   ctm=clock(); dnf=-1;
+   if(split == YEP){
+    errc=talsh_split_tensor_elementwise(contr_ptrn,dtens,ltens,limg,rtens,rimg,scale_real,scale_imag,conj_bits,
+                                        accumulative); //blocking call
+   }else if(small == YEP){
+    errc=talsh_small_tensor_contract(contr_ptrn,dtens,ltens,limg,rtens,rimg,scale_real,scale_imag,conj_bits,accumulative,
+                                     (talsh_nonfinite_check != NOPE)?&dnf:NULL); //blocking call
+   }else{
+    if(talsh_autotune != NOPE){ //autotuned contraction strategy
+     errc=talsh_host_tensor_contract_tuned(contr_ptrn,dtens,dftr,ltens,limg,lftr,rtens,rimg,rftr,scale_real,scale_imag,
+                                           conj_bits,accumulative,(talsh_nonfinite_check != NOPE)?&dnf:NULL); //blocking call
+    }else{
+     errc=cpu_tensor_block_contract(contr_ptrn,lftr,rftr,dftr,scale_real,scale_imag,conj_bits,accumulative); //blocking call
+    }
+    if(errc == TALSH_SUCCESS && talshTensorRank(dtens) == 0){ //explicit update is needed for scalar destinations
+     j=talsh_update_f_scalar(dftr,dtens->data_kind[0],dtens->dev_rsc[0].gmem_p);
+     if(j) errc=TALSH_FAILURE;
+    }
    }
+   if(errc == TALSH_SUCCESS && talsh_nonfinite_check != NOPE) tsk->nonfinite=talsh_op_nonfinite(dnf,dtens,ltens,limg,rtens,rimg);
    tsk->exec_time=((double)(clock()-ctm))/CLOCKS_PER_SEC;
    //Dissociate <tensor_block_t> objects:
-   j=talsh_tensor_f_dissoc(rftr); if(j) errc=TALSH_FAILURE;
-   j=talsh_tensor_f_dissoc(lftr); if(j) errc=TALSH_FAILURE;
-   j=talsh_tensor_f_dissoc(dftr); if(j) errc=TALSH_FAILURE;
+   if(small != YEP){
+    j=talsh_tensor_f_dissoc(rftr); if(j) errc=TALSH_FAILURE;
+    j=talsh_tensor_f_dissoc(lftr); if(j) errc=TALSH_FAILURE;
+    j=talsh_tensor_f_dissoc(dftr); if(j) errc=TALSH_FAILURE;
+   }
    //Host task finalization and coherence control:
    if(errc){ //task error
     if(errc == TRY_LATER || errc == DEVICE_UNABLE){
@@ -5655,6 +8609,67 @@ int talshTensorDecomposeSVD(const char * cptrn,   //in: C-string: symbolic decom
                             const char absorb,    //in: whether or not to absorb the middle tensor factor stens into other factors: {N,L,R,S}
                             int dev_id,           //in: device id (flat or kind-specific)
                             int dev_kind)         //in: device kind (if present, <dev_id> is kind-specific)
+{
+ return talsh_tensor_decompose(TALSH_DECOMP_SVD,cptrn,dtens,ltens,rtens,stens,absorb,0,0.0,NULL,NULL,dev_id,dev_kind);
+}
+
+int talshTensorDecomposeSVDTrunc(const char * cptrn,        //in: C-string: symbolic decomposition pattern, e.g. "D(a,b,c,d)=L(c,i,j,a)*R(b,j,d,i)"
+                                 talsh_tens_t * dtens,      //in: tensor block to be decomposed
+                                 talsh_tens_t * ltens,      //inout: left tensor factor
+                                 talsh_tens_t * rtens,      //inout: right tensor factor
+                                 talsh_tens_t * stens,      //out: middle tensor factor (singular values), may be empty on entrance
+                                 const char absorb,         //in: whether or not to absorb the middle tensor factor stens into other factors: {N,L,R,S}
+                                 int max_rank,              //in: max number of retained singular triplets (0: no limit)
+                                 double rel_threshold,      //in: singular values below <rel_threshold> times the largest one are discarded
+                                 int * achieved_rank,       //out: number of retained singular triplets
+                                 double * discarded_weight, //out: discarded weight (relative to the squared 2-norm of dtens)
+                                 int dev_id,                //in: device id (flat or kind-specific)
+                                 int dev_kind)              //in: device kind (if present, <dev_id> is kind-specific)
+{
+ int rank;
+ double weight;
+
+ if(max_rank < 0 || rel_threshold < 0.0) return TALSH_INVALID_ARGS;
+ if(achieved_rank == NULL) achieved_rank=&rank;
+ if(discarded_weight == NULL) discarded_weight=&weight;
+ *achieved_rank=0; *discarded_weight=0.0;
+ return talsh_tensor_decompose(TALSH_DECOMP_SVD_TRUNC,cptrn,dtens,ltens,rtens,stens,absorb,max_rank,rel_threshold,
+                               achieved_rank,discarded_weight,dev_id,dev_kind);
+}
+
+int talshTensorDecomposeQR(const char * cptrn,   //in: C-string: symbolic decomposition pattern, e.g. "D(a,b,c)=Q(a,b,i)*R(i,c)"
+                           talsh_tens_t * dtens, //in: tensor block to be decomposed
+                           talsh_tens_t * qtens, //inout: isometric tensor factor Q
+                           talsh_tens_t * rtens, //inout: upper-triangular tensor factor R
+                           int dev_id,           //in: device id (flat or kind-specific)
+                           int dev_kind)         //in: device kind (if present, <dev_id> is kind-specific)
+{
+ int errc,ier;
+
+ talsh_tens_t stens;
+ errc=talshTensorClean(&stens);
+ if(errc == TALSH_SUCCESS){
+  errc=talsh_tensor_decompose(TALSH_DECOMP_QR,cptrn,dtens,qtens,rtens,&stens,'N',0,0.0,NULL,NULL,dev_id,dev_kind);
+  ier=talshTensorDestruct(&stens); if(ier != TALSH_SUCCESS && errc == TALSH_SUCCESS) errc=ier;
+ }
+ return errc;
+}
+
+static int talsh_tensor_decompose(int decomp_kind,             //in: decomposition kind: {TALSH_DECOMP_SVD,TALSH_DECOMP_SVD_TRUNC,TALSH_DECOMP_QR}
+                                  const char * cptrn,          //in: C-string: symbolic decomposition pattern
+                                  talsh_tens_t * dtens,        //in: tensor block to be decomposed
+                                  talsh_tens_t * ltens,        //inout: left tensor factor
+                                  talsh_tens_t * rtens,        //inout: right tensor factor
+                                  talsh_tens_t * stens,        //out: middle tensor factor (singular values), may be empty on entrance
+                                  const char absorb,           //in: whether or not to absorb the middle tensor factor stens into other factors: {N,L,R,S}
+                                  int max_rank,                //in: max number of retained singular triplets (0: no limit)
+                                  double rel_threshold,        //in: relative singular value cutoff
+                                  int * achieved_rank,         //out: number of retained singular triplets
+                                  double * discarded_weight,   //out: relative discarded weight
+                                  int dev_id,                  //in: device id (flat or kind-specific)
+                                  int dev_kind)                //in: device kind (if present, <dev_id> is kind-specific)
+/** Tensor decomposition: Full SVD (device runtime), truncated SVD or QR (native Host path).
+    In case of QR, the left and right tensor factors receive Q and R, respectively. **/
 {
  const double svd_scale_max = 1e31;
  const double svd_scale_fac = 1e2;
@@ -5665,6 +8680,7 @@ int talshTensorDecomposeSVD(const char * cptrn,   //in: C-string: symbolic decom
  char perm_sym[1024];
  void *dftr,*lftr,*rftr,*sftr;
  talsh_tens_t xtens,ytens,ztens,*utens,*vtens;
+ talsh_tens_pins_t pins;
 #ifndef NO_GPU
  tensBlck_t *dctr,*lctr,*rctr,*sctr;
 #endif
@@ -5725,6 +8741,7 @@ int talshTensorDecomposeSVD(const char * cptrn,   //in: C-string: symbolic decom
   }
  }
  //printf("#DEBUG(talshTensorDecomposeSVD): Execution device (kind,id): %d %d\n",dvk,dvn);
+ if(decomp_kind != TALSH_DECOMP_SVD && dvk != DEV_HOST) return TALSH_NOT_IMPLEMENTED; //`Future: Native decompositions on accelerators
  //Perform the tensor decomposition via SVD on device of kind <dvk>:
  errc=TALSH_SUCCESS;
  // Choose the tensor body image for each original tensor argument:
@@ -5824,20 +8841,27 @@ int talshTensorDecomposeSVD(const char * cptrn,   //in: C-string: symbolic decom
   errc=TALSH_SUCCESS;
   switch(dvk){
    case DEV_HOST:
+    //Pin all tensor arguments for the duration of the Host operation:
+    talsh_tensor_pins_clean(&pins);
+    talsh_tensor_pins_add(&pins,&ztens); talsh_tensor_pins_add(&pins,utens);
+    talsh_tensor_pins_add(&pins,vtens); talsh_tensor_pins_add(&pins,stens);
     //Associate TAL-SH tensor images with <tensor_block_t> objects:
     errc=talsh_tensor_f_assoc(&ztens,dimg,&dftr);
     if(errc || dftr == NULL){
+     talsh_tensor_pins_release(&pins);
      return TALSH_FAILURE;
     }
     errc=talsh_tensor_f_assoc(utens,limg,&lftr);
     if(errc || lftr == NULL){
      errc=talsh_tensor_f_dissoc(dftr);
+     talsh_tensor_pins_release(&pins);
      return TALSH_FAILURE;
     }
     errc=talsh_tensor_f_assoc(vtens,rimg,&rftr);
     if(errc || rftr == NULL){
      errc=talsh_tensor_f_dissoc(lftr);
      errc=talsh_tensor_f_dissoc(dftr);
+     talsh_tensor_pins_release(&pins);
      return TALSH_FAILURE;
     }
     errc=talsh_tensor_f_assoc(stens,simg,&sftr);
@@ -5845,6 +8869,7 @@ int talshTensorDecomposeSVD(const char * cptrn,   //in: C-string: symbolic decom
      errc=talsh_tensor_f_dissoc(rftr);
      errc=talsh_tensor_f_dissoc(lftr);
      errc=talsh_tensor_f_dissoc(dftr);
+     talsh_tensor_pins_release(&pins);
      return TALSH_FAILURE;
     }
     devid=talshFlatDevId(DEV_HOST,0); //execution device
@@ -5855,6 +8880,7 @@ int talshTensorDecomposeSVD(const char * cptrn,   //in: C-string: symbolic decom
      j=talsh_tensor_f_dissoc(rftr); if(j) errc=TALSH_FAILURE;
      j=talsh_tensor_f_dissoc(lftr); if(j) errc=TALSH_FAILURE;
      j=talsh_tensor_f_dissoc(dftr); if(j) errc=TALSH_FAILURE;
+     talsh_tensor_pins_release(&pins);
      return errc;
     }
     errc=talsh_tensor_image_discard_other(vtens,rimg); //the only remaining image 0 is the source image
@@ -5863,6 +8889,7 @@ int talshTensorDecomposeSVD(const char * cptrn,   //in: C-string: symbolic decom
      j=talsh_tensor_f_dissoc(rftr); if(j) errc=TALSH_FAILURE;
      j=talsh_tensor_f_dissoc(lftr); if(j) errc=TALSH_FAILURE;
      j=talsh_tensor_f_dissoc(dftr); if(j) errc=TALSH_FAILURE;
+     talsh_tensor_pins_release(&pins);
      return errc;
     }
     errc=talsh_tensor_image_discard_other(stens,simg); //the only remaining image 0 is the source image
@@ -5871,6 +8898,7 @@ int talshTensorDecomposeSVD(const char * cptrn,   //in: C-string: symbolic decom
      j=talsh_tensor_f_dissoc(rftr); if(j) errc=TALSH_FAILURE;
      j=talsh_tensor_f_dissoc(lftr); if(j) errc=TALSH_FAILURE;
      j=talsh_tensor_f_dissoc(dftr); if(j) errc=TALSH_FAILURE;
+     talsh_tensor_pins_release(&pins);
      return errc;
     }
     //Mark source images unavailable:
@@ -5879,7 +8907,17 @@ int talshTensorDecomposeSVD(const char * cptrn,   //in: C-string: symbolic decom
     vtens->avail[0] = NOPE;
     stens->avail[0] = NOPE;
     //Schedule tensor operation via the device-kind specific runtime:
-    errc=cpu_tensor_block_decompose_svd(absorb,dftr,lftr,rftr,sftr); //blocking call
+    switch(decomp_kind){
+     case TALSH_DECOMP_SVD_TRUNC:
+      errc=talsh_tensor_svd_trunc(&ztens,dimg,nlu,utens,vtens,stens,absorb,max_rank,rel_threshold,
+                                  achieved_rank,discarded_weight); //blocking call
+      break;
+     case TALSH_DECOMP_QR:
+      errc=talsh_tensor_qr(&ztens,dimg,nlu,utens,vtens); //blocking call
+      break;
+     default:
+      errc=cpu_tensor_block_decompose_svd(absorb,dftr,lftr,rftr,sftr); //blocking call
+    }
     //printf("#DEBUG(talshTensorDecomposeSVD): Executed SVD on CPU with status %d\n",errc);
     //Dissociate <tensor_block_t> objects:
     j=talsh_tensor_f_dissoc(sftr); if(j) errc=TALSH_FAILURE;
@@ -5891,6 +8929,7 @@ int talshTensorDecomposeSVD(const char * cptrn,   //in: C-string: symbolic decom
     utens->avail[0] = YEP;
     vtens->avail[0] = YEP;
     stens->avail[0] = YEP;
+    talsh_tensor_pins_release(&pins);
     if(errc){ //task error
      if(errc != TRY_LATER && errc != DEVICE_UNABLE && errc != NUM_INSTABILITY) errc=TALSH_FAILURE;
     }
@@ -6196,59 +9235,173 @@ int talshTensorOrthogonalizeMGS(talsh_tens_t * dtens, //inout: on entrance tenso
                                 int * iso_dims,       //in: ordered list of the isometric tensor dimensions (tensor dimension numeration starts from 0)
                                 int dev_id,           //in: device id (flat or kind-specific)
                                 int dev_kind)         //in: device kind (if present, <dev_id> is kind-specific)
+/** The isometric dimensions form the rows of the tall-skinny matricization of dtens, which is
+    replaced by the Q factor of its thin QR decomposition (CholeskyQR2 on Host). **/
 {
+ int drnk,nrest,isom[MAX_TENSOR_RANK],rest[MAX_TENSOR_RANK],qdims[MAX_TENSOR_RANK],rdims[MAX_TENSOR_RANK];
+ int errc,ier,i,j,l;
+ const int *ddims;
+ size_t m,n;
+ char qr_ptrn[2048],copy_ptrn[2048];
+ talsh_tens_t qtens,rtens;
+
  //Check function arguments:
  if(talsh_on == 0) return TALSH_NOT_INITIALIZED;
  if(dtens == NULL || iso_dims == NULL || num_iso_dims <= 0) return TALSH_INVALID_ARGS;
- //`Implement
- return TALSH_NOT_IMPLEMENTED;
+ if(talshTensorIsEmpty(dtens) != NOPE) return TALSH_OBJECT_IS_EMPTY;
+ ddims=talshTensorDimExtents(dtens,&drnk);
+ if(num_iso_dims > drnk) return TALSH_INVALID_ARGS;
+ //Split tensor dimensions into the isometric (row) and complementary (column) sets:
+ for(i=0;i<drnk;++i) isom[i]=0;
+ m=1; n=1;
+ for(i=0;i<num_iso_dims;++i){
+  if(iso_dims[i] < 0 || iso_dims[i] >= drnk || isom[iso_dims[i]] != 0) return TALSH_INVALID_ARGS;
+  isom[iso_dims[i]]=1; qdims[i]=ddims[iso_dims[i]]; m*=ddims[iso_dims[i]];
+ }
+ nrest=0;
+ for(i=0;i<drnk;++i){if(isom[i] == 0){rest[nrest++]=i; n*=ddims[i];}}
+ if(nrest == 0 || n > m) return TALSH_INVALID_ARGS; //the complementary dimensions must form a non-empty, not wider column space
+ //Symbolic patterns: D(d..)=Q(iso..,c..)*R(c..,rest..) and D(d..)=Q(iso..,rest..):
+ l=snprintf(qr_ptrn,sizeof(qr_ptrn),"D(");
+ for(i=0;i<drnk;++i) l+=snprintf(&(qr_ptrn[l]),sizeof(qr_ptrn)-l,"%sd%d",(i == 0)?"":",",i);
+ l+=snprintf(&(qr_ptrn[l]),sizeof(qr_ptrn)-l,")=Q(");
+ for(i=0;i<num_iso_dims;++i) l+=snprintf(&(qr_ptrn[l]),sizeof(qr_ptrn)-l,"d%d,",iso_dims[i]);
+ for(i=0;i<nrest;++i) l+=snprintf(&(qr_ptrn[l]),sizeof(qr_ptrn)-l,"%sc%d",(i == 0)?"":",",i);
+ l+=snprintf(&(qr_ptrn[l]),sizeof(qr_ptrn)-l,")*R(");
+ for(i=0;i<nrest;++i) l+=snprintf(&(qr_ptrn[l]),sizeof(qr_ptrn)-l,"c%d,",i);
+ for(i=0;i<nrest;++i) l+=snprintf(&(qr_ptrn[l]),sizeof(qr_ptrn)-l,"%sd%d",(i == 0)?"":",",rest[i]);
+ l+=snprintf(&(qr_ptrn[l]),sizeof(qr_ptrn)-l,")");
+ l=snprintf(copy_ptrn,sizeof(copy_ptrn),"D(");
+ for(i=0;i<drnk;++i) l+=snprintf(&(copy_ptrn[l]),sizeof(copy_ptrn)-l,"%sd%d",(i == 0)?"":",",i);
+ l+=snprintf(&(copy_ptrn[l]),sizeof(copy_ptrn)-l,")=Q(");
+ for(i=0;i<num_iso_dims;++i) l+=snprintf(&(copy_ptrn[l]),sizeof(copy_ptrn)-l,"d%d,",iso_dims[i]);
+ for(i=0;i<nrest;++i) l+=snprintf(&(copy_ptrn[l]),sizeof(copy_ptrn)-l,"%sd%d",(i == 0)?"":",",rest[i]);
+ l+=snprintf(&(copy_ptrn[l]),sizeof(copy_ptrn)-l,")");
+ if(l >= (int)sizeof(copy_ptrn)) return TALSH_FAILURE;
+ //Construct the tensor factors:
+ for(i=0;i<nrest;++i){
+  j=ddims[rest[i]]; qdims[num_iso_dims+i]=j; rdims[i]=j; rdims[nrest+i]=j;
+ }
+ errc=talshTensorClean(&qtens); if(errc != TALSH_SUCCESS) return errc;
+ errc=talshTensorClean(&rtens); if(errc != TALSH_SUCCESS) return errc;
+ errc=talshTensorConstruct(&qtens,dtens->data_kind[0],drnk,qdims);
+ if(errc == NOT_CLEAN) errc=TALSH_SUCCESS;
+ if(errc == TALSH_SUCCESS){
+  errc=talshTensorConstruct(&rtens,dtens->data_kind[0],nrest*2,rdims);
+  if(errc == NOT_CLEAN) errc=TALSH_SUCCESS;
+  if(errc == TALSH_SUCCESS){
+   //Perform the QR decomposition and replace dtens with the Q factor:
+   errc=talshTensorDecomposeQR(qr_ptrn,dtens,&qtens,&rtens,dev_id,dev_kind);
+   if(errc == TALSH_SUCCESS) errc=talshTensorCopy(copy_ptrn,dtens,&qtens,dev_id,dev_kind);
+   ier=talshTensorDestruct(&rtens); if(ier != TALSH_SUCCESS && errc == TALSH_SUCCESS) errc=ier;
+  }
+  ier=talshTensorDestruct(&qtens); if(ier != TALSH_SUCCESS && errc == TALSH_SUCCESS) errc=ier;
+ }
+ return errc;
+}
+
+static double talsh_body_norm1(const void * body, int data_kind, size_t n)
+/** Computes the 1-norm of a tensor body. **/
+{
+ size_t j;
+ double norm1;
+ const float *r4p;
+ const double *r8p;
+ const talshComplex4 *c4p;
+ const talshComplex8 *c8p;
+
+ norm1=0.0;
+ switch(data_kind){
+  case R4:
+   r4p=(const float*)body;
+#pragma omp parallel for shared(r4p,n) reduction(+:norm1) schedule(guided)
+   for(j=0;j<n;++j){norm1+=(double)(ABS(r4p[j]));}
+   break;
+  case R8:
+   r8p=(const double*)body;
+#pragma omp parallel for shared(r8p,n) reduction(+:norm1) schedule(guided)
+   for(j=0;j<n;++j){norm1+=ABS(r8p[j]);}
+   break;
+  case C4:
+   c4p=(const talshComplex4*)body;
+#pragma omp parallel for shared(c4p,n) reduction(+:norm1) schedule(guided)
+   for(j=0;j<n;++j){norm1+=(double)(talshComplex4Abs(c4p[j]));}
+   break;
+  case C8:
+   c8p=(const talshComplex8*)body;
+#pragma omp parallel for shared(c8p,n) reduction(+:norm1) schedule(guided)
+   for(j=0;j<n;++j){norm1+=talshComplex8Abs(c8p[j]);}
+   break;
+ }
+ return norm1;
+}
+
+template <typename R>
+static double talsh_body_norm1_split(const R * body, size_t n)
+/** Computes the 1-norm of a complex tensor body stored in the split-complex layout. **/
+{
+ double norm1=0.0;
+#pragma omp parallel for reduction(+:norm1) schedule(guided)
+ for(long long l=0; l<(long long)n; ++l) norm1+=std::sqrt((double)body[l]*(double)body[l]+(double)body[n+l]*(double)body[n+l]);
+ return norm1;
 }
 
 double talshTensorImageNorm1_cpu(const talsh_tens_t * talsh_tens)
-/** Computes the 1-norm of the tensor body image residing on Host. **/
+/** Computes the 1-norm of the tensor body image residing on Host. A compressed
+    tensor body is decompressed into a temporary buffer (the tensor stays compressed),
+    a split-complex tensor body is read in place (the tensor stays split). **/
 {
- int i,nimg;
- size_t j,n;
+ int i,nimg,dks,split;
+ size_t n;
  int dtk[TALSH_MAX_DEV_PRESENT];
  double norm1;
- float *r4p;
- double *r8p;
- talshComplex4 *c4p;
- talshComplex8 *c8p;
+ void * temp;
+ talsh_tens_pins_t pins;
 
 #pragma omp flush
  norm1=-1.0;
  if(talsh_tens != NULL){
-  i=talshTensorDataKind(talsh_tens,&nimg,dtk);
-  if(i == TALSH_SUCCESS){
-   for(i=0;i<talsh_tens->ndev;++i){
-    if(talsh_tens->dev_rsc[i].dev_id == talshFlatDevId(DEV_HOST,0)){
-     n=talshTensorVolume(talsh_tens); norm1=0.0;
-     switch(dtk[i]){
-      case R4:
-       r4p=(float*)(talsh_tens->dev_rsc[i].gmem_p);
-#pragma omp parallel for shared(r4p,n) reduction(+:norm1) schedule(guided)
-       for(j=0;j<n;++j){norm1+=(double)(ABS(r4p[j]));}
-       break;
-      case R8:
-       r8p=(double*)(talsh_tens->dev_rsc[i].gmem_p);
-#pragma omp parallel for shared(r8p,n) reduction(+:norm1) schedule(guided)
-       for(j=0;j<n;++j){norm1+=ABS(r8p[j]);}
-       break;
-      case C4:
-       c4p=(talshComplex4*)(talsh_tens->dev_rsc[i].gmem_p);
-#pragma omp parallel for shared(c4p,n) reduction(+:norm1) schedule(guided)
-       for(j=0;j<n;++j){norm1+=(double)(talshComplex4Abs(c4p[j]));}
-       break;
-      case C8:
-       c8p=(talshComplex8*)(talsh_tens->dev_rsc[i].gmem_p);
-#pragma omp parallel for shared(c8p,n) reduction(+:norm1) schedule(guided)
-       for(j=0;j<n;++j){norm1+=talshComplex8Abs(c8p[j]);}
-       break;
+  if(talsh_tensor_is_compressed(talsh_tens) == YEP){
+   n=talshTensorVolume(talsh_tens);
+   talsh_tens_reg_shard_t & shard=talsh_tensor_registry_lock(talsh_tens); //the compressed body is not released meanwhile
+   auto it=shard.entries.find(talsh_tens);
+   if(it != shard.entries.end() && it->second.zip_data != NULL){
+    if(tens_valid_data_kind(it->second.zip_kind,&dks) == YEP){
+     temp=malloc(n*dks);
+     if(temp != NULL){
+      if(talsh_body_decompress(it->second.zip_data,it->second.zip_size,temp,n*dks) == 0)
+       norm1=talsh_body_norm1(temp,it->second.zip_kind,n);
+      free(temp);
+     }
+    }
+   }
+   talsh_tensor_registry_unlock(shard);
+  }else{
+   talsh_tensor_pins_clean(&pins);
+   talsh_tensor_pins_add(&pins,talsh_tens); //the body image must not be relocated while being read
+   i=talshTensorDataKind(talsh_tens,&nimg,dtk);
+   if(i == TALSH_SUCCESS){
+    talsh_tens_reg_shard_t & shard=talsh_tensor_registry_lock(talsh_tens); //the layout is not converted meanwhile
+    auto it=shard.entries.find(talsh_tens);
+    split=((it != shard.entries.end())?it->second.cplx_split:NOPE);
+    n=talshTensorVolume(talsh_tens);
+    for(i=0;i<talsh_tens->ndev;++i){
+     if(talsh_tens->dev_rsc[i].dev_id == talshFlatDevId(DEV_HOST,0)){
+      if(split == YEP){ //the split layout is read directly (the tensor is constant)
+       if(dtk[i] == C4){
+        norm1=talsh_body_norm1_split((const float*)(talsh_tens->dev_rsc[i].gmem_p),n);
+       }else{
+        norm1=talsh_body_norm1_split((const double*)(talsh_tens->dev_rsc[i].gmem_p),n);
+       }
+      }else{
+       norm1=talsh_body_norm1(talsh_tens->dev_rsc[i].gmem_p,dtk[i],n);
+      }
+      break;
      }
-     break;
     }
+    talsh_tensor_registry_unlock(shard);
    }
+   talsh_tensor_pins_release(&pins);
   }
  }
  return norm1;
@@ -53,6 +53,44 @@ Tensor::Impl::Impl(const std::vector<std::size_t> & signature, //tensor signatur
 }
 
 
+Tensor::Impl::Impl(const std::vector<std::size_t> & signature, //tensor signature (identifier): signature[0:rank-1]
+                   const std::vector<int> & dims,              //tensor dimension extents: dims[0:rank-1]
+                   int data_kind,                              //tensor data kind
+                   const std::string & file_name,              //name of the file holding the tensor body
+                   int map_mode,                               //file mapping mode
+                   int map_advice):                            //memory access advice
+ signature_(signature), host_mem_(nullptr), used_(0)
+{
+ int errc = talshTensorClean(&tensor_); assert(errc == TALSH_SUCCESS);
+ const int rank = static_cast<int>(dims.size());
+ errc = talshTensorConstructMapped(&tensor_,data_kind,rank,dims.data(),file_name.c_str(),map_mode,map_advice);
+ if(errc != TALSH_SUCCESS)
+  std::cout << "#ERROR(talsh::Tensor::Tensor): talshTensorConstructMapped error " << errc << std::endl << std::flush;
+ assert(errc == TALSH_SUCCESS);
+ assert(signature.size() == dims.size());
+ const void * body_p = nullptr;
+ errc = talshTensorGetBodyAccessConst(&tensor_,&body_p,data_kind,0,DEV_HOST); assert(errc == TALSH_SUCCESS);
+ host_mem_ = const_cast<void*>(body_p); //results synchronized back to Host will land in the mapped file
+ write_task_ = nullptr;
+}
+
+
+Tensor::Impl::Impl(const std::string & file_name,              //name of the TAL-SH tensor file
+                   int io_flags):                              //I/O flags
+ host_mem_(nullptr), used_(0)
+{
+ int errc = talshTensorClean(&tensor_); assert(errc == TALSH_SUCCESS);
+ std::size_t signature[MAX_TENSOR_RANK];
+ errc = talshTensorLoad(&tensor_,file_name.c_str(),signature,io_flags);
+ if(errc == TALSH_SUCCESS){
+  signature_.assign(signature,signature+talshTensorRank(&tensor_));
+ }else{ //the tensor stays empty
+  std::cout << "#ERROR(talsh::Tensor::load): talshTensorLoad error " << errc << " for file " << file_name << std::endl << std::flush;
+ }
+ write_task_ = nullptr;
+}
+
+
 Tensor::Impl::~Impl()
 {
  if(used_ != 0) std::cout << "#ERROR(Tensor::Impl::~Impl): Non-zero use count = " << used_ << std::endl;
@@ -80,6 +118,33 @@ Tensor::Tensor(const std::vector<int> & dims,              //tensor dimension ex
 }
 
 
+Tensor::Tensor(const std::vector<std::size_t> & signature, //tensor signature (identifier): signature[0:rank-1]
+               const std::vector<int> & dims,              //tensor dimension extents: dims[0:rank-1]
+               int data_kind,                              //tensor data kind
+               const std::string & file_name,              //name of the file holding the tensor body
+               int map_mode,                               //file mapping mode
+               int map_advice):                            //memory access advice
+ pimpl_(new Impl(signature,dims,data_kind,file_name,map_mode,map_advice))
+{
+}
+
+
+Tensor::Tensor(const std::vector<int> & dims,              //tensor dimension extents: dims[0:rank-1]
+               int data_kind,                              //tensor data kind
+               const std::string & file_name,              //name of the file holding the tensor body
+               int map_mode,                               //file mapping mode
+               int map_advice):                            //memory access advice
+ Tensor(std::vector<std::size_t>(dims.size(),0),dims,data_kind,file_name,map_mode,map_advice)
+{
+}
+
+
+Tensor::Tensor(std::shared_ptr<Impl> impl):
+ pimpl_(std::move(impl))
+{
+}
+
+
 /** Returns TRUE if the tensor is empty and cannot be used, which may
     happen when no enough memory was available during tensor construction. **/
 bool Tensor::isEmpty() const
@@ -273,6 +338,59 @@ bool Tensor::ready(int * status, const int device_kind, const int device_id, voi
 }
 
 
+/** Compresses the tensor body (completes the pending write task first). **/
+bool Tensor::compress(int zip_mode, double tolerance)
+{
+ bool res = this->completeWriteTask();
+ if(res){
+  int errc = talshTensorCompress(&(pimpl_->tensor_),zip_mode,tolerance);
+  if(errc != TALSH_SUCCESS && errc != TRY_LATER && errc != TALSH_NOT_ALLOWED)
+   std::cout << "#ERROR(talsh::Tensor::compress): talshTensorCompress error " << errc << std::endl;
+  res = (errc == TALSH_SUCCESS);
+ }
+ return res;
+}
+
+
+/** Decompresses the tensor body into a Host image. **/
+bool Tensor::decompress()
+{
+ int errc = talshTensorDecompress(&(pimpl_->tensor_));
+ if(errc != TALSH_SUCCESS && errc != TRY_LATER)
+  std::cout << "#ERROR(talsh::Tensor::decompress): talshTensorDecompress error " << errc << std::endl;
+ return (errc == TALSH_SUCCESS);
+}
+
+
+/** Returns TRUE if the tensor body is currently compressed. **/
+bool Tensor::isCompressed() const
+{
+ return (talshTensorIsCompressed(&(pimpl_->tensor_)) == YEP);
+}
+
+
+/** Saves the tensor into a TAL-SH tensor file (completes the pending write task first). **/
+bool Tensor::save(const std::string & file_name, int io_flags)
+{
+ bool res = this->completeWriteTask();
+ if(res){
+  int errc = talshTensorSave(&(pimpl_->tensor_),file_name.c_str(),(pimpl_->signature_).data(),io_flags);
+  if(errc != TALSH_SUCCESS){
+   std::cout << "#ERROR(talsh::Tensor::save): talshTensorSave error " << errc << " for file " << file_name << std::endl;
+   res = false;
+  }
+ }
+ return res;
+}
+
+
+/** Loads a tensor from a TAL-SH tensor file. The returned tensor is empty if loading failed. **/
+Tensor Tensor::load(const std::string & file_name, int io_flags)
+{
+ return Tensor(std::make_shared<Impl>(file_name,io_flags));
+}
+
+
 /** Prints the tensor info. **/
 void Tensor::print() const
 {
@@ -483,6 +601,43 @@ int Tensor::copyBody(TensorTask * task_handle,    //out: task handle associated
 }
 
 
+int Tensor::copyBody(TensorTask * task_handle,           //out: task handle associated with this operation or nullptr (synchronous)
+                     const ContractionPattern & pattern, //in: pre-parsed permutation pattern
+                     Tensor & left,                      //in: left tensor (source)
+                     const int device_kind,              //in: execution device kind
+                     const int device_id)                //in: execution device id
+{
+ int errc = TALSH_SUCCESS;
+ this->completeWriteTask();
+ left.completeWriteTask();
+ const talsh_contr_ptrn_t * contr_ptrn = pattern.get();
+ talsh_tens_t * dtens = this->getTalshTensorPtr();
+ talsh_tens_t * ltens = left.getTalshTensorPtr();
+ if(task_handle != nullptr){ //asynchronous
+  bool task_empty = task_handle->isEmpty(); assert(task_empty);
+  talsh_task_t * task_hl = task_handle->getTalshTaskPtr();
+  errc = talshTensorCopyDig(contr_ptrn,dtens,ltens,device_id,device_kind,COPY_MT,task_hl);
+  if(errc != TALSH_SUCCESS && errc != TRY_LATER && errc != DEVICE_UNABLE)
+   std::cout << "#ERROR(talsh::Tensor::copyBody): talshTensorCopyDig error " << errc << std::endl;
+  assert(errc == TALSH_SUCCESS || errc == TRY_LATER || errc == DEVICE_UNABLE);
+  if(errc == TALSH_SUCCESS){
+   task_handle->used_tensors_[0] = this;
+   task_handle->used_tensors_[1] = &left;
+   task_handle->num_tensors_ = 2;
+   this->resetWriteTask(task_handle);
+  }else{
+   task_handle->clean();
+  }
+ }else{ //synchronous
+  errc = talshTensorCopyDig(contr_ptrn,dtens,ltens,device_id,device_kind,COPY_MT);
+  if(errc != TALSH_SUCCESS && errc != TRY_LATER && errc != DEVICE_UNABLE)
+   std::cout << "#ERROR(talsh::Tensor::copyBody): talshTensorCopyDig error " << errc << std::endl;
+  assert(errc == TALSH_SUCCESS || errc == TRY_LATER || errc == DEVICE_UNABLE);
+ }
+ return errc;
+}
+
+
 int Tensor::decomposeSVD(TensorTask * task_handle,    //out: task handle associated with this operation or nullptr (synchronous)
                          const std::string & pattern, //in: decomposition pattern string (same as the tensor contraction pattern)
                          Tensor & left,               //out: left tensor factor
@@ -569,6 +724,148 @@ int Tensor::decomposeSVDLR(TensorTask * task_handle,    //out: task handle assoc
 }
 
 
+int Tensor::decomposeSVD(TensorTask * task_handle,    //out: task handle associated with this operation or nullptr (synchronous)
+                         const std::string & pattern, //in: decomposition pattern string (same as the tensor contraction pattern)
+                         Tensor & left,               //out: left tensor factor
+                         Tensor & right,              //out: right tensor factor
+                         Tensor & middle,             //out: middle tensor factor (may be empty on entrance)
+                         int max_rank,                //in: max number of retained singular triplets (0: no limit)
+                         double rel_threshold,        //in: relative singular value cutoff (0: none)
+                         int * achieved_rank,         //out: number of retained singular triplets
+                         double * discarded_weight,   //out: relative discarded weight
+                         const int device_kind,       //in: execution device kind
+                         const int device_id)         //in: execution device id
+{
+ int errc = TALSH_SUCCESS;
+ this->completeWriteTask();
+ left.completeWriteTask();
+ right.completeWriteTask();
+ const char * contr_ptrn = pattern.c_str();
+ talsh_tens_t * dtens = this->getTalshTensorPtr();
+ talsh_tens_t * ltens = left.getTalshTensorPtr();
+ talsh_tens_t * rtens = right.getTalshTensorPtr();
+ talsh_tens_t * stens = middle.getTalshTensorPtr();
+ if(task_handle != nullptr) task_handle->clean();
+ errc = talshTensorDecomposeSVDTrunc(contr_ptrn,dtens,ltens,rtens,stens,'N',max_rank,rel_threshold,
+                                     achieved_rank,discarded_weight,device_id,device_kind);
+ return errc;
+}
+
+
+int Tensor::decomposeSVDL(TensorTask * task_handle,    //out: task handle associated with this operation or nullptr (synchronous)
+                          const std::string & pattern, //in: decomposition pattern string (same as the tensor contraction pattern)
+                          Tensor & left,               //out: left tensor factor
+                          Tensor & right,              //out: right tensor factor
+                          int max_rank,                //in: max number of retained singular triplets (0: no limit)
+                          double rel_threshold,        //in: relative singular value cutoff (0: none)
+                          int * achieved_rank,         //out: number of retained singular triplets
+                          double * discarded_weight,   //out: relative discarded weight
+                          const int device_kind,       //in: execution device kind
+                          const int device_id)         //in: execution device id
+{
+ int errc = TALSH_SUCCESS;
+ this->completeWriteTask();
+ left.completeWriteTask();
+ right.completeWriteTask();
+ const char * contr_ptrn = pattern.c_str();
+ talsh_tens_t * dtens = this->getTalshTensorPtr();
+ talsh_tens_t * ltens = left.getTalshTensorPtr();
+ talsh_tens_t * rtens = right.getTalshTensorPtr();
+ if(task_handle != nullptr) task_handle->clean();
+ talsh_tens_t stens;
+ errc = talshTensorClean(&stens);
+ if(errc == TALSH_SUCCESS){
+  errc = talshTensorDecomposeSVDTrunc(contr_ptrn,dtens,ltens,rtens,&stens,'L',max_rank,rel_threshold,
+                                      achieved_rank,discarded_weight,device_id,device_kind);
+  int ier = talshTensorDestruct(&stens); if(ier != TALSH_SUCCESS && errc == TALSH_SUCCESS) errc = ier;
+ }
+ return errc;
+}
+
+
+int Tensor::decomposeSVDR(TensorTask * task_handle,    //out: task handle associated with this operation or nullptr (synchronous)
+                          const std::string & pattern, //in: decomposition pattern string (same as the tensor contraction pattern)
+                          Tensor & left,               //out: left tensor factor
+                          Tensor & right,              //out: right tensor factor
+                          int max_rank,                //in: max number of retained singular triplets (0: no limit)
+                          double rel_threshold,        //in: relative singular value cutoff (0: none)
+                          int * achieved_rank,         //out: number of retained singular triplets
+                          double * discarded_weight,   //out: relative discarded weight
+                          const int device_kind,       //in: execution device kind
+                          const int device_id)         //in: execution device id
+{
+ int errc = TALSH_SUCCESS;
+ this->completeWriteTask();
+ left.completeWriteTask();
+ right.completeWriteTask();
+ const char * contr_ptrn = pattern.c_str();
+ talsh_tens_t * dtens = this->getTalshTensorPtr();
+ talsh_tens_t * ltens = left.getTalshTensorPtr();
+ talsh_tens_t * rtens = right.getTalshTensorPtr();
+ if(task_handle != nullptr) task_handle->clean();
+ talsh_tens_t stens;
+ errc = talshTensorClean(&stens);
+ if(errc == TALSH_SUCCESS){
+  errc = talshTensorDecomposeSVDTrunc(contr_ptrn,dtens,ltens,rtens,&stens,'R',max_rank,rel_threshold,
+                                      achieved_rank,discarded_weight,device_id,device_kind);
+  int ier = talshTensorDestruct(&stens); if(ier != TALSH_SUCCESS && errc == TALSH_SUCCESS) errc = ier;
+ }
+ return errc;
+}
+
+
+int Tensor::decomposeSVDLR(TensorTask * task_handle,    //out: task handle associated with this operation or nullptr (synchronous)
+                           const std::string & pattern, //in: decomposition pattern string (same as the tensor contraction pattern)
+                           Tensor & left,               //out: left tensor factor
+                           Tensor & right,              //out: right tensor factor
+                           int max_rank,                //in: max number of retained singular triplets (0: no limit)
+                           double rel_threshold,        //in: relative singular value cutoff (0: none)
+                           int * achieved_rank,         //out: number of retained singular triplets
+                           double * discarded_weight,   //out: relative discarded weight
+                           const int device_kind,       //in: execution device kind
+                           const int device_id)         //in: execution device id
+{
+ int errc = TALSH_SUCCESS;
+ this->completeWriteTask();
+ left.completeWriteTask();
+ right.completeWriteTask();
+ const char * contr_ptrn = pattern.c_str();
+ talsh_tens_t * dtens = this->getTalshTensorPtr();
+ talsh_tens_t * ltens = left.getTalshTensorPtr();
+ talsh_tens_t * rtens = right.getTalshTensorPtr();
+ if(task_handle != nullptr) task_handle->clean();
+ talsh_tens_t stens;
+ errc = talshTensorClean(&stens);
+ if(errc == TALSH_SUCCESS){
+  errc = talshTensorDecomposeSVDTrunc(contr_ptrn,dtens,ltens,rtens,&stens,'S',max_rank,rel_threshold,
+                                      achieved_rank,discarded_weight,device_id,device_kind);
+  int ier = talshTensorDestruct(&stens); if(ier != TALSH_SUCCESS && errc == TALSH_SUCCESS) errc = ier;
+ }
+ return errc;
+}
+
+
+int Tensor::decomposeQR(TensorTask * task_handle,    //out: task handle associated with this operation or nullptr (synchronous)
+                        const std::string & pattern, //in: decomposition pattern string (same as the tensor contraction pattern)
+                        Tensor & left,               //out: isometric tensor factor Q
+                        Tensor & right,              //out: upper-triangular tensor factor R
+                        const int device_kind,       //in: execution device kind
+                        const int device_id)         //in: execution device id
+{
+ int errc = TALSH_SUCCESS;
+ this->completeWriteTask();
+ left.completeWriteTask();
+ right.completeWriteTask();
+ const char * contr_ptrn = pattern.c_str();
+ talsh_tens_t * dtens = this->getTalshTensorPtr();
+ talsh_tens_t * qtens = left.getTalshTensorPtr();
+ talsh_tens_t * rtens = right.getTalshTensorPtr();
+ if(task_handle != nullptr) task_handle->clean();
+ errc = talshTensorDecomposeQR(contr_ptrn,dtens,qtens,rtens,device_id,device_kind);
+ return errc;
+}
+
+
 int Tensor::orthogonalizeSVD(TensorTask * task_handle,    //out: task handle associated with this operation or nullptr (synchronous)
                              const std::string & pattern, //in: decomposition pattern string (same as the tensor contraction pattern)
                              const int device_kind,       //in: execution device kind
@@ -9,7 +9,8 @@ LICENSE: BSD 3-Clause **/
 #ifndef TALSHXX_HPP_
 #define TALSHXX_HPP_
 
-#include "talsh_task.hpp" //TAL-SH C++ task
+#include "talsh_task.hpp"    //TAL-SH C++ task
+#include "talsh_pattern.hpp" //TAL-SH C++ tensor operation pattern
 #include "talsh.h"        //TAL-SH C header
 #include "mem_manager.h"  //TAL-SH memory manager
 
@@ -100,9 +101,124 @@ class Tensor{
 
 public:
 
- /** Tensor body slice view for a quick access (host-side) **/
- template <typename FloatingType>
+ /** Tensor body slice view for a quick access (host-side):
+     View<T> has a run-time rank and checked access (slow),
+     View<T,Rank> has a compile-time rank, precomputed strides
+     and unchecked access (fast), see getView<T,Rank>(). **/
+ template <typename FloatingType, unsigned int Rank = 0>
  class View{
+ public:
+
+  static_assert(Rank > 0,"FATAL(talsh::Tensor::View): Invalid tensor rank!");
+
+  View(FloatingType * body,                       //body of the full tensor
+       const std::size_t (&full_extents)[Rank],   //full tensor dimension extents
+       const std::size_t (&extents)[Rank],        //slice dimension extents
+       const std::size_t (&bases)[Rank]):         //slice dimension bases
+   body_(body)
+  {
+   std::size_t stride = 1;
+   for(unsigned int i = 0; i < Rank; ++i){
+    assert(bases[i] + extents[i] <= full_extents[i]);
+    body_ += bases[i] * stride;
+    extents_[i] = extents[i];
+    strides_[i] = stride;
+    stride *= full_extents[i];
+   }
+   num_rows_ = 1; for(unsigned int i = 1; i < Rank; ++i) num_rows_ *= extents_[i];
+  }
+
+  /** Unchecked element access by its multi-index (slice-relative): view(i0,i1,...). **/
+  template <typename... IntegralTypes>
+  inline FloatingType & operator()(IntegralTypes... mlndx) const{
+   static_assert(sizeof...(IntegralTypes) == Rank,"FATAL(talsh::Tensor::View::operator()): Wrong number of indices!");
+   const std::size_t ind[Rank] = {static_cast<std::size_t>(mlndx)...};
+   std::size_t offset = 0;
+   for(unsigned int i = 0; i < Rank; ++i) offset += ind[i] * strides_[i];
+   return body_[offset];
+  }
+
+  /** Unchecked element access by its multi-index (slice-relative). **/
+  inline FloatingType & operator[](const std::size_t (&mlndx)[Rank]) const{
+   std::size_t offset = 0;
+   for(unsigned int i = 0; i < Rank; ++i) offset += mlndx[i] * strides_[i];
+   return body_[offset];
+  }
+
+  /** Checked element access by its multi-index (slice-relative). **/
+  FloatingType & at(const std::size_t (&mlndx)[Rank]) const{
+   for(unsigned int i = 0; i < Rank; ++i) assert(mlndx[i] < extents_[i]);
+   return (*this)[mlndx];
+  }
+
+  /** Returns the extent of a slice dimension. **/
+  inline std::size_t getExtent(unsigned int dim) const {return extents_[dim];}
+
+  /** Returns the stride of a slice dimension (in elements). **/
+  inline std::size_t getStride(unsigned int dim) const {return strides_[dim];}
+
+  /** Returns the number of rows in the slice (a row spans the leading dimension,
+      which is contiguous in memory). **/
+  inline std::size_t getNumRows() const {return num_rows_;}
+
+  /** Returns the length of each row in the slice. **/
+  inline std::size_t getRowLength() const {return extents_[0];}
+
+  /** Returns a pointer to the beginning of a contiguous row of the slice
+      (rows are numbered in the column-major order over dimensions 1..Rank-1).
+      If <mlndx> is given, it will contain the multi-index of the first row element. **/
+  FloatingType * getRow(std::size_t row, std::size_t * mlndx = nullptr) const{
+   std::size_t offset = 0;
+   if(mlndx != nullptr) mlndx[0] = 0;
+   for(unsigned int i = 1; i < Rank; ++i){
+    const std::size_t ind = row % extents_[i]; row /= extents_[i];
+    offset += ind * strides_[i];
+    if(mlndx != nullptr) mlndx[i] = ind;
+   }
+   return body_ + offset;
+  }
+
+  /** Applies a function to each contiguous row of the slice: func(row_ptr, row_length, mlndx),
+      where <mlndx> is the multi-index of the first row element. Rows are processed in parallel. **/
+  template <typename Function>
+  void forEachRow(Function func) const{
+   const std::size_t num_rows = num_rows_;
+   const std::size_t row_len = extents_[0];
+#ifndef NO_OMP
+#pragma omp parallel for schedule(static)
+#endif
+   for(std::size_t row = 0; row < num_rows; ++row){
+    std::size_t mlndx[Rank];
+    FloatingType * row_ptr = getRow(row,mlndx);
+    func(row_ptr,row_len,static_cast<const std::size_t *>(mlndx));
+   }
+   return;
+  }
+
+  /** Applies a function to each element of the slice: func(element, mlndx).
+      Rows are processed in parallel, elements of a row sequentially. **/
+  template <typename Function>
+  void forEach(Function func) const{
+   forEachRow([&func](FloatingType * row_ptr, std::size_t row_len, const std::size_t * first){
+    std::size_t mlndx[Rank];
+    for(unsigned int i = 0; i < Rank; ++i) mlndx[i] = first[i];
+    for(std::size_t j = 0; j < row_len; ++j){
+     mlndx[0] = j;
+     func(row_ptr[j],static_cast<const std::size_t *>(mlndx));
+    }
+   });
+   return;
+  }
+
+ private:
+  FloatingType * body_;      //pointer to the first element of the slice
+  std::size_t extents_[Rank]; //slice dimension extents
+  std::size_t strides_[Rank]; //dimension strides
+  std::size_t num_rows_;      //number of rows in the slice
+ };
+
+ template <typename FloatingType>
+ class View<FloatingType,0>{
  public:
 
   View(FloatingType * body,
@@ -170,6 +286,14 @@ public:
         T * ext_mem,                                        //pointer to an external memory storage where the tensor body will reside
         const T * init_val = nullptr);                      //optional scalar initialization value (provide nullptr if not needed)
 
+ /** Full Ctor with a memory-mapped file storage (tensor body resides in a file mapped into Host memory) **/
+ Tensor(const std::vector<std::size_t> & signature,         //tensor signature (identifier): signature[0:rank-1]
+        const std::vector<int> & dims,                      //tensor dimension extents: dims[0:rank-1]
+        int data_kind,                                      //tensor data kind
+        const std::string & file_name,                      //name of the file holding the tensor body
+        int map_mode = MEM_MAP_OPEN,                        //file mapping mode: {MEM_MAP_OPEN,MEM_MAP_CREATE,MEM_MAP_PRIVATE}
+        int map_advice = MEM_MAP_ADVICE_NORMAL);            //memory access advice: {MEM_MAP_ADVICE_NORMAL,...}
+
  /** Short Ctor with scalar initialization (TAL-SH provides tensor data storage) **/
  template <typename T>
  Tensor(const std::vector<int> & dims,                      //tensor dimension extents: dims[0:rank-1]
@@ -191,6 +315,13 @@ public:
         T * ext_mem,                                        //pointer to an external memory storage where the tensor body will reside
         const T * init_val = nullptr);                      //optional scalar initialization value (provide nullptr if not needed)
 
+ /** Short Ctor with a memory-mapped file storage (tensor body resides in a file mapped into Host memory) **/
+ Tensor(const std::vector<int> & dims,                      //tensor dimension extents: dims[0:rank-1]
+        int data_kind,                                      //tensor data kind
+        const std::string & file_name,                      //name of the file holding the tensor body
+        int map_mode = MEM_MAP_OPEN,                        //file mapping mode: {MEM_MAP_OPEN,MEM_MAP_CREATE,MEM_MAP_PRIVATE}
+        int map_advice = MEM_MAP_ADVICE_NORMAL);            //memory access advice: {MEM_MAP_ADVICE_NORMAL,...}
+
  /** Copy ctor **/
  Tensor(const Tensor & tensor) = default;
 
@@ -249,6 +380,13 @@ public:
  template<typename T>
  bool getDataAccessHostConst(const T ** data_ptr);
 
+ /** Initializes/transforms the tensor body on Host tile by tile in parallel: <tile_func> is
+     invoked as int tile_func(const talsh_tens_dense_t & tile) concurrently for disjoint contiguous
+     tiles of the tensor body (see talshTensorApplyTiles) and must return 0 on success. **/
+ template<typename TileFunc>
+ int applyTiles(TileFunc tile_func,
+                std::size_t tile_volume = 0); //in: approximate tile volume (0:default)
+
  /** Returns a typed view of the full tensor. **/
  template<typename T>
  View<T> getSliceView();
@@ -262,6 +400,15 @@ public:
  View<T> getSliceView(const std::initializer_list<IntegralType> slice_extents,
                       const std::initializer_list<IntegralType> slice_bases);
 
+ /** Returns a typed compile-time-rank view of the full tensor (fast unchecked access). **/
+ template<typename T, unsigned int Rank>
+ View<T,Rank> getView();
+
+ /** Returns a typed compile-time-rank view of a slice of the tensor with base offsets. **/
+ template<typename T, unsigned int Rank>
+ View<T,Rank> getView(const std::size_t (&slice_extents)[Rank],
+                      const std::size_t (&slice_bases)[Rank]);
+
  /** Tensor element access by its multi-index (slow). **/
  template <typename T, typename IntegralType>
  T & operator[](const std::initializer_list<IntegralType> mlndx);
@@ -343,6 +490,15 @@ public:
               const int device_kind = DEV_HOST,       //in: execution device kind
               const int device_id = 0);               //in: execution device id
 
+ /** Copies the body of another congruent tensor with an optional dimension permutation
+     using a pre-parsed pattern (no run-time pattern parsing).
+     Returns an error code (0:success). **/
+ int copyBody(TensorTask * task_handle,               //out: task handle associated with this operation or nullptr (synchronous)
+              const ContractionPattern & pattern,     //in: pre-parsed permutation pattern
+              Tensor & left,                          //in: left tensor (source)
+              const int device_kind = DEV_HOST,       //in: execution device kind
+              const int device_id = 0);               //in: execution device id
+
  /** Performs accumulation of a tensor into the current tensor:
      this += left * scalar_factor
      Returns an error code (0:success). **/
@@ -354,6 +510,17 @@ public:
                 const int device_id = 0,                //in: execution device id
                 const T factor = TensorData<T>::unity); //in: scalar factor
 
+ /** Performs accumulation of a tensor into the current tensor using a pre-parsed pattern:
+     this += left * scalar_factor
+     Returns an error code (0:success). **/
+ template <typename T = double>
+ int accumulate(TensorTask * task_handle,               //out: task handle associated with this operation or nullptr (synchronous)
+                const ContractionPattern & pattern,     //in: pre-parsed accumulation pattern
+                Tensor & left,                          //in: left tensor
+                const int device_kind = DEV_HOST,       //in: execution device kind
+                const int device_id = 0,                //in: execution device id
+                const T factor = TensorData<T>::unity); //in: scalar factor
+
  /** Performs a tensor contraction of two tensors and accumulates the result into the current tensor:
      this += left * right * scalar_factor
      Returns an error code (0:success). **/
@@ -367,6 +534,20 @@ public:
                         const T factor = TensorData<T>::unity,  //in: scalar factor (alpha)
                         bool accumulative = true);              //in: accumulate versus overwrite the destination tensor
 
+ /** Performs a tensor contraction of two tensors using a pre-parsed pattern
+     and accumulates the result into the current tensor:
+     this += left * right * scalar_factor
+     Returns an error code (0:success). **/
+ template <typename T = double>
+ int contractAccumulate(TensorTask * task_handle,               //out: task handle associated with this operation or nullptr (synchronous)
+                        const ContractionPattern & pattern,     //in: pre-parsed contraction pattern
+                        Tensor & left,                          //in: left tensor
+                        Tensor & right,                         //in: right tensor
+                        const int device_kind = DEV_HOST,       //in: execution device kind
+                        const int device_id = 0,                //in: execution device id
+                        const T factor = TensorData<T>::unity,  //in: scalar factor (alpha)
+                        bool accumulative = true);              //in: accumulate versus overwrite the destination tensor
+
  /** Performs an extra large tensor contraction of two tensors and accumulates the result into the current tensor:
      this += left * right * scalar_factor
      Regardless of the chosen execution device, this operation is blocking and the result will be available on Host.
@@ -453,6 +634,73 @@ public:
                     const int device_kind = DEV_HOST, //in: execution device kind
                     const int device_id = 0);         //in: execution device id
 
+ /** Truncated tensor decomposition via SVD (executed on Host). Retains at most <max_rank>
+     leading singular triplets (0: no limit), discarding those with singular values below
+     <rel_threshold> times the largest one. The tensor factors keep their shapes and are
+     zero-padded beyond the achieved rank. Large matricizations with a small requested rank
+     are decomposed via the randomized range finder with power iterations.
+     On exit, <achieved_rank> is the number of retained singular triplets and <discarded_weight>
+     is the squared 2-norm of the discarded part relative to that of the tensor (both may be nullptr).
+     The absorption of the middle tensor factor follows the non-truncated variants.
+     Returns an error code (0:success). **/
+ int decomposeSVD(TensorTask * task_handle,         //out: task handle associated with this operation or nullptr (synchronous)
+                  const std::string & pattern,      //in: decomposition pattern string (same as the tensor contraction pattern)
+                  Tensor & left,                    //out: left tensor factor
+                  Tensor & right,                   //out: right tensor factor
+                  Tensor & middle,                  //out: middle tensor factor (may be empty on entrance)
+                  int max_rank,                     //in: max number of retained singular triplets (0: no limit)
+                  double rel_threshold,             //in: relative singular value cutoff (0: none)
+                  int * achieved_rank,              //out: number of retained singular triplets
+                  double * discarded_weight,        //out: relative discarded weight
+                  const int device_kind = DEV_HOST, //in: execution device kind
+                  const int device_id = 0);         //in: execution device id
+
+ int decomposeSVDL(TensorTask * task_handle,         //out: task handle associated with this operation or nullptr (synchronous)
+                   const std::string & pattern,      //in: decomposition pattern string (same as the tensor contraction pattern)
+                   Tensor & left,                    //out: left tensor factor
+                   Tensor & right,                   //out: right tensor factor
+                   int max_rank,                     //in: max number of retained singular triplets (0: no limit)
+                   double rel_threshold,             //in: relative singular value cutoff (0: none)
+                   int * achieved_rank,              //out: number of retained singular triplets
+                   double * discarded_weight,        //out: relative discarded weight
+                   const int device_kind = DEV_HOST, //in: execution device kind
+                   const int device_id = 0);         //in: execution device id
+
+ int decomposeSVDR(TensorTask * task_handle,         //out: task handle associated with this operation or nullptr (synchronous)
+                   const std::string & pattern,      //in: decomposition pattern string (same as the tensor contraction pattern)
+                   Tensor & left,                    //out: left tensor factor
+                   Tensor & right,                   //out: right tensor factor
+                   int max_rank,                     //in: max number of retained singular triplets (0: no limit)
+                   double rel_threshold,             //in: relative singular value cutoff (0: none)
+                   int * achieved_rank,              //out: number of retained singular triplets
+                   double * discarded_weight,        //out: relative discarded weight
+                   const int device_kind = DEV_HOST, //in: execution device kind
+                   const int device_id = 0);         //in: execution device id
+
+ int decomposeSVDLR(TensorTask * task_handle,         //out: task handle associated with this operation or nullptr (synchronous)
+                    const std::string & pattern,      //in: decomposition pattern string (same as the tensor contraction pattern)
+                    Tensor & left,                    //out: left tensor factor
+                    Tensor & right,                   //out: right tensor factor
+                    int max_rank,                     //in: max number of retained singular triplets (0: no limit)
+                    double rel_threshold,             //in: relative singular value cutoff (0: none)
+                    int * achieved_rank,              //out: number of retained singular triplets
+                    double * discarded_weight,        //out: relative discarded weight
+                    const int device_kind = DEV_HOST, //in: execution device kind
+                    const int device_id = 0);         //in: execution device id
+
+ /** Tensor decomposition via the thin QR decomposition (executed on Host).
+     Example of the decomposition of tensor D(a,b,c,d):
+      D(a,b,c,d)=Q(c,i,a)*R(i,d,b)
+     The open indices of the Q factor form the rows of the tall-skinny matricization
+     of the tensor, the volume of the contracted indices must coincide with the volume
+     of the open indices of the R factor. Returns an error code (0:success). **/
+ int decomposeQR(TensorTask * task_handle,         //out: task handle associated with this operation or nullptr (synchronous)
+                 const std::string & pattern,      //in: decomposition pattern string (same as the tensor contraction pattern)
+                 Tensor & left,                    //out: isometric tensor factor Q
+                 Tensor & right,                   //out: upper-triangular tensor factor R
+                 const int device_kind = DEV_HOST, //in: execution device kind
+                 const int device_id = 0);         //in: execution device id
+
  /** Internal tensor orthogonalization via SVD and discarding the middle tensor.
      Returns an error code (0:success).
      Example of the decomposition of tensor D(a,b,c,d,e):
@@ -470,7 +718,8 @@ public:
                       const int device_kind = DEV_HOST, //in: execution device kind
                       const int device_id = 0);         //in: execution device id
 
- /** Internal tensor orthogonalization via the Modified Gram-Schmidt procedure.
+ /** Internal tensor orthogonalization via the thin QR decomposition (CholeskyQR2,
+     with the Modified Gram-Schmidt fallback for rank-deficient tensors).
      The set of tensor dimensions provided in the isometric dimension set argument
      will form the column space of the corresponding orthogonal matrix,
      which can either be square or tall rectangular. Thus, the cumulative
@@ -481,6 +730,29 @@ public:
                       const int device_kind = DEV_HOST, //in: execution device kind
                       const int device_id = 0);         //in: execution device id
 
+ /** Compresses the tensor body (completes the pending write task first): All body images are released
+     and the body will be decompressed into a Host image on first use. Previously obtained pointers
+     to the tensor body become invalid. In the lossy mode (TALSH_ZIP_LOSSY), each real component
+     is restored within the absolute error <tolerance>. **/
+ bool compress(int zip_mode = TALSH_ZIP_LOSSLESS, //in: compression mode: {TALSH_ZIP_LOSSLESS,TALSH_ZIP_LOSSY}
+               double tolerance = 0.0);           //in: absolute error bound (TALSH_ZIP_LOSSY only)
+
+ /** Decompresses the tensor body into a Host image (no action if not compressed). **/
+ bool decompress();
+
+ /** Returns TRUE if the tensor body is currently compressed. **/
+ bool isCompressed() const;
+
+ /** Saves the tensor into a TAL-SH tensor file (completes the pending write task first).
+     The tensor body is written in independently checksummed chunks in parallel,
+     optionally compressed (TALSH_IO_COMPRESS) and/or bypassing the page cache (TALSH_IO_DIRECT). **/
+ bool save(const std::string & file_name,     //in: file name
+           int io_flags = TALSH_IO_DEFAULT);  //in: I/O flags: Bitwise OR of TALSH_IO_XXX
+
+ /** Loads a tensor from a TAL-SH tensor file (the tensor is constructed on Host). **/
+ static Tensor load(const std::string & file_name,    //in: file name
+                    int io_flags = TALSH_IO_DEFAULT); //in: I/O flags: Bitwise OR of TALSH_IO_XXX
+
  /** Prints the tensor info. **/
  void print() const;
  /** Prints the tensor info and elements greater or equal to "thresh". **/
@@ -545,12 +817,25 @@ private:
        T * ext_mem,                                        //pointer to an external memory storage where the tensor body will reside
        const T * init_val = nullptr);                      //optional scalar initialization value (provide nullptr if not needed)
 
+  Impl(const std::vector<std::size_t> & signature,         //tensor signature (identifier): signature[0:rank-1]
+       const std::vector<int> & dims,                      //tensor dimension extents: dims[0:rank-1]
+       int data_kind,                                      //tensor data kind
+       const std::string & file_name,                      //name of the file holding the tensor body
+       int map_mode,                                       //file mapping mode
+       int map_advice);                                    //memory access advice
+
+  Impl(const std::string & file_name,                      //name of the TAL-SH tensor file
+       int io_flags);                                      //I/O flags
+
   Impl(const Impl &) = delete;
   Impl & operator=(const Impl &) = delete;
 
   ~Impl();
  };
 
+ //Private ctor (tensor loading):
+ Tensor(std::shared_ptr<Impl> impl);
+
  //Data members:
  std::shared_ptr<Impl> pimpl_;
 };
@@ -687,16 +972,15 @@ Tensor::Impl::Impl(const std::initializer_list<std::size_t> signature, //tensor
  int errc = talshTensorClean(&tensor_); assert(errc == TALSH_SUCCESS);
  assert(ext_mem != nullptr);
  const int rank = static_cast<int>(dims.size());
- if(init_val == nullptr){
-  errc = talshTensorConstruct(&tensor_,TensorData<T>::kind,rank,dims.begin(),talshFlatDevId(DEV_HOST,0),(void*)ext_mem);
- }else{
-  std::cout << "#FATAL: Initialization of tensors with external memory storage is not implemented in TAL-SH yet!" << std::endl; assert(false);
-  errc = talshTensorConstruct(&tensor_,TensorData<T>::kind,rank,dims.begin(),talshFlatDevId(DEV_HOST,0),(void*)ext_mem,-1,
-                              NULL,realPart(*init_val),imagPart(*init_val));
- }
+ errc = talshTensorConstruct(&tensor_,TensorData<T>::kind,rank,dims.begin(),talshFlatDevId(DEV_HOST,0),(void*)ext_mem);
  if(errc != TALSH_SUCCESS && errc != TRY_LATER)
   std::cout << "#ERROR(talsh::Tensor::Tensor): talshTensorConstruct error " << errc << std::endl << std::flush;
  assert(errc == TALSH_SUCCESS || errc == TRY_LATER);
+ if(errc == TALSH_SUCCESS && init_val != nullptr){ //external memory is initialized in place on Host
+  errc = talshTensorInit(&tensor_,realPart(*init_val),imagPart(*init_val),0,DEV_HOST);
+  if(errc != TALSH_SUCCESS) std::cout << "#ERROR(talsh::Tensor::Tensor): talshTensorInit error " << errc << std::endl << std::flush;
+  assert(errc == TALSH_SUCCESS);
+ }
  assert(signature.size() == dims.size());
  write_task_ = nullptr;
 }
@@ -712,16 +996,15 @@ Tensor::Impl::Impl(const std::vector<std::size_t> & signature, //tensor signatur
  int errc = talshTensorClean(&tensor_); assert(errc == TALSH_SUCCESS);
  assert(ext_mem != nullptr);
  const int rank = static_cast<int>(dims.size());
- if(init_val == nullptr){
-  errc = talshTensorConstruct(&tensor_,TensorData<T>::kind,rank,dims.data(),talshFlatDevId(DEV_HOST,0),(void*)ext_mem);
- }else{
-  std::cout << "#FATAL: Initialization of tensors with external memory storage is not implemented in TAL-SH yet!" << std::endl; assert(false);
-  errc = talshTensorConstruct(&tensor_,TensorData<T>::kind,rank,dims.data(),talshFlatDevId(DEV_HOST,0),(void*)ext_mem,-1,
-                              NULL,realPart(*init_val),imagPart(*init_val));
- }
+ errc = talshTensorConstruct(&tensor_,TensorData<T>::kind,rank,dims.data(),talshFlatDevId(DEV_HOST,0),(void*)ext_mem);
  if(errc != TALSH_SUCCESS && errc != TRY_LATER)
   std::cout << "#ERROR(talsh::Tensor::Tensor): talshTensorConstruct error " << errc << std::endl << std::flush;
  assert(errc == TALSH_SUCCESS || errc == TRY_LATER);
+ if(errc == TALSH_SUCCESS && init_val != nullptr){ //external memory is initialized in place on Host
+  errc = talshTensorInit(&tensor_,realPart(*init_val),imagPart(*init_val),0,DEV_HOST);
+  if(errc != TALSH_SUCCESS) std::cout << "#ERROR(talsh::Tensor::Tensor): talshTensorInit error " << errc << std::endl << std::flush;
+  assert(errc == TALSH_SUCCESS);
+ }
  assert(signature.size() == dims.size());
  write_task_ = nullptr;
 }
@@ -819,10 +1102,11 @@ bool Tensor::getDataAccessHostConst(const T ** data_ptr)
 {
  this->completeWriteTask();
  int data_kind = TensorData<T>::kind;
- const talsh_tens_t * dtens = this->getTalshTensorPtr();
+ talsh_tens_t * dtens = this->getTalshTensorPtr();
  assert(dtens != nullptr);
  const void * body_ptr;
- int errc = talshTensorGetBodyAccessConst(dtens,&body_ptr,data_kind,0,DEV_HOST);
+ int errc = talshTensorSetComplexLayout(dtens,TALSH_CPLX_INTERLEAVED); //constant access requires the interleaved layout
+ if(errc == TALSH_SUCCESS) errc = talshTensorGetBodyAccessConst(dtens,&body_ptr,data_kind,0,DEV_HOST);
  if(errc == TALSH_SUCCESS){
   *data_ptr = static_cast<const T*>(body_ptr);
  }else{
@@ -833,6 +1117,24 @@ bool Tensor::getDataAccessHostConst(const T ** data_ptr)
 }
 
 
+/** Adapts a C++ callable to the TAL-SH tile initialization interface. **/
+template<typename TileFunc>
+int talsh_tile_func_adapter(const talsh_tens_dense_t * tile, void * context)
+{
+ return (*static_cast<TileFunc*>(context))(*tile);
+}
+
+/** Initializes/transforms the tensor body on Host tile by tile in parallel. **/
+template<typename TileFunc>
+int Tensor::applyTiles(TileFunc tile_func, std::size_t tile_volume)
+{
+ this->completeWriteTask();
+ talsh_tens_t * dtens = this->getTalshTensorPtr();
+ assert(dtens != nullptr);
+ return talshTensorApplyTiles(dtens,&talsh_tile_func_adapter<TileFunc>,static_cast<void*>(&tile_func),tile_volume);
+}
+
+
 /** Returns a typed view of the full tensor. **/
 template<typename T>
 Tensor::View<T> Tensor::getSliceView()
@@ -878,6 +1180,32 @@ Tensor::View<T> Tensor::getSliceView(const std::initializer_list<IntegralType> s
  return Tensor::View<T>(body,full_extents,std::vector<std::size_t>(slice_extents),std::vector<std::size_t>(slice_bases));
 }
 
+/** Returns a typed compile-time-rank view of the full tensor (fast unchecked access). **/
+template<typename T, unsigned int Rank>
+Tensor::View<T,Rank> Tensor::getView()
+{
+ unsigned int num_dims = 0;
+ const auto * dims = getDimExtents(num_dims); assert(num_dims == Rank);
+ std::size_t full_extents[Rank], bases[Rank];
+ for(unsigned int i = 0; i < Rank; ++i){full_extents[i] = dims[i]; bases[i] = 0;}
+ return getView<T,Rank>(full_extents,bases);
+}
+
+/** Returns a typed compile-time-rank view of a slice of the tensor with base offsets. **/
+template<typename T, unsigned int Rank>
+Tensor::View<T,Rank> Tensor::getView(const std::size_t (&slice_extents)[Rank],
+                                     const std::size_t (&slice_bases)[Rank])
+{
+ auto synced = sync(DEV_HOST,0,pimpl_->host_mem_,true); assert(synced);
+ T * body;
+ auto access_granted = getDataAccessHost(&body); assert(access_granted);
+ unsigned int num_dims = 0;
+ const auto * dims = getDimExtents(num_dims); assert(num_dims == Rank);
+ std::size_t full_extents[Rank];
+ for(unsigned int i = 0; i < Rank; ++i) full_extents[i] = dims[i];
+ return Tensor::View<T,Rank>(body,full_extents,slice_extents,slice_bases);
+}
+
 
 /** Tensor element access by its multi-index. **/
 template <typename T, typename IntegralType>
@@ -1004,6 +1332,47 @@ int Tensor::accumulate(TensorTask * task_handle,    //out: task handle associate
 }
 
 
+/** Performs accumulation of a tensor into the current tensor using a pre-parsed pattern:
+    this += left * scalar_factor **/
+template <typename T>
+int Tensor::accumulate(TensorTask * task_handle,           //out: task handle associated with this operation or nullptr (synchronous)
+                       const ContractionPattern & pattern, //in: pre-parsed accumulation pattern
+                       Tensor & left,                      //in: left tensor
+                       const int device_kind,              //in: execution device kind
+                       const int device_id,                //in: execution device id
+                       const T factor)                     //in: scalar factor
+{
+ int errc = TALSH_SUCCESS;
+ this->completeWriteTask();
+ left.completeWriteTask();
+ const talsh_contr_ptrn_t * contr_ptrn = pattern.get();
+ talsh_tens_t * dtens = this->getTalshTensorPtr();
+ talsh_tens_t * ltens = left.getTalshTensorPtr();
+ if(task_handle != nullptr){ //asynchronous
+  bool task_empty = task_handle->isEmpty(); assert(task_empty);
+  talsh_task_t * task_hl = task_handle->getTalshTaskPtr();
+  errc = talshTensorAddDig(contr_ptrn,dtens,ltens,realPart(factor),imagPart(factor),device_id,device_kind,COPY_MT,task_hl);
+  if(errc != TALSH_SUCCESS && errc != TRY_LATER && errc != DEVICE_UNABLE)
+   std::cout << "#ERROR(talsh::Tensor::accumulate): talshTensorAddDig error " << errc << std::endl; //debug
+  assert(errc == TALSH_SUCCESS || errc == TRY_LATER || errc == DEVICE_UNABLE);
+  if(errc == TALSH_SUCCESS){
+   task_handle->used_tensors_[0] = this;
+   task_handle->used_tensors_[1] = &left;
+   task_handle->num_tensors_ = 2;
+   this->resetWriteTask(task_handle);
+  }else{
+   task_handle->clean();
+  }
+ }else{ //synchronous
+  errc = talshTensorAddDig(contr_ptrn,dtens,ltens,realPart(factor),imagPart(factor),device_id,device_kind,COPY_MT);
+  if(errc != TALSH_SUCCESS && errc != TRY_LATER && errc != DEVICE_UNABLE)
+   std::cout << "#ERROR(talsh::Tensor::accumulate): talshTensorAddDig error " << errc << std::endl; //debug
+  assert(errc == TALSH_SUCCESS || errc == TRY_LATER || errc == DEVICE_UNABLE);
+ }
+ return errc;
+}
+
+
 /** Performs a tensor contraction of two tensors and accumulates the result into the current tensor:
     this += left * right * scalar_factor **/
 template <typename T>
@@ -1054,6 +1423,56 @@ int Tensor::contractAccumulate(TensorTask * task_handle,    //out: task handle a
 }
 
 
+/** Performs a tensor contraction of two tensors using a pre-parsed pattern
+    and accumulates the result into the current tensor:
+    this += left * right * scalar_factor **/
+template <typename T>
+int Tensor::contractAccumulate(TensorTask * task_handle,           //out: task handle associated with this operation or nullptr (synchronous)
+                               const ContractionPattern & pattern, //in: pre-parsed contraction pattern
+                               Tensor & left,                      //in: left tensor
+                               Tensor & right,                     //in: right tensor
+                               const int device_kind,              //in: execution device kind
+                               const int device_id,                //in: execution device id
+                               const T factor,                     //in: scalar factor (alpha)
+                               bool accumulative)                  //in: accumulate in (default) VS overwrite destination tensor
+{
+ int errc = TALSH_SUCCESS;
+ this->completeWriteTask();
+ left.completeWriteTask();
+ right.completeWriteTask();
+ int accum = YEP; if(!accumulative) accum = NOPE;
+ const talsh_contr_ptrn_t * contr_ptrn = pattern.get();
+ talsh_tens_t * dtens = this->getTalshTensorPtr();
+ talsh_tens_t * ltens = left.getTalshTensorPtr();
+ talsh_tens_t * rtens = right.getTalshTensorPtr();
+ if(task_handle != nullptr){ //asynchronous
+  bool task_empty = task_handle->isEmpty(); assert(task_empty);
+  talsh_task_t * task_hl = task_handle->getTalshTaskPtr();
+  errc = talshTensorContractDig(contr_ptrn,dtens,ltens,rtens,realPart(factor),imagPart(factor),device_id,device_kind,
+                                COPY_MTT,accum,task_hl);
+  if(errc != TALSH_SUCCESS && errc != TRY_LATER && errc != DEVICE_UNABLE)
+   std::cout << "#ERROR(talsh::Tensor::contractAccumulate): talshTensorContractDig error " << errc << std::endl; //debug
+  assert(errc == TALSH_SUCCESS || errc == TRY_LATER || errc == DEVICE_UNABLE);
+  if(errc == TALSH_SUCCESS){
+   task_handle->used_tensors_[0] = this;
+   task_handle->used_tensors_[1] = &left;
+   task_handle->used_tensors_[2] = &right;
+   task_handle->num_tensors_ = 3;
+   this->resetWriteTask(task_handle);
+  }else{
+   task_handle->clean();
+  }
+ }else{ //synchronous
+  errc = talshTensorContractDig(contr_ptrn,dtens,ltens,rtens,realPart(factor),imagPart(factor),device_id,device_kind,
+                                COPY_MTT,accum);
+  if(errc != TALSH_SUCCESS && errc != TRY_LATER && errc != DEVICE_UNABLE)
+   std::cout << "#ERROR(talsh::Tensor::contractAccumulate): talshTensorContractDig error " << errc << std::endl; //debug
+  assert(errc == TALSH_SUCCESS || errc == TRY_LATER || errc == DEVICE_UNABLE);
+ }
+ return errc;
+}
+
+
 /** Performs an extra large tensor contraction of two tensors and accumulates the result into the current tensor:
     this += left * right * scalar_factor **/
 template <typename T>
@@ -0,0 +1,366 @@
+/** ExaTensor::TAL-SH: Optional C++20 coroutine interface to the C++ API.
+REVISION: 2026/10/19
+
+Copyright (C) 2014-2022 Dmitry I. Lyakh (Liakh)
+Copyright (C) 2014-2022 Oak Ridge National Laboratory (UT-Battelle)
+
+LICENSE: BSD 3-Clause
+
+Usage (requires C++20):
+ talsh::coro::Task<int> branch(talsh::coro::Scheduler & sched, talsh::Tensor & d, ...){
+  int errc = co_await talsh::coro::contractAccumulate(sched,d,"D(a,b)+=L(a,c)*R(c,b)",l,r,DEV_NVIDIA_GPU,0);
+  if(errc == TALSH_SUCCESS) errc = co_await talsh::coro::sync(sched,d);
+  co_return errc;
+ }
+ talsh::coro::Task<int> root(talsh::coro::Scheduler & sched, ...){
+  std::vector<talsh::coro::Task<int>> branches;
+  branches.emplace_back(branch(sched,d1,...));
+  branches.emplace_back(branch(sched,d2,...));
+  co_await talsh::coro::whenAll(branches); //independent branches run concurrently
+  co_return branches[0].result();
+ }
+ talsh::coro::Scheduler sched;
+ int errc = sched.run(root(sched,...));
+
+Each awaited TAL-SH operation is submitted asynchronously with its own task handle
+and the awaiting coroutine is suspended until the Scheduler observes the completion
+of the task. The Scheduler is single-threaded: all coroutines are resumed
+on the thread that calls Scheduler::run() or Scheduler::progress(). **/
+
+#ifndef TALSHXX_CORO_HPP_
+#define TALSHXX_CORO_HPP_
+
+#if __cplusplus >= 202002L && defined(__cpp_impl_coroutine)
+
+#include "talshxx.hpp" //TAL-SH C++ API
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+#include <vector>
+#include <string>
+#include <cassert>
+
+namespace talsh{
+
+namespace coro{
+
+/** TAL-SH completion scheduler: Resumes suspended coroutines upon completion of their TAL-SH tasks. **/
+class Scheduler{
+public:
+
+ Scheduler() = default;
+
+ Scheduler(const Scheduler &) = delete;
+ Scheduler & operator=(const Scheduler &) = delete;
+ Scheduler(Scheduler &&) = delete;
+ Scheduler & operator=(Scheduler &&) = delete;
+ ~Scheduler() {assert(pending_.empty());}
+
+ /** Registers a suspended coroutine to be resumed upon completion of a TAL-SH task. **/
+ void enqueue(TensorTask * task,                 //in: active TAL-SH task (owned by the suspended coroutine)
+              int * status,                      //out: TAL-SH task completion status
+              std::coroutine_handle<> coroutine) //in: suspended coroutine
+ {
+  pending_.push_back(Pending{task,status,coroutine});
+ }
+
+ /** Returns the number of TAL-SH tasks in flight. **/
+ std::size_t getNumPending() const {return pending_.size();}
+
+ /** Tests all TAL-SH tasks in flight once and resumes the coroutines of the completed ones.
+     Returns TRUE if no TAL-SH tasks are left in flight. **/
+ bool progress()
+ {
+  std::vector<Pending> pending;
+  pending.swap(pending_); //resumed coroutines may enqueue new tasks
+  std::vector<std::coroutine_handle<>> ready;
+  for(auto & entry: pending){
+   if(entry.task->test(entry.status)){
+    ready.push_back(entry.coroutine);
+   }else{
+    pending_.push_back(entry);
+   }
+  }
+  for(auto & coroutine: ready) coroutine.resume();
+  return pending_.empty();
+ }
+
+ /** Runs a coroutine to completion and returns its result. **/
+ template <typename TaskType>
+ auto run(TaskType && task)
+ {
+  task.start();
+  while(!task.done()) this->progress();
+  return task.result();
+ }
+
+ /** Drives all TAL-SH tasks in flight to completion. **/
+ void drain()
+ {
+  while(!(this->progress()));
+ }
+
+private:
+
+ struct Pending{
+  TensorTask * task;                 //active TAL-SH task
+  int * status;                      //TAL-SH task completion status
+  std::coroutine_handle<> coroutine; //suspended coroutine
+ };
+
+ std::vector<Pending> pending_; //coroutines waiting for TAL-SH task completion
+};
+
+
+/** Awaitable TAL-SH operation: The submitter is a callable int(TensorTask*)
+    which submits the TAL-SH operation asynchronously and returns an error code.
+    co_await returns TALSH_SUCCESS upon successful completion of the operation,
+    a submission error code or TALSH_FAILURE if the TAL-SH task has failed. **/
+template <typename Submitter>
+class Operation{
+public:
+
+ Operation(Scheduler & scheduler, Submitter submitter):
+  scheduler_(scheduler), submitter_(std::move(submitter)), error_code_(TALSH_SUCCESS), status_(TALSH_TASK_EMPTY)
+ {}
+
+ Operation(const Operation &) = delete;
+ Operation & operator=(const Operation &) = delete;
+
+ bool await_ready() const noexcept {return false;}
+
+ bool await_suspend(std::coroutine_handle<> coroutine)
+ {
+  error_code_ = submitter_(&task_);
+  if(error_code_ != TALSH_SUCCESS) return false; //submission failed: resume immediately
+  if(task_.test(&status_)) return false;         //completed synchronously: resume immediately
+  scheduler_.enqueue(&task_,&status_,coroutine);
+  return true;
+ }
+
+ int await_resume() const noexcept
+ {
+  if(error_code_ != TALSH_SUCCESS) return error_code_;
+  if(status_ != TALSH_TASK_COMPLETED && status_ != TALSH_TASK_EMPTY) return TALSH_FAILURE;
+  return TALSH_SUCCESS;
+ }
+
+private:
+
+ Scheduler & scheduler_; //completion scheduler
+ Submitter submitter_;   //TAL-SH operation submitter
+ TensorTask task_;       //TAL-SH task handle (lives in the frame of the suspended coroutine)
+ int error_code_;        //submission error code
+ int status_;            //TAL-SH task completion status
+};
+
+/** Creates an awaitable TAL-SH operation from a submitter callable int(TensorTask*). **/
+template <typename Submitter>
+Operation<Submitter> operation(Scheduler & scheduler, Submitter submitter)
+{
+ return Operation<Submitter>(scheduler,std::move(submitter));
+}
+
+
+template <typename T> class Task;
+
+namespace detail{
+
+struct WhenAllState{
+ std::size_t remaining;           //number of unfinished coroutines (plus one while starting them)
+ std::coroutine_handle<> awaiter; //coroutine awaiting all of them
+};
+
+template <typename T>
+struct TaskPromise{
+ T result_{};
+ std::exception_ptr exception_;
+ std::coroutine_handle<> continuation_ = std::noop_coroutine(); //coroutine awaiting this one
+ WhenAllState * group_ = nullptr;                                //group this coroutine belongs to
+
+ struct FinalAwaiter{
+  bool await_ready() const noexcept {return false;}
+  template <typename Promise>
+  std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> coroutine) noexcept
+  {
+   auto & promise = coroutine.promise();
+   if(promise.group_ != nullptr){
+    if(--(promise.group_->remaining) == 0) return promise.group_->awaiter;
+    return std::noop_coroutine();
+   }
+   return promise.continuation_;
+  }
+  void await_resume() const noexcept {}
+ };
+
+ Task<T> get_return_object() noexcept;
+ std::suspend_always initial_suspend() const noexcept {return {};}
+ FinalAwaiter final_suspend() const noexcept {return {};}
+ void return_value(T value) {result_ = std::move(value);}
+ void unhandled_exception() noexcept {exception_ = std::current_exception();}
+};
+
+} //namespace detail
+
+
+/** Lazily started coroutine producing a value of type T (typically an int error code).
+    It is started when awaited, passed to whenAll(), or run by the Scheduler. **/
+template <typename T = int>
+class Task{
+public:
+
+ using promise_type = detail::TaskPromise<T>;
+
+ explicit Task(std::coroutine_handle<promise_type> coroutine) noexcept: coroutine_(coroutine) {}
+
+ Task(const Task &) = delete;
+ Task & operator=(const Task &) = delete;
+ Task(Task && task) noexcept: coroutine_(std::exchange(task.coroutine_,nullptr)) {}
+ Task & operator=(Task && task) noexcept
+ {
+  if(this != &task){
+   if(coroutine_) coroutine_.destroy();
+   coroutine_ = std::exchange(task.coroutine_,nullptr);
+  }
+  return *this;
+ }
+ ~Task() {if(coroutine_) coroutine_.destroy();}
+
+ /** Returns TRUE if the coroutine has finished. **/
+ bool done() const noexcept {return coroutine_.done();}
+
+ /** Starts the coroutine (it runs until its first suspension). **/
+ void start() {coroutine_.resume();}
+
+ /** Returns the result of a finished coroutine (rethrows its exception, if any). **/
+ T & result()
+ {
+  assert(coroutine_.done());
+  auto & promise = coroutine_.promise();
+  if(promise.exception_) std::rethrow_exception(promise.exception_);
+  return promise.result_;
+ }
+
+ //Awaiting a Task starts it and resumes the awaiter upon its completion:
+ bool await_ready() const noexcept {return coroutine_.done();}
+ std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiter) noexcept
+ {
+  coroutine_.promise().continuation_ = awaiter;
+  return coroutine_;
+ }
+ T & await_resume() {return result();}
+
+private:
+
+ std::coroutine_handle<promise_type> coroutine_;
+
+ template <typename U> friend class WhenAll;
+};
+
+template <typename T>
+Task<T> detail::TaskPromise<T>::get_return_object() noexcept
+{
+ return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+
+
+/** Awaitable that starts a number of coroutines concurrently and resumes
+    the awaiter once all of them have finished. **/
+template <typename T>
+class WhenAll{
+public:
+
+ explicit WhenAll(std::vector<Task<T>> & tasks): tasks_(tasks), state_{0,nullptr} {}
+
+ bool await_ready() const noexcept {return tasks_.empty();}
+
+ bool await_suspend(std::coroutine_handle<> awaiter)
+ {
+  state_.remaining = tasks_.size() + 1; //extra count guards against resumption while starting
+  state_.awaiter = awaiter;
+  for(auto & task: tasks_){
+   task.coroutine_.promise().group_ = &state_;
+   task.start();
+  }
+  return (--(state_.remaining) != 0); //resume immediately if all have already finished
+ }
+
+ void await_resume() const noexcept {}
+
+private:
+
+ std::vector<Task<T>> & tasks_;
+ detail::WhenAllState state_;
+};
+
+/** Awaits completion of all coroutines (they run concurrently). Results are retrieved via Task::result(). **/
+template <typename T>
+WhenAll<T> whenAll(std::vector<Task<T>> & tasks)
+{
+ return WhenAll<T>(tasks);
+}
+
+
+//Awaitable TAL-SH operations (see the corresponding talsh::Tensor methods):
+
+/** Awaitable tensor synchronization on a given device. **/
+inline auto sync(Scheduler & scheduler, Tensor & tensor,
+                 const int device_kind = DEV_HOST, const int device_id = 0,
+                 void * device_mem = nullptr, bool exclusive = false)
+{
+ return operation(scheduler,[&tensor,device_kind,device_id,device_mem,exclusive](TensorTask * task){
+  return (tensor.sync(task,device_kind,device_id,device_mem,exclusive) ? TALSH_SUCCESS : TALSH_FAILURE);
+ });
+}
+
+/** Awaitable tensor initialization to a scalar value. **/
+template <typename T = double>
+auto setValue(Scheduler & scheduler, Tensor & tensor,
+              const int device_kind = DEV_HOST, const int device_id = 0,
+              const T scalar_value = TensorData<T>::zero)
+{
+ return operation(scheduler,[&tensor,device_kind,device_id,scalar_value](TensorTask * task){
+  return tensor.setValue(task,device_kind,device_id,scalar_value);
+ });
+}
+
+/** Awaitable tensor copy with an optional dimension permutation: tensor = left (permuted). **/
+inline auto copyBody(Scheduler & scheduler, Tensor & tensor, const std::string & pattern, Tensor & left,
+                     const int device_kind = DEV_HOST, const int device_id = 0)
+{
+ return operation(scheduler,[&tensor,pattern,&left,device_kind,device_id](TensorTask * task){
+  return tensor.copyBody(task,pattern,left,device_kind,device_id);
+ });
+}
+
+/** Awaitable tensor accumulation: tensor += left * factor. **/
+template <typename T = double>
+auto accumulate(Scheduler & scheduler, Tensor & tensor, const std::string & pattern, Tensor & left,
+                const int device_kind = DEV_HOST, const int device_id = 0,
+                const T factor = TensorData<T>::unity)
+{
+ return operation(scheduler,[&tensor,pattern,&left,device_kind,device_id,factor](TensorTask * task){
+  return tensor.accumulate(task,pattern,left,device_kind,device_id,factor);
+ });
+}
+
+/** Awaitable tensor contraction: tensor += left * right * factor. **/
+template <typename T = double>
+auto contractAccumulate(Scheduler & scheduler, Tensor & tensor, const std::string & pattern,
+                        Tensor & left, Tensor & right,
+                        const int device_kind = DEV_HOST, const int device_id = 0,
+                        const T factor = TensorData<T>::unity, bool accumulative = true)
+{
+ return operation(scheduler,[&tensor,pattern,&left,&right,device_kind,device_id,factor,accumulative](TensorTask * task){
+  return tensor.contractAccumulate(task,pattern,left,right,device_kind,device_id,factor,accumulative);
+ });
+}
+
+} //namespace coro
+
+} //namespace talsh
+
+#endif //C++20 coroutines
+
+#endif //TALSHXX_CORO_HPP_
@@ -89,6 +89,26 @@ FOR DEVELOPERS ONLY:
 #define MEM_ALLOC_TMP_BUF 1
 #define MEM_ALLOC_ALL_BUF 2
 
+//HOST MEMORY MAPPING OF FILES:
+#define MEM_MAP_OPEN 0    //map an existing file in shared mode (modifications persist in the file)
+#define MEM_MAP_CREATE 1  //create the file if needed, resize it to the requested size, and map it in shared mode
+#define MEM_MAP_PRIVATE 2 //map an existing file in private copy-on-write mode (modifications do not persist)
+#define MEM_MAP_ADVICE_NORMAL 0     //no specific access pattern
+#define MEM_MAP_ADVICE_SEQUENTIAL 1 //sequential access (aggressive read-ahead)
+#define MEM_MAP_ADVICE_RANDOM 2     //random access (no read-ahead)
+#define MEM_MAP_ADVICE_WILLNEED 3   //the whole mapped region will be needed soon (prefetch it)
+
+//RANDOM NUMBER DISTRIBUTIONS (keep consistent with tensor_algebra.F90):
+#define RANDOM_UNIFORM 0 //uniform on [0,1)
+#define RANDOM_NORMAL 1  //standard normal (zero mean, unit variance)
+
+//HOST BLAS BACKENDS (runtime BLAS dispatch, keep consistent with tensor_algebra.F90):
+#define BLAS_BACKEND_NONE 0     //no BLAS: in-house matrix multiplication kernels only
+#define BLAS_BACKEND_GENERIC 1  //BLAS without thread control (e.g., reference BLAS)
+#define BLAS_BACKEND_OPENBLAS 2 //OpenBLAS
+#define BLAS_BACKEND_MKL 3      //Intel MKL
+#define BLAS_BACKEND_BLIS 4     //BLIS
+
 //ALIASES (keep consistent with tensor_algebra.F90):
 #define NOPE 0
 #define YEP 1
@@ -254,6 +274,11 @@ typedef int (*talsh_tens_init_i)(const talsh_tens_data_t * tens_data,
                                  const talsh_tens_signature_t * tens_signature);
 // Dummy function that does no initialization on a tensor:
 int talsh_tens_no_init(const talsh_tens_data_t *, const talsh_tens_shape_t *, const talsh_tens_signature_t *);
+// Interface for a user-defined tile-wise tensor initialization/transformation function, invoked
+// concurrently for disjoint tiles of the tensor body: <tile->body> points to the contiguous tile
+// elements (column-major), <tile->bases> are the base offsets of the tile inside the tensor,
+// <tile->dims> are the tile extents, <context> is passed through from the caller:
+typedef int (*talsh_tens_tile_init_i)(const talsh_tens_dense_t * tile, void * context);
 
 //FUNCTION PROTOTYPES:
 extern "C"{
@@ -261,6 +286,21 @@ extern "C"{
  size_t fortran_cptr_int(void * cptr);
  int tens_valid_data_kind(int datk, int * datk_size = NULL);
  int tens_valid_data_kind_(int datk, int * datk_size);
+ int tens_random_fill(void * body, size_t offset, size_t count, int datk, unsigned long long seed, int distr);
+ int tens_nonfinite_check(const void * body, size_t vol, int datk);
+//Host BLAS dispatch:
+ int cpu_blas_load(const char * lib_path);
+ int cpu_blas_backend();
+ void cpu_blas_set_threads(int num_threads, int serial_in_parallel);
+ int cpu_blas_call_begin();
+ void cpu_blas_call_end(int nthreads);
+ int cpu_blas_gemm(int datk, const char * transa, const char * transb, int m, int n, int k,
+                   const void * alpha, const void * a, int lda, const void * b, int ldb,
+                   const void * beta, void * c, int ldc);
+ int cpu_blas_gemm_batch(int datk, const char * transa, const char * transb, int batch, int m, int n, int k,
+                         const void * alpha, const void * a, int lda, size_t stride_a,
+                         const void * b, int ldb, size_t stride_b,
+                         const void * beta, void * c, int ldc, size_t stride_c);
  int permutation_trivial(const int perm_len, const int * perm, const int base = 0);
  void get_contr_pattern_sym(const int * rank_left, const int * rank_right, const int * conj_bits,
                             const int * cptrn_dig, char * cptrn_sym, int * cpl, int * ierr);
@@ -314,6 +354,14 @@ extern "C"{
  int tensShape_reshape(talsh_tens_shape_t * tshape,
                        int rank, const int * dims = NULL, const int * divs = NULL, const int * grps = NULL);
  void tensShape_print(const talsh_tens_shape_t * tshape);
+ int tensShape_pool_stats(int multi_index, unsigned long long * pool_gets, unsigned long long * heap_gets, long long * num_used);
+// Data compression and checksums:
+ size_t talsh_data_compress(const void * src, size_t src_size, size_t elem_size, void * dst, size_t dst_capacity, void * work);
+ int talsh_data_decompress(const void * src, size_t src_size, size_t elem_size, void * dst, size_t dst_size, void * work);
+ uint64_t talsh_data_checksum(const void * src, size_t src_size);
+ int talsh_body_compress(const void * body, size_t body_size, int data_kind, int zip_mode, double tolerance,
+                         void ** zip_data, size_t * zip_size);
+ int talsh_body_decompress(const void * zip_data, size_t zip_size, void * body, size_t body_size);
 }
 
 #endif /*TENSOR_ALGEBRA_H_*/
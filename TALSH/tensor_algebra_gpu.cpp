@@ -77,10 +77,28 @@ TO BE FIXED:
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
+#include <cmath>
+
+#include <algorithm>
 
 static int VERBOSE=1; //verbosity for error messages
 static int DEBUG=0; //debugging mode
 
+static const size_t TENS_SHAPE_POOL_SIZE=8192; //max number of pooled tensor shapes (and their non-pinned multi-indices)
+
+static obj_pool_t * tens_shape_pool(int multi_index)
+/** Returns the object pool for tensor shapes (<multi_index>=0) or for their
+    non-pinned {dims,divs,grps} storage (<multi_index>!=0), constructed on first use.
+    The pools live until program termination since shapes may outlive the runtime. **/
+{
+ static obj_pool_t pools[2];
+ static const int ready = obj_pool_construct(&(pools[0]),sizeof(talsh_tens_shape_t),TENS_SHAPE_POOL_SIZE) +
+                          obj_pool_construct(&(pools[1]),3*MAX_TENSOR_RANK*sizeof(int),TENS_SHAPE_POOL_SIZE);
+ (void)ready;
+ if(multi_index != 0) return &(pools[1]);
+ return &(pools[0]);
+}
+
 size_t fortran_cptr_int(void * cptr)
 {
  return ((size_t)(cptr));
@@ -108,6 +126,136 @@ int tens_valid_data_kind_(int datk, int * datk_size) //Fortran binding
  return tens_valid_data_kind(datk,datk_size);
 }
 
+//Counter-based random number generation (Philox4x32-10, Salmon et al., SC'11):
+static const uint32_t PHILOX_M0=0xD2511F53U, PHILOX_M1=0xCD9E8D57U; //round multipliers
+static const uint32_t PHILOX_W0=0x9E3779B9U, PHILOX_W1=0xBB67AE85U; //key increments (Weyl sequence)
+static const size_t PHILOX_LANES=16; //number of Philox blocks generated together (vectorized over lanes)
+
+static void philox4x32_10(size_t first, unsigned long long seed, uint32_t (&out)[4][PHILOX_LANES])
+/** Generates PHILOX_LANES consecutive Philox4x32-10 blocks with counters {first,first+1,..} under the key <seed>. **/
+{
+ uint32_t c0[PHILOX_LANES],c1[PHILOX_LANES],c2[PHILOX_LANES],c3[PHILOX_LANES];
+ uint32_t k0=(uint32_t)seed, k1=(uint32_t)(seed>>32);
+ for(size_t l=0; l<PHILOX_LANES; ++l){
+  uint64_t ctr=(uint64_t)(first+l);
+  c0[l]=(uint32_t)ctr; c1[l]=(uint32_t)(ctr>>32); c2[l]=0U; c3[l]=0U;
+ }
+ for(int r=0; r<10; ++r){
+  for(size_t l=0; l<PHILOX_LANES; ++l){
+   uint64_t p0=(uint64_t)PHILOX_M0*c0[l];
+   uint64_t p1=(uint64_t)PHILOX_M1*c2[l];
+   uint32_t n0=(uint32_t)(p1>>32)^c1[l]^k0;
+   uint32_t n2=(uint32_t)(p0>>32)^c3[l]^k1;
+   c1[l]=(uint32_t)p1; c3[l]=(uint32_t)p0; c0[l]=n0; c2[l]=n2;
+  }
+  k0+=PHILOX_W0; k1+=PHILOX_W1;
+ }
+ for(size_t l=0; l<PHILOX_LANES; ++l){out[0][l]=c0[l]; out[1][l]=c1[l]; out[2][l]=c2[l]; out[3][l]=c3[l];}
+ return;
+}
+
+static inline void philox_uniform(const uint32_t (&rnd)[4][PHILOX_LANES], float * vals)
+/** Converts Philox blocks into 4*PHILOX_LANES floats uniform on [0,1) (24 random bits each). **/
+{
+ for(int i=0; i<4; ++i){
+  for(size_t l=0; l<PHILOX_LANES; ++l) vals[l*4+i]=(float)(rnd[i][l]>>8)*(1.0f/16777216.0f);
+ }
+ return;
+}
+
+static inline void philox_uniform(const uint32_t (&rnd)[4][PHILOX_LANES], double * vals)
+/** Converts Philox blocks into 2*PHILOX_LANES doubles uniform on [0,1) (53 random bits each). **/
+{
+ for(int i=0; i<2; ++i){
+  for(size_t l=0; l<PHILOX_LANES; ++l){
+   uint64_t x=((uint64_t)rnd[2*i+1][l]<<32)|(uint64_t)rnd[2*i][l];
+   vals[l*2+i]=(double)(x>>11)*(1.0/9007199254740992.0);
+  }
+ }
+ return;
+}
+
+template <typename T>
+static void tens_random_fill_real(T * vals, size_t first, size_t count, unsigned long long seed, int distr)
+/** Sets vals[0:count-1] to the random numbers #first..#first+count-1 of the stream defined by <seed>.
+    Each random number depends solely on its position in the stream, thus the result
+    is independent of the number of threads and of how the stream is split into pieces.
+    Normal variates are produced by the Box-Muller transform of consecutive pairs of uniform numbers. **/
+{
+ const size_t GROUP=(16/sizeof(T))*PHILOX_LANES; //random numbers per group of Philox blocks
+ if(count == 0) return;
+ const size_t gbeg=first/GROUP, gend=(first+count-1)/GROUP+1;
+#pragma omp parallel for schedule(static)
+ for(long long g=(long long)gbeg; g<(long long)gend; ++g){
+  uint32_t rnd[4][PHILOX_LANES];
+  T buf[(16/sizeof(T))*PHILOX_LANES];
+  philox4x32_10((size_t)g*(GROUP/(16/sizeof(T))),seed,rnd);
+  philox_uniform(rnd,buf);
+  if(distr == RANDOM_NORMAL){
+   for(size_t i=0; i<GROUP; i+=2){
+    double r=std::sqrt(-2.0*std::log(1.0-(double)buf[i]));
+    double a=6.283185307179586476925*(double)buf[i+1];
+    buf[i]=(T)(r*std::cos(a)); buf[i+1]=(T)(r*std::sin(a));
+   }
+  }
+  size_t lb=std::max((size_t)g*GROUP,first), le=std::min((size_t)(g+1)*GROUP,first+count);
+  for(size_t j=lb; j<le; ++j) vals[j-first]=buf[j-(size_t)g*GROUP];
+ }
+ return;
+}
+
+int tens_random_fill(void * body, size_t offset, size_t count, int datk, unsigned long long seed, int distr)
+/** Fills <count> tensor elements of data kind <datk> in <body> with pseudo-random numbers
+    (RANDOM_XXX distribution) which would reside at element positions offset..offset+count-1
+    of a tensor body filled with the same <seed>. Complex elements take two consecutive
+    random numbers (real, imaginary). The values are generated by a counter-based generator,
+    so they are bitwise reproducible regardless of the number of threads or the tiling.
+    Returns 0 on success, -1 on invalid arguments. **/
+{
+ if(distr != RANDOM_UNIFORM && distr != RANDOM_NORMAL) return -1;
+ if(body == NULL && count > 0) return -1;
+ switch(datk){
+  case R4: tens_random_fill_real(static_cast<float*>(body),offset,count,seed,distr); break;
+  case R8: tens_random_fill_real(static_cast<double*>(body),offset,count,seed,distr); break;
+  case C4: tens_random_fill_real(static_cast<float*>(body),offset*2,count*2,seed,distr); break;
+  case C8: tens_random_fill_real(static_cast<double*>(body),offset*2,count*2,seed,distr); break;
+  default: return -1;
+ }
+ return 0;
+}
+
+template <typename U>
+static int tens_nonfinite_scan(const U * words, size_t count, U exp_mask)
+/** Returns YEP if any IEEE word in words[0:count-1] has all exponent bits set (NaN or Inf).
+    The scan is branch-free within a chunk (vectorizable) and runs in parallel over chunks. **/
+{
+ const size_t CHUNK=4096;
+ const size_t nchunks=(count+CHUNK-1)/CHUNK;
+ int found=NOPE;
+#pragma omp parallel for schedule(static) reduction(|:found)
+ for(long long c=0; c<(long long)nchunks; ++c){
+  const size_t lb=(size_t)c*CHUNK, le=std::min(lb+CHUNK,count);
+  U bad=0;
+  for(size_t l=lb; l<le; ++l) bad|=(U)((words[l]&exp_mask) == exp_mask);
+  if(bad != 0) found|=YEP;
+ }
+ return found;
+}
+
+int tens_nonfinite_check(const void * body, size_t vol, int datk)
+/** Returns YEP if the tensor body of <vol> elements of data kind <datk> contains a NaN or Inf
+    (in any real component), NOPE otherwise, -1 on invalid arguments. **/
+{
+ if(body == NULL && vol > 0) return -1;
+ switch(datk){
+  case R4: return tens_nonfinite_scan(static_cast<const uint32_t*>(body),vol,(uint32_t)0x7F800000U);
+  case R8: return tens_nonfinite_scan(static_cast<const uint64_t*>(body),vol,(uint64_t)0x7FF0000000000000ULL);
+  case C4: return tens_nonfinite_scan(static_cast<const uint32_t*>(body),vol*2,(uint32_t)0x7F800000U);
+  case C8: return tens_nonfinite_scan(static_cast<const uint64_t*>(body),vol*2,(uint64_t)0x7FF0000000000000ULL);
+ }
+ return -1;
+}
+
 int permutation_trivial(const int perm_len, const int * perm, const int base)
 {
  int trivial = 1;
@@ -619,8 +767,7 @@ int tensShape_create(talsh_tens_shape_t ** tshape)
 /** Creates a tensor shape and cleans it. **/
 {
  if(tshape == NULL) return -1;
- *tshape=(talsh_tens_shape_t*)malloc(sizeof(talsh_tens_shape_t));
- if(*tshape == NULL) return TRY_LATER;
+ if(obj_pool_get(tens_shape_pool(0),(void**)tshape) != 0){*tshape=NULL; return TRY_LATER;}
  return tensShape_clean(*tshape);
 }
 
@@ -667,8 +814,12 @@ int tensShape_construct(talsh_tens_shape_t * tshape, int pinned, int rank, const
  if(rank > 0 && tshape->num_dim <= 0){ //acquire multi-index resources
   if(tshape->dims != NULL || tshape->divs != NULL || tshape->grps != NULL) return -7; //shape must be clean if .num_dim<0
   if(pinned == NOPE){
-   mi_dims=(int*)malloc(3*rank*sizeof(int));
-   if(mi_dims == NULL) return TRY_LATER;
+   if(rank <= MAX_TENSOR_RANK){
+    if(obj_pool_get(tens_shape_pool(1),(void**)(&mi_dims)) != 0) return TRY_LATER;
+   }else{
+    mi_dims=(int*)malloc(3*rank*sizeof(int));
+    if(mi_dims == NULL) return TRY_LATER;
+   }
    mi_divs=mi_dims+rank;
    mi_grps=mi_divs+rank;
   }else{
@@ -729,7 +880,11 @@ int tensShape_destruct(talsh_tens_shape_t * tshape)
   if(tshape->dims != NULL){
    pinned=mi_entry_pinned(tshape->dims);
    if(pinned == NOPE){
-    free(tshape->dims); //will free all {dims,divs,grps}
+    if(tshape->num_dim <= MAX_TENSOR_RANK){ //will release all {dims,divs,grps}
+     errc=obj_pool_release(tens_shape_pool(1),tshape->dims); if(errc != 0) n++;
+    }else{
+     free(tshape->dims); //will free all {dims,divs,grps}
+    }
     tshape->dims=NULL; tshape->divs=NULL; tshape->grps=NULL;
    }else{
     if(tshape->grps != NULL){errc=mi_entry_release(tshape->grps); if(errc != 0) n++; tshape->grps=NULL;} //release a mi resource
@@ -754,7 +909,7 @@ int tensShape_destroy(talsh_tens_shape_t * tshape)
  int errc,n;
  if(tshape == NULL) return -1;
  n=0; errc=tensShape_destruct(tshape); if(errc) n=NOT_CLEAN;
- free(tshape);
+ errc=obj_pool_release(tens_shape_pool(0),tshape); if(errc) n=NOT_CLEAN;
  return n; //either 0 (success) or NOT_CLEAN
 }
 
@@ -826,3 +981,10 @@ void tensShape_print(const talsh_tens_shape_t * tshape)
  printf("]");
  return;
 }
+
+int tensShape_pool_stats(int multi_index, unsigned long long * pool_gets, unsigned long long * heap_gets, long long * num_used)
+/** Returns the usage counters of the tensor shape pool (<multi_index>=0)
+    or of the pool of non-pinned shape multi-indices (<multi_index>!=0). **/
+{
+ return obj_pool_get_stats(tens_shape_pool(multi_index),pool_gets,heap_gets,num_used);
+}
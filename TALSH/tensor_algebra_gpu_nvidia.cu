@@ -2760,6 +2760,21 @@ __host__ int gpu_busy_least()
  return n;
 }
 
+__host__ int gpu_tasks_in_flight(int gpu_num)
+/** Returns the number of tasks submitted to GPU#gpu_num which have not been retired
+    (completed, deferred, or failed) yet. If <gpu_num> is negative, returns the total
+    number of such tasks over all GPUs in use. **/
+{
+ int i,n;
+ n=0;
+ for(i=0;i<MAX_GPUS_PER_NODE;i++){
+  if(gpu_up[i] > GPU_OFF && (gpu_num < 0 || gpu_num == i)){
+   n+=(int)(gpu_stats[i].tasks_submitted-(gpu_stats[i].tasks_completed+gpu_stats[i].tasks_deferred+gpu_stats[i].tasks_failed));
+  }
+ }
+ return n;
+}
+
 __host__ int gpu_in_focus(int gpu_num)
 /** If <gpu_num> is not passed here, returns the id of the current GPU in focus.
     If <gpu_num> is passed here, returns YEP if it is currently in focus, NOPE otherwise.
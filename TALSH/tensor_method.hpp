@@ -12,6 +12,7 @@ LICENSE: BSD 3-Clause **/
 #ifdef EXATN_SERVICE
 
 #include "byte_packet.h"
+#include "talsh.h"
 
 namespace talsh{
 
@@ -32,6 +33,15 @@ public:
  //Application-defined external tensor method:
  virtual int apply(Tensor & local_tensor) = 0;
 
+ //Optional tile-parallel variant of the tensor method, invoked concurrently for disjoint
+ //contiguous tiles of the local tensor body (an apply() implementation may forward to applyTiled()):
+ virtual int applyTile(const talsh_tens_dense_t & tile) {return TALSH_NOT_IMPLEMENTED;}
+
+ template <typename TensorType = Tensor>
+ int applyTiled(TensorType & local_tensor) {
+  return local_tensor.applyTiles([this](const talsh_tens_dense_t & tile){return this->applyTile(tile);});
+ }
+
 };
 
 } //namespace talsh
@@ -8,24 +8,37 @@ LICENSE: BSD 3-Clause **/
 #include "talshxx.hpp"
 #include "talsh.h"
 #include "device_algebra.h"
+#include "mem_manager.h"
 
 #include <iostream>
 #include <memory>
 #include <string>
 #include <complex>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <atomic>
+#include <thread>
 
 #include <cstdio>
 #include <cstdlib>
 #include <cmath>
 #include <ctime>
+#include <cstring>
 #include <cassert>
 
+#ifndef NO_OMP
+#include <omp.h>
+#endif
+
 extern "C"{
  void test_talsh_c(int * ierr);
  void test_talsh_cxx(int * ierr);
  void test_talsh_xl(int * ierr);
  void test_talsh_hyper(int * ierr);
+ void test_talsh_defrag(int * ierr);
  void test_talsh_svd(int * ierr);
+ void test_talsh_threads(int * ierr);
  void test_talsh_qc_xl(int * ierr);
  void test_talsh_qc(int * ierr);
  void test_nwchem_c(int * ierr);
@@ -146,6 +159,604 @@ void test_talsh_c(int * ierr)
 #endif
  printf(" Tensor result was moved back to Host: Norm1 = %E: Correct = %E\n",talshTensorImageNorm1_cpu(&tens0),theor_norm1);
 
+//Tensor files (all I/O flag combinations, rejection of corrupted files):
+ {
+  const int fdims[]={64,48,32};
+  const size_t fsign[]={3,5,7};
+  const size_t fchunk=64*1024; //many chunks
+  const char * tfile="talsh_tensor.tns";
+  auto fref=[](size_t l, size_t n){ //compressible (zero blocks and smooth values) and incompressible chunks
+   return (l < n/4) ? 0.0 : ((l < n/2) ? std::sin(1e-3*(double)l) : (double)((l*2654435761ULL)%1000003ULL));
+  };
+  talsh_tens_t ft,gt;
+  void *fbody_p=NULL,*gbody_p=NULL;
+  errc=talshTensorClean(&ft); if(errc){*ierr=61; return;};
+  errc=talshTensorConstruct(&ft,R8,3,fdims,talshFlatDevId(DEV_HOST,0),NULL,-1,NULL,0.0); if(errc){*ierr=61; return;};
+  const size_t fvol=talshTensorVolume(&ft);
+  errc=talshTensorGetBodyAccess(&ft,&fbody_p,R8,0,DEV_HOST); if(errc){*ierr=61; return;};
+  for(size_t l=0; l<fvol; ++l) static_cast<double*>(fbody_p)[l]=fref(l,fvol);
+  const int io_flags[]={TALSH_IO_DEFAULT,TALSH_IO_COMPRESS,TALSH_IO_DIRECT,TALSH_IO_COMPRESS|TALSH_IO_DIRECT};
+  for(int io : io_flags){
+   errc=talshTensorSave(&ft,tfile,fsign,io,fchunk); if(errc){*ierr=61; return;};
+   for(int lio : {TALSH_IO_DEFAULT,TALSH_IO_DIRECT}){
+    size_t gsign[MAX_TENSOR_RANK]={0};
+    int grank=-1;
+    errc=talshTensorClean(&gt); if(errc){*ierr=62; return;};
+    errc=talshTensorLoad(&gt,tfile,gsign,lio); if(errc){*ierr=62; return;};
+    const int * gdims=talshTensorDimExtents(&gt,&grank);
+    if(grank != 3 || gdims == NULL){*ierr=62; return;};
+    for(int i=0; i<3; ++i){if(gdims[i] != fdims[i] || gsign[i] != fsign[i]){*ierr=62; return;};}
+    errc=talshTensorGetBodyAccess(&gt,&gbody_p,R8,0,DEV_HOST); if(errc){*ierr=62; return;};
+    for(size_t l=0; l<fvol; ++l){if(static_cast<const double*>(gbody_p)[l] != fref(l,fvol)){*ierr=62; return;};}
+    errc=talshTensorDestruct(&gt); if(errc){*ierr=62; return;};
+   }
+  }
+  //Corrupted files must be rejected (a chunk or the header region fails its checksum):
+  for(int io : io_flags){
+   for(long foffs : {-1L,112L}){ //last body byte, signature[0] in the header region
+    errc=talshTensorSave(&ft,tfile,fsign,io,fchunk); if(errc){*ierr=63; return;};
+    FILE * tf=fopen(tfile,"r+b"); if(tf == NULL){*ierr=63; return;};
+    if(fseek(tf,foffs,(foffs < 0)?SEEK_END:SEEK_SET) != 0){fclose(tf); *ierr=63; return;};
+    int fbyte=fgetc(tf);
+    if(fbyte == EOF || fseek(tf,-1L,SEEK_CUR) != 0 || fputc(fbyte^0x5A,tf) == EOF){fclose(tf); *ierr=63; return;};
+    fclose(tf);
+    errc=talshTensorClean(&gt); if(errc){*ierr=63; return;};
+    errc=talshTensorLoad(&gt,tfile,NULL,io&TALSH_IO_DIRECT); if(errc != TALSH_OBJECT_BROKEN){*ierr=63; return;};
+    if(talshTensorIsEmpty(&gt) != YEP){*ierr=63; return;};
+   }
+  }
+  std::remove(tfile);
+  errc=talshTensorDestruct(&ft); if(errc){*ierr=63; return;};
+ }
+
+//Small tensors: Native Host path versus <tensor_block_t> path (per-call latency):
+ {
+  const int SDIM=6;
+  const int NUM_CALLS=2000;
+  const int sdims[]={SDIM,SDIM,SDIM};
+  talsh_tens_t sdst[2],sl,sr;
+  std::complex<double> * sbody[2];
+  void * body_p;
+  double tm_call[2][4];
+  for(int i=0; i<2; ++i){
+   errc=talshTensorClean(&(sdst[i])); if(errc){*ierr=19; return;};
+   errc=talshTensorConstruct(&(sdst[i]),C8,3,sdims,talshFlatDevId(DEV_HOST,0),NULL,-1,NULL,0.0); if(errc){*ierr=19; return;};
+   errc=talshTensorGetBodyAccess(&(sdst[i]),&body_p,C8,0,DEV_HOST); if(errc){*ierr=19; return;};
+   sbody[i]=static_cast<std::complex<double>*>(body_p);
+  }
+  errc=talshTensorClean(&sl); if(errc){*ierr=20; return;};
+  errc=talshTensorConstruct(&sl,C8,3,sdims,talshFlatDevId(DEV_HOST,0),NULL,-1,NULL,0.0); if(errc){*ierr=20; return;};
+  errc=talshTensorGetBodyAccess(&sl,&body_p,C8,0,DEV_HOST); if(errc){*ierr=20; return;};
+  std::complex<double> * lbody=static_cast<std::complex<double>*>(body_p);
+  errc=talshTensorClean(&sr); if(errc){*ierr=20; return;};
+  errc=talshTensorConstruct(&sr,C8,2,sdims,talshFlatDevId(DEV_HOST,0),NULL,-1,NULL,0.0); if(errc){*ierr=20; return;};
+  errc=talshTensorGetBodyAccess(&sr,&body_p,C8,0,DEV_HOST); if(errc){*ierr=20; return;};
+  std::complex<double> * rbody=static_cast<std::complex<double>*>(body_p);
+  size_t svol=talshTensorVolume(&sl);
+  for(size_t l=0; l<svol; ++l) lbody[l]=std::complex<double>(std::sin((double)l),1e-2*(double)l);
+  for(size_t l=0; l<talshTensorVolume(&sr); ++l) rbody[l]=std::complex<double>(std::cos((double)l),-1e-3*(double)l);
+  //Same sequence of operations via the native path (0) and via the <tensor_block_t> path (1):
+  size_t small_vol=talshSetSmallTensorVolume(TALSH_SMALL_TENSOR_VOLUME);
+  for(int i=0; i<2; ++i){
+   talshSetSmallTensorVolume((i == 0)?TALSH_SMALL_TENSOR_VOLUME:0);
+   errc=talshTensorCopy("D(a,b,c)=L(c,a,b)",&(sdst[i]),&sl); if(errc){*ierr=21; return;};
+   errc=talshTensorAdd("D(a,b,c)+=L(b,c,a)",&(sdst[i]),&sl,0.5,-0.25); if(errc){*ierr=21; return;};
+   errc=talshTensorContract("D(a,b,c)+=L+(c,d,a)*R(d,b)",&(sdst[i]),&sl,&sr,1.0,2.0); if(errc){*ierr=21; return;};
+   errc=talshTensorScale(&(sdst[i]),0.5,0.5); if(errc){*ierr=21; return;};
+  }
+  double max_diff=0.0;
+  for(size_t l=0; l<svol; ++l) max_diff=std::max(max_diff,std::abs(sbody[0][l]-sbody[1][l]));
+  printf(" Small tensor operations: Max deviation native vs <tensor_block_t> = %E\n",max_diff);
+  if(max_diff > 1e-10){*ierr=22; return;};
+  unsigned long long pool_allocs[2],heap_allocs[2];
+  long long num_used;
+  errc=talshObjectPoolStats(&(pool_allocs[0]),&(heap_allocs[0]),&num_used); if(errc){*ierr=25; return;};
+  for(int i=0; i<2; ++i){
+   talshSetSmallTensorVolume((i == 0)?TALSH_SMALL_TENSOR_VOLUME:0);
+   tms=clock();
+   for(int n=0; n<NUM_CALLS; ++n) errc=talshTensorCopy("D(a,b,c)=L(c,a,b)",&(sdst[i]),&sl);
+   tm_call[i][0]=((double)(clock()-tms))/CLOCKS_PER_SEC/NUM_CALLS; tms=clock();
+   for(int n=0; n<NUM_CALLS; ++n) errc=talshTensorAdd("D(a,b,c)+=L(b,c,a)",&(sdst[i]),&sl,1e-3);
+   tm_call[i][1]=((double)(clock()-tms))/CLOCKS_PER_SEC/NUM_CALLS; tms=clock();
+   for(int n=0; n<NUM_CALLS; ++n) errc=talshTensorContract("D(a,b,c)+=L(c,d,a)*R(d,b)",&(sdst[i]),&sl,&sr,1e-3);
+   tm_call[i][2]=((double)(clock()-tms))/CLOCKS_PER_SEC/NUM_CALLS; tms=clock();
+   for(int n=0; n<NUM_CALLS; ++n) errc=talshTensorScale(&(sdst[i]),1.0,0.0);
+   tm_call[i][3]=((double)(clock()-tms))/CLOCKS_PER_SEC/NUM_CALLS;
+   if(errc){*ierr=23; return;};
+  }
+  talshSetSmallTensorVolume(small_vol);
+  errc=talshObjectPoolStats(&(pool_allocs[1]),&(heap_allocs[1]),&num_used); if(errc){*ierr=25; return;};
+  printf(" Object pools: Pooled allocations = %llu: Heap allocations = %llu\n",
+         pool_allocs[1]-pool_allocs[0],heap_allocs[1]-heap_allocs[0]);
+  if(heap_allocs[1] != heap_allocs[0]){*ierr=26; return;}; //steady-state submission must not touch the heap
+  printf(" Small tensor (volume %lu) per-call latency (usec): native / <tensor_block_t>:\n",svol);
+  printf("  Copy %.2f / %.2f; Add %.2f / %.2f; Contract %.2f / %.2f; Scale %.2f / %.2f\n",
+         tm_call[0][0]*1e6,tm_call[1][0]*1e6,tm_call[0][1]*1e6,tm_call[1][1]*1e6,
+         tm_call[0][2]*1e6,tm_call[1][2]*1e6,tm_call[0][3]*1e6,tm_call[1][3]*1e6);
+  errc=talshTensorDestruct(&sr); if(errc){*ierr=24; return;};
+  errc=talshTensorDestruct(&sl); if(errc){*ierr=24; return;};
+  for(int i=0; i<2; ++i){errc=talshTensorDestruct(&(sdst[i])); if(errc){*ierr=24; return;};}
+ }
+
+//Zero-copy operations on tensor slices versus the slice-extract-insert path:
+ {
+  const int ddims[]={16,10,14}, ldims[]={20,16,18}, rdims[]={12,14};
+  const size_t doffs[]={2,1,3}, loffs[]={3,2,4}, roffs[]={1,2};
+  const int dsdims[]={9,6,10}, lsdims[]={10,8,9}, rsdims[]={8,6};
+  const int idoffs[]={2,1,3}, iloffs[]={3,2,4}, iroffs[]={1,2};
+  talsh_tens_t zd[2],zl,zr,tmp[3];
+  talsh_tens_slice_t dsl,lsl,rsl;
+  errc=talshTensorSliceClean(&dsl); if(errc){*ierr=28; return;};
+  errc=talshTensorSliceClean(&lsl); if(errc){*ierr=28; return;};
+  errc=talshTensorSliceClean(&rsl); if(errc){*ierr=28; return;};
+  std::complex<double> * zbody[2];
+  void * body_p;
+  for(int i=0; i<2; ++i){
+   errc=talshTensorClean(&(zd[i])); if(errc){*ierr=27; return;};
+   errc=talshTensorConstruct(&(zd[i]),C8,3,ddims,talshFlatDevId(DEV_HOST,0),NULL,-1,NULL,0.0); if(errc){*ierr=27; return;};
+   errc=talshTensorGetBodyAccess(&(zd[i]),&body_p,C8,0,DEV_HOST); if(errc){*ierr=27; return;};
+   zbody[i]=static_cast<std::complex<double>*>(body_p);
+   for(size_t l=0; l<talshTensorVolume(&(zd[i])); ++l) zbody[i][l]=std::complex<double>(1e-2*(double)(l%7),0.0);
+  }
+  errc=talshTensorClean(&zl); if(errc){*ierr=27; return;};
+  errc=talshTensorConstruct(&zl,C8,3,ldims,talshFlatDevId(DEV_HOST,0),NULL,-1,NULL,0.0); if(errc){*ierr=27; return;};
+  errc=talshTensorGetBodyAccess(&zl,&body_p,C8,0,DEV_HOST); if(errc){*ierr=27; return;};
+  std::complex<double> * zlbody=static_cast<std::complex<double>*>(body_p);
+  for(size_t l=0; l<talshTensorVolume(&zl); ++l) zlbody[l]=std::complex<double>(std::sin((double)l),1e-3*(double)(l%13));
+  errc=talshTensorClean(&zr); if(errc){*ierr=27; return;};
+  errc=talshTensorConstruct(&zr,C8,2,rdims,talshFlatDevId(DEV_HOST,0),NULL,-1,NULL,0.0); if(errc){*ierr=27; return;};
+  errc=talshTensorGetBodyAccess(&zr,&body_p,C8,0,DEV_HOST); if(errc){*ierr=27; return;};
+  std::complex<double> * zrbody=static_cast<std::complex<double>*>(body_p);
+  for(size_t l=0; l<talshTensorVolume(&zr); ++l) zrbody[l]=std::complex<double>(std::cos((double)l),-1e-2*(double)(l%5));
+  //Zero-copy path:
+  errc=talshTensorSliceConstruct(&dsl,&(zd[0]),doffs,dsdims); if(errc){*ierr=28; return;};
+  errc=talshTensorSliceConstruct(&lsl,&zl,loffs,lsdims); if(errc){*ierr=28; return;};
+  errc=talshTensorSliceConstruct(&rsl,&zr,roffs,rsdims); if(errc){*ierr=28; return;};
+  errc=talshTensorSliceContract("D(a,b,c)+=L+(c,d,a)*R(d,b)",&dsl,&lsl,&rsl,0.5,1.0); if(errc){*ierr=29; return;};
+  errc=talshTensorSliceAdd("D(a,b,c)+=L(c,b,a)",&dsl,&lsl,-0.25,0.0);
+  if(errc != TALSH_INVALID_ARGS){*ierr=29; return;}; //shape mismatch must be rejected
+  //Slice-extract-insert path:
+  const int * tdims[]={dsdims,lsdims,rsdims};
+  for(int i=0; i<3; ++i){
+   errc=talshTensorClean(&(tmp[i])); if(errc){*ierr=30; return;};
+   errc=talshTensorConstruct(&(tmp[i]),C8,(i<2)?3:2,tdims[i],talshFlatDevId(DEV_HOST,0),NULL,-1,NULL,0.0); if(errc){*ierr=30; return;};
+  }
+  errc=talshTensorSlice(&(tmp[1]),&zl,iloffs,0,DEV_HOST); if(errc){*ierr=30; return;};
+  errc=talshTensorSlice(&(tmp[2]),&zr,iroffs,0,DEV_HOST); if(errc){*ierr=30; return;};
+  errc=talshTensorContract("D(a,b,c)+=L+(c,d,a)*R(d,b)",&(tmp[0]),&(tmp[1]),&(tmp[2]),0.5,1.0); if(errc){*ierr=30; return;};
+  errc=talshTensorInsert(&(zd[1]),&(tmp[0]),idoffs,0,DEV_HOST,COPY_MT,YEP); if(errc){*ierr=30; return;};
+  double max_diff=0.0;
+  for(size_t l=0; l<talshTensorVolume(&(zd[0])); ++l) max_diff=std::max(max_diff,std::abs(zbody[0][l]-zbody[1][l]));
+  printf(" Zero-copy slice contraction: Max deviation from the slice-extract-insert path = %E\n",max_diff);
+  if(max_diff > 1e-10){*ierr=31; return;};
+  //Split-complex 3M formulation undoes the 4M one:
+  int cgemm_mode=talshSetComplexGemmMode(TALSH_CGEMM_3M);
+  errc=talshTensorSliceContract("D(a,b,c)+=L+(c,d,a)*R(d,b)",&dsl,&lsl,&rsl,-0.5,-1.0); if(errc){*ierr=34; return;};
+  talshSetComplexGemmMode(cgemm_mode);
+  max_diff=0.0;
+  for(size_t l=0; l<talshTensorVolume(&(zd[0])); ++l)
+   max_diff=std::max(max_diff,std::abs(zbody[0][l]-std::complex<double>(1e-2*(double)(l%7),0.0)));
+  printf(" Split-complex 3M versus 4M slice contraction: Max deviation = %E\n",max_diff);
+  if(max_diff > 1e-10){*ierr=34; return;};
+  //Split-complex layout conversion round trip:
+  std::vector<double> zre(talshTensorVolume(&zl)),zim(talshTensorVolume(&zl));
+  errc=talshTensorComplexSplit(&zl,zre.data(),zim.data(),C8); if(errc){*ierr=35; return;};
+  for(size_t l=0; l<zre.size(); ++l){
+   if(zre[l] != zlbody[l].real() || zim[l] != zlbody[l].imag()){*ierr=35; return;};
+   zre[l]*=2.0;
+  }
+  errc=talshTensorComplexMerge(&zl,zre.data(),zim.data(),C8); if(errc){*ierr=35; return;};
+  for(size_t l=0; l<zre.size(); ++l){if(zlbody[l] != std::complex<double>(zre[l],zim[l])){*ierr=35; return;};}
+  //Zero-copy slice copy (permutation) versus slice extraction:
+  const size_t zoffs[]={0,0,0};
+  const int pdims[]={dsdims[2],dsdims[0],dsdims[1]};
+  errc=talshTensorDestruct(&(tmp[1])); if(errc){*ierr=32; return;};
+  errc=talshTensorConstruct(&(tmp[1]),C8,3,pdims,talshFlatDevId(DEV_HOST,0),NULL,-1,NULL,0.0); if(errc){*ierr=32; return;};
+  errc=talshTensorSliceDestruct(&lsl); if(errc){*ierr=32; return;};
+  errc=talshTensorSliceConstruct(&lsl,&(tmp[1]),zoffs,pdims); if(errc){*ierr=32; return;};
+  errc=talshTensorSliceCopy("D(c,a,b)=L(a,b,c)",&lsl,&dsl); if(errc){*ierr=32; return;};
+  errc=talshTensorSlice(&(tmp[0]),&(zd[0]),idoffs,0,DEV_HOST); if(errc){*ierr=32; return;};
+  errc=talshTensorGetBodyAccess(&(tmp[0]),&body_p,C8,0,DEV_HOST); if(errc){*ierr=32; return;};
+  const std::complex<double> * sbody0=static_cast<std::complex<double>*>(body_p);
+  errc=talshTensorGetBodyAccess(&(tmp[1]),&body_p,C8,0,DEV_HOST); if(errc){*ierr=32; return;};
+  const std::complex<double> * pbody=static_cast<std::complex<double>*>(body_p);
+  max_diff=0.0;
+  for(int c=0; c<dsdims[2]; ++c){
+   for(int b=0; b<dsdims[1]; ++b){
+    for(int a=0; a<dsdims[0]; ++a){
+     max_diff=std::max(max_diff,std::abs(pbody[c+pdims[0]*(a+pdims[1]*b)]-sbody0[a+dsdims[0]*(b+dsdims[1]*c)]));
+    }
+   }
+  }
+  printf(" Zero-copy slice copy: Max deviation from the slice extraction = %E\n",max_diff);
+  if(max_diff != 0.0){*ierr=32; return;};
+  errc=talshTensorSliceDestruct(&rsl); if(errc){*ierr=33; return;};
+  errc=talshTensorSliceDestruct(&lsl); if(errc){*ierr=33; return;};
+  errc=talshTensorSliceDestruct(&dsl); if(errc){*ierr=33; return;};
+  for(int i=2; i>=0; --i){errc=talshTensorDestruct(&(tmp[i])); if(errc){*ierr=33; return;};}
+  errc=talshTensorDestruct(&zr); if(errc){*ierr=33; return;};
+  errc=talshTensorDestruct(&zl); if(errc){*ierr=33; return;};
+  for(int i=0; i<2; ++i){errc=talshTensorDestruct(&(zd[i])); if(errc){*ierr=33; return;};}
+ }
+
+//Parallel data import/export (data kind conversion, non-temporal stores, asynchronous):
+ {
+  const int xdims[]={64,256,256}; //32 MB in R8: streaming stores
+  talsh_tens_t xr8,xc4;
+  errc=talshTensorClean(&xr8); if(errc){*ierr=36; return;};
+  errc=talshTensorConstruct(&xr8,R8,3,xdims,talshFlatDevId(DEV_HOST,0),NULL,-1,NULL,0.0); if(errc){*ierr=36; return;};
+  errc=talshTensorClean(&xc4); if(errc){*ierr=36; return;};
+  errc=talshTensorConstruct(&xc4,C4,2,xdims,talshFlatDevId(DEV_HOST,0),NULL,-1,NULL,0.0); if(errc){*ierr=36; return;};
+  const size_t xvol=talshTensorVolume(&xr8);
+  std::vector<double> xsrc(xvol),xdst(xvol);
+  for(size_t l=0; l<xvol; ++l) xsrc[l]=std::sin((double)l);
+  talsh_task_t xtask;
+  errc=talshTaskClean(&xtask); if(errc){*ierr=37; return;};
+  errc=talshTensorImportData(&xr8,R8,xsrc.data(),&xtask); if(errc){*ierr=37; return;};
+  int sts;
+  errc=talshTaskWait(&xtask,&sts); if(errc || sts != TALSH_TASK_COMPLETED){*ierr=37; return;};
+  errc=talshTaskDestruct(&xtask); if(errc){*ierr=37; return;};
+  errc=talshTensorExportData(&xr8,R8,xdst.data()); if(errc){*ierr=38; return;};
+  if(xdst != xsrc){*ierr=38; return;};
+  //Asynchronous export (the transfer thread is joined once the task is over, the task is reusable):
+  std::fill(xdst.begin(),xdst.end(),0.0);
+  errc=talshTensorExportData(&xr8,R8,xdst.data(),&xtask); if(errc){*ierr=38; return;};
+  errc=talshTaskWait(&xtask,&sts); if(errc || sts != TALSH_TASK_COMPLETED){*ierr=38; return;};
+  errc=talshTaskDestruct(&xtask); if(errc){*ierr=38; return;};
+  if(xdst != xsrc){*ierr=38; return;};
+  //R8 data into a C4 tensor and back into C8 data:
+  errc=talshTensorImportData(&xc4,R8,xsrc.data()); if(errc){*ierr=39; return;};
+  std::vector<std::complex<double> > xc8(talshTensorVolume(&xc4));
+  errc=talshTensorExportData(&xc4,C8,xc8.data()); if(errc){*ierr=39; return;};
+  double max_diff=0.0;
+  for(size_t l=0; l<xc8.size(); ++l) max_diff=std::max(max_diff,std::abs(xc8[l]-std::complex<double>(xsrc[l],0.0)));
+  printf(" Data import/export with conversion R8->C4->C8: Max deviation = %E\n",max_diff);
+  if(max_diff > 1e-6){*ierr=39; return;};
+  errc=talshTensorExportData(&xc4,R8,xdst.data()); if(errc != TALSH_INVALID_ARGS){*ierr=39; return;}; //complex into real
+  errc=talshTensorDestruct(&xc4); if(errc){*ierr=40; return;};
+  errc=talshTensorDestruct(&xr8); if(errc){*ierr=40; return;};
+ }
+
+//Counter-based random initialization (reproducible regardless of threading and tiling):
+ {
+  const int rdims[]={37,100}; //not a multiple of the generator block
+  talsh_tens_t rr8,rc8;
+  errc=talshTensorClean(&rr8); if(errc){*ierr=41; return;};
+  errc=talshTensorConstruct(&rr8,R8,2,rdims,talshFlatDevId(DEV_HOST,0)); if(errc){*ierr=41; return;};
+  errc=talshTensorClean(&rc8); if(errc){*ierr=41; return;};
+  errc=talshTensorConstruct(&rc8,C8,2,rdims,talshFlatDevId(DEV_HOST,0)); if(errc){*ierr=41; return;};
+  const size_t rvol=talshTensorVolume(&rr8);
+  std::vector<double> rfull(rvol),rtile(rvol);
+  errc=talshTensorInitRandom(&rr8,20211220ULL); if(errc){*ierr=41; return;};
+  errc=talshTensorExportData(&rr8,R8,rfull.data()); if(errc){*ierr=41; return;};
+  double rmean=0.0;
+  for(size_t l=0; l<rvol; ++l){
+   if(rfull[l] < 0.0 || rfull[l] >= 1.0){*ierr=41; return;};
+   rmean+=rfull[l];
+  }
+  rmean/=(double)rvol;
+  printf(" Random uniform fill: Mean = %f\n",rmean);
+  if(std::abs(rmean-0.5) > 0.05){*ierr=41; return;};
+  //Same stream generated piecewise (irregular tiles) must be bitwise identical:
+  const size_t rcuts[]={0,1,13,777,2048,rvol};
+  for(int i=0; i<5; ++i){
+   errc=tens_random_fill(&(rtile[rcuts[i]]),rcuts[i],rcuts[i+1]-rcuts[i],R8,20211220ULL,RANDOM_UNIFORM); if(errc){*ierr=42; return;};
+  }
+  if(rtile != rfull){*ierr=42; return;};
+#ifndef NO_OMP
+  const int rthreads=omp_get_max_threads();
+  omp_set_num_threads(1);
+  errc=talshTensorInitRandom(&rr8,20211220ULL); omp_set_num_threads(rthreads); if(errc){*ierr=42; return;};
+  errc=talshTensorExportData(&rr8,R8,rtile.data()); if(errc){*ierr=42; return;};
+  if(rtile != rfull){*ierr=42; return;};
+#endif
+  //Normal distribution on complex numbers:
+  errc=talshTensorInitRandom(&rc8,7ULL,TALSH_RANDOM_NORMAL); if(errc){*ierr=43; return;};
+  std::vector<std::complex<double> > rz(rvol);
+  errc=talshTensorExportData(&rc8,C8,rz.data()); if(errc){*ierr=43; return;};
+  double rvar=0.0; rmean=0.0;
+  for(size_t l=0; l<rvol; ++l){rmean+=rz[l].real()+rz[l].imag(); rvar+=std::norm(rz[l]);}
+  rmean/=(double)(2*rvol); rvar/=(double)(2*rvol);
+  printf(" Random normal fill: Mean = %f, Variance = %f\n",rmean,rvar);
+  if(std::abs(rmean) > 0.05 || std::abs(rvar-1.0) > 0.1){*ierr=43; return;};
+  errc=talshTensorInitRandom(&rc8,7ULL,-1); if(errc != TALSH_INVALID_ARGS){*ierr=43; return;};
+  errc=talshTensorDestruct(&rc8); if(errc){*ierr=43; return;};
+  errc=talshTensorDestruct(&rr8); if(errc){*ierr=43; return;};
+ }
+
+//NaN/Inf screening of Host tensor operations (fused into the native kernel epilogue or a single output pass):
+ {
+  const int ndims[]={8,8};
+  talsh_tens_t nd,nl,nr;
+  errc=talshTensorClean(&nd); if(errc){*ierr=44; return;};
+  errc=talshTensorConstruct(&nd,R8,2,ndims,talshFlatDevId(DEV_HOST,0),NULL,-1,NULL,0.0); if(errc){*ierr=44; return;};
+  errc=talshTensorClean(&nl); if(errc){*ierr=44; return;};
+  errc=talshTensorConstruct(&nl,R8,2,ndims,talshFlatDevId(DEV_HOST,0),NULL,-1,NULL,1.0); if(errc){*ierr=44; return;};
+  errc=talshTensorClean(&nr); if(errc){*ierr=44; return;};
+  errc=talshTensorConstruct(&nr,R8,2,ndims,talshFlatDevId(DEV_HOST,0),NULL,-1,NULL,1.0); if(errc){*ierr=44; return;};
+  int prev_check=talshSetNonFiniteCheck(YEP);
+  const size_t prev_small=talshSetSmallTensorVolume(TALSH_SMALL_TENSOR_VOLUME);
+  for(int path=0; path<2; ++path){ //native small-tensor kernel, then CP-TAL
+   if(path == 1) talshSetSmallTensorVolume(0);
+   int nflags=-1;
+   talsh_task_t ntask;
+   errc=talshTaskClean(&ntask); if(errc){*ierr=44; return;};
+   errc=talshTensorContract("D(a,b)+=L(a,c)*R(c,b)",&nd,&nl,&nr,1.0,0.0,0,DEV_HOST,COPY_MTT,NOPE,&ntask); if(errc){*ierr=44; return;};
+   errc=talshTaskWait(&ntask,&sts); if(errc || sts != TALSH_TASK_COMPLETED){*ierr=44; return;};
+   errc=talshTaskNonFinite(&ntask,&nflags); if(errc || nflags != 0){*ierr=44; return;};
+   errc=talshTaskDestruct(&ntask); if(errc){*ierr=44; return;};
+   double * nlbody=NULL;
+   errc=talshTensorGetBodyAccess(&nl,(void**)&nlbody,R8,0,DEV_HOST); if(errc){*ierr=45; return;};
+   nlbody[9]=std::numeric_limits<double>::infinity();
+   errc=talshTaskClean(&ntask); if(errc){*ierr=45; return;};
+   errc=talshTensorContract("D(a,b)+=L(a,c)*R(c,b)",&nd,&nl,&nr,1.0,0.0,0,DEV_HOST,COPY_MTT,NOPE,&ntask); if(errc){*ierr=45; return;};
+   errc=talshTaskWait(&ntask,&sts); if(errc || sts != TALSH_TASK_COMPLETED){*ierr=45; return;};
+   errc=talshTaskNonFinite(&ntask,&nflags); if(errc || nflags != 3){*ierr=45; return;}; //D and L flagged
+   errc=talshTaskDestruct(&ntask); if(errc){*ierr=45; return;};
+   printf(" NaN/Inf screening (path %d): Flags = %d\n",path,nflags);
+   nlbody[9]=1.0;
+   errc=talshTensorInit(&nd,0.0,0.0,0,DEV_HOST); if(errc){*ierr=45; return;};
+  }
+  talshSetSmallTensorVolume(prev_small);
+  talshSetNonFiniteCheck(prev_check);
+  errc=talshTensorDestruct(&nr); if(errc){*ierr=45; return;};
+  errc=talshTensorDestruct(&nl); if(errc){*ierr=45; return;};
+  errc=talshTensorDestruct(&nd); if(errc){*ierr=45; return;};
+ }
+
+//Autotuning of Host tensor contractions (all candidate strategies must agree, the tuned plan must persist):
+ {
+  talsh_tens_t ad,al,ar;
+  int addims[]={24,20,18}, aldims[]={24,16,18}, ardims[]={16,20};
+  const char * adb="talsh_autotune.db";
+  errc=talshTensorClean(&ad); if(errc){*ierr=46; return;};
+  errc=talshTensorConstruct(&ad,R8,3,addims,talshFlatDevId(DEV_HOST,0),NULL,-1,NULL,0.0); if(errc){*ierr=46; return;};
+  errc=talshTensorClean(&al); if(errc){*ierr=46; return;};
+  errc=talshTensorConstruct(&al,R8,3,aldims,talshFlatDevId(DEV_HOST,0)); if(errc){*ierr=46; return;};
+  errc=talshTensorClean(&ar); if(errc){*ierr=46; return;};
+  errc=talshTensorConstruct(&ar,R8,2,ardims,talshFlatDevId(DEV_HOST,0)); if(errc){*ierr=46; return;};
+  errc=talshTensorInitRandom(&al,1ULL); if(errc){*ierr=46; return;};
+  errc=talshTensorInitRandom(&ar,2ULL); if(errc){*ierr=46; return;};
+  std::remove(adb);
+  const size_t prev_small=talshSetSmallTensorVolume(0);
+  int prev_tune=talshSetAutotune(YEP,adb); if(prev_tune != NOPE){*ierr=46; return;};
+  const size_t avol=talshTensorVolume(&ad);
+  std::vector<double> aref(avol), ares(avol);
+  for(int rep=0; rep<=TALSH_HOST_CTR_STRATEGIES; ++rep){ //time all candidates, then run the tuned one
+   errc=talshTensorContract("D(a,b,c)+=L(a,d,c)*R(d,b)",&ad,&al,&ar,1.0,0.0,0,DEV_HOST,COPY_MTT,NOPE); if(errc){*ierr=46; return;};
+   errc=talshTensorExportData(&ad,R8,((rep == 0)?aref.data():ares.data())); if(errc){*ierr=46; return;};
+   for(size_t l=0; rep > 0 && l<avol; ++l){
+    if(std::abs(ares[l]-aref[l]) > 1e-12*(1.0+std::abs(aref[l]))){*ierr=46; return;};
+   }
+  }
+  int ntuned=-1, npending=-1;
+  errc=talshAutotuneStats(&ntuned,&npending); if(errc || ntuned != 1 || npending != 0){*ierr=47; return;};
+  errc=talshAutotuneSave(); if(errc){*ierr=47; return;};
+  int nerr=0; //concurrent autotuned contractions (CP-TAL algorithms are chosen per call)
+#ifndef NO_OMP
+#pragma omp parallel num_threads(4) reduction(+:nerr)
+#endif
+  {
+   talsh_tens_t td,tl,tr;
+   std::vector<double> tres(avol);
+   nerr+=talshTensorClean(&td); nerr+=talshTensorClean(&tl); nerr+=talshTensorClean(&tr);
+   nerr+=talshTensorConstruct(&td,R8,3,addims,talshFlatDevId(DEV_HOST,0),NULL,-1,NULL,0.0);
+   nerr+=talshTensorConstruct(&tl,R8,3,aldims,talshFlatDevId(DEV_HOST,0));
+   nerr+=talshTensorConstruct(&tr,R8,2,ardims,talshFlatDevId(DEV_HOST,0));
+   nerr+=talshTensorInitRandom(&tl,1ULL); nerr+=talshTensorInitRandom(&tr,2ULL);
+   for(int rep=0; rep<=TALSH_HOST_CTR_STRATEGIES; ++rep){
+    nerr+=talshTensorContract("D(a,b,c)+=L(a,d,c)*R(d,b)",&td,&tl,&tr,1.0,0.0,0,DEV_HOST,COPY_MTT,NOPE);
+    nerr+=talshTensorExportData(&td,R8,tres.data());
+    for(size_t l=0; l<avol; ++l){
+     if(std::abs(tres[l]-aref[l]) > 1e-12*(1.0+std::abs(aref[l]))){++nerr; break;}
+    }
+   }
+   nerr+=talshTensorDestruct(&tr); nerr+=talshTensorDestruct(&tl); nerr+=talshTensorDestruct(&td);
+  }
+  if(nerr != 0){*ierr=47; return;};
+  talshSetAutotune(prev_tune);
+  talshSetSmallTensorVolume(prev_small);
+  FILE * adbf=fopen(adb,"r"); if(adbf == NULL){*ierr=47; return;};
+  char adbl[1024]; int nplans=0;
+  while(fgets(adbl,sizeof(adbl),adbf) != NULL){if(adbl[0] != '#') ++nplans;}
+  fclose(adbf); std::remove(adb);
+  if(nplans != 1){*ierr=47; return;};
+  printf(" Autotuned Host contraction plans: %d\n",ntuned);
+  errc=talshTensorDestruct(&ar); if(errc){*ierr=47; return;};
+  errc=talshTensorDestruct(&al); if(errc){*ierr=47; return;};
+  errc=talshTensorDestruct(&ad); if(errc){*ierr=47; return;};
+ }
+
+//Host BLAS loaded at run time (hyper-contraction via batched GEMM, checked against a direct evaluation):
+ {
+  if(talshBlasLoad("libtalsh_no_such_blas.so") != TALSH_NOT_AVAILABLE){*ierr=48; return;};
+  const char * blas_libs[]={"libopenblas.so.0","libblas.so.3"};
+  int blas_kind=TALSH_NOT_AVAILABLE;
+  for(int i=0; i<2 && blas_kind < 0; ++i) blas_kind=talshBlasLoad(blas_libs[i]);
+  if(blas_kind >= 0){
+   if(talshBlasBackend() != blas_kind){*ierr=48; return;};
+   talsh_tens_t bd,bl,br;
+   const int ba=12, bb=10, bc=6, bk=8;
+   int bddims[]={ba,bb,bc}, bldims[]={ba,bk,bc}, brdims[]={bk,bb,bc};
+   errc=talshTensorClean(&bd); if(errc){*ierr=48; return;};
+   errc=talshTensorConstruct(&bd,R8,3,bddims,talshFlatDevId(DEV_HOST,0),NULL,-1,NULL,0.0); if(errc){*ierr=48; return;};
+   errc=talshTensorClean(&bl); if(errc){*ierr=48; return;};
+   errc=talshTensorConstruct(&bl,R8,3,bldims,talshFlatDevId(DEV_HOST,0)); if(errc){*ierr=48; return;};
+   errc=talshTensorClean(&br); if(errc){*ierr=48; return;};
+   errc=talshTensorConstruct(&br,R8,3,brdims,talshFlatDevId(DEV_HOST,0)); if(errc){*ierr=48; return;};
+   errc=talshTensorInitRandom(&bl,3ULL); if(errc){*ierr=48; return;};
+   errc=talshTensorInitRandom(&br,4ULL); if(errc){*ierr=48; return;};
+   std::vector<double> blv(ba*bk*bc), brv(bk*bb*bc), bdv(ba*bb*bc);
+   errc=talshTensorExportData(&bl,R8,blv.data()); if(errc){*ierr=48; return;};
+   errc=talshTensorExportData(&br,R8,brv.data()); if(errc){*ierr=48; return;};
+   const size_t prev_small=talshSetSmallTensorVolume(0);
+   talshSetBlasThreads(2,YEP);
+   errc=talshTensorContract("D(a,b,c)+=L(a,d,c)*R(d,b,c)",&bd,&bl,&br,1.0,0.0,0,DEV_HOST,COPY_MTT,NOPE); if(errc){*ierr=49; return;};
+   talshSetBlasThreads(0,YEP);
+   talshSetSmallTensorVolume(prev_small);
+   errc=talshTensorExportData(&bd,R8,bdv.data()); if(errc){*ierr=49; return;};
+   double bdev=0.0;
+   for(int c=0; c<bc; ++c){
+    for(int b=0; b<bb; ++b){
+     for(int a=0; a<ba; ++a){
+      double val=0.0;
+      for(int d=0; d<bk; ++d) val+=blv[(c*bk+d)*ba+a]*brv[(c*bb+b)*bk+d];
+      bdev=std::max(bdev,std::abs(bdv[(c*bb+b)*ba+a]-val));
+     }
+    }
+   }
+   if(bdev > 1e-12){*ierr=49; return;};
+   printf(" Run-time Host BLAS (backend %d): Hyper-contraction max deviation = %E\n",blas_kind,bdev);
+   errc=talshTensorDestruct(&br); if(errc){*ierr=49; return;};
+   errc=talshTensorDestruct(&bl); if(errc){*ierr=49; return;};
+   errc=talshTensorDestruct(&bd); if(errc){*ierr=49; return;};
+  }else{
+   printf(" Run-time Host BLAS: No BLAS library found, skipped\n");
+  }
+ }
+
+//Split-complex tensor layout (native Host transpose, addition, scaling and Hadamard product, checked against the interleaved layout):
+ {
+  const int sa=24, sb=20;
+  const int sdims[]={sa,sb}, stdims[]={sb,sa};
+  talsh_tens_t sd[2],sl[2],sr[2],sc[2]; //[0]: split-complex layout, [1]: interleaved layout (reference)
+  for(int i=0; i<2; ++i){
+   errc=talshTensorClean(&(sd[i])); if(errc){*ierr=50; return;};
+   errc=talshTensorConstruct(&(sd[i]),C8,2,sdims,talshFlatDevId(DEV_HOST,0),NULL,-1,NULL,0.0); if(errc){*ierr=50; return;};
+   errc=talshTensorClean(&(sc[i])); if(errc){*ierr=50; return;};
+   errc=talshTensorConstruct(&(sc[i]),C8,2,sdims,talshFlatDevId(DEV_HOST,0),NULL,-1,NULL,0.0); if(errc){*ierr=50; return;};
+   errc=talshTensorClean(&(sl[i])); if(errc){*ierr=50; return;};
+   errc=talshTensorConstruct(&(sl[i]),C8,2,stdims,talshFlatDevId(DEV_HOST,0)); if(errc){*ierr=50; return;};
+   errc=talshTensorInitRandom(&(sl[i]),5ULL); if(errc){*ierr=50; return;};
+   errc=talshTensorClean(&(sr[i])); if(errc){*ierr=50; return;};
+   errc=talshTensorConstruct(&(sr[i]),C8,2,sdims,talshFlatDevId(DEV_HOST,0)); if(errc){*ierr=50; return;};
+   errc=talshTensorInitRandom(&(sr[i]),6ULL); if(errc){*ierr=50; return;};
+  }
+  talsh_tens_t * stens[]={&(sd[0]),&(sl[0]),&(sr[0]),&(sc[0])};
+  for(int i=0; i<4; ++i){
+   errc=talshTensorSetComplexLayout(stens[i],TALSH_CPLX_SPLIT); if(errc){*ierr=50; return;};
+   if(talshTensorComplexLayout(stens[i]) != TALSH_CPLX_SPLIT){*ierr=50; return;};
+  }
+  for(int i=0; i<2; ++i){
+   errc=talshTensorAdd("D(a,b)+=L+(b,a)",&(sd[i]),&(sl[i]),0.5,-0.25,0,DEV_HOST); if(errc){*ierr=51; return;};
+   errc=talshTensorCopy("D(a,b)=L(b,a)",&(sc[i]),&(sl[i]),0,DEV_HOST); if(errc){*ierr=51; return;};
+   errc=talshTensorContract("D(a,b)+=L(a,b)*R(a,b)",&(sd[i]),&(sc[i]),&(sr[i]),1.5,0.5,0,DEV_HOST); if(errc){*ierr=51; return;};
+   errc=talshTensorScale(&(sd[i]),0.5,2.0,0,DEV_HOST); if(errc){*ierr=51; return;};
+  }
+  for(int i=0; i<4; ++i){if(talshTensorComplexLayout(stens[i]) != TALSH_CPLX_SPLIT){*ierr=52; return;};} //no fallback
+  const void * sbody;
+  std::vector<double> sre[2], sim[2];
+  for(int i=0; i<2; ++i){
+   sre[i].resize(sa*sb); sim[i].resize(sa*sb);
+   errc=talshTensorComplexSplit(&(sd[i]),sre[i].data(),sim[i].data(),C8); if(errc){*ierr=52; return;};
+  }
+  if(sre[0] != sre[1] || sim[0] != sim[1]){*ierr=52; return;};
+  const double snorm[]={talshTensorImageNorm1_cpu(&(sd[0])),talshTensorImageNorm1_cpu(&(sd[1]))};
+  if(std::abs(snorm[0]-snorm[1]) > 1e-12*snorm[1]){*ierr=52; return;};
+  errc=talshTensorGetBodyAccessConst(&(sd[0]),&sbody,C8,0,DEV_HOST); if(errc != TALSH_NOT_ALLOWED){*ierr=52; return;};
+  if(talshTensorComplexLayout(&(sd[0])) != TALSH_CPLX_SPLIT){*ierr=52; return;}; //constant access does not convert
+  std::vector<std::complex<double> > sval(sa*sb), sref(sa*sb);
+  errc=talshTensorExportData(&(sd[0]),C8,sval.data()); if(errc){*ierr=52; return;};
+  errc=talshTensorExportData(&(sd[1]),C8,sref.data()); if(errc){*ierr=52; return;};
+  if(talshTensorComplexLayout(&(sd[0])) != TALSH_CPLX_INTERLEAVED){*ierr=52; return;};
+  double sdev=0.0;
+  for(size_t l=0; l<sval.size(); ++l) sdev=std::max(sdev,std::abs(sval[l]-sref[l]));
+  printf(" Split-complex layout: Max deviation from the interleaved layout = %E\n",sdev);
+  if(sdev > 1e-12){*ierr=52; return;};
+  for(int i=0; i<2; ++i){
+   errc=talshTensorDestruct(&(sc[i])); if(errc){*ierr=53; return;};
+   errc=talshTensorDestruct(&(sr[i])); if(errc){*ierr=53; return;};
+   errc=talshTensorDestruct(&(sl[i])); if(errc){*ierr=53; return;};
+   errc=talshTensorDestruct(&(sd[i])); if(errc){*ierr=53; return;};
+  }
+ }
+
+//Compressed tensor bodies (lossless and lossy round trips, decompression on first use only):
+ {
+  const int zdims[]={40,30,20};
+  talsh_tens_t zt;
+  errc=talshTensorClean(&zt); if(errc){*ierr=54; return;};
+  errc=talshTensorConstruct(&zt,R8,3,zdims,talshFlatDevId(DEV_HOST,0)); if(errc){*ierr=54; return;};
+  errc=talshTensorInitRandom(&zt,7ULL); if(errc){*ierr=54; return;};
+  const size_t zvol=talshTensorVolume(&zt);
+  std::vector<double> zref(zvol), zval(zvol);
+  errc=talshTensorExportData(&zt,R8,zref.data()); if(errc){*ierr=54; return;};
+  const double znorm=talshTensorImageNorm1_cpu(&zt);
+  //Lossless: Queries do not decompress the tensor body:
+  size_t zsize=0;
+  errc=talshTensorCompress(&zt,TALSH_ZIP_LOSSLESS); if(errc){*ierr=54; return;};
+  if(talshTensorIsCompressed(&zt,&zsize) != YEP || zsize == 0){*ierr=54; return;};
+  int zn=-1,zdevs[TALSH_MAX_DEV_PRESENT],zdtks[TALSH_MAX_DEV_PRESENT];
+  errc=talshTensorPresence(&zt,&zn,zdevs,zdtks); if(errc || zn != 0){*ierr=54; return;};
+  if(talshTensorInUse(&zt) != NOPE){*ierr=54; return;};
+  if(talshTensorImageNorm1_cpu(&zt) != znorm){*ierr=54; return;};
+  if(talshTensorIsCompressed(&zt) != YEP){*ierr=54; return;};
+  errc=talshTensorDecompress(&zt); if(errc){*ierr=55; return;};
+  if(talshTensorIsCompressed(&zt) != NOPE){*ierr=55; return;};
+  errc=talshTensorExportData(&zt,R8,zval.data()); if(errc){*ierr=55; return;};
+  for(size_t l=0; l<zvol; ++l){if(zval[l] != zref[l]){*ierr=55; return;};}
+  //Lossy: Decompressed on first use by a tensor operation, within the error bound:
+  const double ztol=1e-3;
+  errc=talshTensorCompress(&zt,TALSH_ZIP_LOSSY,ztol); if(errc){*ierr=56; return;};
+  if(talshTensorIsCompressed(&zt,&zsize) != YEP || zsize >= zvol*sizeof(double)){*ierr=56; return;};
+  errc=talshTensorScale(&zt,2.0,0.0,0,DEV_HOST); if(errc){*ierr=56; return;};
+  if(talshTensorIsCompressed(&zt) != NOPE){*ierr=56; return;};
+  errc=talshTensorExportData(&zt,R8,zval.data()); if(errc){*ierr=56; return;};
+  double zdev=0.0;
+  for(size_t l=0; l<zvol; ++l) zdev=std::max(zdev,std::abs(zval[l]*0.5-zref[l]));
+  printf(" Compressed tensor body: Lossy max deviation = %E (bound %E), compression ratio = %.2f\n",
+         zdev,ztol,(double)(zvol*sizeof(double))/(double)zsize);
+  if(zdev > ztol*(1.0+1e-9)){*ierr=56; return;};
+  //Body access decompresses as well:
+  errc=talshTensorCompress(&zt,TALSH_ZIP_LOSSLESS); if(errc){*ierr=57; return;};
+  void * zbody_p=NULL;
+  errc=talshTensorGetBodyAccess(&zt,&zbody_p,R8,0,DEV_HOST); if(errc){*ierr=57; return;};
+  if(talshTensorIsCompressed(&zt) != NOPE){*ierr=57; return;};
+  for(size_t l=0; l<zvol; ++l){if(static_cast<const double*>(zbody_p)[l] != zval[l]){*ierr=57; return;};}
+  errc=talshTensorDestruct(&zt); if(errc){*ierr=57; return;};
+ }
+
+//Memory-mapped tensor bodies (written through the mapping, reopened and checked):
+ {
+  const int mdims[]={32,24,16};
+  const char * mfile="talsh_mapped.bin";
+  talsh_tens_t mt;
+  std::remove(mfile);
+  errc=talshTensorClean(&mt); if(errc){*ierr=58; return;};
+  errc=talshTensorConstructMapped(&mt,R8,3,mdims,mfile); if(errc != TALSH_FAILURE){*ierr=58; return;}; //no such file
+  errc=talshTensorConstructMapped(&mt,R8,3,mdims,mfile,MEM_MAP_CREATE,MEM_MAP_ADVICE_SEQUENTIAL); if(errc){*ierr=58; return;};
+  const size_t mvol=talshTensorVolume(&mt);
+  std::vector<double> mref(mvol), mval(mvol);
+  void * mbody_p=NULL;
+  errc=talshTensorGetBodyAccess(&mt,&mbody_p,R8,0,DEV_HOST); if(errc){*ierr=58; return;};
+  for(size_t l=0; l<mvol; ++l){if(static_cast<const double*>(mbody_p)[l] != 0.0){*ierr=58; return;};} //new space reads as zeros
+  errc=talshTensorInitRandom(&mt,9ULL); if(errc){*ierr=58; return;};
+  errc=talshTensorExportData(&mt,R8,mref.data()); if(errc){*ierr=58; return;};
+  errc=talshTensorDestruct(&mt); if(errc){*ierr=58; return;}; //unmaps the file
+  //Shared mapping: The body persists in the file and modifications are written back:
+  FILE * mf=fopen(mfile,"rb"); if(mf == NULL){*ierr=59; return;};
+  size_t mread=fread(mval.data(),sizeof(double),mvol,mf); fclose(mf);
+  if(mread != mvol){*ierr=59; return;};
+  for(size_t l=0; l<mvol; ++l){if(mval[l] != mref[l]){*ierr=59; return;};}
+  errc=talshTensorConstructMapped(&mt,R8,3,mdims,mfile,MEM_MAP_OPEN,MEM_MAP_ADVICE_RANDOM); if(errc){*ierr=59; return;};
+  errc=talshTensorExportData(&mt,R8,mval.data()); if(errc){*ierr=59; return;};
+  for(size_t l=0; l<mvol; ++l){if(mval[l] != mref[l]){*ierr=59; return;};}
+  errc=talshTensorScale(&mt,2.0,0.0,0,DEV_HOST); if(errc){*ierr=59; return;};
+  errc=talshTensorDestruct(&mt); if(errc){*ierr=59; return;};
+  for(size_t l=0; l<mvol; ++l) mref[l]*=2.0;
+  //Private mapping: Modifications are discarded:
+  errc=talshTensorConstructMapped(&mt,R8,3,mdims,mfile,MEM_MAP_PRIVATE); if(errc){*ierr=60; return;};
+  errc=talshTensorExportData(&mt,R8,mval.data()); if(errc){*ierr=60; return;};
+  for(size_t l=0; l<mvol; ++l){if(mval[l] != mref[l]){*ierr=60; return;};}
+  errc=talshTensorScale(&mt,-1.0,0.0,0,DEV_HOST); if(errc){*ierr=60; return;};
+  errc=talshTensorDestruct(&mt); if(errc){*ierr=60; return;};
+  errc=talshTensorConstructMapped(&mt,R8,3,mdims,mfile,MEM_MAP_OPEN,MEM_MAP_ADVICE_WILLNEED); if(errc){*ierr=60; return;};
+  errc=talshTensorExportData(&mt,R8,mval.data()); if(errc){*ierr=60; return;};
+  for(size_t l=0; l<mvol; ++l){if(mval[l] != mref[l]){*ierr=60; return;};}
+  errc=talshTensorDestruct(&mt); if(errc){*ierr=60; return;};
+  std::remove(mfile);
+ }
+
 //Unregister tensor blocks with TAL-SH:
  errc=talshTensorDestruct(&tens2); if(errc){*ierr=15; return;};
  errc=talshTensorDestruct(&tens1); if(errc){*ierr=16; return;};
@@ -224,6 +835,19 @@ void test_talsh_cxx(int * ierr)
     auto view = dtens.getSliceView<double>(); //full tensor view
     std::cout << "Destination tensor first element value via view = " << view[{0,0,0,0}] <<
                 " (reference = " << 0.01*0.001*VDIM*VDIM << ")" << std::endl;
+    //Access the destination tensor body via a compile-time-rank Tensor::View:
+    auto fview = dtens.getView<double,4>(); //full tensor view
+    double norm = 0.0;
+    fview.forEachRow([&norm](double * row, std::size_t len, const std::size_t *){
+     double rnorm = 0.0; for(std::size_t i = 0; i < len; ++i) rnorm += row[i];
+#ifndef NO_OMP
+#pragma omp atomic
+#endif
+     norm += rnorm;
+    });
+    std::cout << "Destination tensor first element value via fast view = " << fview(0,0,0,0) <<
+                "; Element sum = " << norm << " (reference = " <<
+                0.01*0.001*VDIM*VDIM*VDIM*VDIM*ODIM*ODIM << ")" << std::endl;
    }
   }
  }
@@ -286,6 +910,113 @@ void test_talsh_cxx(int * ierr)
   }
  }
 
+ //Test task groups:
+ if(*ierr == 0){
+  talsh::Tensor atens({1,2},{ODIM,ODIM},0.0);
+  talsh::Tensor btens({1,2},{ODIM,ODIM},0.0);
+  talsh::TaskGroup group; //must be destroyed before the tensors
+  *ierr = atens.setValue(&(group.addTask()),DEV_HOST,0,1.0);
+  if(*ierr == 0) *ierr = btens.setValue(&(group.addTask()),DEV_HOST,0,2.0);
+  if(*ierr == 0){
+   //Accumulate btens into atens once both initializations have completed:
+   constexpr talsh::ContractionPattern add_ptrn("D(a,b)+=L(a,b)"); //parsed at compile time
+   group.whenAll([&](bool success){
+    if(success) *ierr = atens.accumulate(&(group.addTask()),add_ptrn,btens,DEV_HOST,0,1.0);
+   });
+   bool done = group.waitAll();
+   const double * data_ptr = nullptr;
+   atens.getDataAccessHostConst(&data_ptr);
+   std::cout << "Task group completion status = " << done << "; Error " << *ierr
+             << "; Number of tasks = " << group.getNumTasks() << "; Element value = " << data_ptr[0]
+             << " (reference = 3)" << std::endl;
+  }
+ }
+
+ //Test compile-time pattern parsing against the run-time parser:
+ if(*ierr == 0){
+  constexpr talsh::ContractionPattern mm_ptrn("D(a,b)+=L(a,c)*R(c,b)");
+  static_assert(mm_ptrn.getDestRank() == 2 && mm_ptrn.getLeftRank() == 2 && mm_ptrn.getRightRank() == 2 &&
+                mm_ptrn.getConjBits() == 0,"#ERROR(test_talsh_cxx): Wrong ranks of D(a,b)+=L(a,c)*R(c,b)");
+  static_assert(mm_ptrn.getDigit(0) == 1 && mm_ptrn.getDigit(1) == -1 &&
+                mm_ptrn.getDigit(2) == -2 && mm_ptrn.getDigit(3) == 2,
+                "#ERROR(test_talsh_cxx): Wrong digital pattern of D(a,b)+=L(a,c)*R(c,b)");
+  constexpr talsh::ContractionPattern cj_ptrn("D(a,b)+=L+(c,a)*R(b,c)");
+  static_assert(cj_ptrn.getDestRank() == 2 && cj_ptrn.getLeftRank() == 2 && cj_ptrn.getRightRank() == 2 &&
+                cj_ptrn.getConjBits() == 2,"#ERROR(test_talsh_cxx): Wrong ranks of D(a,b)+=L+(c,a)*R(b,c)");
+  static_assert(cj_ptrn.getDigit(0) == -2 && cj_ptrn.getDigit(1) == 1 &&
+                cj_ptrn.getDigit(2) == 2 && cj_ptrn.getDigit(3) == -1,
+                "#ERROR(test_talsh_cxx): Wrong digital pattern of D(a,b)+=L+(c,a)*R(b,c)");
+  const char * valid[] = {"D(a,b)+=L(a,c)*R(c,b)","D(a,b)+=L+(c,a)*R(b,c)"};
+  const talsh::ContractionPattern * parsed[] = {&mm_ptrn,&cj_ptrn};
+  int nerr = 0;
+  for(int i = 0; i < 2; ++i){ //the run-time parser must produce the same digital pattern
+   talsh_contr_ptrn_t ptrn;
+   const talsh_contr_ptrn_t * cptrn = parsed[i]->get();
+   if(talshContrPatternParse(valid[i],&ptrn) != TALSH_SUCCESS){++nerr; continue;}
+   if(ptrn.drank != cptrn->drank || ptrn.lrank != cptrn->lrank || ptrn.rrank != cptrn->rrank ||
+      ptrn.conj_bits != cptrn->conj_bits) ++nerr;
+   for(int k = 0; k < ptrn.lrank + ptrn.rrank; ++k){if(ptrn.dig_ptrn[k] != cptrn->dig_ptrn[k]) ++nerr;}
+  }
+  const char * malformed[] = {"D(a,b)+=L(a,c)*R(c,d)",  //unpaired index label
+                              "D(a,b)+=L(a,a)*R(a,b)",  //repeated index label
+                              "D(a,b)+=L(a,c)R(c,b)",   //missing *
+                              "D(a,b)+=L(a,c)*R(c,b",   //unbalanced parentheses
+                              "D(a,b)+L(a,c)*R(c,b)",   //missing = (tolerated by the run-time parser)
+                              "D(a,b)+=(a,c)*R(c,b)"};  //missing tensor name (tolerated by the run-time parser)
+  for(int i = 0; i < 6; ++i){ //the compile-time parser rejects all malformed patterns
+   const char * pattern = malformed[i];
+   talsh_contr_ptrn_t ptrn;
+   if(i < 4 && talshContrPatternParse(pattern,&ptrn) == TALSH_SUCCESS) ++nerr;
+   bool rejected = false;
+   try{
+    talsh::detail::patternOk(pattern,static_cast<int>(std::strlen(pattern))); //throws at run time
+   }catch(const std::invalid_argument &){
+    rejected = true;
+   }
+   if(!rejected) ++nerr;
+  }
+  std::cout << "Compile-time versus run-time pattern parsing: Errors " << nerr << std::endl;
+  if(nerr != 0) *ierr = 1;
+ }
+
+ //Test tile-parallel initialization (orbital energy denominators):
+ if(*ierr == 0){
+  talsh::Tensor etens({1,2,3,4},{VDIM,VDIM,ODIM,ODIM},0.0);
+  auto denominator = [](std::size_t a, std::size_t b, std::size_t i, std::size_t j){
+   return 1.0/(1.0+0.1*static_cast<double>(a+b)+0.2*static_cast<double>(i+j));
+  };
+  *ierr = etens.applyTiles([&denominator](const talsh_tens_dense_t & tile){
+   double * body = static_cast<double*>(tile.body);
+   std::size_t l = 0;
+   for(std::size_t j = 0; j < tile.dims[3]; ++j){
+    for(std::size_t i = 0; i < tile.dims[2]; ++i){
+     for(std::size_t b = 0; b < tile.dims[1]; ++b){
+      for(std::size_t a = 0; a < tile.dims[0]; ++a){
+       body[l++] = denominator(tile.bases[0]+a,tile.bases[1]+b,tile.bases[2]+i,tile.bases[3]+j);
+      }
+     }
+    }
+   }
+   return 0;
+  },1000);
+  if(*ierr == 0){
+   auto eview = etens.getView<double,4>();
+   double max_diff = 0.0;
+   for(std::size_t j = 0; j < ODIM; ++j){
+    for(std::size_t i = 0; i < ODIM; ++i){
+     for(std::size_t b = 0; b < VDIM; ++b){
+      for(std::size_t a = 0; a < VDIM; ++a){
+       max_diff = std::max(max_diff,std::abs(eview(a,b,i,j)-denominator(a,b,i,j)));
+      }
+     }
+    }
+   }
+   std::cout << "Tile-parallel initialization completion status: Error " << *ierr
+             << "; Max deviation = " << max_diff << std::endl;
+   if(max_diff != 0.0) *ierr = 1;
+  }
+ }
+
  //Shutdown TAL-SH:
  talsh::shutdown();
  return;
@@ -430,6 +1161,60 @@ void test_talsh_hyper(int * ierr)
 }
 
 
+void test_talsh_defrag(int * ierr)
+/** Online defragmentation of the Host argument buffer: Bodies of the tensor arguments
+    of pending Host tasks stay in place, idle bodies are relocated intact. **/
+{
+ const int NUM_FRAGS=12; //4 fragments in each of 3 top-level Host buffer entries
+ size_t host_buffer_size=64*1024*1024; //bytes
+ int host_arg_max,errc;
+
+ *ierr=0;
+ errc=talshInit(&host_buffer_size,&host_arg_max,0,NULL,0,NULL,0,NULL); if(errc){*ierr=1; return;};
+ {
+  const size_t top_size=talshDeviceTensorSize(0,DEV_HOST); //size of a top-level Host buffer entry (bytes)
+  const int frag_dims[]={(int)(top_size/(4*sizeof(double)))}, big_dims[]={(int)(top_size/sizeof(double))};
+  talsh_tens_t frag[NUM_FRAGS],acc[3],big;
+  talsh_task_t tasks[3];
+  int nerr=0;
+  for(int i=0; i<NUM_FRAGS; ++i){
+   nerr+=talshTensorClean(&(frag[i]));
+   nerr+=talshTensorConstruct(&(frag[i]),R8,1,frag_dims,talshFlatDevId(DEV_HOST,0),NULL,0,NULL,(double)(i+1)); //in HAB
+  }
+  for(int i=1; i<NUM_FRAGS; i+=2) nerr+=talshTensorDestruct(&(frag[i])); //half of the buffer is free but fragmented
+  if(nerr != 0){*ierr=2; return;};
+  talshSetHostBufferAutoDefrag(0);
+  nerr+=talshTensorClean(&big);
+  if(talshTensorConstruct(&big,R8,1,big_dims,talshFlatDevId(DEV_HOST,0),NULL,0) != TRY_LATER) ++nerr;
+  talshSetHostBufferAutoDefrag(1);
+  for(int b=0; b<3; ++b){ //input tensor of a pending Host task in each top-level buffer entry: No relocation
+   nerr+=talshTensorClean(&(acc[b])); nerr+=talshTaskClean(&(tasks[b]));
+   nerr+=talshTensorConstruct(&(acc[b]),R8,1,frag_dims,talshFlatDevId(DEV_HOST,0),NULL,-1,NULL,0.0);
+   nerr+=talshTensorAdd("D(a)+=L(a)",&(acc[b]),&(frag[b*4]),1.0,0.0,0,DEV_HOST,COPY_MTT,&(tasks[b]));
+   int sts; if(talshTaskWait(&(tasks[b]),&sts) != TALSH_SUCCESS || sts != TALSH_TASK_COMPLETED) ++nerr;
+  }
+  if(talshTensorConstruct(&big,R8,1,big_dims,talshFlatDevId(DEV_HOST,0),NULL,0) != TRY_LATER) ++nerr;
+  for(int b=0; b<3; ++b) nerr+=talshTaskDestruct(&(tasks[b]));
+  if(talshTensorConstruct(&big,R8,1,big_dims,talshFlatDevId(DEV_HOST,0),NULL,0) != TALSH_SUCCESS) ++nerr; //defragmented
+  for(int i=0; i<NUM_FRAGS; i+=2){ //relocated bodies must be intact
+   double norm1=talshTensorImageNorm1_cpu(&(frag[i]));
+   if(std::abs(norm1-(double)frag_dims[0]*(double)(i+1)) > 1e-12*norm1) ++nerr;
+   nerr+=talshTensorDestruct(&(frag[i]));
+  }
+  for(int b=0; b<3; ++b){
+   double norm1=talshTensorImageNorm1_cpu(&(acc[b]));
+   if(std::abs(norm1-(double)frag_dims[0]*(double)(b*4+1)) > 1e-12*norm1) ++nerr;
+   nerr+=talshTensorDestruct(&(acc[b]));
+  }
+  nerr+=talshTensorDestruct(&big);
+  printf(" Host argument buffer defragmentation: Errors = %d\n",nerr);
+  if(nerr != 0){*ierr=3; return;};
+ }
+ errc=talshShutdown(); if(errc){*ierr=4; return;};
+ return;
+}
+
+
 void test_talsh_svd(int * ierr)
 {
  const std::size_t DESKTOP_MEM = 4;  //GB
@@ -454,6 +1239,141 @@ void test_talsh_svd(int * ierr)
  }
  std::cout << " Max buffer size on execution device = " << talsh::getDeviceMaxBufferSize(device,0) << std::endl;
  std::cout << " Max tensor size on execution device = " << talsh::getDeviceMaxTensorSize(device,0) << std::endl;
+ //Truncated SVD on Host (scoped):
+ {
+  std::cout << " Testing truncated SVD on Host:" << std::endl;
+  //Fills a tensor with pseudo-random values:
+  auto fill = [](talsh::Tensor & tens, unsigned int seed){
+   double * body; tens.getDataAccessHost(&body);
+   std::srand(seed);
+   for(std::size_t i = 0; i < tens.getVolume(); ++i) body[i] = static_cast<double>(std::rand())/RAND_MAX - 0.5;
+  };
+  //Squared 2-norm of the difference of two tensors of the same shape:
+  auto diff2 = [](talsh::Tensor & tens0, talsh::Tensor & tens1){
+   double *body0,*body1,res = 0.0;
+   tens0.getDataAccessHost(&body0); tens1.getDataAccessHost(&body1);
+   for(std::size_t i = 0; i < tens0.getVolume(); ++i) res += (body0[i]-body1[i])*(body0[i]-body1[i]);
+   return res;
+  };
+  //Tensor D(a,b,c,d) of exact rank 12 with respect to the (a,b)|(c,d) matricization:
+  talsh::Tensor xtens({16,16,12},0.0), ytens({12,20,20},0.0);
+  talsh::Tensor dtens({16,16,20,20},0.0), ztens({16,16,20,20},0.0);
+  fill(xtens,1); fill(ytens,2);
+  *ierr = dtens.contractAccumulate(nullptr,"D(a,b,c,d)+=X(a,b,i)*Y(i,c,d)",xtens,ytens,DEV_HOST,0,1.0,false);
+  if(*ierr != TALSH_SUCCESS){*ierr = 21; return;}
+  double dnorm2 = diff2(dtens,ztens);
+  //Randomized range finder with rank detection:
+  talsh::Tensor ltens({16,16,16},0.0), rtens({16,20,20},0.0);
+  int rank = 0; double weight = 1.0;
+  double tm = time_sys_sec();
+  *ierr = dtens.decomposeSVDLR(nullptr,"D(a,b,c,d)=L(a,b,i)*R(i,c,d)",ltens,rtens,16,1e-10,&rank,&weight);
+  tm = time_sys_sec() - tm;
+  std::cout << "  Randomized (256x400, max rank 16): Status " << *ierr << ": Rank " << rank
+            << ": Discarded weight " << weight << ": Time (s) " << tm << std::endl;
+  if(*ierr != TALSH_SUCCESS){*ierr = 22; return;}
+  if(rank != 12 || weight > 1e-12){*ierr = 23; return;}
+  *ierr = ztens.contractAccumulate(nullptr,"D(a,b,c,d)+=L(a,b,i)*R(i,c,d)",ltens,rtens,DEV_HOST,0,1.0,false);
+  double err = diff2(dtens,ztens)/dnorm2;
+  std::cout << "  Relative reconstruction error = " << std::sqrt(err) << std::endl;
+  if(*ierr != TALSH_SUCCESS || err > 1e-20){*ierr = 24; return;}
+  //Truncation to a lower rank (the discarded weight must match the reconstruction error):
+  talsh::Tensor stens({16},0.0);
+  *ierr = dtens.decomposeSVD(nullptr,"D(a,b,c,d)=L(a,b,i)*R(i,c,d)",ltens,rtens,stens,6,0.0,&rank,&weight);
+  std::cout << "  Randomized (256x400, max rank 6): Status " << *ierr << ": Rank " << rank
+            << ": Discarded weight " << weight << std::endl;
+  if(*ierr != TALSH_SUCCESS || rank != 6){*ierr = 25; return;}
+  double * sbody; stens.getDataAccessHost(&sbody);
+  for(int i = 1; i < 16; ++i){if(sbody[i] > sbody[i-1] || (i >= rank && sbody[i] != 0.0)){*ierr = 26; return;}}
+  *ierr = dtens.decomposeSVDL(nullptr,"D(a,b,c,d)=L(a,b,i)*R(i,c,d)",ltens,rtens,6,0.0,&rank,&weight);
+  if(*ierr != TALSH_SUCCESS){*ierr = 27; return;}
+  *ierr = ztens.contractAccumulate(nullptr,"D(a,b,c,d)+=L(a,b,i)*R(i,c,d)",ltens,rtens,DEV_HOST,0,1.0,false);
+  err = diff2(dtens,ztens)/dnorm2;
+  std::cout << "  Relative squared reconstruction error = " << err << std::endl;
+  if(*ierr != TALSH_SUCCESS || std::abs(err-weight) > 1e-10){*ierr = 28; return;}
+  //Threshold-only truncation of a large matricization of exact rank 48 (the sketch must grow):
+  talsh::Tensor gxtens({16,16,48},0.0), gytens({48,20,20},0.0);
+  talsh::Tensor gdtens({16,16,20,20},0.0), gztens({16,16,20,20},0.0);
+  talsh::Tensor gltens({16,16,64},0.0), grtens({64,20,20},0.0);
+  fill(gxtens,5); fill(gytens,6);
+  *ierr = gdtens.contractAccumulate(nullptr,"D(a,b,c,d)+=X(a,b,i)*Y(i,c,d)",gxtens,gytens,DEV_HOST,0,1.0,false);
+  if(*ierr != TALSH_SUCCESS){*ierr = 32; return;}
+  double gnorm2 = diff2(gdtens,gztens);
+  *ierr = gdtens.decomposeSVDLR(nullptr,"D(a,b,c,d)=L(a,b,i)*R(i,c,d)",gltens,grtens,0,1e-10,&rank,&weight);
+  std::cout << "  Randomized (256x400, threshold 1e-10): Status " << *ierr << ": Rank " << rank
+            << ": Discarded weight " << weight << std::endl;
+  if(*ierr != TALSH_SUCCESS || rank != 48 || weight > 1e-12){*ierr = 33; return;}
+  *ierr = gztens.contractAccumulate(nullptr,"D(a,b,c,d)+=L(a,b,i)*R(i,c,d)",gltens,grtens,DEV_HOST,0,1.0,false);
+  err = diff2(gdtens,gztens)/gnorm2;
+  if(*ierr != TALSH_SUCCESS || err > 1e-20){*ierr = 34; return;}
+  //Jacobi SVD of a small permuted matricization with a threshold cutoff:
+  talsh::Tensor btens({4,6,5,3},0.0), wtens({4,6,5,3},0.0);
+  talsh::Tensor utens({5,18,4},0.0), vtens({3,18,6},0.0);
+  fill(btens,3);
+  double bnorm2 = diff2(btens,wtens);
+  *ierr = btens.decomposeSVDR(nullptr,"D(a,b,c,d)=L(c,i,a)*R(d,i,b)",utens,vtens,0,0.0,&rank,&weight);
+  std::cout << "  Jacobi (20x18, full rank): Status " << *ierr << ": Rank " << rank
+            << ": Discarded weight " << weight << std::endl;
+  if(*ierr != TALSH_SUCCESS || rank != 18 || weight > 1e-12){*ierr = 29; return;}
+  *ierr = wtens.contractAccumulate(nullptr,"D(a,b,c,d)+=L(c,i,a)*R(d,i,b)",utens,vtens,DEV_HOST,0,1.0,false);
+  err = diff2(btens,wtens)/bnorm2;
+  if(*ierr != TALSH_SUCCESS || err > 1e-20){*ierr = 30; return;}
+  *ierr = btens.decomposeSVDR(nullptr,"D(a,b,c,d)=L(c,i,a)*R(d,i,b)",utens,vtens,0,0.5,&rank,&weight);
+  *ierr = wtens.contractAccumulate(nullptr,"D(a,b,c,d)+=L(c,i,a)*R(d,i,b)",utens,vtens,DEV_HOST,0,1.0,false);
+  err = diff2(btens,wtens)/bnorm2;
+  std::cout << "  Jacobi (20x18, threshold 0.5): Status " << *ierr << ": Rank " << rank
+            << ": Discarded weight " << weight << std::endl;
+  if(*ierr != TALSH_SUCCESS || rank <= 0 || rank >= 18 || std::abs(err-weight) > 1e-10){*ierr = 31; return;}
+  *ierr = 0;
+ }
+ //QR decomposition and orthogonalization on Host (scoped):
+ {
+  std::cout << " Testing QR decomposition on Host:" << std::endl;
+  //Max deviation of the Gram matrix G(i,j) of Q(x,i,y) over the isometric (x,y) dimensions from the identity:
+  auto iso_err = [](talsh::Tensor & gtens){
+   std::complex<double> * body; gtens.getDataAccessHost(&body);
+   const int n = gtens.getDimExtent(0); double res = 0.0;
+   for(int j = 0; j < n; ++j){
+    for(int i = 0; i < n; ++i) res = std::max(res,std::abs(body[j*n+i]-std::complex<double>((i == j)?1.0:0.0,0.0)));
+   }
+   return res;
+  };
+  //Tall-skinny QR via CholeskyQR2:
+  talsh::Tensor dtens({64,16,32},std::complex<double>{0.0,0.0}), ztens({64,16,32},std::complex<double>{0.0,0.0});
+  talsh::Tensor qtens({32,64,16},std::complex<double>{0.0,0.0}), rtens({16,16},std::complex<double>{0.0,0.0});
+  talsh::Tensor gtens({16,16},std::complex<double>{0.0,0.0});
+  std::complex<double> * dbody; dtens.getDataAccessHost(&dbody);
+  std::srand(4);
+  for(std::size_t i = 0; i < dtens.getVolume(); ++i)
+   dbody[i] = std::complex<double>(static_cast<double>(std::rand())/RAND_MAX-0.5,static_cast<double>(std::rand())/RAND_MAX-0.5);
+  double tm = time_sys_sec();
+  *ierr = dtens.decomposeQR(nullptr,"D(a,b,c)=Q(c,a,i)*R(i,b)",qtens,rtens);
+  tm = time_sys_sec() - tm;
+  std::cout << "  CholeskyQR2 (2048x16): Status " << *ierr << ": Time (s) " << tm << std::endl;
+  if(*ierr != TALSH_SUCCESS){*ierr = 41; return;}
+  *ierr = ztens.contractAccumulate(nullptr,"D(a,b,c)+=Q(c,a,i)*R(i,b)",qtens,rtens,DEV_HOST,0,std::complex<double>{1.0,0.0},false);
+  std::complex<double> * zbody; ztens.getDataAccessHost(&zbody);
+  double err = 0.0;
+  for(std::size_t i = 0; i < dtens.getVolume(); ++i) err = std::max(err,std::abs(dbody[i]-zbody[i]));
+  std::cout << "  Max reconstruction error = " << err << std::endl;
+  if(*ierr != TALSH_SUCCESS || err > 1e-12){*ierr = 42; return;}
+  *ierr = gtens.contractAccumulate(nullptr,"G(i,j)+=L+(c,a,i)*R(c,a,j)",qtens,qtens,DEV_HOST,0,std::complex<double>{1.0,0.0},false);
+  err = iso_err(gtens);
+  std::cout << "  Max deviation of Q+Q from identity = " << err << std::endl;
+  if(*ierr != TALSH_SUCCESS || err > 1e-12){*ierr = 43; return;}
+  std::complex<double> * rbody; rtens.getDataAccessHost(&rbody);
+  for(int j = 0; j < 16; ++j){for(int i = j+1; i < 16; ++i){if(rbody[j*16+i] != std::complex<double>(0.0,0.0)){*ierr = 44; return;}}}
+  //Orthogonalization of a rank-deficient tensor (MGS fallback):
+  for(int j = 0; j < 32; ++j){for(int i = 0; i < 64; ++i) dbody[j*64*16+5*64+i] = dbody[j*64*16+2*64+i];}
+  *ierr = dtens.orthogonalizeMGS(nullptr,{0,2});
+  std::cout << "  Orthogonalization of a rank-deficient tensor: Status " << *ierr << std::endl;
+  if(*ierr != TALSH_SUCCESS){*ierr = 45; return;}
+  talsh::Tensor htens({16,16},std::complex<double>{0.0,0.0});
+  *ierr = htens.contractAccumulate(nullptr,"G(b,e)+=L+(a,b,c)*R(a,e,c)",dtens,dtens,DEV_HOST,0,std::complex<double>{1.0,0.0},false);
+  err = iso_err(htens);
+  std::cout << "  Max deviation of D+D from identity = " << err << std::endl;
+  if(*ierr != TALSH_SUCCESS || err > 1e-12){*ierr = 46; return;}
+  *ierr = 0;
+ }
  //Test body (scoped):
  {
   //Create tensors on Host:
@@ -573,6 +1493,240 @@ void test_talsh_svd(int * ierr)
 }
 
 
+void test_talsh_threads(int * ierr)
+/** Concurrent submission of synchronous Host tensor operations on disjoint tensors
+    from multiple application threads: Submission rate vs thread count, also while
+    the Host argument buffer is being defragmented by another thread. **/
+{
+ const int NUM_CALLS=4000; //per thread
+ const int dims[]={8,8,8};
+ size_t host_buffer_size=64*1024*1024; //bytes
+ int host_arg_max,errc;
+
+ *ierr=0;
+ errc=talshInit(&host_buffer_size,&host_arg_max,0,NULL,0,NULL,0,NULL); if(errc){*ierr=1; return;};
+#ifndef NO_OMP
+ int max_threads=omp_get_max_threads();
+#else
+ int max_threads=1;
+#endif
+ //Concurrent acquisition/release of slab entries (lock-free free list with per-thread magazines):
+ {
+  const int NUM_SLAB_ENTRIES=256, NUM_SLAB_ITERS=20000, MAX_HELD=8;
+  slab_t slab;
+  int nerr=0;
+  errc=slab_clean(&slab);
+  if(errc == 0) errc=slab_construct(&slab,sizeof(long long),NUM_SLAB_ENTRIES);
+  if(errc == 0) errc=slab_set_magazines(&slab,4,MAX_HELD);
+  if(errc){*ierr=4; return;};
+#ifndef NO_OMP
+#pragma omp parallel num_threads(max_threads) reduction(+:nerr)
+#endif
+  {
+#ifndef NO_OMP
+   const long long tid=omp_get_thread_num();
+#else
+   const long long tid=0;
+#endif
+   void * held[MAX_HELD];
+   for(int it=0; it<NUM_SLAB_ITERS; ++it){
+    const long long marker=tid*NUM_SLAB_ITERS+it; //unique per thread and iteration
+    int num_held=0;
+    for(int i=0; i<(it%MAX_HELD)+1; ++i){
+     void * entry=NULL;
+     int ier=slab_entry_get(&slab,&entry);
+     if(ier == 0){*((long long*)entry)=marker; held[num_held++]=entry;}else{if(ier != TRY_LATER) ++nerr;}
+    }
+    for(int i=0; i<num_held; ++i){
+     if(*((long long*)(held[i])) != marker) ++nerr; //the same entry was given to two threads
+     if(slab_entry_release(&slab,held[i]) != 0) ++nerr;
+    }
+   }
+  }
+  void * entry=NULL; //double release must be detected
+  if(slab_entry_get(&slab,&entry) == 0){
+   if(slab_entry_release(&slab,entry) != 0) ++nerr;
+   if(slab_entry_release(&slab,entry) != 1) ++nerr;
+  }else{
+   ++nerr;
+  }
+  if(slab_destruct(&slab) != 0) ++nerr;
+  printf(" Slab stress test: %d threads: Errors = %d\n",max_threads,nerr);
+  if(nerr != 0){*ierr=5; return;};
+ }
+ //Thread budget of BLAS calls issued concurrently by application threads (outside parallel regions):
+ {
+  const int NUM_APP_THREADS=4, BLAS_THREADS=8;
+  int granted[NUM_APP_THREADS];
+  std::atomic<int> arrived(0);
+  int nerr=0,total=0;
+  talshSetBlasThreads(BLAS_THREADS,YEP);
+  for(int round=0; round<2; ++round){ //0: the budget is held by another call; 1: all calls start at once
+   const int held=((round == 0)?cpu_blas_call_begin():0);
+   if(round == 0 && held != BLAS_THREADS) ++nerr; //a lone call gets the whole budget
+   arrived=0;
+   std::vector<std::thread> app;
+   for(int t=0; t<NUM_APP_THREADS; ++t){
+    app.emplace_back([&granted,&arrived,t](){
+     granted[t]=cpu_blas_call_begin();
+     ++arrived; while(arrived.load() < NUM_APP_THREADS) std::this_thread::yield(); //all calls are in flight
+     cpu_blas_call_end(granted[t]);
+    });
+   }
+   for(auto & thr: app) thr.join();
+   total=held;
+   for(int t=0; t<NUM_APP_THREADS; ++t){if(granted[t] < 1) ++nerr; total+=granted[t];}
+   if(round == 0){
+    if(total != BLAS_THREADS+NUM_APP_THREADS) ++nerr; //one thread per call beyond the budget
+    cpu_blas_call_end(held);
+   }else{
+    if(total > BLAS_THREADS+NUM_APP_THREADS-1) ++nerr; //at most one thread per call beyond the budget
+   }
+  }
+  const int lone=cpu_blas_call_begin(); //all threads have been released
+  if(lone != BLAS_THREADS) ++nerr;
+  cpu_blas_call_end(lone);
+  talshSetBlasThreads(0,YEP);
+  printf(" Concurrent BLAS calls: %d application threads: %d BLAS threads (budget %d): Errors = %d\n",
+         NUM_APP_THREADS,total,BLAS_THREADS,nerr);
+  if(nerr != 0){*ierr=6; return;};
+ }
+ //Concurrent Host operations on HAB-resident tensors while the Host argument buffer is being defragmented:
+ {
+  const int NUM_DEFRAG_CYCLES=16; //number of fragmentation/defragmentation cycles
+  const int MAX_FRAGS=12; //max number of quarter-size fragments in the Host argument buffer
+  const int wdims[]={32,32,32}; //long enough operations to overlap with relocations
+  const size_t top_size=talshDeviceTensorSize(0,DEV_HOST);
+  const int frag_dims[]={(int)(top_size/(4*sizeof(double)))}, big_dims[]={(int)(top_size/sizeof(double))};
+  int nerr=0,num_cycles=0;
+#ifndef NO_OMP
+#pragma omp parallel num_threads(max_threads) reduction(+:nerr)
+#endif
+  {
+#ifndef NO_OMP
+   const int tid=omp_get_thread_num(), nthreads=omp_get_num_threads();
+   omp_set_num_threads(1);
+#else
+   const int tid=0, nthreads=1;
+#endif
+   const bool worker=(tid != 0 || nthreads == 1), defragger=(tid == 0);
+   talsh_tens_t dtens,ltens,rtens;
+   int num_ops=0,cycles=0;
+   if(worker){ //worker: HAB-resident input arguments (relocatable in between the operations)
+    nerr+=talshTensorClean(&dtens); nerr+=talshTensorClean(&ltens); nerr+=talshTensorClean(&rtens);
+    nerr+=talshTensorConstruct(&dtens,R8,3,wdims,talshFlatDevId(DEV_HOST,0),NULL,-1,NULL,0.0);
+    nerr+=talshTensorConstruct(&ltens,R8,3,wdims,talshFlatDevId(DEV_HOST,0),NULL,0,NULL,0.5);
+    nerr+=talshTensorConstruct(&rtens,R8,2,wdims,talshFlatDevId(DEV_HOST,0),NULL,0,NULL,0.25);
+   }
+#ifndef NO_OMP
+#pragma omp barrier
+#endif
+   while(cycles < NUM_DEFRAG_CYCLES){
+    if(worker){
+     for(int n=0; n<((nthreads == 1)?10:1); ++n){
+      if(talshTensorContract("D(a,b,c)+=L(c,d,a)*R(d,b)",&dtens,&ltens,&rtens,1.0,0.0,0,DEV_HOST) != TALSH_SUCCESS) ++nerr;
+      ++num_ops;
+     }
+    }
+    if(defragger){ //fill the buffer, fragment it and defragment it
+     talsh_tens_t frag[MAX_FRAGS];
+     int num_frags=0,ier;
+     while(num_frags < MAX_FRAGS){
+      talshTensorClean(&(frag[num_frags]));
+      ier=talshTensorConstruct(&(frag[num_frags]),R8,1,frag_dims,talshFlatDevId(DEV_HOST,0),NULL,0,NULL,(double)(num_frags+1));
+      if(ier != TALSH_SUCCESS){if(ier != TRY_LATER) ++nerr; break;}
+      ++num_frags;
+     }
+     for(int i=0; i<num_frags; i+=2) nerr+=talshTensorDestruct(&(frag[i]));
+     ier=talshHostBufferDefrag(top_size);
+     if(ier == TALSH_SUCCESS){ //the vacated buffer entry is reused at once
+      talsh_tens_t big;
+      talshTensorClean(&big);
+      if(talshTensorConstruct(&big,R8,1,big_dims,talshFlatDevId(DEV_HOST,0),NULL,0,NULL,-1.0) != TALSH_SUCCESS) ++nerr;
+      nerr+=talshTensorDestruct(&big);
+     }else{
+      if(ier != TRY_LATER) ++nerr;
+     }
+     for(int i=1; i<num_frags; i+=2){
+      double norm1=talshTensorImageNorm1_cpu(&(frag[i]));
+      if(std::abs(norm1-(double)frag_dims[0]*(double)(i+1)) > 1e-12*norm1) ++nerr;
+      nerr+=talshTensorDestruct(&(frag[i]));
+     }
+#ifndef NO_OMP
+#pragma omp atomic update
+#endif
+     ++num_cycles;
+    }
+#ifndef NO_OMP
+#pragma omp atomic read
+#endif
+    cycles=num_cycles;
+   }
+   if(worker){
+    double norm1=talshTensorImageNorm1_cpu(&dtens);
+    double correct=(double)talshTensorVolume(&dtens)*(double)wdims[0]*0.5*0.25*(double)num_ops;
+    if(std::abs(norm1-correct) > 1e-9*correct) ++nerr;
+    nerr+=talshTensorDestruct(&rtens); nerr+=talshTensorDestruct(&ltens); nerr+=talshTensorDestruct(&dtens);
+   }
+  }
+  printf(" Host operations during defragmentation: %d threads: Errors = %d\n",max_threads,nerr);
+  if(nerr != 0){*ierr=8; return;};
+ }
+ size_t small_vol=talshSetSmallTensorVolume(TALSH_SMALL_TENSOR_VOLUME);
+ for(int path=0; path<2; ++path){ //0: native small-tensor path; 1: <tensor_block_t> path
+  talshSetSmallTensorVolume((path == 0)?TALSH_SMALL_TENSOR_VOLUME:0);
+  double rate1=0.0;
+  for(int num_threads=1; num_threads<=max_threads; num_threads*=2){
+   int nerr=0;
+   double tms=0.0,tm=0.0;
+#ifndef NO_OMP
+#pragma omp parallel num_threads(num_threads) reduction(+:nerr)
+#endif
+   {
+#ifndef NO_OMP
+    omp_set_num_threads(1); //Host kernels must not spawn nested thread teams (the 1-thread baseline would be inflated)
+#endif
+    talsh_tens_t dtens,ltens,rtens;
+    nerr+=talshTensorClean(&dtens); nerr+=talshTensorClean(&ltens); nerr+=talshTensorClean(&rtens);
+    nerr+=talshTensorConstruct(&dtens,R8,3,dims,talshFlatDevId(DEV_HOST,0),NULL,-1,NULL,0.0);
+    nerr+=talshTensorConstruct(&ltens,R8,3,dims,talshFlatDevId(DEV_HOST,0),NULL,-1,NULL,0.5);
+    nerr+=talshTensorConstruct(&rtens,R8,2,dims,talshFlatDevId(DEV_HOST,0),NULL,-1,NULL,0.25);
+#ifndef NO_OMP
+#pragma omp barrier
+#pragma omp master
+    tms=omp_get_wtime();
+#pragma omp barrier
+#else
+    tms=((double)clock())/CLOCKS_PER_SEC;
+#endif
+    for(int n=0; n<NUM_CALLS; ++n){
+     if(talshTensorContract("D(a,b,c)+=L(c,d,a)*R(d,b)",&dtens,&ltens,&rtens,1.0,0.0,0,DEV_HOST) != TALSH_SUCCESS) ++nerr;
+    }
+#ifndef NO_OMP
+#pragma omp barrier
+#pragma omp master
+    tm=omp_get_wtime()-tms;
+#else
+    tm=((double)clock())/CLOCKS_PER_SEC-tms;
+#endif
+    double norm1=talshTensorImageNorm1_cpu(&dtens);
+    double correct=(double)talshTensorVolume(&dtens)*(double)dims[0]*0.5*0.25*NUM_CALLS;
+    if(std::abs(norm1-correct) > 1e-9*correct) ++nerr;
+    nerr+=talshTensorDestruct(&rtens); nerr+=talshTensorDestruct(&ltens); nerr+=talshTensorDestruct(&dtens);
+   }
+   double rate=((double)(num_threads*NUM_CALLS))/tm;
+   if(num_threads == 1) rate1=rate;
+   printf(" %s path: %d threads: Submission rate = %.0f ops/s (speedup %.2f): Errors = %d\n",
+          (path == 0)?"Native":"<tensor_block_t>",num_threads,rate,rate/rate1,nerr);
+   if(nerr != 0){*ierr=2; return;};
+  }
+ }
+ talshSetSmallTensorVolume(small_vol);
+ errc=talshShutdown(); if(errc){*ierr=3; return;};
+ return;
+}
+
+
 void test_talsh_qc_xl(int * ierr)
 {
  const std::size_t HOST_MEM_LIM = 180; //GB
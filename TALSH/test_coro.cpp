@@ -0,0 +1,81 @@
+/** TALSH::C++20 coroutine interface testing.
+
+!Copyright (C) 2014-2022 Dmitry I. Lyakh (Liakh)
+!Copyright (C) 2014-2022 Oak Ridge National Laboratory (UT-Battelle)
+
+LICENSE: BSD 3-Clause **/
+
+#include "talshxx_coro.hpp"
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+
+#if __cplusplus >= 202002L && defined(__cpp_impl_coroutine)
+
+using namespace talsh::coro;
+
+Task<int> branch(Scheduler & sched, talsh::Tensor & dtens, talsh::Tensor & ltens, talsh::Tensor & rtens)
+{
+ int errc = co_await setValue(sched,dtens,DEV_HOST,0,0.0);
+ if(errc == TALSH_SUCCESS) errc = co_await contractAccumulate(sched,dtens,"D(a,b)+=L(a,c)*R(c,b)",ltens,rtens,DEV_HOST,0,1.0);
+ if(errc == TALSH_SUCCESS) errc = co_await sync(sched,dtens);
+ co_return errc;
+}
+
+Task<int> root(Scheduler & sched, talsh::Tensor & d1, talsh::Tensor & d2, talsh::Tensor & ltens, talsh::Tensor & rtens)
+{
+ std::vector<Task<int>> branches;
+ branches.emplace_back(branch(sched,d1,ltens,rtens));
+ branches.emplace_back(branch(sched,d2,ltens,rtens));
+ co_await whenAll(branches); //independent branches run concurrently
+ int errc = branches[0].result();
+ if(errc == TALSH_SUCCESS) errc = branches[1].result();
+ if(errc == TALSH_SUCCESS) errc = co_await accumulate(sched,d1,"D(a,b)+=L(a,b)",d2,DEV_HOST,0,1.0);
+ if(errc == TALSH_SUCCESS) errc = co_await sync(sched,d1);
+ co_return errc;
+}
+
+static int check_body(talsh::Tensor & tens, double ref)
+{
+ const double * body = nullptr;
+ if(!tens.getDataAccessHostConst(&body)) return 1;
+ for(std::size_t i = 0; i < tens.getVolume(); ++i){
+  if(std::abs(body[i] - ref) > 1e-12) return 1;
+ }
+ return 0;
+}
+
+int main()
+{
+ const int DIM = 16;
+ std::size_t host_buf_size = static_cast<std::size_t>(1024*1024*64);
+ int ierr = 0;
+
+ talsh::initialize(&host_buf_size);
+ {
+  talsh::Tensor ltens({1,2},{DIM,DIM},0.5);
+  talsh::Tensor rtens({1,2},{DIM,DIM},2.0);
+  talsh::Tensor d1({1,2},{DIM,DIM},-1.0);
+  talsh::Tensor d2({1,2},{DIM,DIM},-1.0);
+  Scheduler sched;
+  int errc = sched.run(root(sched,d1,d2,ltens,rtens));
+  if(errc != TALSH_SUCCESS){ierr = 1;}
+  else if(sched.getNumPending() != 0){ierr = 2;}
+  else if(check_body(d2,static_cast<double>(DIM)) != 0){ierr = 3;}
+  else if(check_body(d1,static_cast<double>(2*DIM)) != 0){ierr = 4;}
+ }
+ talsh::shutdown();
+ std::cout << "TAL-SH coroutine test: IERR = " << ierr << std::endl;
+ return ierr;
+}
+
+#else
+
+int main()
+{
+ std::cout << "TAL-SH coroutine test: C++20 coroutines are not supported by the compiler" << std::endl;
+ return 1;
+}
+
+#endif